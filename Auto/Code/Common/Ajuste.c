@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "Ajuste.h"
+
+// Coeficiente do modelo de custo gravado no perfil
+typedef struct {
+    const char *nome;
+    size_t deslocamento;
+} CoeficienteModelo;
+
+static const CoeficienteModelo coeficientes[] = {
+    { "nsQuicksortSeq",     offsetof(ModeloCusto, nsQuicksortSeq) },
+    { "nsQuicksortConc",    offsetof(ModeloCusto, nsQuicksortConc) },
+    { "nsDuploPivo",        offsetof(ModeloCusto, nsDuploPivo) },
+    { "nsParticaoSerial",   offsetof(ModeloCusto, nsParticaoSerial) },
+    { "nsDuplicatasLomuto", offsetof(ModeloCusto, nsDuplicatasLomuto) },
+    { "nsMinMax",           offsetof(ModeloCusto, nsMinMax) },
+    { "nsCorridas",         offsetof(ModeloCusto, nsCorridas) },
+    { "nsContagem",         offsetof(ModeloCusto, nsContagem) },
+    { "nsAprendida",        offsetof(ModeloCusto, nsAprendida) },
+    { "nsMesclagem",        offsetof(ModeloCusto, nsMesclagem) },
+    { "nsMesclagemLocal",   offsetof(ModeloCusto, nsMesclagemLocal) },
+    { "nsCompactacao",      offsetof(ModeloCusto, nsCompactacao) },
+    { "nsInverter",         offsetof(ModeloCusto, nsInverter) },
+    { "usThread",           offsetof(ModeloCusto, usThread) },
+    { "eficienciaParalela", offsetof(ModeloCusto, eficienciaParalela) },
+};
+#define NUM_COEFICIENTES (int)(sizeof(coeficientes) / sizeof(coeficientes[0]))
+
+// Perfil do processo
+static AjusteMaquina ajusteProcesso;
+static pthread_once_t ajusteCarregado = PTHREAD_ONCE_INIT;
+static const char *arquivoProcesso = NULL;
+
+// Preenche o perfil com os valores padrão
+void ajustePadrao(AjusteMaquina *ajuste) {
+    memset(ajuste, 0, sizeof(*ajuste));
+    for (int a = 0; a < ORDENACAO_NUM_ALGORITMOS; a++) {
+        ajuste->algoritmos[a].limiteTarefa = ORDENACAO_LIMITE_TAREFA;
+        ajuste->algoritmos[a].limiteInsercao = 1;
+    }
+    modeloCustoPadrao(&ajuste->modelo);
+}
+
+// Retorna a classe de tamanho de n
+int classeTamanho(long n) {
+    int classe = 0;
+    while (n >= 10 && classe < AJUSTE_NUM_CLASSES - 1) {
+        n /= 10;
+        classe++;
+    }
+    return classe;
+}
+
+// Função para aplicar uma linha "chave=valor" do perfil; retorna -1 se a chave for desconhecida
+static int aplicarChave(AjusteMaquina *ajuste, const char *chave, const char *valor) {
+    if (strcmp(chave, "cpus") == 0) {
+        ajuste->cpus = atoi(valor);
+        return 0;
+    }
+
+    // Coeficientes do modelo: modelo.<nome>
+    if (strncmp(chave, "modelo.", 7) == 0) {
+        for (int c = 0; c < NUM_COEFICIENTES; c++) {
+            if (strcmp(chave + 7, coeficientes[c].nome) == 0) {
+                *(double *)((char *)&ajuste->modelo + coeficientes[c].deslocamento) = atof(valor);
+                ajuste->modeloAjustado = 1;
+                return 0;
+            }
+        }
+        return -1;
+    }
+
+    // Parâmetros de um algoritmo: <algoritmo>.<parâmetro>
+    const char *ponto = strchr(chave, '.');
+    if (!ponto || ponto - chave >= 32) {
+        return -1;
+    }
+    char nome[32];
+    memcpy(nome, chave, (size_t)(ponto - chave));
+    nome[ponto - chave] = '\0';
+    AlgoritmoOrdenacao algoritmo;
+    if (algoritmoOrdenacaoDoNome(nome, &algoritmo) < 0) {
+        return -1;
+    }
+    AjusteAlgoritmo *parametros = &ajuste->algoritmos[algoritmo];
+    const char *parametro = ponto + 1;
+
+    if (strcmp(parametro, "limite_tarefa") == 0) {
+        parametros->limiteTarefa = atol(valor) > 0 ? atol(valor) : 1;
+    } else if (strcmp(parametro, "limite_insercao") == 0) {
+        parametros->limiteInsercao = atol(valor) > 0 ? atol(valor) : 1;
+    } else if (strncmp(parametro, "threads.1e", 10) == 0) {
+        int classe = atoi(parametro + 10);
+        if (classe < 0 || classe >= AJUSTE_NUM_CLASSES) {
+            return -1;
+        }
+        parametros->threads[classe] = atoi(valor) > 0 ? atoi(valor) : 0;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+// Lê o perfil do arquivo sobre os valores padrão
+int carregarAjuste(const char *arquivo, AjusteMaquina *ajuste) {
+    ajustePadrao(ajuste);
+    FILE *entrada = fopen(arquivo, "r");
+    if (!entrada) {
+        return -1;
+    }
+
+    char linha[512];
+    int numeroLinha = 0;
+    while (fgets(linha, sizeof(linha), entrada)) {
+        numeroLinha++;
+        linha[strcspn(linha, "\r\n")] = '\0';
+        char *chave = linha;
+        while (*chave == ' ' || *chave == '\t') {
+            chave++;
+        }
+        if (*chave == '\0' || *chave == '#') {
+            continue;
+        }
+
+        char *igual = strchr(chave, '=');
+        if (!igual) {
+            fprintf(stderr, "Aviso: linha %d do perfil %s ignorada (esperado chave=valor)\n", numeroLinha, arquivo);
+            continue;
+        }
+        *igual = '\0';
+        if (aplicarChave(ajuste, chave, igual + 1) < 0) {
+            fprintf(stderr, "Aviso: chave desconhecida no perfil %s: %s\n", arquivo, chave);
+        }
+    }
+    fclose(entrada);
+
+    ajuste->carregado = 1;
+    snprintf(ajuste->arquivo, sizeof(ajuste->arquivo), "%s", arquivo);
+    return 0;
+}
+
+// Grava o perfil no arquivo
+int salvarAjuste(const char *arquivo, const AjusteMaquina *ajuste) {
+    FILE *saida = fopen(arquivo, "w");
+    if (!saida) {
+        perror("Erro ao gravar o perfil de ajuste");
+        return -1;
+    }
+
+    fprintf(saida, "# Perfil de ajuste gerado pelo Autoajuste (ver Common/Ajuste.h)\n");
+    fprintf(saida, "cpus=%d\n", ajuste->cpus);
+
+    AjusteMaquina padrao;
+    ajustePadrao(&padrao);
+    for (int a = 0; a < ORDENACAO_NUM_ALGORITMOS; a++) {
+        const AjusteAlgoritmo *parametros = &ajuste->algoritmos[a];
+        const char *nome = nomeAlgoritmoOrdenacao((AlgoritmoOrdenacao)a);
+        if (parametros->limiteTarefa != padrao.algoritmos[a].limiteTarefa) {
+            fprintf(saida, "%s.limite_tarefa=%ld\n", nome, parametros->limiteTarefa);
+        }
+        if (parametros->limiteInsercao != padrao.algoritmos[a].limiteInsercao) {
+            fprintf(saida, "%s.limite_insercao=%ld\n", nome, parametros->limiteInsercao);
+        }
+        for (int c = 0; c < AJUSTE_NUM_CLASSES; c++) {
+            if (parametros->threads[c] > 0) {
+                fprintf(saida, "%s.threads.1e%d=%d\n", nome, c, parametros->threads[c]);
+            }
+        }
+    }
+
+    for (int c = 0; c < NUM_COEFICIENTES; c++) {
+        fprintf(saida, "modelo.%s=%g\n", coeficientes[c].nome,
+                *(const double *)((const char *)&ajuste->modelo + coeficientes[c].deslocamento));
+    }
+
+    if (fclose(saida) != 0) {
+        perror("Erro ao gravar o perfil de ajuste");
+        return -1;
+    }
+    return 0;
+}
+
+// Define o arquivo do perfil do processo
+void definirArquivoAjuste(const char *arquivo) {
+    arquivoProcesso = arquivo;
+}
+
+// Função para carregar o perfil do processo (executada uma única vez)
+static void carregarAjusteProcesso(void) {
+    const char *arquivo = arquivoProcesso;
+    if (!arquivo) {
+        arquivo = getenv(AJUSTE_VARIAVEL);
+    }
+    if (!arquivo || *arquivo == '\0') {
+        arquivo = AJUSTE_ARQUIVO_PADRAO;
+    }
+
+    if (strcmp(arquivo, "nenhum") == 0) {
+        ajustePadrao(&ajusteProcesso);
+        return;
+    }
+    if (carregarAjuste(arquivo, &ajusteProcesso) < 0 && arquivoProcesso) {
+        // Só avisa quando o arquivo foi pedido explicitamente
+        fprintf(stderr, "Aviso: perfil de ajuste %s não encontrado; usando os valores padrão\n", arquivo);
+    }
+}
+
+// Retorna o perfil do processo, carregado na primeira chamada
+const AjusteMaquina *ajusteMaquina(void) {
+    pthread_once(&ajusteCarregado, carregarAjusteProcesso);
+    return &ajusteProcesso;
+}
+
+// Retorna as threads úteis do algoritmo para n elementos, até disponiveis
+int threadsAjustadas(const AjusteMaquina *ajuste, AlgoritmoOrdenacao algoritmo, long n, int disponiveis) {
+    int threads = ajuste->algoritmos[algoritmo].threads[classeTamanho(n)];
+    if (threads <= 0 || threads > disponiveis) {
+        return disponiveis;
+    }
+    return threads;
+}
+
+// Imprime o perfil
+void imprimirAjuste(FILE *saida, const AjusteMaquina *ajuste) {
+    fprintf(saida, "Perfil de ajuste: %s (%d CPUs na calibração)\n",
+            ajuste->carregado ? ajuste->arquivo : "valores padrão", ajuste->cpus);
+    for (int a = 0; a < ORDENACAO_NUM_ALGORITMOS; a++) {
+        const AjusteAlgoritmo *parametros = &ajuste->algoritmos[a];
+        fprintf(saida, "  %-15s limite de tarefa %ld, limite de inserção %ld, threads por classe:",
+                nomeAlgoritmoOrdenacao((AlgoritmoOrdenacao)a), parametros->limiteTarefa, parametros->limiteInsercao);
+        for (int c = 0; c < AJUSTE_NUM_CLASSES; c++) {
+            if (parametros->threads[c] > 0) {
+                fprintf(saida, " 1e%d=%d", c, parametros->threads[c]);
+            } else {
+                fprintf(saida, " 1e%d=*", c);
+            }
+        }
+        fprintf(saida, "\n");
+    }
+    fprintf(saida, "  modelo:");
+    for (int c = 0; c < NUM_COEFICIENTES; c++) {
+        fprintf(saida, " %s=%g", coeficientes[c].nome,
+                *(const double *)((const char *)&ajuste->modelo + coeficientes[c].deslocamento));
+    }
+    fprintf(saida, "\n");
+}
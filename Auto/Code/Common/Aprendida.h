@@ -0,0 +1,49 @@
+#ifndef APRENDIDA_H
+#define APRENDIDA_H
+
+#include "PoolThreads.h"
+
+/*
+ * Ordenação aprendida: um modelo da função de distribuição acumulada (CDF) das chaves,
+ * ajustado em uma amostra, leva cada chave direto ao balde onde ela deve terminar, em vez
+ * de comparações. Funciona bem com distribuições suaves (como a uniforme das entradas do
+ * CriarEntrada), em que o modelo erra pouco.
+ *
+ * 1. Ajuste do modelo: cada trecho do vetor sorteia a sua parte de APRENDIDA_AMOSTRA
+ *    chaves em paralelo, e os histogramas das partes sobre APRENDIDA_FOLHAS segmentos de
+ *    mesma largura (entre o mínimo e o máximo da amostra) são somados. O modelo é a CDF
+ *    linear por partes que passa pelas frações acumuladas nos limites dos segmentos; ela é
+ *    monótona, de forma que os baldes já saem em ordem entre si.
+ * 2. Limite de erro: dentro de um segmento o modelo supõe chaves uniformes, e o seu erro
+ *    na amostra é limitado pela fração da amostra no segmento. Se algum segmento tiver mais
+ *    de APRENDIDA_ERRO_MAXIMO da amostra (sem contar os segmentos em que todas as chaves da
+ *    amostra são iguais, que caem inteiros em um balde), a ordenação é recusada e o
+ *    chamador usa outro algoritmo.
+ * 3. Distribuição: cada trecho conta as chaves de cada balde (cerca de
+ *    APRENDIDA_ELEMENTOS_BALDE chaves por balde, segundo o modelo) e depois as espalha no
+ *    vetor auxiliar, de forma estável.
+ * 4. Acabamento: cada balde é posicionado por um modelo linear próprio (entre o mínimo e o
+ *    máximo do balde) e as chaves que caem na mesma posição prevista são ordenadas pela
+ *    inserção (ou, em grupos maiores que APRENDIDA_GRUPO_INSERCAO, pelo Quicksort). Os
+ *    baldes com mais de APRENDIDA_CAPACIDADE vezes o tamanho esperado transbordam: o modelo
+ *    errou naquela região, e o balde inteiro vai para o Quicksort. Os baldes são divididos
+ *    entre os trabalhadores.
+ */
+
+#define APRENDIDA_AMOSTRA              16384 // Chaves da amostra usada no ajuste do modelo
+#define APRENDIDA_FOLHAS               1024  // Segmentos lineares do modelo da CDF
+#define APRENDIDA_ELEMENTOS_BALDE      2048  // Elementos esperados por balde
+#define APRENDIDA_MAX_BALDES           8192
+#define APRENDIDA_ERRO_MAXIMO          0.05  // Fração máxima da amostra em um único segmento
+#define APRENDIDA_CAPACIDADE           8     // Capacidade de cada balde, em múltiplos do tamanho esperado
+#define APRENDIDA_GRUPO_INSERCAO       32    // Grupos maiores vão para o Quicksort
+#define APRENDIDA_MIN_ELEMENTOS        4096  // Vetores menores são recusados
+#define APRENDIDA_MIN_ELEMENTOS_TRECHO 65536 // Elementos mínimos por trecho das fases paralelas
+#define APRENDIDA_MAX_TRECHOS          256
+
+// Ordena os n elementos de origem em destino (pode ser o próprio vetor) pelo modelo da
+// CDF; com pool, até numThreads trabalhadores são usados (0 = todos). Retorna 0 em caso de
+// sucesso, 1 se o modelo for recusado (nada é alterado) e -1 em caso de erro.
+int ordenarAprendida(const int *origem, int *destino, long n, PoolThreads *pool, int numThreads);
+
+#endif
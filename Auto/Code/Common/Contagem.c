@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "Contagem.h"
+#include "Memoria.h"
+
+// Trecho [inicio, fim) do vetor: mínimo e máximo, depois a contagem
+typedef struct {
+    const int *vetor;
+    long inicio;
+    long fim;
+    int minimo;
+    int maximo;
+    unsigned int *contagem; // Contagens do trecho (faixa posições)
+    long faixa;
+} TrechoContagem;
+
+// Parte [inicio, fim) da faixa de valores: soma das contagens e escrita na saída
+typedef struct {
+    unsigned int *contagens; // numContagens vetores de faixa posições; o primeiro recebe a soma
+    int numContagens;
+    long faixa;
+    long inicio;
+    long fim;
+    long total;              // Elementos com valores na parte
+    long posicao;            // Posição da parte na saída
+    int minimo;
+    int *destino;
+} ParteFaixa;
+
+// Retorna 1 se a faixa for pequena o bastante para n elementos
+int faixaContagemViavel(long n, long minimo, long maximo) {
+    return n > 0 && (unsigned long)n <= UINT_MAX && maximo - minimo + 1 <= CONTAGEM_FATOR * n;
+}
+
+// Função para dividir [0, n) em num trechos do vetor
+static void dividirTrechos(TrechoContagem *trechos, int num, const int *vetor, long n) {
+    for (int t = 0; t < num; t++) {
+        trechos[t].vetor = vetor;
+        trechos[t].inicio = n * t / num;
+        trechos[t].fim = n * (t + 1) / num;
+    }
+}
+
+// Função para obter o mínimo e o máximo de um trecho
+static void minMaxTrecho(void *arg) {
+    TrechoContagem *t = (TrechoContagem *)arg;
+    int minimo = t->vetor[t->inicio], maximo = minimo;
+    for (long i = t->inicio + 1; i < t->fim; i++) {
+        int v = t->vetor[i];
+        minimo = v < minimo ? v : minimo;
+        maximo = v > maximo ? v : maximo;
+    }
+    t->minimo = minimo;
+    t->maximo = maximo;
+}
+
+// Função para contar os valores de um trecho no seu vetor de contagens (zerado aqui, para
+// que as páginas sejam tocadas pela thread que as usa)
+static void contarTrecho(void *arg) {
+    TrechoContagem *t = (TrechoContagem *)arg;
+    unsigned int *contagem = t->contagem;
+    memset(contagem, 0, (size_t)t->faixa * sizeof(unsigned int));
+    for (long i = t->inicio; i < t->fim; i++) {
+        contagem[t->vetor[i] - t->minimo]++;
+    }
+}
+
+// Função para somar as contagens de uma parte da faixa no primeiro vetor de contagens
+static void somarParte(void *arg) {
+    ParteFaixa *p = (ParteFaixa *)arg;
+    long total = 0;
+    for (long v = p->inicio; v < p->fim; v++) {
+        unsigned int soma = p->contagens[v];
+        for (int c = 1; c < p->numContagens; c++) {
+            soma += p->contagens[c * p->faixa + v];
+        }
+        p->contagens[v] = soma;
+        total += soma;
+    }
+    p->total = total;
+}
+
+// Função para escrever os valores de uma parte da faixa na saída, a partir da sua posição
+static void escreverParte(void *arg) {
+    ParteFaixa *p = (ParteFaixa *)arg;
+    int *saida = p->destino + p->posicao;
+    for (long v = p->inicio; v < p->fim; v++) {
+        int valor = p->minimo + (int)v;
+        for (unsigned int k = p->contagens[v]; k > 0; k--) {
+            *saida++ = valor;
+        }
+    }
+}
+
+// Obtém o mínimo e o máximo do vetor por uma redução paralela
+void faixaValores(const int *vetor, long n, PoolThreads *pool, int numThreads, int *minimo, int *maximo) {
+    *minimo = 0;
+    *maximo = 0;
+    if (n <= 0) {
+        return;
+    }
+
+    long numTrechos = numTrechosPool(pool, numThreads, n, CONTAGEM_MIN_ELEMENTOS_TRECHO, CONTAGEM_MAX_TRECHOS);
+    TrechoContagem trechos[CONTAGEM_MAX_TRECHOS];
+    dividirTrechos(trechos, (int)numTrechos, vetor, n);
+    executarItensPool(pool, minMaxTrecho, trechos, sizeof(TrechoContagem), (int)numTrechos);
+    *minimo = trechos[0].minimo;
+    *maximo = trechos[0].maximo;
+    for (long t = 1; t < numTrechos; t++) {
+        *minimo = trechos[t].minimo < *minimo ? trechos[t].minimo : *minimo;
+        *maximo = trechos[t].maximo > *maximo ? trechos[t].maximo : *maximo;
+    }
+}
+
+// Ordena os n elementos de origem em destino por contagem
+int ordenarContagem(const int *origem, int *destino, long n, PoolThreads *pool, int numThreads) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    // 1. Mínimo e máximo (redução paralela)
+    long numTrechos = numTrechosPool(pool, numThreads, n, CONTAGEM_MIN_ELEMENTOS_TRECHO, CONTAGEM_MAX_TRECHOS);
+    int minimo, maximo;
+    faixaValores(origem, n, pool, numThreads, &minimo, &maximo);
+
+    // 2. Faixa grande demais: o chamador usa outro algoritmo
+    if (!faixaContagemViavel(n, minimo, maximo)) {
+        return 1;
+    }
+    long faixa = (long)maximo - minimo + 1;
+
+    // 3. Contagens por trecho, com no máximo CONTAGEM_FATOR * n contagens no total
+    long numContagens = CONTAGEM_FATOR * n / faixa;
+    if (numContagens > numTrechos) {
+        numContagens = numTrechos;
+    }
+    if (numContagens < 1) {
+        numContagens = 1;
+    }
+    unsigned int *contagens = (unsigned int *)obterBufferTemporario((size_t)numContagens * faixa * sizeof(unsigned int));
+    if (!contagens) {
+        printf("Erro: Falha na alocação de memória para as contagens.\n");
+        return -1;
+    }
+
+    TrechoContagem trechos[CONTAGEM_MAX_TRECHOS];
+    dividirTrechos(trechos, (int)numContagens, origem, n);
+    for (long c = 0; c < numContagens; c++) {
+        trechos[c].minimo = minimo;
+        trechos[c].faixa = faixa;
+        trechos[c].contagem = contagens + c * faixa;
+    }
+    executarItensPool(pool, contarTrecho, trechos, sizeof(TrechoContagem), (int)numContagens);
+
+    // 4. Soma das contagens por parte da faixa e posição de cada parte (soma de prefixos)
+    long numPartes = numTrechos < faixa ? numTrechos : faixa;
+    ParteFaixa partes[CONTAGEM_MAX_TRECHOS];
+    for (long p = 0; p < numPartes; p++) {
+        partes[p].contagens = contagens;
+        partes[p].numContagens = (int)numContagens;
+        partes[p].faixa = faixa;
+        partes[p].inicio = faixa * p / numPartes;
+        partes[p].fim = faixa * (p + 1) / numPartes;
+        partes[p].minimo = minimo;
+        partes[p].destino = destino;
+    }
+    executarItensPool(pool, somarParte, partes, sizeof(ParteFaixa), (int)numPartes);
+
+    long posicao = 0;
+    for (long p = 0; p < numPartes; p++) {
+        partes[p].posicao = posicao;
+        posicao += partes[p].total;
+    }
+
+    // 5. Escrita da saída
+    executarItensPool(pool, escreverParte, partes, sizeof(ParteFaixa), (int)numPartes);
+
+    devolverBufferTemporario(contagens);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef CONTAGEM_H
+#define CONTAGEM_H
+
+#include "PoolThreads.h"
+
+/*
+ * Ordenação por contagem para vetores com faixa de valores pequena (como os gerados pelo
+ * CriarEntrada, com valores em ±n): O(n + faixa), sem comparações.
+ *
+ * 1. O mínimo e o máximo são obtidos por uma redução paralela (um trecho por trabalhador).
+ * 2. Se a faixa (máximo - mínimo + 1) passar de CONTAGEM_FATOR * n, a ordenação é recusada
+ *    e o chamador usa outro algoritmo.
+ * 3. Cada trecho é contado em um vetor de contagens próprio, sem sincronização. O total de
+ *    contagens é limitado a CONTAGEM_FATOR * n, de forma que faixas maiores usam menos
+ *    vetores (e menos threads nesta fase).
+ * 4. As contagens são somadas em paralelo, cada trabalhador com uma parte da faixa; a soma
+ *    de prefixos das partes dá a posição de cada uma na saída.
+ * 5. Cada trabalhador escreve os valores da sua parte da faixa na saída.
+ */
+
+#define CONTAGEM_FATOR             4     // Faixa máxima, em múltiplos de n
+#define CONTAGEM_MIN_ELEMENTOS_TRECHO 65536 // Elementos mínimos por trecho das fases paralelas
+#define CONTAGEM_MAX_TRECHOS       256
+
+// Retorna 1 se a faixa [minimo, maximo] for pequena o bastante para n elementos
+int faixaContagemViavel(long n, long minimo, long maximo);
+
+// Obtém o mínimo e o máximo do vetor por uma redução paralela (com pool, até numThreads
+// trabalhadores; 0 = todos); com n = 0, ambos recebem 0
+void faixaValores(const int *vetor, long n, PoolThreads *pool, int numThreads, int *minimo, int *maximo);
+
+// Ordena os n elementos de origem em destino (pode ser o próprio vetor) por contagem; com
+// pool, até numThreads trabalhadores são usados (0 = todos). Retorna 0 em caso de sucesso,
+// 1 se a faixa for grande demais (nada é alterado) e -1 em caso de erro.
+int ordenarContagem(const int *origem, int *destino, long n, PoolThreads *pool, int numThreads);
+
+#endif
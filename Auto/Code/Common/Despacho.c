@@ -0,0 +1,364 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Despacho.h"
+#include "Ajuste.h"
+#include "Compactacao.h"
+
+// Preenche os coeficientes padrão do modelo (medidos com vetores aleatórios de 10^3 a
+// 3 * 10^6 elementos e com 10 a 10^4 chaves distintas na partição de Lomuto)
+void modeloCustoPadrao(ModeloCusto *modelo) {
+    modelo->nsQuicksortSeq = 6.4;
+    modelo->nsQuicksortConc = 5.8;
+    modelo->nsDuploPivo = 5.4;
+    modelo->nsParticaoSerial = 2.0;
+    modelo->nsDuplicatasLomuto = 0.45;
+    modelo->nsMinMax = 0.7;
+    modelo->nsCorridas = 6.5;
+    modelo->nsContagem = 8.0;
+    modelo->nsAprendida = 40.0;
+    modelo->nsMesclagem = 4.7;
+    modelo->nsMesclagemLocal = 8.2;
+    modelo->nsCompactacao = 7.0;
+    modelo->nsInverter = 0.5;
+    modelo->usThread = 100.0;
+    modelo->eficienciaParalela = 0.85;
+    modelo->numCPUs = cpusDisponiveis();
+}
+
+// Preenche os coeficientes do modelo com os do perfil de ajuste da máquina, se houver
+void modeloCustoMaquina(ModeloCusto *modelo) {
+    const AjusteMaquina *ajuste = ajusteMaquina();
+    if (ajuste->modeloAjustado) {
+        *modelo = ajuste->modelo;
+        modelo->numCPUs = cpusDisponiveis();
+    } else {
+        modeloCustoPadrao(modelo);
+    }
+}
+
+// Função para calcular log2(x), x >= 1, sem a libm (parte inteira exata e a fração
+// interpolada; o erro, de no máximo 0,09, não muda a ordem de grandeza das previsões)
+static double log2Aproximado(double x) {
+    double inteira = 0.0;
+    while (x >= 2.0) {
+        x /= 2.0;
+        inteira += 1.0;
+    }
+    return inteira + (x - 1.0);
+}
+
+// Função para calcular a raiz quadrada, x >= 0, pelo método de Newton
+static double raizQuadrada(double x) {
+    double r = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; i++) {
+        double proxima = 0.5 * (r + x / r);
+        if (proxima >= r) {
+            break;
+        }
+        r = proxima;
+    }
+    return r;
+}
+
+// Função para obter o próximo número de threads avaliado: 1, 2, 4, ... e o máximo
+static int proximoNumThreads(int t, int maxThreads) {
+    return t * 2 > maxThreads && t < maxThreads ? maxThreads : t * 2;
+}
+
+// Função para comparar inteiros no qsort da amostra
+static int compararInteiros(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Função para amostrar as chaves: faixa de valores, duplicatas e chaves distintas estimadas
+static void amostrarChaves(const int *vetor, long n, PerfilEntrada *perfil) {
+    long m = n < DESPACHO_AMOSTRAS ? n : DESPACHO_AMOSTRAS;
+    perfil->amostras = m;
+    perfil->minimo = 0;
+    perfil->maximo = 0;
+    perfil->fracaoDuplicatas = 0.0;
+    perfil->distintasEstimadas = (double)n;
+    if (m == 0) {
+        return;
+    }
+
+    int *amostra = malloc((size_t)m * sizeof(int));
+    if (!amostra) {
+        perror("Erro ao alocar a amostra do despacho");
+        return;
+    }
+
+    // Vetores pequenos são copiados inteiros; nos demais, as posições são sorteadas
+    // com uma sequência fixa, para que o mesmo arquivo gere sempre o mesmo plano
+    if (m == n) {
+        for (long i = 0; i < n; i++) {
+            amostra[i] = vetor[i];
+        }
+    } else {
+        unsigned long long estado = 0x2545F4914F6CDD1Dull;
+        for (long k = 0; k < m; k++) {
+            estado = estado * 6364136223846793005ull + 1442695040888963407ull;
+            amostra[k] = vetor[(estado >> 33) % (unsigned long long)n];
+        }
+    }
+    qsort(amostra, (size_t)m, sizeof(int), compararInteiros);
+
+    // Chaves distintas (d) e chaves vistas uma única vez (f1) na amostra
+    long distintas = 0, unicas = 0;
+    for (long i = 0; i < m; ) {
+        long j = i + 1;
+        while (j < m && amostra[j] == amostra[i]) {
+            j++;
+        }
+        distintas++;
+        unicas += j - i == 1;
+        i = j;
+    }
+
+    perfil->minimo = amostra[0];
+    perfil->maximo = amostra[m - 1];
+    perfil->fracaoDuplicatas = 1.0 - (double)distintas / m;
+    if (m == n) {
+        perfil->distintasEstimadas = (double)distintas;
+    } else {
+        double estimativa = raizQuadrada((double)n / m) * unicas + (distintas - unicas);
+        perfil->distintasEstimadas = estimativa > n ? (double)n : estimativa;
+    }
+    free(amostra);
+}
+
+// Mede o perfil da entrada
+void perfilarEntrada(const int *vetor, long n, PoolThreads *pool, PerfilEntrada *perfil) {
+    perfil->n = n;
+    medirPreordenacao(vetor, n, pool, &perfil->preordenacao);
+    escolherEstrategiaPreordenacao(&perfil->preordenacao);
+    amostrarChaves(vetor, n, perfil);
+}
+
+// Função para calcular o ganho efetivo de numThreads threads
+static double ganhoThreads(const ModeloCusto *modelo, int numThreads) {
+    int efetivas = numThreads < modelo->numCPUs ? numThreads : modelo->numCPUs;
+    if (efetivas < 1) {
+        efetivas = 1;
+    }
+    return 1.0 + (efetivas - 1) * modelo->eficienciaParalela;
+}
+
+// Prevê o tempo, em segundos, do algoritmo com o número de threads
+double preverTempo(const ModeloCusto *modelo, const PerfilEntrada *perfil, AlgoritmoOrdenacao algoritmo,
+                   int numThreads) {
+    double n = (double)perfil->n;
+    if (n < 2) {
+        return 0.0;
+    }
+    double nlogn = n * log2Aproximado(n);
+    double ganho = ganhoThreads(modelo, numThreads);
+    double pool = numThreads * modelo->usThread * 1e3;
+    double ns;
+
+    switch (algoritmo) {
+    case ORDENACAO_QUICKSORT_SEQ:
+        ns = modelo->nsQuicksortSeq * nlogn;
+        break;
+    case ORDENACAO_QUICKSORT_CONC: {
+        double distintas = perfil->distintasEstimadas > 1.0 ? perfil->distintasEstimadas : 1.0;
+        double paralelo = modelo->nsQuicksortConc * nlogn + modelo->nsDuplicatasLomuto * n * n / distintas;
+        ns = paralelo / ganho + modelo->nsParticaoSerial * n * (1.0 - 1.0 / numThreads) + pool;
+        break;
+    }
+    case ORDENACAO_DUPLO_PIVO_SEQ:
+        ns = modelo->nsDuploPivo * nlogn;
+        break;
+    case ORDENACAO_DUPLO_PIVO_CONC:
+        // A primeira partição percorre o vetor inteiro e só depois as partes se dividem
+        ns = modelo->nsDuploPivo * nlogn / ganho + modelo->nsParticaoSerial * n * (1.0 - 1.0 / numThreads) + pool;
+        break;
+    case ORDENACAO_MINMAX_SEQ:
+        ns = modelo->nsMinMax * n * n;
+        break;
+    case ORDENACAO_MINMAX_CONC:
+        // Cada um dos numThreads segmentos custa (n / T)², e a mesclagem é linear
+        ns = modelo->nsMinMax * n * n / numThreads / ganho + modelo->nsParticaoSerial * n + pool;
+        break;
+    case ORDENACAO_CORRIDAS: {
+        double corridas = perfil->preordenacao.corridas > 1 ? (double)perfil->preordenacao.corridas : 1.0;
+        if (n / corridas < PREORDENACAO_CORRIDA_MEDIA_MIN) {
+            ns = modelo->nsCorridas * nlogn;
+        } else {
+            ns = modelo->nsCorridas * n * (log2Aproximado(corridas) + 1.0);
+        }
+        break;
+    }
+    case ORDENACAO_CONTAGEM: {
+        // A faixa da amostra; se o vetor tiver uma faixa maior, o algoritmo usa o Quicksort
+        long faixa = (long)perfil->maximo - perfil->minimo + 1;
+        if (!faixaContagemViavel(perfil->n, perfil->minimo, perfil->maximo)) {
+            return -1.0;
+        }
+        double contagens = (double)CONTAGEM_FATOR * n / faixa;
+        if (contagens > numThreads) {
+            contagens = numThreads;
+        }
+        ns = modelo->nsContagem * (n + (double)faixa * (contagens > 1.0 ? contagens : 1.0)) / ganho + pool;
+        break;
+    }
+    case ORDENACAO_MESCLAGEM:
+        ns = modelo->nsMesclagem * nlogn / ganho + pool;
+        break;
+    case ORDENACAO_MESCLAGEM_LOCAL:
+        ns = modelo->nsMesclagemLocal * nlogn / ganho + pool;
+        break;
+    case ORDENACAO_APRENDIDA:
+        if (perfil->n < APRENDIDA_MIN_ELEMENTOS) {
+            return -1.0;
+        }
+        ns = modelo->nsAprendida * n / ganho + pool;
+        break;
+    default:
+        return -1.0;
+    }
+    return ns * 1e-9;
+}
+
+// Prevê o tempo, em segundos, da ordenação compactada com o número de threads
+double preverTempoCompactado(const ModeloCusto *modelo, const PerfilEntrada *perfil, int numThreads) {
+    double n = (double)perfil->n;
+    if (n < 2) {
+        return 0.0;
+    }
+    int largura = larguraChaves(perfil->minimo, perfil->maximo);
+    if (largura == 32) {
+        return -1.0;
+    }
+    // Detecção, compactação e expansão são lineares e somam cerca de uma passada do radix sort
+    double passadas = largura / 8 + 1;
+    double ns = modelo->nsCompactacao * n * passadas / ganhoThreads(modelo, numThreads) +
+                numThreads * modelo->usThread * 1e3;
+    return ns * 1e-9;
+}
+
+// Função para saber se o algoritmo divide o trabalho entre threads
+static int algoritmoConcorrente(AlgoritmoOrdenacao algoritmo) {
+    return algoritmo == ORDENACAO_QUICKSORT_CONC || algoritmo == ORDENACAO_MINMAX_CONC ||
+           algoritmo == ORDENACAO_CONTAGEM || algoritmo == ORDENACAO_APRENDIDA ||
+           algoritmo == ORDENACAO_DUPLO_PIVO_CONC || algoritmo == ORDENACAO_MESCLAGEM ||
+           algoritmo == ORDENACAO_MESCLAGEM_LOCAL;
+}
+
+// Escolhe o plano mais barato com até maxThreads threads
+void planejarOrdenacao(const ModeloCusto *modelo, const PerfilEntrada *perfil, int maxThreads,
+                       PlanoOrdenacao *plano) {
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+    plano->estrategia = perfil->preordenacao.estrategia;
+    plano->algoritmo = ORDENACAO_QUICKSORT_SEQ;
+    plano->compactar = 0;
+    plano->numThreads = 1;
+
+    // Vetores já ordenados ou sem subidas não precisam de algoritmo
+    if (plano->estrategia == PREORDENACAO_JA_ORDENADO) {
+        plano->tempoPrevisto = 0.0;
+        return;
+    }
+    if (plano->estrategia == PREORDENACAO_INVERTIDO) {
+        plano->tempoPrevisto = modelo->nsInverter * perfil->n * 1e-9;
+        return;
+    }
+
+    // Demais casos: o candidato mais barato (os primeiros vencem os empates)
+    plano->estrategia = PREORDENACAO_ALGORITMO;
+    plano->tempoPrevisto = preverTempo(modelo, perfil, ORDENACAO_QUICKSORT_SEQ, 1);
+    for (int a = 0; a < ORDENACAO_NUM_ALGORITMOS; a++) {
+        int concorrente = algoritmoConcorrente((AlgoritmoOrdenacao)a);
+        for (int t = 1; t <= (concorrente ? maxThreads : 1); t = proximoNumThreads(t, maxThreads)) {
+            double tempo = preverTempo(modelo, perfil, (AlgoritmoOrdenacao)a, t);
+            if (tempo >= 0.0 && tempo < plano->tempoPrevisto) {
+                plano->algoritmo = (AlgoritmoOrdenacao)a;
+                plano->numThreads = t;
+                plano->tempoPrevisto = tempo;
+            }
+        }
+    }
+
+    // Compactação: o algoritmo escolhido acima fica para o caso de o vetor inteiro precisar
+    // de 32 bits
+    for (int t = 1; t <= maxThreads; t = proximoNumThreads(t, maxThreads)) {
+        double tempo = preverTempoCompactado(modelo, perfil, t);
+        if (tempo >= 0.0 && tempo < plano->tempoPrevisto) {
+            plano->compactar = 1;
+            plano->numThreads = t;
+            plano->tempoPrevisto = tempo;
+        }
+    }
+}
+
+// Executa o plano sobre o vetor
+int executarPlano(int *vetor, long n, const PlanoOrdenacao *plano, PoolThreads *pool) {
+    if (plano->estrategia == PREORDENACAO_JA_ORDENADO) {
+        return 0;
+    }
+    if (plano->estrategia == PREORDENACAO_INVERTIDO) {
+        inverterVetor(vetor, n);
+        return 0;
+    }
+
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, plano->algoritmo);
+    opcoes.pool = pool;
+    opcoes.numThreads = plano->numThreads;
+    opcoes.threadsUteis = plano->numThreads;
+    opcoes.compactar = plano->compactar;
+    return ordenarI32(vetor, n, &opcoes);
+}
+
+// Retorna o nome do plano
+const char *nomePlano(const PlanoOrdenacao *plano) {
+    if (plano->estrategia == PREORDENACAO_JA_ORDENADO || plano->estrategia == PREORDENACAO_INVERTIDO) {
+        return nomeEstrategiaPreordenacao(plano->estrategia);
+    }
+    return plano->compactar ? "compactada" : nomeAlgoritmoOrdenacao(plano->algoritmo);
+}
+
+// Imprime o perfil da entrada
+void imprimirPerfil(FILE *saida, const PerfilEntrada *perfil) {
+    fprintf(saida, "Perfil: %ld elementos, chaves de %d a %d (amostra de %ld), %.1f%% de duplicatas, "
+            "~%.0f chaves distintas\n", perfil->n, perfil->minimo, perfil->maximo, perfil->amostras,
+            100.0 * perfil->fracaoDuplicatas, perfil->distintasEstimadas);
+    imprimirPreordenacao(saida, &perfil->preordenacao);
+}
+
+// Imprime o tempo previsto de cada candidato
+void imprimirCandidatos(FILE *saida, const ModeloCusto *modelo, const PerfilEntrada *perfil, int maxThreads) {
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+    fprintf(saida, "Candidatos (tempo previsto):\n");
+    for (int a = 0; a < ORDENACAO_NUM_ALGORITMOS; a++) {
+        int concorrente = algoritmoConcorrente((AlgoritmoOrdenacao)a);
+        fprintf(saida, "  %-15s", nomeAlgoritmoOrdenacao((AlgoritmoOrdenacao)a));
+        for (int t = 1; t <= (concorrente ? maxThreads : 1); t = proximoNumThreads(t, maxThreads)) {
+            double tempo = preverTempo(modelo, perfil, (AlgoritmoOrdenacao)a, t);
+            if (tempo < 0.0) {
+                fprintf(saida, " inviável");
+                break;
+            } else if (concorrente) {
+                fprintf(saida, " %d thread(s): %.6f s;", t, tempo);
+            } else {
+                fprintf(saida, " %.6f s", tempo);
+            }
+        }
+        fprintf(saida, "\n");
+    }
+    fprintf(saida, "  %-15s", "compactada");
+    for (int t = 1; t <= maxThreads; t = proximoNumThreads(t, maxThreads)) {
+        double tempo = preverTempoCompactado(modelo, perfil, t);
+        if (tempo < 0.0) {
+            fprintf(saida, " inviável");
+            break;
+        }
+        fprintf(saida, " %d thread(s): %.6f s;", t, tempo);
+    }
+    fprintf(saida, "\n");
+}
@@ -0,0 +1,133 @@
+#ifndef DESPACHO_H
+#define DESPACHO_H
+
+#include <stdio.h>
+#include "Ordenacao.h"
+#include "Preordenacao.h"
+
+/*
+ * Despacho automático: escolhe o algoritmo e o número de threads a partir de um perfil da
+ * entrada e de um modelo de custo, em vez de o operador escolher o programa à mão.
+ *
+ * O perfil (perfilarEntrada) junta a pré-ordenação medida em uma passada linear (ver
+ * Common/Preordenacao.h) com uma amostra de DESPACHO_AMOSTRAS chaves, da qual saem a
+ * faixa de valores, a fração de duplicatas e o número estimado de chaves distintas
+ * (estimador GEE: sqrt(n / m) * f1 + (d - f1), com f1 = chaves vistas uma única vez na
+ * amostra e d = chaves distintas na amostra).
+ *
+ * O modelo de custo (ModeloCusto) prevê o tempo de cada candidato:
+ * - quicksort-seq (Hoare): nsQuicksortSeq * n log2 n;
+ * - quicksort-conc (Lomuto): (nsQuicksortConc * n log2 n + nsDuplicatasLomuto * n² / D) / T
+ *   mais as partições iniciais, que não se dividem entre as threads, e a criação do pool;
+ *   o termo n² / D é o custo quadrático da partição de Lomuto com D chaves distintas;
+ * - duplo-pivo-seq e duplo-pivo-conc: nsDuploPivo * n log2 n (dividido por T no
+ *   concorrente, mais as partições iniciais e a criação do pool); a partição de dois pivôs
+ *   não fica quadrática com chaves repetidas;
+ * - minmax-seq e minmax-conc: nsMinMax * n² (dividido pelos segmentos no concorrente);
+ * - corridas: nsCorridas * n log2 (corridas naturais);
+ * - contagem: nsContagem * (n + F * C) / T, com F = faixa de valores da amostra e C = vetores
+ *   de contagem (ver Common/Contagem.h); só é candidata com F <= CONTAGEM_FATOR * n;
+ * - mesclagem: nsMesclagem * n log2 n / T (ver Common/Mesclagem.h), sem depender da ordem
+ *   nem das chaves repetidas;
+ * - mesclagem-local: nsMesclagemLocal * n log2 n / T, no próprio vetor (ver
+ *   Common/MesclagemLocal.h); mais lenta que a mesclagem, mas sem o vetor auxiliar de n;
+ * - aprendida: nsAprendida * n / T (ver Common/Aprendida.h); não é candidata com menos de
+ *   APRENDIDA_MIN_ELEMENTOS elementos;
+ * - compactada: nsCompactacao * n * (P + 1) / T, com P = passadas do radix sort (1 se a faixa
+ *   da amostra couber em 8 bits, 2 em 16; ver Common/Compactacao.h); não é candidata com
+ *   faixas de 32 bits e, se o vetor inteiro precisar deles, o algoritmo do plano (o mais
+ *   barato entre os demais) ordena sem compactação;
+ * - vetores já ordenados ou sem subidas dispensam o algoritmo (nada a fazer ou inverter).
+ * Nas fórmulas, T = 1 + (min(threads, CPUs) - 1) * eficienciaParalela. Os algoritmos concorrentes são
+ * avaliados com 1, 2, 4, ... threads até o máximo informado, e o plano é o candidato mais
+ * barato. Com corridas curtas (média abaixo de PREORDENACAO_CORRIDA_MEDIA_MIN), a mesclagem
+ * de corridas equivale a um mergesort, e o custo passa a ser nsCorridas * n log2 n.
+ *
+ * O estimador GEE tende a subestimar as chaves distintas quando quase todas são únicas, o
+ * que deixa o modelo conservador com a partição de Lomuto.
+ *
+ * Os coeficientes padrão foram medidos em uma máquina de referência (ver
+ * modeloCustoPadrao); modeloCustoMaquina usa os medidos pelo Autoajuste, quando houver um
+ * perfil de ajuste. O tempo previsto e o real são registrados em REGISTRO_DESPACHO para
+ * avaliar o modelo.
+ */
+
+#define DESPACHO_AMOSTRAS 4096 // Chaves sorteadas para a faixa de valores e as duplicatas
+
+// Coeficientes do modelo de custo (nanossegundos por unidade de trabalho)
+typedef struct {
+    double nsQuicksortSeq;     // Por n log2 n
+    double nsQuicksortConc;    // Por n log2 n, com uma thread
+    double nsDuploPivo;        // Por n log2 n (dois pivôs), com uma thread
+    double nsParticaoSerial;   // Por elemento das partições iniciais (não paralelas)
+    double nsDuplicatasLomuto; // Por n² / chaves distintas
+    double nsMinMax;           // Por n²
+    double nsCorridas;         // Por n log2 corridas
+    double nsContagem;         // Por elemento e por posição dos vetores de contagem
+    double nsAprendida;        // Por elemento, com uma thread
+    double nsMesclagem;        // Por n log2 n (mergesort), com uma thread
+    double nsMesclagemLocal;   // Por n log2 n (mergesort no próprio vetor), com uma thread
+    double nsCompactacao;      // Por elemento e por passada do radix sort compactado, com uma thread
+    double nsInverter;         // Por elemento invertido
+    double usThread;           // Microssegundos para criar cada thread do pool
+    double eficienciaParalela; // Fração do ganho ideal obtida por thread extra
+    int numCPUs;               // CPUs disponíveis (afinidade e cota do cgroup): threads além disso não trazem ganho
+} ModeloCusto;
+
+// Perfil da entrada usado pelo modelo
+typedef struct {
+    long n;
+    int minimo;                 // Menor chave da amostra
+    int maximo;                 // Maior chave da amostra
+    long amostras;              // Chaves amostradas (todas, se n <= DESPACHO_AMOSTRAS)
+    double fracaoDuplicatas;    // 1 - distintas / amostras
+    double distintasEstimadas;  // Estimativa de chaves distintas no vetor inteiro
+    MetricasPreordenacao preordenacao;
+} PerfilEntrada;
+
+// Plano escolhido
+typedef struct {
+    EstrategiaPreordenacao estrategia; // PREORDENACAO_ALGORITMO usa o algoritmo abaixo
+    AlgoritmoOrdenacao algoritmo;
+    int compactar;                     // 1 = chaves compactadas em 8/16 bits (ver Common/Compactacao.h)
+    int numThreads;                    // 1 nos algoritmos sequenciais
+    double tempoPrevisto;              // Segundos
+} PlanoOrdenacao;
+
+// Preenche os coeficientes padrão do modelo
+void modeloCustoPadrao(ModeloCusto *modelo);
+
+// Preenche os coeficientes medidos pelo Autoajuste (perfil de ajuste, ver Common/Ajuste.h)
+// ou, sem perfil, os padrão
+void modeloCustoMaquina(ModeloCusto *modelo);
+
+// Mede o perfil da entrada; com pool, a passada de pré-ordenação é dividida entre os trabalhadores
+void perfilarEntrada(const int *vetor, long n, PoolThreads *pool, PerfilEntrada *perfil);
+
+// Prevê o tempo, em segundos, do algoritmo com o número de threads
+double preverTempo(const ModeloCusto *modelo, const PerfilEntrada *perfil, AlgoritmoOrdenacao algoritmo,
+                   int numThreads);
+
+// Prevê o tempo, em segundos, da ordenação compactada com o número de threads (-1 se a faixa
+// da amostra precisar de 32 bits)
+double preverTempoCompactado(const ModeloCusto *modelo, const PerfilEntrada *perfil, int numThreads);
+
+// Escolhe o plano mais barato com até maxThreads threads
+void planejarOrdenacao(const ModeloCusto *modelo, const PerfilEntrada *perfil, int maxThreads,
+                       PlanoOrdenacao *plano);
+
+// Executa o plano sobre o vetor (com pool, os algoritmos concorrentes usam plano->numThreads
+// dos seus trabalhadores no lugar de um pool temporário); retorna 0 em caso de sucesso
+int executarPlano(int *vetor, long n, const PlanoOrdenacao *plano, PoolThreads *pool);
+
+// Retorna o nome do plano: o do algoritmo, "compactada" ou o da estratégia ("ja-ordenado",
+// "invertido")
+const char *nomePlano(const PlanoOrdenacao *plano);
+
+// Imprime o perfil da entrada
+void imprimirPerfil(FILE *saida, const PerfilEntrada *perfil);
+
+// Imprime o tempo previsto de cada candidato com até maxThreads threads
+void imprimirCandidatos(FILE *saida, const ModeloCusto *modelo, const PerfilEntrada *perfil, int maxThreads);
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef ENTRADA_SAIDA_H
+#define ENTRADA_SAIDA_H
+
+#include <stddef.h>
+
+/*
+ * Módulo de entrada e saída dos vetores binários usados pelos programas de ordenação.
+ *
+ * O formato do arquivo é sempre o mesmo: um inteiro com o comprimento do vetor seguido
+ * dos elementos (inteiros de 32 bits). A leitura e a gravação podem ser feitas por três
+ * backends:
+ *
+ * - ES_STDIO: fread/fwrite síncronos (comportamento original dos programas);
+ * - ES_URING: io_uring com o próprio vetor registrado como buffer fixo e várias
+ *   requisições de 1 a 4 MB em voo ao mesmo tempo;
+ * - ES_PREAD: pread/pwrite distribuídos em um pequeno pool de threads. É usado
+ *   automaticamente quando o io_uring não está disponível no kernel.
+ *
+ * O gravador incremental (GravadorVetor) permite enviar trechos já finalizados do vetor
+ * para o disco enquanto o restante ainda está sendo produzido (por exemplo, durante a
+ * mesclagem final do MinMaxSort concorrente).
+ *
+ * Na gravação direta (O_DIRECT) a saída não passa pelo page cache: os elementos são
+ * copiados, em ordem, para dois buffers alinhados a huge pages que se alternam entre
+ * preenchimento e gravação. No modo de durabilidade, um único fdatasync é feito ao final.
+ *
+ * Arquivos segmentados guardam muitos vetores pequenos em um único buffer contíguo (ver
+ * Common/OrdenacaoSegmentada.h). O primeiro inteiro é ES_MARCADOR_SEGMENTADO, negativo,
+ * para que os leitores do formato simples rejeitem o arquivo:
+ *
+ *     int32 marcador | int32 numSegmentos | int32 n | int64 deslocamentos[numSegmentos + 1] | int32 valores[n]
+ *
+ * O segmento s ocupa valores[deslocamentos[s] .. deslocamentos[s + 1]); deslocamentos[0] é 0
+ * e deslocamentos[numSegmentos] é n.
+ *
+ * Arquivos de registros guardam linhas de largura fixa: uma chave inteira de 32 ou 64 bits
+ * seguida de uma carga de larguraCarga bytes, sem preenchimento entre os registros (ver
+ * Common/OrdenacaoRegistros.h). O primeiro inteiro é ES_MARCADOR_REGISTROS:
+ *
+ *     int32 marcador | int32 larguraChave (4 ou 8) | int32 larguraCarga | int32 n | registros[n]
+ *
+ * Com indiceEsparso, cada saída gravada por gravarVetorArquivo ou pelo gravador incremental
+ * ganha também um índice esparso em <arquivo>.idx, para consultas de faixa sem ler o arquivo
+ * inteiro (ver Common/IndiceEsparso.h).
+ *
+ * Arquivos de permutação guardam os índices que ordenam um vetor (argsort, ver
+ * Common/OrdenacaoRegistros.h), de 32 ou 64 bits. O primeiro inteiro é ES_MARCADOR_PERMUTACAO:
+ *
+ *     int32 marcador | int32 larguraIndice (4 ou 8) | int32 n | indices[n]
+ *
+ * Arquivos de cadeias guardam uma coluna de cadeias de bytes de comprimento variável, cada
+ * uma precedida do seu comprimento, sem preenchimento (ver Common/OrdenacaoCadeias.h). O
+ * primeiro inteiro é ES_MARCADOR_CADEIAS:
+ *
+ *     int32 marcador | int32 n | int64 bytes | coluna[bytes]
+ *
+ * e a coluna contém n vezes (uint32 comprimento | comprimento bytes).
+ */
+
+// Backends de E/S disponíveis
+typedef enum {
+    ES_STDIO = 0, // fread/fwrite
+    ES_URING,     // io_uring com buffers registrados
+    ES_PREAD      // pread/pwrite com pool de threads
+} BackendES;
+
+// Valores padrão das requisições assíncronas
+#define ES_TAMANHO_BLOCO_PADRAO (2u * 1024 * 1024) // Bytes por requisição
+#define ES_TAMANHO_BLOCO_MIN    (1u * 1024 * 1024)
+#define ES_TAMANHO_BLOCO_MAX    (4u * 1024 * 1024)
+#define ES_PROFUNDIDADE_PADRAO  8                  // Requisições em voo no io_uring
+#define ES_THREADS_POOL         4                  // Threads do fallback pread/pwrite
+
+// Gravação direta (O_DIRECT)
+#define ES_ALINHAMENTO_DIRETO    4096                 // Alinhamento de endereço, tamanho e posição
+#define ES_TAMANHO_BUFFER_DIRETO (4u * 1024 * 1024)   // Bytes em cada um dos dois buffers
+
+// Primeiro inteiro dos arquivos segmentados
+#define ES_MARCADOR_SEGMENTADO (-0x53454731) // -"SEG1"
+
+// Primeiro inteiro dos arquivos de registros e maior carga aceita
+#define ES_MARCADOR_REGISTROS  (-0x52454731) // -"REG1"
+#define ES_CARGA_MAXIMA        1024          // Bytes
+
+// Primeiro inteiro dos arquivos de permutação
+#define ES_MARCADOR_PERMUTACAO (-0x50455231) // -"PER1"
+
+// Primeiro inteiro dos arquivos de cadeias e tamanho do cabeçalho
+#define ES_MARCADOR_CADEIAS    (-0x53545231) // -"STR1"
+#define ES_CABECALHO_CADEIAS   16            // Bytes
+
+// Configuração de E/S escolhida pelo usuário
+typedef struct {
+    BackendES backend;   // Backend utilizado
+    size_t tamanhoBloco; // Tamanho de cada requisição em bytes
+    int profundidade;    // Número máximo de requisições em voo
+    int direto;          // 1 = gravar a saída com O_DIRECT
+    int durabilidade;    // 1 = fdatasync único ao final da gravação
+    int indiceEsparso;   // 1 = gravar também o índice esparso <saida>.idx
+} ConfiguracaoES;
+
+// Estrutura opaca do gravador incremental
+typedef struct GravadorVetor GravadorVetor;
+
+// Preenche a configuração com os valores padrão (backend stdio)
+void configuracaoESPadrao(ConfiguracaoES *config);
+
+// Converte o nome do backend ("stdio", "uring" ou "pread"); retorna -1 se for inválido
+int backendESDoNome(const char *nome, BackendES *backend);
+
+// Retorna o nome do backend
+const char *nomeBackendES(BackendES backend);
+
+// Retorna 1 se a configuração grava a saída em segundo plano (io_uring, pool ou O_DIRECT)
+int gravacaoIncremental(const ConfiguracaoES *config);
+
+// Lê o vetor do arquivo binário; retorna NULL em caso de erro.
+// O vetor é alocado com alocarBuffer (Memoria.h) e deve ser liberado com liberarBuffer.
+int *lerVetorArquivo(const char *nomeArquivo, int *n, const ConfiguracaoES *config);
+
+// Lê apenas o tamanho do vetor gravado no arquivo; retorna 0 em caso de sucesso
+int lerTamanhoArquivo(const char *nomeArquivo, int *n);
+
+// Lê os valores do arquivo em blocos de até capacidade elementos no buffer bloco, chamando
+// consumir para cada bloco, sem carregar o vetor inteiro (entradas maiores que a memória);
+// retorna 0 em caso de sucesso
+int lerVetorEmBlocos(const char *nomeArquivo, int *bloco, long capacidade,
+                     void (*consumir)(const int *valores, long quantidade, void *contexto), void *contexto);
+
+// Lê os n valores do arquivo para um vetor já alocado (por exemplo, reaproveitado entre
+// vários arquivos ou mapeado de outro processo); retorna 0 em caso de sucesso
+int lerValoresArquivo(const char *nomeArquivo, int *vetor, int n, const ConfiguracaoES *config);
+
+// Lê apenas os elementos [inicio, inicio + quantidade) do vetor gravado no arquivo (sem
+// verificar o tamanho; ver lerTamanhoArquivo); retorna 0 em caso de sucesso
+int lerTrechoVetorArquivo(const char *nomeArquivo, int *vetor, long inicio, long quantidade,
+                          const ConfiguracaoES *config);
+
+// Lê um arquivo segmentado; retorna 0 em caso de sucesso. Os valores são alocados com
+// alocarBuffer (liberar com liberarBuffer) e os deslocamentos com malloc (liberar com free).
+int lerSegmentosArquivo(const char *nomeArquivo, int **valores, int *n, long **deslocamentos,
+                        int *numSegmentos, const ConfiguracaoES *config);
+
+// Grava um arquivo segmentado (a gravação direta não se aplica a esse formato); retorna 0
+// em caso de sucesso
+int gravarSegmentosArquivo(const char *nomeArquivo, const int *valores, const long *deslocamentos,
+                           int numSegmentos, const ConfiguracaoES *config);
+
+// Lê um arquivo de registros; retorna 0 em caso de sucesso. Os registros são alocados com
+// alocarBuffer (liberar com liberarBuffer).
+int lerRegistrosArquivo(const char *nomeArquivo, void **registros, int *n, int *larguraChave,
+                        int *larguraCarga, const ConfiguracaoES *config);
+
+// Grava um arquivo de registros (a gravação direta não se aplica a esse formato); retorna 0
+// em caso de sucesso
+int gravarRegistrosArquivo(const char *nomeArquivo, const void *registros, int n, int larguraChave,
+                           int larguraCarga, const ConfiguracaoES *config);
+
+// Lê um arquivo de permutação; retorna 0 em caso de sucesso. Os índices são alocados com
+// alocarBuffer e devem ser liberados com liberarBuffer.
+int lerPermutacaoArquivo(const char *nomeArquivo, void **indices, int *n, int *larguraIndice,
+                         const ConfiguracaoES *config);
+
+// Grava um arquivo de permutação; retorna 0 em caso de sucesso
+int gravarPermutacaoArquivo(const char *nomeArquivo, const void *indices, int n, int larguraIndice,
+                            const ConfiguracaoES *config);
+
+// Lê um arquivo de cadeias e verifica os comprimentos; retorna 0 em caso de sucesso. A
+// coluna é alocada com alocarBuffer e deve ser liberada com liberarBuffer.
+int lerCadeiasArquivo(const char *nomeArquivo, unsigned char **coluna, size_t *bytes, int *n,
+                      const ConfiguracaoES *config);
+
+// Grava um arquivo de cadeias; retorna 0 em caso de sucesso
+int gravarCadeiasArquivo(const char *nomeArquivo, const unsigned char *coluna, size_t bytes, int n,
+                         const ConfiguracaoES *config);
+
+// Grava o vetor no arquivo binário; retorna 0 em caso de sucesso
+int gravarVetorArquivo(const char *nomeArquivo, const int *vetor, int n, const ConfiguracaoES *config);
+
+// Abre um gravador incremental para o vetor de n elementos. O cabeçalho é gravado
+// imediatamente e os elementos são enviados por enviarBlocoGravador. A memória do vetor
+// deve permanecer válida (e os trechos enviados inalterados) até fecharGravadorVetor.
+// Na gravação direta os trechos devem ser enviados em ordem.
+GravadorVetor *abrirGravadorVetor(const char *nomeArquivo, const int *vetor, int n, const ConfiguracaoES *config);
+
+// Envia os elementos [inicio, inicio + quantidade) para gravação assíncrona
+int enviarBlocoGravador(GravadorVetor *gravador, long inicio, long quantidade);
+
+// Aguarda todas as gravações pendentes e fecha o arquivo; retorna 0 em caso de sucesso
+int fecharGravadorVetor(GravadorVetor *gravador);
+
+#endif
@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "IndiceEsparso.h"
+
+// Função para montar o nome do índice (<arquivoDados>.idx); retorna NULL se faltar memória
+static char *nomeDoIndice(const char *arquivoDados) {
+    size_t tamanho = strlen(arquivoDados) + sizeof(INDICE_EXTENSAO);
+    char *nome = malloc(tamanho);
+    if (nome) {
+        snprintf(nome, tamanho, "%s%s", arquivoDados, INDICE_EXTENSAO);
+    }
+    return nome;
+}
+
+// Função para preencher a árvore de Eytzinger a partir do nó k, em ordem simétrica;
+// retorna o próximo bloco a ser colocado
+static long montarArvore(int *cercas, int *blocos, const int *maximos, long numBlocos, long proximo, long k) {
+    if (k > numBlocos) {
+        return proximo;
+    }
+    proximo = montarArvore(cercas, blocos, maximos, numBlocos, proximo, 2 * k);
+    cercas[k] = maximos[proximo];
+    blocos[k] = (int)proximo;
+    return montarArvore(cercas, blocos, maximos, numBlocos, proximo + 1, 2 * k + 1);
+}
+
+// Grava o índice esparso do vetor ordenado em <arquivoDados>.idx
+int gravarIndiceEsparso(const char *arquivoDados, const int *vetor, long n) {
+    char *nome = nomeDoIndice(arquivoDados);
+    if (!nome) {
+        printf("Erro: Falha na alocação de memória.\n");
+        return -1;
+    }
+
+    // O índice só vale para vetores ordenados
+    for (long i = 1; i < n; i++) {
+        if (vetor[i] < vetor[i - 1]) {
+            printf("Aviso: A saída não está ordenada; o índice esparso não foi gravado.\n");
+            unlink(nome);
+            free(nome);
+            return 1;
+        }
+    }
+
+    long numBlocos = (n + INDICE_PASSO - 1) / INDICE_PASSO;
+    size_t bytes = INDICE_CABECALHO + (size_t)(2 * (numBlocos + 1) + 2 * numBlocos) * sizeof(int);
+    int *imagem = calloc(1, bytes);
+    if (!imagem) {
+        printf("Erro: Falha na alocação de memória.\n");
+        free(nome);
+        return -1;
+    }
+
+    imagem[0] = INDICE_MARCADOR;
+    imagem[1] = INDICE_PASSO;
+    imagem[2] = (int)n;
+    imagem[3] = (int)numBlocos;
+    int *cercas = imagem + INDICE_CABECALHO / sizeof(int);
+    int *blocos = cercas + numBlocos + 1;
+    int *minimos = blocos + numBlocos + 1;
+    int *maximos = minimos + numBlocos;
+    for (long b = 0; b < numBlocos; b++) {
+        long fim = (b + 1) * INDICE_PASSO < n ? (b + 1) * INDICE_PASSO : n;
+        minimos[b] = vetor[b * INDICE_PASSO];
+        maximos[b] = vetor[fim - 1];
+    }
+    montarArvore(cercas, blocos, maximos, numBlocos, 0, 1);
+
+    int erro = 0;
+    FILE *arquivo = fopen(nome, "wb");
+    if (!arquivo || fwrite(imagem, 1, bytes, arquivo) != bytes) {
+        printf("Erro: Não foi possível gravar o índice esparso %s.\n", nome);
+        erro = -1;
+    }
+    if (arquivo && fclose(arquivo) != 0 && erro == 0) {
+        printf("Erro: Falha ao fechar o índice esparso %s (%s).\n", nome, strerror(errno));
+        erro = -1;
+    }
+
+    free(imagem);
+    free(nome);
+    return erro;
+}
+
+// Função para mapear um arquivo inteiro somente para leitura; retorna NULL em caso de erro
+static void *mapearArquivo(const char *nome, size_t *bytes) {
+    int fd = open(nome, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir %s.\n", nome);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(int)) {
+        printf("Erro: O arquivo %s está vazio ou não pode ser lido.\n", nome);
+        close(fd);
+        return NULL;
+    }
+    *bytes = (size_t)st.st_size;
+    void *mapa = mmap(NULL, *bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        printf("Erro: Falha ao mapear %s (%s).\n", nome, strerror(errno));
+        return NULL;
+    }
+    return mapa;
+}
+
+// Grava o índice esparso de um arquivo binário ordenado já existente
+int construirIndiceEsparso(const char *arquivoDados) {
+    size_t bytes;
+    int *dados = mapearArquivo(arquivoDados, &bytes);
+    if (!dados) {
+        return -1;
+    }
+    madvise(dados, bytes, MADV_SEQUENTIAL);
+
+    int erro = -1;
+    if (dados[0] < 0 || bytes < (size_t)(dados[0] + 1L) * sizeof(int)) {
+        printf("Erro: %s não é um vetor binário simples.\n", arquivoDados);
+    } else {
+        erro = gravarIndiceEsparso(arquivoDados, dados + 1, dados[0]);
+    }
+    munmap(dados, bytes);
+    return erro;
+}
+
+// Mapeia o arquivo de dados e o seu índice
+int abrirIndiceEsparso(const char *arquivoDados, IndiceEsparso *indice) {
+    memset(indice, 0, sizeof(*indice));
+    char *nome = nomeDoIndice(arquivoDados);
+    if (!nome) {
+        printf("Erro: Falha na alocação de memória.\n");
+        return -1;
+    }
+
+    indice->mapaDados = mapearArquivo(arquivoDados, &indice->bytesDados);
+    indice->mapaIndice = indice->mapaDados ? mapearArquivo(nome, &indice->bytesIndice) : NULL;
+    if (!indice->mapaIndice) {
+        fecharIndiceEsparso(indice);
+        free(nome);
+        return -1;
+    }
+
+    // Só as páginas tocadas pelas consultas devem ser lidas do arquivo de dados
+    madvise(indice->mapaDados, indice->bytesDados, MADV_RANDOM);
+
+    const int *dados = indice->mapaDados;
+    const int *cabecalho = indice->mapaIndice;
+    int n = dados[0];
+    int valido = indice->bytesIndice >= INDICE_CABECALHO && cabecalho[0] == INDICE_MARCADOR && cabecalho[1] > 0;
+    if (valido) {
+        long numBlocos = cabecalho[3];
+        size_t esperado = INDICE_CABECALHO + (size_t)(4 * numBlocos + 2) * sizeof(int);
+        valido = n >= 0 && indice->bytesDados >= (size_t)(n + 1L) * sizeof(int) && cabecalho[2] == n &&
+                 numBlocos == (n + (long)cabecalho[1] - 1) / cabecalho[1] && indice->bytesIndice == esperado;
+    }
+    if (!valido) {
+        printf("Erro: O índice %s não corresponde a %s (índice desatualizado ou arquivo inválido).\n", nome, arquivoDados);
+        fecharIndiceEsparso(indice);
+        free(nome);
+        return -1;
+    }
+    free(nome);
+
+    indice->n = n;
+    indice->passo = cabecalho[1];
+    indice->numBlocos = cabecalho[3];
+    indice->cercas = cabecalho + INDICE_CABECALHO / sizeof(int);
+    indice->blocos = indice->cercas + indice->numBlocos + 1;
+    indice->minimos = indice->blocos + indice->numBlocos + 1;
+    indice->maximos = indice->minimos + indice->numBlocos;
+    indice->valores = dados + 1;
+    return 0;
+}
+
+// Desfaz os mapeamentos do índice
+void fecharIndiceEsparso(IndiceEsparso *indice) {
+    if (indice->mapaIndice) {
+        munmap(indice->mapaIndice, indice->bytesIndice);
+    }
+    if (indice->mapaDados) {
+        munmap(indice->mapaDados, indice->bytesDados);
+    }
+    indice->mapaIndice = indice->mapaDados = NULL;
+}
+
+// Função para encontrar o primeiro bloco cujo maior valor é maior ou igual à chave (ou maior,
+// com incluirIguais); retorna numBlocos se não houver
+static long buscarBloco(const IndiceEsparso *indice, int chave, int incluirIguais) {
+    long k = 1, numBlocos = indice->numBlocos;
+    while (k <= numBlocos) {
+        __builtin_prefetch(indice->cercas + 16 * k);
+        int cerca = indice->cercas[k];
+        k = 2 * k + (incluirIguais ? cerca <= chave : cerca < chave);
+    }
+
+    // Desfazer as descidas à direita depois da última descida à esquerda
+    k >>= __builtin_ffsl(~k);
+    return k == 0 ? numBlocos : indice->blocos[k];
+}
+
+// Função para encontrar a posição do primeiro valor maior ou igual à chave (ou maior, com
+// incluirIguais) pelo índice e por uma busca binária no bloco
+static long limiteIndice(IndiceEsparso *indice, int chave, int incluirIguais) {
+    long b = buscarBloco(indice, chave, incluirIguais);
+    if (b == indice->numBlocos) {
+        return indice->n;
+    }
+
+    long inicio = b * indice->passo;
+    long fim = inicio + indice->passo < indice->n ? inicio + indice->passo : indice->n;
+    const int *v = indice->valores;
+    indice->blocosLidos++;
+    if (v[inicio] != indice->minimos[b] || v[fim - 1] != indice->maximos[b]) {
+        printf("Erro: O bloco %ld não corresponde ao índice (índice desatualizado).\n", b);
+        return -1;
+    }
+
+    while (inicio < fim) {
+        long meio = inicio + (fim - inicio) / 2;
+        if (v[meio] < chave || (incluirIguais && v[meio] == chave)) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+// Retorna a posição do primeiro valor maior ou igual à chave
+long limiteInferiorIndice(IndiceEsparso *indice, int chave) {
+    return limiteIndice(indice, chave, 0);
+}
+
+// Retorna a posição do primeiro valor maior que a chave
+long limiteSuperiorIndice(IndiceEsparso *indice, int chave) {
+    return limiteIndice(indice, chave, 1);
+}
@@ -0,0 +1,74 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/*
+ * Alocador de buffers compartilhado pelos programas de ordenação.
+ *
+ * Os vetores grandes (entrada e buffers temporários) são alocados com mmap, alinhados a
+ * 2 MB, para que o kernel possa usar huge pages e reduzir as falhas de TLB nas fases de
+ * acesso aleatório (partição e mesclagem). Os modos disponíveis são:
+ *
+ * - MEM_MALLOC: malloc simples (comportamento original);
+ * - MEM_THP: mmap alinhado a 2 MB com madvise(MADV_HUGEPAGE) (padrão);
+ * - MEM_HUGETLB: huge pages explícitas (MAP_HUGETLB), quando houver páginas reservadas
+ *   em /proc/sys/vm/nr_hugepages; caso contrário, usa MEM_THP.
+ *
+ * Buffers menores que MEM_TAMANHO_HUGE_PAGE sempre usam malloc. Os buffers temporários
+ * devolvidos com devolverBufferTemporario são reaproveitados pelas fases seguintes.
+ *
+ * Um gancho de distribuição (definirDistribuicaoMemoria) pode fazer o primeiro toque dos
+ * buffers de alocarBuffer, por exemplo para espalhar as páginas entre nós NUMA.
+ */
+
+#define MEM_TAMANHO_HUGE_PAGE (2ul * 1024 * 1024)
+
+// Modos de alocação
+typedef enum {
+    MEM_MALLOC = 0, // malloc
+    MEM_THP,        // Transparent Huge Pages (madvise)
+    MEM_HUGETLB     // Huge pages explícitas
+} ModoMemoria;
+
+// Define o modo usado por alocarBuffer
+void definirModoMemoria(ModoMemoria modo);
+
+// Retorna o modo atual
+ModoMemoria modoMemoriaAtual(void);
+
+// Converte o nome do modo ("malloc", "thp" ou "hugetlb"); retorna -1 se for inválido
+int modoMemoriaDoNome(const char *nome, ModoMemoria *modo);
+
+// Retorna o nome do modo
+const char *nomeModoMemoria(ModoMemoria modo);
+
+// Define a função que faz o primeiro toque dos buffers grandes de alocarBuffer (NULL desativa)
+void definirDistribuicaoMemoria(void (*distribuir)(void *buffer, size_t bytes, void *contexto), void *contexto);
+
+// Aloca um buffer no modo atual; retorna NULL em caso de erro
+void *alocarBuffer(size_t bytes);
+
+// Aloca um buffer no modo indicado; retorna NULL em caso de erro
+void *alocarBufferModo(size_t bytes, ModoMemoria modo);
+
+// Libera um buffer obtido por alocarBuffer ou alocarBufferModo
+void liberarBuffer(void *ptr);
+
+// Obtém um buffer temporário com pelo menos bytes, reaproveitando um devolvido antes
+void *obterBufferTemporario(size_t bytes);
+
+// Devolve um buffer temporário para ser reaproveitado
+void devolverBufferTemporario(void *ptr);
+
+// Libera todos os buffers temporários devolvidos
+void liberarBuffersTemporarios(void);
+
+// Retorna quantas huge pages o kernel efetivamente usou para o buffer
+size_t contarHugePages(const void *ptr);
+
+// Imprime quantas huge pages foram obtidas para os buffers alocados
+void imprimirRelatorioMemoria(FILE *saida);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef MESCLAGEM_INCREMENTAL_H
+#define MESCLAGEM_INCREMENTAL_H
+
+#include <stdio.h>
+#include "EntradaSaida.h"
+
+/*
+ * Manutenção incremental de um arquivo binário já ordenado: um lote pequeno de valores
+ * novos (o delta), já ordenado em memória, é mesclado à base em uma única passada
+ * sequencial, sem ordenar a base de novo. O custo é proporcional ao delta mais uma
+ * passada pelo arquivo.
+ *
+ * A mesclagem avança por galope (busca exponencial seguida de busca binária): para cada
+ * valor do delta, o trecho da base com valores menores ou iguais é localizado em
+ * O(log comprimento) e copiado em bloco, sem comparações elemento a elemento. Com chaves
+ * iguais, os valores da base vêm antes dos do delta (a mesclagem é estável).
+ *
+ * - Caminho de arquivo (padrão): a base é lida em blocos de ES_TAMANHO_BLOCO_PADRAO bytes
+ *   com pread. Quando o trecho intacto passa do bloco lido, o galope continua no arquivo,
+ *   lendo um único valor por sonda, e trechos com pelo menos
+ *   INCREMENTAL_MIN_COPIA_KERNEL bytes são copiados de arquivo para arquivo por
+ *   copy_file_range, sem passar pelo processo (com read/write se o sistema de arquivos não
+ *   aceitar).
+ * - Caminho mapeado (--mapear): a base e a saída são mapeadas com mmap e os trechos
+ *   intactos são copiados com memcpy de um mapeamento para o outro.
+ *
+ * A saída é gravada em um arquivo temporário no mesmo diretório e renomeada ao final, de
+ * forma que a saída pode ser a própria base e que um erro no meio não a corrompe. A base
+ * precisa estar ordenada (ver ValidarResultado); ela não é verificada, pois os trechos
+ * copiados em bloco não são lidos pelo processo.
+ */
+
+#define INCREMENTAL_MIN_COPIA_KERNEL (4L * 1024 * 1024) // Bytes mínimos de um trecho copiado com copy_file_range
+
+// Opções do modo incremental do Ordenar
+typedef struct {
+    const char *base; // Arquivo ordenado que recebe o delta (--base) ou NULL
+    int mapear;       // 1 = mesclar pelos mapeamentos da base e da saída (--mapear)
+} OpcoesIncremental;
+
+// Resumo de uma mesclagem incremental
+typedef struct {
+    long base;          // Elementos da base
+    long delta;         // Elementos do delta
+    long trechos;       // Trechos da base copiados em bloco
+    long bytesKernel;   // Bytes copiados com copy_file_range
+    long sondas;        // Valores da base lidos um a um pelo galope no arquivo
+} EstatisticasIncremental;
+
+// Mescla os n valores ordenados de delta ao arquivo ordenado arquivoBase, gravando o
+// resultado em arquivoSaida (que pode ser o próprio arquivoBase). Com mapear, usa o
+// caminho mapeado; config->durabilidade faz um fdatasync antes da renomeação, e
+// config->indiceEsparso refaz o índice esparso da saída (ver Common/IndiceEsparso.h).
+// estatisticas é opcional. Retorna 0 em caso de sucesso e -1 em caso de erro.
+int mesclarDeltaArquivo(const char *arquivoBase, const int *delta, long n, const char *arquivoSaida,
+                        int mapear, const ConfiguracaoES *config, EstatisticasIncremental *estatisticas);
+
+// Extrai de argv as opções do modo incremental (--base, --mapear), deixando as demais
+// para extrairOpcoes; retorna o novo argc ou -1
+int extrairOpcoesIncremental(int argc, char *argv[], OpcoesIncremental *opcoes);
+
+// Imprime a lista de opções do modo incremental
+void imprimirOpcoesIncremental(FILE *saida);
+
+// Imprime o resumo de uma mesclagem incremental
+void imprimirEstatisticasIncremental(FILE *saida, const EstatisticasIncremental *estatisticas);
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef OPCOES_H
+#define OPCOES_H
+
+#include "EntradaSaida.h"
+#include "Memoria.h"
+#include "Topologia.h"
+
+/*
+ * Opções de linha de comando comuns aos programas de ordenação.
+ *
+ * As opções podem aparecer em qualquer posição e são removidas de argv, de forma que
+ * cada programa continua verificando apenas os seus argumentos posicionais:
+ *
+ *   --es <stdio|uring|pread>   Backend de leitura e gravação dos vetores
+ *   --es-bloco <MB>            Tamanho de cada requisição assíncrona (1 a 4 MB)
+ *   --es-profundidade <N>      Número de requisições em voo no io_uring
+ *   --es-direto                Grava a saída com O_DIRECT, sem passar pelo page cache
+ *   --es-durabilidade          Faz um único fdatasync ao final da gravação
+ *   --indice-esparso           Grava também o índice esparso <saida>.idx (ver Common/IndiceEsparso.h)
+ *   --memoria <malloc|thp|hugetlb>  Modo de alocação dos vetores (aplicado por extrairOpcoes)
+ *   --afinidade <nenhuma|compacta|espalhada>  Fixação das threads e primeiro toque NUMA
+ *   --topologia <NxC>          Topologia falsa (N nós com C CPUs) para testes
+ *   --preordenacao             Mede a pré-ordenação e aproveita corridas (ver Common/Preordenacao.h)
+ *   --compactar                Compacta as chaves em 8/16 bits quando couberem (ver Common/Compactacao.h)
+ *   --duplo-pivo               Quicksorts com a partição de dois pivôs (Yaroslavskiy)
+ *   --mesclagem                Mergesort paralelo no lugar do MinMaxSort (ConcMinMax, ver Common/Mesclagem.h)
+ *   --ajuste <arquivo|nenhum>  Perfil de ajuste da máquina (ver Common/Ajuste.h)
+ *   --argsort <arquivo>        Grava também a permutação que ordena a entrada (argsort)
+ *   --indices <32|64>          Largura dos índices da permutação (padrão: 32)
+ *
+ * Modo em lote (ver Common/Lote.h), em que os arquivos de entrada e saída não são
+ * argumentos posicionais:
+ *
+ *   --entradas <padrão>        Arquivos de entrada (glob, pode ser repetida)
+ *   --manifesto <arquivo>      Arquivo com uma linha "entrada[<TAB>saida]" por ordenação
+ *   --saida-dir <diretório>    Diretório das saídas sem nome explícito
+ *   --lote-concorrente         Ordena arquivos pequenos ao mesmo tempo
+ *
+ * Os programas que implementam só uma parte das opções verificam as pedidas com
+ * verificarOpcoesAceitas e recusam as demais com um erro, em vez de ignorá-las.
+ */
+
+#define OPCOES_MAX_ENTRADAS 64
+
+// Opções de execução reconhecidas
+typedef struct {
+    ConfiguracaoES es;        // Configuração de entrada e saída
+    ModoMemoria modoMemoria;  // Modo de alocação dos vetores
+    PoliticaAfinidade afinidade; // Política de afinidade das threads
+    const char *topologia;    // Topologia falsa ("NxC") ou NULL para a real
+    const char *entradas[OPCOES_MAX_ENTRADAS]; // Padrões de entrada do modo em lote
+    int numEntradas;
+    const char *manifesto;    // Manifesto do modo em lote (ou NULL)
+    const char *saidaDir;     // Diretório das saídas do modo em lote (ou NULL)
+    int loteConcorrente;      // 1 = arquivos pequenos do lote são ordenados ao mesmo tempo
+    int preordenacao;         // 1 = medir a pré-ordenação antes de ordenar
+    int compactar;            // 1 = compactar as chaves em 8/16 bits quando couberem
+    int duploPivo;            // 1 = Quicksorts com dois pivôs (SeqQuicksort e ConcQuickSort)
+    int mesclagem;            // 1 = mergesort paralelo no lugar do MinMaxSort (ConcMinMax)
+    const char *ajuste;       // Perfil de ajuste (aplicado por extrairOpcoes) ou NULL para o padrão
+    const char *argsort;      // Arquivo da permutação que ordena a entrada ou NULL
+    int larguraIndice;        // Bytes de cada índice da permutação (4 ou 8)
+} OpcoesExecucao;
+
+// Grupos de opções, para os programas que implementam só uma parte delas (--memoria vale
+// para todos)
+#define OPCOES_GRUPO_LOTE            0x001 // --entradas, --manifesto, --saida-dir, --lote-concorrente
+#define OPCOES_GRUPO_AFINIDADE       0x002 // --afinidade, --topologia
+#define OPCOES_GRUPO_PREORDENACAO    0x004 // --preordenacao
+#define OPCOES_GRUPO_COMPACTAR       0x008 // --compactar
+#define OPCOES_GRUPO_DUPLO_PIVO      0x010 // --duplo-pivo
+#define OPCOES_GRUPO_AJUSTE          0x020 // --ajuste
+#define OPCOES_GRUPO_ARGSORT         0x040 // --argsort, --indices
+#define OPCOES_GRUPO_INDICE_ESPARSO  0x080 // --indice-esparso
+#define OPCOES_GRUPO_ES              0x100 // --es, --es-bloco, --es-profundidade, --es-durabilidade
+#define OPCOES_GRUPO_ES_DIRETO       0x200 // --es-direto
+#define OPCOES_GRUPO_MESCLAGEM       0x400 // --mesclagem
+#define OPCOES_GRUPOS_TODOS          0x7ff
+
+// Preenche as opções com os valores padrão
+void opcoesPadrao(OpcoesExecucao *opcoes);
+
+// Extrai as opções de argv, compactando os argumentos posicionais no início.
+// Retorna o novo argc ou -1 se alguma opção for inválida.
+int extrairOpcoes(int argc, char *argv[], OpcoesExecucao *opcoes);
+
+// Retorna 1 se as opções pedem o modo em lote (--entradas ou --manifesto)
+int modoLote(const OpcoesExecucao *opcoes);
+
+// Lê o valor inteiro positivo de uma opção (também usada pelas opções próprias de cada
+// programa); retorna -1 e imprime um erro se o valor for inválido
+int lerValorPositivo(const char *opcao, const char *valor, long *saida);
+
+// Verifica se as opções pedidas pertencem aos grupos que o programa implementa; imprime a
+// primeira opção recusada e retorna -1 se houver alguma
+int verificarOpcoesAceitas(const OpcoesExecucao *opcoes, int grupos);
+
+// Imprime a lista de opções aceitas
+void imprimirOpcoes(FILE *saida);
+
+// Imprime a lista de opções, apenas com as dos grupos dados
+void imprimirOpcoesAceitas(FILE *saida, int grupos);
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef ORDENACAO_DISTRIBUIDA_H
+#define ORDENACAO_DISTRIBUIDA_H
+
+#include <stdio.h>
+#include "EntradaSaida.h"
+#include "Ordenacao.h"
+
+/*
+ * Ordenação distribuída por amostragem (sample sort) entre processos trabalhadores da
+ * mesma máquina, que fazem o papel dos nós de um cluster: cada processo tem a sua própria
+ * memória e só enxerga a sua fatia da entrada, e as chaves passam de um processo a outro
+ * por sockets Unix (socketpair), no lugar da rede.
+ *
+ * O processo que chama ordenarDistribuido é o coordenador. Ele cria um socket de controle
+ * para cada trabalhador e uma malha com um socket para cada par de trabalhadores, e então
+ * cria os trabalhadores com fork. As fases são:
+ *
+ * 1. Leitura: o trabalhador r lê apenas os elementos [r * n / P, (r + 1) * n / P) da entrada.
+ * 2. Amostragem: cada trabalhador envia ao coordenador até DISTRIBUIDA_AMOSTRAS elementos
+ *    sorteados da sua fatia; o coordenador ordena a amostra global e devolve a todos os
+ *    mesmos P - 1 separadores, nos quantis da amostra.
+ * 3. Partição: cada trabalhador separa a sua fatia em P baldes pelos separadores, em
+ *    trechos divididos entre as threads do seu pool. Elementos iguais a um separador
+ *    repetido são distribuídos em rodízio entre os baldes que o aceitam, para que chaves
+ *    muito repetidas não sobrecarreguem um único processo.
+ * 4. Contagens: os tamanhos dos baldes vão ao coordenador, que devolve a cada trabalhador
+ *    quantos elementos ele vai receber de cada origem (e onde colocá-los).
+ * 5. Troca: cada balde é enviado ao seu destino pela malha, por uma thread de envio,
+ *    enquanto a thread principal recebe de todas as origens ao mesmo tempo (poll) direto
+ *    na posição final do vetor local.
+ * 6. Ordenação: o vetor recebido é ordenado com o algoritmo pedido (o OrdenarDistribuido
+ *    usa o Quicksort concorrente de dois pivôs) no pool do trabalhador.
+ * 7. Gravação: o trabalhador r grava o fragmento <prefixo>.<r>, um vetor binário comum.
+ *
+ * Os fragmentos, na ordem de r, formam o vetor ordenado inteiro: todos os elementos do
+ * fragmento r são menores ou iguais aos do fragmento r + 1. Ao final, cada trabalhador
+ * envia ao coordenador o tempo e os bytes enviados e recebidos em cada fase.
+ */
+
+#define DISTRIBUIDA_MAX_PROCESSOS        16        // A malha usa P * (P - 1) descritores no coordenador
+#define DISTRIBUIDA_AMOSTRAS             1024      // Elementos sorteados por trabalhador
+#define DISTRIBUIDA_BUFFER_SOCKET        (1 << 20) // Bytes pedidos para os buffers dos sockets da malha
+#define DISTRIBUIDA_MIN_ELEMENTOS_TRECHO 65536     // Elementos mínimos por trecho da partição
+#define DISTRIBUIDA_MAX_TRECHOS          256
+
+// Fases de um trabalhador
+typedef enum {
+    DISTRIBUIDA_LEITURA = 0,
+    DISTRIBUIDA_AMOSTRAGEM,
+    DISTRIBUIDA_PARTICAO,
+    DISTRIBUIDA_CONTAGENS,
+    DISTRIBUIDA_TROCA,
+    DISTRIBUIDA_ORDENACAO,
+    DISTRIBUIDA_GRAVACAO,
+    DISTRIBUIDA_NUM_FASES
+} FaseDistribuida;
+
+// Relatório de um trabalhador, enviado ao coordenador ao final
+typedef struct {
+    long entrada;   // Elementos da fatia lida
+    long saida;     // Elementos do fragmento gravado
+    int primeiro;   // Menor e maior elementos do fragmento (se saida > 0)
+    int ultimo;
+    double tempo[DISTRIBUIDA_NUM_FASES];             // Segundos em cada fase
+    long long bytesEnviados[DISTRIBUIDA_NUM_FASES];  // Bytes enviados ao coordenador ou à malha
+    long long bytesRecebidos[DISTRIBUIDA_NUM_FASES];
+} RelatorioTrabalhador;
+
+// Resumo de uma ordenação distribuída
+typedef struct {
+    int numProcessos;
+    long n;
+    double tempoTotal; // Segundos do coordenador, da criação dos processos ao último relatório
+    RelatorioTrabalhador trabalhadores[DISTRIBUIDA_MAX_PROCESSOS];
+} EstatisticasDistribuida;
+
+// Ordena o arquivo binário arquivoEntrada com numProcessos trabalhadores de numThreads
+// threads cada, usando o algoritmo dado na ordenação local, e grava os fragmentos
+// <prefixoSaida>.0 a <prefixoSaida>.<numProcessos - 1>. estatisticas é opcional. Retorna 0
+// em caso de sucesso e -1 se algum trabalhador falhar.
+int ordenarDistribuido(const char *arquivoEntrada, const char *prefixoSaida, int numProcessos, int numThreads,
+                       AlgoritmoOrdenacao algoritmo, const ConfiguracaoES *config, EstatisticasDistribuida *estatisticas);
+
+// Retorna o nome da fase
+const char *nomeFaseDistribuida(FaseDistribuida fase);
+
+// Imprime o tempo (o do trabalhador mais lento) e o volume trocado em cada fase, o tamanho
+// de cada fragmento e se os fragmentos estão em ordem entre si
+void imprimirEstatisticasDistribuida(FILE *saida, const EstatisticasDistribuida *estatisticas);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef ORDENACAO_REGISTROS_H
+#define ORDENACAO_REGISTROS_H
+
+#include "PoolThreads.h"
+
+/*
+ * Ordenação estável de registros da biblioteca libconcsort: cada registro tem uma chave
+ * inteira de 32 ou 64 bits (com sinal) e uma carga de larguraCarga bytes, que acompanha a
+ * chave sem participar da comparação. Mover a carga inteira a cada troca ou passada
+ * desperdiçaria cache e banda de memória, então só pares de 16 bytes são ordenados:
+ *
+ * 1. Empacotamento: cada registro vira um par (chave, valor), com a chave convertida para
+ *    um inteiro sem sinal de mesma ordem. O valor é a própria carga, quando ela tiver até
+ *    REGISTROS_CARGA_NO_PAR bytes (REGISTROS_CARGA), ou a posição do registro na origem
+ *    (REGISTROS_INDICES); a estratégia é escolhida pelo tamanho da carga.
+ * 2. Ordenação: radix sort LSD dos pares com dígitos de 8 bits (quatro passadas com
+ *    chaves de 32 bits e oito com 64; passadas em que todas as chaves têm o mesmo dígito
+ *    são dispensadas), estável, com a contagem e a distribuição de cada passada divididas
+ *    entre os trabalhadores.
+ * 3. Desempacotamento: cada posição do destino recebe a chave do par e a carga, tirada do
+ *    próprio par ou, com índices, copiada da origem em uma única passada (aplicação da
+ *    permutação). Se a carga de origem e a de destino forem a mesma memória, a carga de
+ *    origem é antes copiada para um buffer temporário.
+ *
+ * Os registros podem estar em um vetor de estruturas (AoS, como no arquivo de registros de
+ * Common/EntradaSaida.h: chave seguida da carga, sem preenchimento) ou em colunas (SoA: um
+ * vetor de chaves e um vetor de cargas).
+ *
+ * O argsort usa os mesmos pares (chave, índice), mas escreve no destino os índices que
+ * ordenam as chaves (a permutação), de 32 ou 64 bits, em vez de mover alguma carga; a
+ * permutação pode então ser aplicada a outras colunas com aplicarPermutacao, uma cópia
+ * dividida entre os trabalhadores.
+ */
+
+#define REGISTROS_CARGA_NO_PAR          8     // Cargas com até esse tamanho (bytes) viajam no próprio par
+#define REGISTROS_MIN_ELEMENTOS_TRECHO  65536 // Registros mínimos por trecho das fases paralelas
+#define REGISTROS_MAX_TRECHOS           256
+
+// Estratégias de ordenação dos registros
+typedef enum {
+    REGISTROS_CARGA = 0, // Pares (chave, carga): a carga viaja com a chave
+    REGISTROS_INDICES    // Pares (chave, índice) e uma única passada de permutação da carga
+} EstrategiaRegistros;
+
+// Retorna a estratégia usada para cargas de larguraCarga bytes
+EstrategiaRegistros estrategiaRegistros(int larguraCarga);
+
+// Retorna o nome da estratégia
+const char *nomeEstrategiaRegistros(EstrategiaRegistros estrategia);
+
+// Ordena os n registros AoS de origem em destino (pode ser o próprio vetor) pela chave, de
+// forma estável; com pool, até numThreads trabalhadores são usados (0 = todos). Retorna 0
+// em caso de sucesso e -1 em caso de erro.
+int ordenarRegistros(const void *origem, void *destino, long n, int larguraChave, int larguraCarga,
+                     PoolThreads *pool, int numThreads);
+
+// Ordena as colunas SoA (n chaves de larguraChave bytes e n cargas de larguraCarga bytes)
+// pela chave, de forma estável, nos próprios vetores; retorna 0 em caso de sucesso e -1 em
+// caso de erro
+int ordenarColunas(void *chaves, void *cargas, long n, int larguraChave, int larguraCarga,
+                   PoolThreads *pool, int numThreads);
+
+// Escreve em indices (de larguraIndice = 4 ou 8 bytes) a permutação que ordena as n chaves de
+// larguraChave bytes, de forma estável: chaves[indices[0]] <= chaves[indices[1]] <= ...
+// Com ordenadas (pode ser o próprio vetor de chaves), as chaves ordenadas também são escritas.
+// Retorna 0 em caso de sucesso e -1 em caso de erro.
+int argsortChaves(const void *chaves, long n, int larguraChave, void *indices, int larguraIndice,
+                  void *ordenadas, PoolThreads *pool, int numThreads);
+
+// Aplica a permutação aos n elementos de largura bytes: destino[i] = origem[indices[i]]
+// (destino não pode ser a própria origem); retorna 0 em caso de sucesso e -1 em caso de erro,
+// inclusive se algum índice estiver fora de [0, n)
+int aplicarPermutacao(const void *origem, void *destino, long n, int largura, const void *indices,
+                      int larguraIndice, PoolThreads *pool, int numThreads);
+
+#endif
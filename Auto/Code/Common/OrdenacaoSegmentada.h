@@ -0,0 +1,41 @@
+#ifndef ORDENACAO_SEGMENTADA_H
+#define ORDENACAO_SEGMENTADA_H
+
+#include "Ordenacao.h"
+
+/*
+ * Ordenação segmentada da biblioteca libconcsort: muitos vetores pequenos (segmentos)
+ * guardados em um único buffer contíguo são ordenados de uma vez, cada um de forma
+ * independente, sem uma chamada (e uma rodada de tarefas) por vetor.
+ *
+ * O segmento s ocupa valores[deslocamentos[s] .. deslocamentos[s + 1]), como no formato de
+ * arquivo segmentado de Common/EntradaSaida.h. O núcleo de cada segmento é escolhido pelo
+ * tamanho:
+ *
+ * - até SEGMENTOS_LIMITE_REDE elementos: rede de ordenação fixa (sem desvios dependentes
+ *   dos dados);
+ * - até SEGMENTOS_LIMITE_INSERCAO elementos: ordenação por inserção;
+ * - acima disso: Quicksort sequencial (o mesmo de ordenarQuicksortSeqI32).
+ *
+ * Os segmentos consecutivos são agrupados em tarefas com aproximadamente o mesmo número de
+ * elementos (várias por trabalhador, para equilibrar a carga), executadas pelo pool das
+ * opções. Segmentos com mais de SEGMENTOS_LIMITE_PARALELO elementos não entram nos grupos:
+ * são ordenados depois, um de cada vez, pelo Quicksort concorrente com o pool inteiro.
+ */
+
+#define SEGMENTOS_LIMITE_REDE      8
+#define SEGMENTOS_LIMITE_INSERCAO  32
+#define SEGMENTOS_LIMITE_PARALELO  (1L << 18)
+#define SEGMENTOS_TAREFAS_POR_TRABALHADOR 8    // Grupos de segmentos por trabalhador do pool
+#define SEGMENTOS_MIN_ELEMENTOS_TAREFA    16384 // Elementos mínimos de um grupo
+
+// Ordena cada um dos numSegmentos segmentos de valores; retorna 0 em caso de sucesso.
+// Das opções são usados o pool (ou numThreads para um pool temporário); algoritmo, saída e
+// gravador são ignorados.
+int ordenarSegmentosI32(int *valores, const long *deslocamentos, long numSegmentos,
+                        const OpcoesOrdenacao *opcoes);
+
+// Ordena um único segmento com o núcleo escolhido pelo tamanho
+void ordenarSegmentoI32(int *segmento, long n);
+
+#endif
@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "PoolThreads.h"
+
+// Tarefa na fila
+typedef struct Tarefa {
+    void (*funcao)(void *);
+    void *arg;
+    GrupoTarefas *grupo;
+    struct Tarefa *prox;
+} Tarefa;
+
+// Fila FIFO de tarefas
+typedef struct {
+    Tarefa *inicio;
+    Tarefa *fim;
+    int tamanho;
+} FilaTarefas;
+
+// Dados de cada trabalhador
+typedef struct {
+    PoolThreads *pool;
+    int indice;
+    FilaTarefas fila; // Tarefas endereçadas a este trabalhador
+} Trabalhador;
+
+struct PoolThreads {
+    pthread_mutex_t mutex;
+    pthread_cond_t condicao;   // Sinalizada quando uma tarefa é submetida ou concluída
+    FilaTarefas compartilhada;
+    Trabalhador *trabalhadores;
+    pthread_t *threads;
+    int numTrabalhadores;
+    int encerrar;
+    const PlanoNUMA *plano;
+};
+
+// Função para inserir uma tarefa no fim da fila
+static void enfileirar(FilaTarefas *fila, Tarefa *tarefa) {
+    tarefa->prox = NULL;
+    if (fila->fim) {
+        fila->fim->prox = tarefa;
+    } else {
+        fila->inicio = tarefa;
+    }
+    fila->fim = tarefa;
+    fila->tamanho++;
+}
+
+// Função para retirar a tarefa do início da fila (NULL se vazia)
+static Tarefa *desenfileirar(FilaTarefas *fila) {
+    Tarefa *tarefa = fila->inicio;
+    if (tarefa) {
+        fila->inicio = tarefa->prox;
+        if (!fila->inicio) {
+            fila->fim = NULL;
+        }
+        fila->tamanho--;
+    }
+    return tarefa;
+}
+
+// Função para executar uma tarefa e marcá-la como concluída no grupo
+static void executarTarefa(PoolThreads *pool, Tarefa *tarefa) {
+    tarefa->funcao(tarefa->arg);
+
+    pthread_mutex_lock(&pool->mutex);
+    tarefa->grupo->pendentes--;
+    pthread_cond_broadcast(&pool->condicao);
+    pthread_mutex_unlock(&pool->mutex);
+    free(tarefa);
+}
+
+// Função executada por cada trabalhador
+static void *lacoTrabalhador(void *arg) {
+    Trabalhador *trabalhador = (Trabalhador *)arg;
+    PoolThreads *pool = trabalhador->pool;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (1) {
+        // Primeiro as tarefas endereçadas a este trabalhador, depois as compartilhadas
+        Tarefa *tarefa = desenfileirar(&trabalhador->fila);
+        if (!tarefa) {
+            tarefa = desenfileirar(&pool->compartilhada);
+        }
+        if (tarefa) {
+            pthread_mutex_unlock(&pool->mutex);
+            executarTarefa(pool, tarefa);
+            pthread_mutex_lock(&pool->mutex);
+        } else if (pool->encerrar) {
+            break;
+        } else {
+            pthread_cond_wait(&pool->condicao, &pool->mutex);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+// Cria o pool com numTrabalhadores threads
+PoolThreads *criarPoolThreads(int numTrabalhadores, const PlanoNUMA *plano) {
+    if (numTrabalhadores <= 0) {
+        fprintf(stderr, "Erro: o pool precisa de pelo menos uma thread.\n");
+        return NULL;
+    }
+
+    PoolThreads *pool = calloc(1, sizeof(PoolThreads));
+    if (!pool) {
+        perror("Erro ao alocar o pool de threads");
+        return NULL;
+    }
+    pool->trabalhadores = calloc(numTrabalhadores, sizeof(Trabalhador));
+    pool->threads = calloc(numTrabalhadores, sizeof(pthread_t));
+    if (!pool->trabalhadores || !pool->threads) {
+        perror("Erro ao alocar o pool de threads");
+        free(pool->trabalhadores);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->condicao, NULL);
+    pool->plano = planoNUMAAtivo(plano) ? plano : NULL;
+
+    // Criar os trabalhadores, cada um fixado no seu índice do plano
+    for (int i = 0; i < numTrabalhadores; i++) {
+        pool->trabalhadores[i].pool = pool;
+        pool->trabalhadores[i].indice = i;
+        if (criarThreadFixada(&pool->threads[i], pool->plano, i, lacoTrabalhador, &pool->trabalhadores[i]) != 0) {
+            perror("Erro ao criar thread do pool");
+            break;
+        }
+        pool->numTrabalhadores++;
+    }
+
+    if (pool->numTrabalhadores == 0) {
+        destruirPoolThreads(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+// Aguarda as tarefas pendentes, encerra as threads e libera o pool
+void destruirPoolThreads(PoolThreads *pool) {
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->encerrar = 1;
+    pthread_cond_broadcast(&pool->condicao);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->numTrabalhadores; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->condicao);
+    free(pool->trabalhadores);
+    free(pool->threads);
+    free(pool);
+}
+
+// Retorna o número de trabalhadores
+int numTrabalhadoresPool(const PoolThreads *pool) {
+    return pool->numTrabalhadores;
+}
+
+// Retorna o plano usado para fixar os trabalhadores
+const PlanoNUMA *planoDoPool(const PoolThreads *pool) {
+    return pool->plano;
+}
+
+// Retorna o número de tarefas na fila compartilhada
+int tarefasNaFila(PoolThreads *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    int tamanho = pool->compartilhada.tamanho;
+    pthread_mutex_unlock(&pool->mutex);
+    return tamanho;
+}
+
+// Prepara um grupo vazio
+void iniciarGrupoTarefas(GrupoTarefas *grupo) {
+    grupo->pendentes = 0;
+}
+
+// Submete funcao(arg) no grupo
+int submeterTarefa(PoolThreads *pool, GrupoTarefas *grupo, int trabalhador,
+                   void (*funcao)(void *), void *arg) {
+    Tarefa *tarefa = malloc(sizeof(Tarefa));
+    if (!tarefa) {
+        funcao(arg);
+        return -1;
+    }
+    tarefa->funcao = funcao;
+    tarefa->arg = arg;
+    tarefa->grupo = grupo;
+
+    pthread_mutex_lock(&pool->mutex);
+    grupo->pendentes++;
+    if (trabalhador >= 0) {
+        enfileirar(&pool->trabalhadores[trabalhador % pool->numTrabalhadores].fila, tarefa);
+    } else {
+        enfileirar(&pool->compartilhada, tarefa);
+    }
+    pthread_cond_broadcast(&pool->condicao);
+    pthread_mutex_unlock(&pool->mutex);
+    return 0;
+}
+
+// Aguarda todas as tarefas do grupo, executando tarefas da fila compartilhada enquanto isso
+void aguardarGrupoTarefas(PoolThreads *pool, GrupoTarefas *grupo) {
+    pthread_mutex_lock(&pool->mutex);
+    while (grupo->pendentes > 0) {
+        Tarefa *tarefa = desenfileirar(&pool->compartilhada);
+        if (tarefa) {
+            pthread_mutex_unlock(&pool->mutex);
+            executarTarefa(pool, tarefa);
+            pthread_mutex_lock(&pool->mutex);
+        } else {
+            pthread_cond_wait(&pool->condicao, &pool->mutex);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// Executa funcao em cada item, pelo pool quando houver mais de um
+void executarItensPool(PoolThreads *pool, void (*funcao)(void *), void *itens, size_t tamanho, int num) {
+    if (!pool || num == 1) {
+        for (int i = 0; i < num; i++) {
+            funcao((char *)itens + (size_t)i * tamanho);
+        }
+        return;
+    }
+    GrupoTarefas grupo;
+    iniciarGrupoTarefas(&grupo);
+    for (int i = 0; i < num; i++) {
+        submeterTarefa(pool, &grupo, -1, funcao, (char *)itens + (size_t)i * tamanho);
+    }
+    aguardarGrupoTarefas(pool, &grupo);
+}
+
+// Retorna o número de trechos: um por trabalhador, sem trechos pequenos demais
+long numTrechosPool(const PoolThreads *pool, int numThreads, long n, long minPorTrecho, long maxTrechos) {
+    long numTrechos = pool ? numTrabalhadoresPool(pool) : 1;
+    if (numThreads > 0 && numThreads < numTrechos) {
+        numTrechos = numThreads;
+    }
+    if (numTrechos > n / minPorTrecho) {
+        numTrechos = n / minPorTrecho;
+    }
+    if (numTrechos > maxTrechos) {
+        numTrechos = maxTrechos;
+    }
+    if (numTrechos < 1) {
+        numTrechos = 1;
+    }
+    return numTrechos;
+}
@@ -0,0 +1,344 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Preordenacao.h"
+#include "Memoria.h"
+
+#define PREORDENACAO_MAX_TRECHOS 256 // Trechos da medição paralela
+#define CORRIDAS_MAX_PILHA       128 // Corridas pendentes (as regras do TimSort limitam a ~log n)
+
+// Trecho [inicio, fim) medido por uma tarefa
+typedef struct {
+    const int *vetor;
+    long n;
+    long inicio;
+    long fim;
+    long descidas;
+    long subidas;
+    long corridas;
+} TrechoPreordenacao;
+
+// Função para medir um trecho: pares vizinhos que começam no trecho e corridas dentro dele
+static void medirTrecho(void *arg) {
+    TrechoPreordenacao *t = (TrechoPreordenacao *)arg;
+    const int *A = t->vetor;
+
+    // Pares (i, i + 1) com i no trecho, inclusive o par que cruza para o próximo trecho
+    long fimPares = t->fim < t->n - 1 ? t->fim : t->n - 1;
+    long descidas = 0, subidas = 0;
+    for (long i = t->inicio; i < fimPares; i++) {
+        descidas += A[i] > A[i + 1];
+        subidas += A[i] < A[i + 1];
+    }
+
+    // Corridas naturais como no TimSort: não decrescentes ou estritamente decrescentes
+    long corridas = 0;
+    long i = t->inicio;
+    while (i < t->fim) {
+        long j = i + 1;
+        if (j < t->fim) {
+            if (A[j] < A[i]) {
+                while (j + 1 < t->fim && A[j + 1] < A[j]) {
+                    j++;
+                }
+            } else {
+                while (j + 1 < t->fim && A[j + 1] >= A[j]) {
+                    j++;
+                }
+            }
+        }
+        corridas++;
+        i = j + 1;
+    }
+
+    t->descidas = descidas;
+    t->subidas = subidas;
+    t->corridas = corridas;
+}
+
+// Função para estimar a fração de pares invertidos por amostragem (sequência fixa)
+static double estimarInversoes(const int *A, long n) {
+    if (n < 2) {
+        return 0.0;
+    }
+
+    unsigned long long estado = 0x9E3779B97F4A7C15ull;
+    long invertidos = 0, validos = 0;
+    for (int k = 0; k < PREORDENACAO_AMOSTRAS; k++) {
+        estado = estado * 6364136223846793005ull + 1442695040888963407ull;
+        long i = (long)((estado >> 33) % (unsigned long long)n);
+        estado = estado * 6364136223846793005ull + 1442695040888963407ull;
+        long j = (long)((estado >> 33) % (unsigned long long)n);
+        if (i == j) {
+            continue;
+        }
+        if (i > j) {
+            long t = i;
+            i = j;
+            j = t;
+        }
+        invertidos += A[i] > A[j];
+        validos++;
+    }
+    return validos ? (double)invertidos / validos : 0.0;
+}
+
+// Mede as métricas de pré-ordenação
+void medirPreordenacao(const int *vetor, long n, PoolThreads *pool, MetricasPreordenacao *metricas) {
+    memset(metricas, 0, sizeof(*metricas));
+    metricas->n = n;
+    if (n <= 0) {
+        return;
+    }
+
+    // Um trecho por trabalhador, sem trechos pequenos demais
+    long numTrechos = numTrechosPool(pool, 0, n, PREORDENACAO_MIN_ELEMENTOS_TRECHO, PREORDENACAO_MAX_TRECHOS);
+
+    TrechoPreordenacao trechos[PREORDENACAO_MAX_TRECHOS];
+    long tamanhoTrecho = n / numTrechos;
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].vetor = vetor;
+        trechos[t].n = n;
+        trechos[t].inicio = t * tamanhoTrecho;
+        trechos[t].fim = t == numTrechos - 1 ? n : (t + 1) * tamanhoTrecho;
+    }
+
+    if (numTrechos == 1) {
+        medirTrecho(&trechos[0]);
+    } else {
+        GrupoTarefas grupo;
+        iniciarGrupoTarefas(&grupo);
+        for (long t = 0; t < numTrechos; t++) {
+            submeterTarefa(pool, &grupo, -1, medirTrecho, &trechos[t]);
+        }
+        aguardarGrupoTarefas(pool, &grupo);
+    }
+
+    for (long t = 0; t < numTrechos; t++) {
+        metricas->descidas += trechos[t].descidas;
+        metricas->subidas += trechos[t].subidas;
+        metricas->corridas += trechos[t].corridas;
+    }
+    metricas->fracaoInversoes = estimarInversoes(vetor, n);
+}
+
+// Escolhe a estratégia a partir das métricas
+EstrategiaPreordenacao escolherEstrategiaPreordenacao(MetricasPreordenacao *metricas) {
+    if (metricas->descidas == 0) {
+        metricas->estrategia = PREORDENACAO_JA_ORDENADO;
+    } else if (metricas->subidas == 0) {
+        metricas->estrategia = PREORDENACAO_INVERTIDO;
+    } else if (metricas->n / metricas->corridas >= PREORDENACAO_CORRIDA_MEDIA_MIN) {
+        metricas->estrategia = PREORDENACAO_CORRIDAS;
+    } else {
+        metricas->estrategia = PREORDENACAO_ALGORITMO;
+    }
+    return metricas->estrategia;
+}
+
+// Retorna o nome da estratégia
+const char *nomeEstrategiaPreordenacao(EstrategiaPreordenacao estrategia) {
+    switch (estrategia) {
+        case PREORDENACAO_JA_ORDENADO: return "ja-ordenado";
+        case PREORDENACAO_INVERTIDO:   return "invertido";
+        case PREORDENACAO_CORRIDAS:    return "corridas";
+        default:                       return "algoritmo";
+    }
+}
+
+// Imprime as métricas e a estratégia escolhida
+void imprimirPreordenacao(FILE *saida, const MetricasPreordenacao *metricas) {
+    fprintf(saida, "Pré-ordenação: %ld descidas, %ld subidas, %ld corridas, %.1f%% de inversões -> %s\n",
+            metricas->descidas, metricas->subidas, metricas->corridas, 100.0 * metricas->fracaoInversoes,
+            nomeEstrategiaPreordenacao(metricas->estrategia));
+}
+
+// Inverte o vetor no lugar
+void inverterVetor(int *vetor, long n) {
+    for (long i = 0, j = n - 1; i < j; i++, j--) {
+        int temp = vetor[i];
+        vetor[i] = vetor[j];
+        vetor[j] = temp;
+    }
+}
+
+// Função para calcular o tamanho mínimo das corridas (entre 32 e 64, como no TimSort)
+static long tamanhoMinimoCorrida(long n) {
+    long resto = 0;
+    while (n >= 64) {
+        resto |= n & 1;
+        n >>= 1;
+    }
+    return n + resto;
+}
+
+// Função para encontrar a corrida que começa em inicio; as decrescentes são invertidas.
+// Retorna o fim (exclusivo) da corrida.
+static long encontrarCorrida(int *A, long inicio, long n) {
+    long fim = inicio + 1;
+    if (fim == n) {
+        return fim;
+    }
+    if (A[fim] < A[inicio]) {
+        while (fim + 1 < n && A[fim + 1] < A[fim]) {
+            fim++;
+        }
+        fim++;
+        inverterVetor(A + inicio, fim - inicio);
+    } else {
+        while (fim + 1 < n && A[fim + 1] >= A[fim]) {
+            fim++;
+        }
+        fim++;
+    }
+    return fim;
+}
+
+// Função para estender por inserção a parte ordenada [inicio, ordenado) até fim
+static void estenderPorInsercao(int *A, long inicio, long ordenado, long fim) {
+    for (long i = ordenado; i < fim; i++) {
+        int valor = A[i];
+        long j = i - 1;
+        while (j >= inicio && A[j] > valor) {
+            A[j + 1] = A[j];
+            j--;
+        }
+        A[j + 1] = valor;
+    }
+}
+
+// Função para encontrar a primeira posição de A[0..n) com valor maior que x
+static long primeiroMaior(const int *A, long n, int x) {
+    long lo = 0, hi = n;
+    while (lo < hi) {
+        long meio = lo + (hi - lo) / 2;
+        if (A[meio] <= x) {
+            lo = meio + 1;
+        } else {
+            hi = meio;
+        }
+    }
+    return lo;
+}
+
+// Função para encontrar a primeira posição de A[0..n) com valor maior ou igual a x
+static long primeiroMaiorOuIgual(const int *A, long n, int x) {
+    long lo = 0, hi = n;
+    while (lo < hi) {
+        long meio = lo + (hi - lo) / 2;
+        if (A[meio] < x) {
+            lo = meio + 1;
+        } else {
+            hi = meio;
+        }
+    }
+    return lo;
+}
+
+// Função para mesclar as corridas vizinhas a = [base, base + lenA) e b = [base + lenA, base + lenA + lenB)
+static void mesclarCorridas(int *A, long base, long lenA, long lenB, int *temp) {
+    int *a = A + base;
+    int *b = a + lenA;
+
+    // Elementos de a menores ou iguais ao primeiro de b e elementos de b maiores ou iguais
+    // ao último de a já estão no lugar
+    long k = primeiroMaior(a, lenA, b[0]);
+    a += k;
+    lenA -= k;
+    if (lenA == 0) {
+        return;
+    }
+    lenB = primeiroMaiorOuIgual(b, lenB, a[lenA - 1]);
+    if (lenB == 0) {
+        return;
+    }
+
+    if (lenA <= lenB) {
+        // Copiar a para o buffer e mesclar do início para o fim
+        memcpy(temp, a, (size_t)lenA * sizeof(int));
+        long i = 0, j = 0, d = 0;
+        while (i < lenA && j < lenB) {
+            a[d++] = b[j] < temp[i] ? b[j++] : temp[i++];
+        }
+        memcpy(a + d, temp + i, (size_t)(lenA - i) * sizeof(int));
+    } else {
+        // Copiar b para o buffer e mesclar do fim para o início
+        memcpy(temp, b, (size_t)lenB * sizeof(int));
+        long i = lenA - 1, j = lenB - 1, d = lenA + lenB - 1;
+        while (i >= 0 && j >= 0) {
+            a[d--] = a[i] > temp[j] ? a[i--] : temp[j--];
+        }
+        memcpy(a, temp, (size_t)(j + 1) * sizeof(int));
+    }
+}
+
+// Ordena o vetor mesclando as corridas naturais
+int ordenarCorridas(int *vetor, long n) {
+    if (n < 2) {
+        return 0;
+    }
+
+    // A menor corrida de cada mesclagem vai para o buffer: no máximo n / 2 elementos
+    int *temp = (int *)obterBufferTemporario((size_t)(n / 2 + 1) * sizeof(int));
+    if (!temp) {
+        printf("Erro: Falha na alocação de memória para mesclar as corridas.\n");
+        return -1;
+    }
+
+    long minimo = tamanhoMinimoCorrida(n);
+    long base[CORRIDAS_MAX_PILHA], tamanho[CORRIDAS_MAX_PILHA];
+    int topo = 0;
+
+    long inicio = 0;
+    while (inicio < n) {
+        // Encontrar a próxima corrida e estendê-la até o tamanho mínimo
+        long fim = encontrarCorrida(vetor, inicio, n);
+        if (fim - inicio < minimo) {
+            long fimEstendido = inicio + minimo < n ? inicio + minimo : n;
+            estenderPorInsercao(vetor, inicio, fim, fimEstendido);
+            fim = fimEstendido;
+        }
+        base[topo] = inicio;
+        tamanho[topo] = fim - inicio;
+        topo++;
+        inicio = fim;
+
+        // Manter as regras da pilha do TimSort: X > Y + Z e Y > Z para as três do topo
+        while (topo > 1) {
+            int m = topo - 2;
+            if ((m > 0 && tamanho[m - 1] <= tamanho[m] + tamanho[m + 1]) ||
+                (m > 1 && tamanho[m - 2] <= tamanho[m - 1] + tamanho[m])) {
+                if (tamanho[m - 1] < tamanho[m + 1]) {
+                    m--;
+                }
+            } else if (tamanho[m] > tamanho[m + 1]) {
+                break;
+            }
+            mesclarCorridas(vetor, base[m], tamanho[m], tamanho[m + 1], temp);
+            tamanho[m] += tamanho[m + 1];
+            for (int k = m + 1; k < topo - 1; k++) {
+                base[k] = base[k + 1];
+                tamanho[k] = tamanho[k + 1];
+            }
+            topo--;
+        }
+    }
+
+    // Mesclar as corridas restantes
+    while (topo > 1) {
+        int m = topo - 2;
+        if (m > 0 && tamanho[m - 1] < tamanho[m + 1]) {
+            m--;
+        }
+        mesclarCorridas(vetor, base[m], tamanho[m], tamanho[m + 1], temp);
+        tamanho[m] += tamanho[m + 1];
+        for (int k = m + 1; k < topo - 1; k++) {
+            base[k] = base[k + 1];
+            tamanho[k] = tamanho[k + 1];
+        }
+        topo--;
+    }
+
+    devolverBufferTemporario(temp);
+    return 0;
+}
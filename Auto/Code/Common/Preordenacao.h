@@ -0,0 +1,70 @@
+#ifndef PREORDENACAO_H
+#define PREORDENACAO_H
+
+#include <stdio.h>
+#include "PoolThreads.h"
+
+/*
+ * Detecção de pré-ordenação: uma passada linear, dividida entre os trabalhadores do pool,
+ * mede quanto do vetor já está ordenado antes de escolher como ordená-lo.
+ *
+ * - descidas: pares vizinhos fora de ordem (A[i] > A[i + 1]);
+ * - subidas: pares vizinhos em ordem estrita (A[i] < A[i + 1]);
+ * - corridas: corridas naturais como no TimSort (trechos não decrescentes ou estritamente
+ *   decrescentes), contadas por trecho do vetor (um trecho por trabalhador);
+ * - fracaoInversoes: fração estimada de pares (i < j) com A[i] > A[j], a partir de uma
+ *   amostra fixa de PREORDENACAO_AMOSTRAS pares (0 = ordenado, 0,5 = aleatório,
+ *   1 = invertido).
+ *
+ * A partir das métricas, escolherEstrategiaPreordenacao decide entre retornar sem ordenar
+ * (vetor já ordenado), apenas inverter o vetor (nenhuma subida), mesclar as corridas
+ * naturais (corridas longas em média) ou usar o algoritmo pedido.
+ *
+ * ordenarCorridas é a mesclagem de corridas naturais: as corridas decrescentes são
+ * invertidas no lugar, as curtas são estendidas por inserção até o tamanho mínimo e as
+ * corridas são mescladas com as regras de pilha do TimSort. Antes de cada mesclagem, os
+ * elementos que já estão no lugar (início da primeira corrida e fim da segunda) são
+ * descartados por busca binária, de forma que corridas já em ordem custam O(log n).
+ */
+
+#define PREORDENACAO_AMOSTRAS          4096 // Pares sorteados para estimar as inversões
+#define PREORDENACAO_CORRIDA_MEDIA_MIN 32   // Tamanho médio das corridas para mesclá-las
+#define PREORDENACAO_MIN_ELEMENTOS_TRECHO 65536 // Elementos mínimos por trecho da medição
+
+// Como o vetor será ordenado
+typedef enum {
+    PREORDENACAO_ALGORITMO = 0, // Algoritmo pedido nas opções
+    PREORDENACAO_JA_ORDENADO,   // Nada a fazer
+    PREORDENACAO_INVERTIDO,     // Inverter o vetor no lugar
+    PREORDENACAO_CORRIDAS       // Mesclar as corridas naturais
+} EstrategiaPreordenacao;
+
+// Métricas medidas antes da ordenação
+typedef struct {
+    long n;
+    long descidas;
+    long subidas;
+    long corridas;
+    double fracaoInversoes;
+    EstrategiaPreordenacao estrategia;
+} MetricasPreordenacao;
+
+// Mede as métricas de pré-ordenação; com pool, a passada é dividida entre os trabalhadores
+void medirPreordenacao(const int *vetor, long n, PoolThreads *pool, MetricasPreordenacao *metricas);
+
+// Escolhe a estratégia a partir das métricas (e a guarda em metricas->estrategia)
+EstrategiaPreordenacao escolherEstrategiaPreordenacao(MetricasPreordenacao *metricas);
+
+// Retorna o nome da estratégia ("algoritmo", "ja-ordenado", "invertido" ou "corridas")
+const char *nomeEstrategiaPreordenacao(EstrategiaPreordenacao estrategia);
+
+// Imprime as métricas e a estratégia escolhida
+void imprimirPreordenacao(FILE *saida, const MetricasPreordenacao *metricas);
+
+// Inverte o vetor no lugar
+void inverterVetor(int *vetor, long n);
+
+// Ordena o vetor mesclando as corridas naturais; retorna 0 em caso de sucesso
+int ordenarCorridas(int *vetor, long n);
+
+#endif
@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include "Registro.h"
+
+// Função para garantir que o diretório "Data" e o arquivo de log existam
+void garantirDiretorioEArquivo(const char *arquivoLog) {
+    struct stat st = {0};
+
+    // Criar o diretório Data, se não existir
+    if (stat("Data", &st) == -1) {
+        mkdir("Data", 0700);  // Cria o diretório com permissão 0700
+    }
+
+    // Abrir o arquivo de log para verificar a primeira linha
+    FILE *arquivo = fopen(arquivoLog, "r+");
+    if (!arquivo) {
+        // Se o arquivo não existir, criá-lo e adicionar o cabeçalho
+        arquivo = fopen(arquivoLog, "w");
+        if (!arquivo) {
+            perror("Erro ao abrir o arquivo de log");
+            exit(1);
+        }
+        // Adicionar a linha de cabeçalho
+        fprintf(arquivo, "Programa,Tempo,Comprimento,Threads\n");
+        fclose(arquivo); // Fechar após escrever o cabeçalho
+    } else {
+        // Arquivo existe, verificar a primeira linha
+        char linha[256];
+        if (fgets(linha, sizeof(linha), arquivo)) {
+            // Verificar se a primeira linha é o cabeçalho esperado
+            if (linha[0] != 'T' || linha[1] != 'e' || linha[2] != 'm' || linha[3] != 'p' || linha[4] != 'o') {
+                // Se não for, adicionar o cabeçalho
+                fseek(arquivo, 0, SEEK_SET);  // Voltar para o início do arquivo
+                fprintf(arquivo, "Programa,Tempo,Comprimento,Threads\n");
+            }
+        }
+        fclose(arquivo); // Fechar o arquivo após verificação
+    }
+}
+
+// Função para abrir o arquivo de log (já com cabeçalho) para acréscimo
+FILE *abrirArquivoRegistro(const char *arquivoLog) {
+    garantirDiretorioEArquivo(arquivoLog);
+
+    FILE *arquivo = fopen(arquivoLog, "a");
+    if (!arquivo) {
+        perror("Erro ao abrir o arquivo de log");
+    }
+    return arquivo;
+}
+
+// Função para acrescentar uma linha a um arquivo de log aberto
+void registrarTempo(FILE *arquivo, const char *programa, double tempoGasto, int comprimentoA, int numThreads) {
+    if (numThreads > 0) {
+        fprintf(arquivo, "%s,%f,%d,%d\n", programa, tempoGasto, comprimentoA, numThreads);
+    } else {
+        fprintf(arquivo, "%s,%f,%d,\n", programa, tempoGasto, comprimentoA);
+    }
+    fflush(arquivo);
+}
+
+// Função para registrar o tempo (e o número de threads) no arquivo de log
+void registrarTempoNoArquivo(const char *arquivoLog, const char *programa, double tempoGasto,
+                             int comprimentoA, int numThreads) {
+    FILE *arquivo = fopen(arquivoLog, "a");
+    if (!arquivo) {
+        perror("Erro ao abrir o arquivo de log");
+        exit(1);
+    }
+
+    // Adicionar a linha de log no arquivo
+    registrarTempo(arquivo, programa, tempoGasto, comprimentoA, numThreads);
+    fclose(arquivo);
+}
+
+// Função para registrar o tempo e as métricas de pré-ordenação
+void registrarPreordenacao(const char *programa, double tempoGasto, int comprimentoA, int numThreads,
+                           const MetricasPreordenacao *metricas) {
+    struct stat st = {0};
+    if (stat("Data", &st) == -1) {
+        mkdir("Data", 0700);
+    }
+
+    // O cabeçalho é escrito quando o arquivo ainda está vazio
+    FILE *arquivo = fopen(REGISTRO_PREORDENACAO, "a");
+    if (!arquivo) {
+        perror("Erro ao abrir o arquivo de pré-ordenação");
+        return;
+    }
+    if (ftell(arquivo) == 0) {
+        fprintf(arquivo, "Programa,Tempo,Comprimento,Threads,Descidas,Subidas,Corridas,FracaoInversoes,Estrategia\n");
+    }
+
+    fprintf(arquivo, "%s,%f,%d,", programa, tempoGasto, comprimentoA);
+    if (numThreads > 0) {
+        fprintf(arquivo, "%d", numThreads);
+    }
+    fprintf(arquivo, ",%ld,%ld,%ld,%f,%s\n", metricas->descidas, metricas->subidas, metricas->corridas,
+            metricas->fracaoInversoes, nomeEstrategiaPreordenacao(metricas->estrategia));
+    fclose(arquivo);
+}
+
+// Função para registrar o plano do despacho automático e os tempos previsto e real
+void registrarDespacho(const char *programa, double tempoGasto, double tempoPerfil, const PerfilEntrada *perfil,
+                       const PlanoOrdenacao *plano) {
+    struct stat st = {0};
+    if (stat("Data", &st) == -1) {
+        mkdir("Data", 0700);
+    }
+
+    // O cabeçalho é escrito quando o arquivo ainda está vazio
+    FILE *arquivo = fopen(REGISTRO_DESPACHO, "a");
+    if (!arquivo) {
+        perror("Erro ao abrir o arquivo do despacho");
+        return;
+    }
+    if (ftell(arquivo) == 0) {
+        fprintf(arquivo, "Programa,Tempo,Comprimento,Threads,Plano,Previsto,TempoPerfil,Minimo,Maximo,"
+                "FracaoDuplicatas,DistintasEstimadas,Corridas,FracaoInversoes\n");
+    }
+
+    fprintf(arquivo, "%s,%f,%ld,%d,%s,%f,%f,%d,%d,%f,%.0f,%ld,%f\n", programa, tempoGasto, perfil->n,
+            plano->numThreads, nomePlano(plano), plano->tempoPrevisto, tempoPerfil, perfil->minimo,
+            perfil->maximo, perfil->fracaoDuplicatas, perfil->distintasEstimadas, perfil->preordenacao.corridas,
+            perfil->preordenacao.fracaoInversoes);
+    fclose(arquivo);
+}
+
+// Função para registrar o tempo, a largura das chaves e as fases da compactação
+void registrarCompactacao(const char *programa, double tempoGasto, int comprimentoA, int numThreads,
+                          const MetricasCompactacao *metricas) {
+    struct stat st = {0};
+    if (stat("Data", &st) == -1) {
+        mkdir("Data", 0700);
+    }
+
+    // O cabeçalho é escrito quando o arquivo ainda está vazio
+    FILE *arquivo = fopen(REGISTRO_COMPACTACAO, "a");
+    if (!arquivo) {
+        perror("Erro ao abrir o arquivo da compactação");
+        return;
+    }
+    if (ftell(arquivo) == 0) {
+        fprintf(arquivo, "Programa,Tempo,Comprimento,Threads,Largura,Passadas,TempoDeteccao,TempoCompactacao,"
+                "TempoOrdenacao,TempoExpansao\n");
+    }
+
+    fprintf(arquivo, "%s,%f,%d,", programa, tempoGasto, comprimentoA);
+    if (numThreads > 0) {
+        fprintf(arquivo, "%d", numThreads);
+    }
+    fprintf(arquivo, ",%d,%d,%f,%f,%f,%f\n", metricas->largura, metricas->passadas, metricas->tempoDeteccao,
+            metricas->tempoCompactacao, metricas->tempoOrdenacao, metricas->tempoExpansao);
+    fclose(arquivo);
+}
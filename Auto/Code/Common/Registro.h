@@ -0,0 +1,61 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+/*
+ * Registro dos tempos de execução em Data/<programa>.txt.
+ *
+ * Cada arquivo começa com o cabeçalho "Programa,Tempo,Comprimento,Threads" e recebe uma
+ * linha por execução. Os arquivos são concatenados pelo GerarCSV.
+ *
+ * Processos que registram muitas execuções (serviço de ordenação, modo em lote) mantêm o
+ * arquivo aberto com abrirArquivoRegistro e usam registrarTempo.
+ *
+ * Com --preordenacao, as métricas medidas antes da ordenação são registradas, junto com o
+ * tempo, em REGISTRO_PREORDENACAO, que tem colunas próprias. Da mesma forma, o despacho
+ * automático (Ordenar) registra o plano escolhido e o tempo previsto em REGISTRO_DESPACHO, e
+ * --compactar registra a largura das chaves e o tempo de cada fase em REGISTRO_COMPACTACAO.
+ */
+
+#include <stdio.h>
+#include "Despacho.h"
+#include "Preordenacao.h"
+#include "Compactacao.h"
+
+// Arquivo das métricas de pré-ordenação (não entra no GerarCSV, que junta apenas os .txt)
+#define REGISTRO_PREORDENACAO "Data/preordenacao.csv"
+
+// Arquivo dos planos do despacho automático (também fora do GerarCSV)
+#define REGISTRO_DESPACHO "Data/despacho.csv"
+
+// Arquivo das fases da compactação das chaves (também fora do GerarCSV)
+#define REGISTRO_COMPACTACAO "Data/compactacao.csv"
+
+// Garante que o diretório "Data" e o arquivo de log (ex.: "Data/conc_quicksort.txt") existam
+void garantirDiretorioEArquivo(const char *arquivoLog);
+
+// Acrescenta uma linha ao arquivo de log. Com numThreads <= 0 (algoritmos sequenciais),
+// a coluna Threads fica vazia.
+void registrarTempoNoArquivo(const char *arquivoLog, const char *programa, double tempoGasto,
+                             int comprimentoA, int numThreads);
+
+// Garante o diretório e o cabeçalho e abre o arquivo de log para acréscimo; retorna NULL em caso de erro
+FILE *abrirArquivoRegistro(const char *arquivoLog);
+
+// Acrescenta uma linha a um arquivo de log já aberto (e descarrega o buffer)
+void registrarTempo(FILE *arquivo, const char *programa, double tempoGasto, int comprimentoA, int numThreads);
+
+// Acrescenta a REGISTRO_PREORDENACAO uma linha com o tempo e as métricas de pré-ordenação
+void registrarPreordenacao(const char *programa, double tempoGasto, int comprimentoA, int numThreads,
+                           const MetricasPreordenacao *metricas);
+
+// Acrescenta a REGISTRO_DESPACHO uma linha com o perfil da entrada, o plano, o tempo
+// previsto, o tempo real da ordenação e o tempo gasto no perfil
+void registrarDespacho(const char *programa, double tempoGasto, double tempoPerfil, const PerfilEntrada *perfil,
+                       const PlanoOrdenacao *plano);
+
+// Acrescenta a REGISTRO_COMPACTACAO uma linha com o tempo, a largura das chaves e o tempo de
+// cada fase da compactação
+void registrarCompactacao(const char *programa, double tempoGasto, int comprimentoA, int numThreads,
+                          const MetricasCompactacao *metricas);
+
+#endif
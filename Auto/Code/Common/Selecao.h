@@ -0,0 +1,110 @@
+#ifndef SELECAO_H
+#define SELECAO_H
+
+#include <stdio.h>
+#include "EntradaSaida.h"
+#include "PoolThreads.h"
+
+/*
+ * Seleção (quickselect) da biblioteca libconcsort: o k-ésimo menor elemento, os k menores
+ * ou os k maiores de um vetor em O(n), sem ordenar o vetor inteiro.
+ *
+ * A seleção sequencial é a recursão do Quicksort em apenas um dos lados: a partição de
+ * Hoare (particionar, de Common/Ordenacao.h), com o pivô na mediana de três, repetida na
+ * parte que contém a posição k, até sobrarem poucos elementos, ordenados por inserção.
+ *
+ * Em vetores grandes, cada rodada da seleção concorrente sorteia uma amostra de
+ * SELECAO_AMOSTRA chaves, ordena a amostra e escolhe dois pivôs em volta da posição
+ * proporcional a k na amostra (como no algoritmo de Floyd e Rivest). Os trabalhadores
+ * contam, cada um no seu trecho, as chaves menores que o primeiro pivô, entre os pivôs e
+ * maiores que o segundo, e depois distribuem as três faixas em um buffer auxiliar, de
+ * volta para o vetor. Quase sempre k cai na faixa do meio, com cerca de
+ * 2 * SELECAO_FOLGA / SELECAO_AMOSTRA das chaves, em que a seleção continua; as demais
+ * faixas não são mais tocadas. O custo total é linear.
+ *
+ * Para entradas maiores que a memória, HeapLimitado mantém os k menores (ou maiores)
+ * valores vistos em um heap de k posições, alimentado por blocos lidos do arquivo: uma
+ * única passada, O(n log k), com memória proporcional a k.
+ *
+ * executarSelecao é o modo de seleção dos programas (--topk K, --nth K ou --percentile P,
+ * com --maiores para contar a partir do maior elemento e --fluxo para forçar a leitura em
+ * blocos): em vez de ordenar, grava apenas os K menores em ordem, ou o elemento pedido.
+ */
+
+#define SELECAO_MIN_PARALELO          (1L << 18) // Faixas menores seguem na seleção sequencial
+#define SELECAO_AMOSTRA               4096       // Chaves sorteadas em cada rodada concorrente
+#define SELECAO_FOLGA                 96         // Posições da amostra entre k e cada pivô
+#define SELECAO_LIMITE_INSERCAO       16         // Faixas com até esse tamanho são ordenadas por inserção
+#define SELECAO_MIN_ELEMENTOS_TRECHO  65536
+#define SELECAO_MAX_TRECHOS           256
+
+// Coloca em vetor[k] o elemento que estaria nessa posição no vetor ordenado, com
+// vetor[0..k) <= vetor[k] <= vetor(k..n); com pool, a seleção usa até numThreads
+// trabalhadores (0 = todos). Retorna 0 em caso de sucesso e -1 em caso de erro.
+int selecionarI32(int *vetor, long n, long k, PoolThreads *pool, int numThreads);
+
+// Coloca em vetor[0..k) os k menores elementos em ordem crescente (ou, com maiores, os k
+// maiores em ordem decrescente); o restante do vetor fica em ordem qualquer. Retorna 0 em
+// caso de sucesso e -1 em caso de erro.
+int topkI32(int *vetor, long n, long k, int maiores, PoolThreads *pool, int numThreads);
+
+// Heap com os k menores (ou maiores) valores vistos até o momento
+typedef struct {
+    int *valores;
+    long tamanho;
+    long capacidade;
+    int maiores;   // 1 = guarda os maiores (heap de mínimo); 0 = os menores (heap de máximo)
+} HeapLimitado;
+
+// Prepara um heap vazio de capacidade valores; retorna -1 se faltar memória
+int iniciarHeapLimitado(HeapLimitado *heap, long capacidade, int maiores);
+
+// Considera os quantidade valores (por exemplo, um bloco lido do arquivo)
+void inserirHeapLimitado(HeapLimitado *heap, const int *valores, long quantidade);
+
+// Ordena o conteúdo do heap em heap->valores[0..tamanho): crescente com os menores e
+// decrescente com os maiores (o heap não pode mais receber valores)
+void finalizarHeapLimitado(HeapLimitado *heap);
+
+// Libera o heap
+void liberarHeapLimitado(HeapLimitado *heap);
+
+// Modos de seleção do ConcQuickSort
+typedef enum {
+    SELECAO_NENHUMA = 0, // Ordenação completa
+    SELECAO_TOPK,        // Os k menores (ou maiores), em ordem
+    SELECAO_NTH,         // O k-ésimo menor (ou maior) elemento
+    SELECAO_PERCENTIL    // O percentil p (posição pelo método do posto mais próximo)
+} ModoSelecao;
+
+// Opções de seleção do ConcQuickSort
+typedef struct {
+    ModoSelecao modo;
+    long k;          // --topk e --nth (a partir de 1)
+    double percentil; // --percentile, de 0 a 100
+    int maiores;     // 1 = contar a partir do maior elemento (--maiores)
+    int fluxo;       // 1 = ler o arquivo em blocos com o heap limitado (--fluxo)
+} OpcoesSelecao;
+
+// Extrai de argv as opções de seleção (--topk, --nth, --percentile, --maiores, --fluxo),
+// deixando as demais para extrairOpcoes; retorna o novo argc ou -1
+int extrairOpcoesSelecao(int argc, char *argv[], OpcoesSelecao *opcoes);
+
+// Imprime a lista de opções de seleção
+void imprimirOpcoesSelecao(FILE *saida);
+
+// Retorna a posição (a partir de 0, no vetor em ordem crescente) do elemento pedido por
+// --nth ou --percentile em um vetor de n elementos, ou -1 se ela não existir
+long posicaoSelecao(const OpcoesSelecao *opcoes, long n);
+
+// Executa a seleção pedida sobre o arquivo binário arquivoEntrada e grava em arquivoSaida
+// os valores selecionados (os k em ordem, ou apenas o elemento da posição pedida). Entradas
+// que não cabem na memória (ou com fluxo) são lidas em blocos pelo heap limitado; as demais
+// são lidas inteiras e selecionadas com até maxThreads trabalhadores do pool. O tempo é
+// registrado em arquivoLog com o nome programa. Retorna 0 em caso de sucesso e -1 em caso
+// de erro.
+int executarSelecao(const char *arquivoEntrada, const char *arquivoSaida, const OpcoesSelecao *selecao,
+                    const ConfiguracaoES *config, PoolThreads *pool, int maxThreads, const char *arquivoLog,
+                    const char *programa);
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef SERVICO_H
+#define SERVICO_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "Ordenacao.h"
+
+/*
+ * Protocolo do serviço de ordenação (ServidorOrdenacao/ClienteOrdenacao).
+ *
+ * O servidor fica em execução com o pool de threads e os buffers temporários já
+ * aquecidos, escutando em um socket Unix. O cliente coloca o vetor em um memfd e envia,
+ * em uma única mensagem, um PedidoOrdenacao e o descritor do memfd (SCM_RIGHTS). O
+ * servidor mapeia o mesmo memfd, ordena o vetor no lugar (sem cópias) e responde com uma
+ * RespostaOrdenacao. Uma conexão pode enviar vários pedidos em sequência.
+ *
+ * O memfd contém apenas os n valores (sem o cabeçalho dos arquivos binários). Antes do
+ * envio, o cliente sela o tamanho do memfd (F_SEAL_SHRINK e F_SEAL_GROW); o servidor recusa
+ * memfds sem esses selos, pois um memfd reduzido depois de mapeado derrubaria o servidor
+ * com SIGBUS ao ser acessado.
+ */
+
+#define SERVICO_SOCKET_PADRAO "/tmp/concsort.sock"
+#define SERVICO_MAGIA         0x434f4e43u // "CONC"
+#define SERVICO_VERSAO        2
+
+// Valores padrão do controle de admissão e das arenas do servidor
+#define SERVICO_MAX_TAREFAS_PADRAO 2  // Ordenações executadas ao mesmo tempo
+#define SERVICO_FILA_PADRAO        16 // Pedidos aguardando; além disso, SERVICO_OCUPADO
+#define SERVICO_ARENA_PADRAO_MB    64 // Tamanho de cada arena temporária pré-tocada
+
+// Situação devolvida na resposta
+typedef enum {
+    SERVICO_OK = 0,
+    SERVICO_OCUPADO,         // Fila cheia (controle de admissão)
+    SERVICO_PEDIDO_INVALIDO, // Cabeçalho, algoritmo ou memfd inválidos
+    SERVICO_ERRO             // Falha durante a ordenação
+} StatusServico;
+
+// Pedido enviado pelo cliente (acompanhado do descritor do memfd)
+typedef struct {
+    uint32_t magia;
+    uint32_t versao;
+    int32_t algoritmo;  // AlgoritmoOrdenacao
+    int32_t numThreads; // Segmentos do MinMaxSort concorrente (0 = tamanho do pool, que também é o limite)
+    int64_t n;          // Número de elementos no memfd
+} PedidoOrdenacao;
+
+// Resposta do servidor
+typedef struct {
+    int32_t status;        // StatusServico
+    int32_t reservado;
+    double tempoOrdenacao; // Segundos ordenando
+    double tempoEspera;    // Segundos aguardando na fila de admissão
+    int64_t memoriaExtra;  // Pico de memória extra da ordenação em bytes (-1 = não medido)
+} RespostaOrdenacao;
+
+// Programa que extrai as opções do serviço
+typedef enum {
+    SERVICO_CLIENTE = 0,
+    SERVICO_SERVIDOR
+} PapelServico;
+
+// Opções próprias do servidor e do cliente
+typedef struct {
+    const char *socket;            // Caminho do socket Unix
+    AlgoritmoOrdenacao algoritmo;  // Cliente: algoritmo pedido
+    int maxTarefas;                // Servidor: ordenações simultâneas
+    int fila;                      // Servidor: pedidos aguardando admissão
+    long arenaMB;                  // Servidor: tamanho de cada arena pré-tocada
+} OpcoesServico;
+
+// Extrai de argv as opções do serviço (--socket e, conforme o papel, --algoritmo do cliente
+// ou --max-tarefas, --fila e --arena do servidor), deixando as demais para extrairOpcoes;
+// retorna o novo argc ou -1, também quando a opção é do outro papel
+int extrairOpcoesServico(int argc, char *argv[], PapelServico papel, OpcoesServico *opcoes);
+
+// Imprime a lista de opções do serviço aceitas no papel dado
+void imprimirOpcoesServico(FILE *saida, PapelServico papel);
+
+// Retorna a descrição da situação
+const char *descricaoStatusServico(int status);
+
+// Cria o socket do servidor (removendo um socket antigo no mesmo caminho); retorna o
+// descritor ou -1
+int escutarServico(const char *caminho);
+
+// Conecta ao servidor; retorna o descritor ou -1
+int conectarServico(const char *caminho);
+
+// Envia o pedido junto com o descritor fdDados; retorna 0 em caso de sucesso
+int enviarPedido(int sock, const PedidoOrdenacao *pedido, int fdDados);
+
+// Recebe um pedido e o descritor enviado com ele (-1 se não houver); retorna 0 em caso de
+// sucesso, 1 se a conexão foi encerrada e -1 em caso de erro
+int receberPedido(int sock, PedidoOrdenacao *pedido, int *fdDados);
+
+// Envia e recebe a resposta; retornam 0 em caso de sucesso
+int enviarResposta(int sock, const RespostaOrdenacao *resposta);
+int receberResposta(int sock, RespostaOrdenacao *resposta);
+
+// Cria um memfd com espaço para n inteiros e o mapeia; retorna o vetor (e o descritor em
+// *fd) ou NULL
+int *criarVetorCompartilhado(long n, int *fd);
+
+// Sela o tamanho do memfd antes do envio ao servidor; retorna 0 em caso de sucesso
+int selarVetorCompartilhado(int fd);
+
+// Mapeia os n inteiros de um memfd recebido; retorna NULL se o memfd não tiver o tamanho
+// selado ou for menor que isso
+int *mapearVetorCompartilhado(int fd, long n);
+
+// Desfaz o mapeamento de um vetor compartilhado
+void liberarVetorCompartilhado(int *vetor, long n);
+
+#endif
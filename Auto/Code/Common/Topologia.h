@@ -0,0 +1,101 @@
+#ifndef TOPOLOGIA_H
+#define TOPOLOGIA_H
+
+#include <stdio.h>
+#include <pthread.h>
+
+/*
+ * Posicionamento das threads e das páginas em máquinas NUMA.
+ *
+ * A topologia (nós e CPUs de cada nó) é lida de /sys/devices/system/node. Com uma
+ * política de afinidade, a thread de índice i é fixada em uma CPU:
+ *
+ * - compacta: preenche todas as CPUs de um nó antes de passar ao próximo;
+ * - espalhada: alterna entre os nós (thread 0 no nó 0, thread 1 no nó 1, ...).
+ *
+ * O primeiro toque dos vetores grandes é feito em paralelo: o buffer é dividido em tantos
+ * segmentos quanto threads, e cada segmento é tocado (e associado com mbind) pela thread
+ * fixada no nó da thread que vai ordená-lo.
+ *
+ * Para testar em máquinas com um único nó, uma topologia falsa ("NxC": N nós com C CPUs
+ * cada) pode ser informada. Nela as CPUs virtuais são mapeadas nas CPUs reais (módulo o
+ * número de CPUs) e o mbind não é chamado.
+ *
+ * Tudo é feito com chamadas de sistema diretas (sched_setaffinity e mbind), sem libnuma.
+ *
+ * cpusDisponiveis conta as CPUs que o processo pode de fato usar: as da máscara de
+ * afinidade, limitadas pela cota de CPU do cgroup (cpu.max no cgroup v2 ou
+ * cpu.cfs_quota_us / cpu.cfs_period_us no v1), arredondada para cima. Em um contêiner com
+ * cota de 2 CPUs em uma máquina de 64, o resultado é 2.
+ */
+
+#define TOPO_MAX_NOS  64
+#define TOPO_MAX_CPUS 1024
+
+// Políticas de afinidade
+typedef enum {
+    AFINIDADE_NENHUMA = 0, // Threads criadas com os atributos padrão
+    AFINIDADE_COMPACTA,    // Preenche um nó por vez
+    AFINIDADE_ESPALHADA    // Alterna entre os nós
+} PoliticaAfinidade;
+
+// Topologia da máquina (ou topologia falsa)
+typedef struct {
+    int numNos;
+    int numCpus;
+    int cpus[TOPO_MAX_CPUS];        // CPUs ordenadas por nó
+    int inicioNo[TOPO_MAX_NOS + 1]; // Índice em cpus da primeira CPU de cada nó
+    int falsa;                      // 1 se a topologia foi simulada
+} Topologia;
+
+// Plano de posicionamento de uma execução
+typedef struct {
+    Topologia topologia;
+    PoliticaAfinidade politica;
+    int numThreads; // Número de segmentos usados no primeiro toque
+} PlanoNUMA;
+
+// Converte o nome da política ("nenhuma", "compacta" ou "espalhada"); retorna -1 se for inválido
+int politicaAfinidadeDoNome(const char *nome, PoliticaAfinidade *politica);
+
+// Retorna o nome da política
+const char *nomePoliticaAfinidade(PoliticaAfinidade politica);
+
+// Lê a topologia real ou monta a falsa descrita por especificacao ("NxC"); retorna -1 se inválida
+int lerTopologia(Topologia *topologia, const char *especificacao);
+
+// Prepara o plano; retorna -1 se a topologia falsa for inválida
+int iniciarPlanoNUMA(PlanoNUMA *plano, PoliticaAfinidade politica, const char *topologiaFalsa, int numThreads);
+
+// Retorna 1 se o plano fixa threads
+int planoNUMAAtivo(const PlanoNUMA *plano);
+
+// CPU (real) em que a thread de índice indice deve executar
+int cpuDaThread(const PlanoNUMA *plano, int indice);
+
+// Nó da thread de índice indice
+int noDaThread(const PlanoNUMA *plano, int indice);
+
+// Cria uma thread fixada na CPU do índice indice (ou com atributos padrão, sem plano ativo)
+int criarThreadFixada(pthread_t *thread, const PlanoNUMA *plano, int indice,
+                      void *(*funcao)(void *), void *arg);
+
+// Fixa a thread atual na CPU do índice indice
+void fixarThreadAtual(const PlanoNUMA *plano, int indice);
+
+// Faz o primeiro toque do buffer em paralelo, segmento i no nó da thread i
+void distribuirPaginas(const PlanoNUMA *plano, void *buffer, size_t bytes);
+
+// Faz com que os buffers de alocarBuffer (Memoria.h) sejam distribuídos segundo o plano
+void ativarPrimeiroToqueNUMA(const PlanoNUMA *plano);
+
+// Imprime uma linha descrevendo o plano
+void descreverPlanoNUMA(const PlanoNUMA *plano, FILE *saida);
+
+// Retorna o número de CPUs disponíveis ao processo (afinidade e cota do cgroup)
+int cpusDisponiveis(void);
+
+// Lê a cota de CPU do cgroup do processo em *cpus; retorna -1 se não houver cota
+int lerCotaCgroup(double *cpus);
+
+#endif
@@ -0,0 +1,82 @@
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "Common/EntradaSaida.h"
+#include "Common/Memoria.h"
+
+// Descrição: Este programa gera um arquivo de cadeias (ver Common/EntradaSaida.h) para a
+// ordenação de cadeias. Ele recebe o nome do arquivo de saída, o número de cadeias e,
+// opcionalmente, o comprimento máximo (padrão: 16 bytes). Os comprimentos são sorteados
+// entre 0 e o máximo e os bytes são letras minúsculas; metade das cadeias começa por um de
+// PREFIXOS_COMUNS prefixos de 8 letras, para que haja prefixos longos compartilhados e
+// cadeias repetidas, como em chaves e URLs reais.
+
+#define COMPRIMENTO_PADRAO 16
+#define COMPRIMENTO_MAXIMO 4096
+#define PREFIXOS_COMUNS    64
+#define TAMANHO_PREFIXO    8
+
+int main(int argc, char *argv[]) {
+    // Verificar se o número de argumentos está correto
+    if (argc != 3 && argc != 4) {
+        fprintf(stderr, "Uso: %s <arquivo_saida> <num_cadeias> [comprimento_max]\n", argv[0]);
+        return 1;
+    }
+
+    const char *nomeArquivo = argv[1];
+    long n = atol(argv[2]);
+    int comprimentoMax = argc == 4 ? atoi(argv[3]) : COMPRIMENTO_PADRAO;
+    if (n <= 0 || n > 0x7fffffff || comprimentoMax < 0 || comprimentoMax > COMPRIMENTO_MAXIMO) {
+        fprintf(stderr, "Argumentos inválidos: n entre 1 e 2^31 - 1 e comprimento máximo de 0 a %d bytes.\n",
+                COMPRIMENTO_MAXIMO);
+        return 1;
+    }
+
+    srand(time(NULL));
+
+    char prefixos[PREFIXOS_COMUNS][TAMANHO_PREFIXO];
+    for (int p = 0; p < PREFIXOS_COMUNS; p++) {
+        for (int b = 0; b < TAMANHO_PREFIXO; b++) {
+            prefixos[p][b] = (char)('a' + rand() % 26);
+        }
+    }
+
+    // Cada cadeia ocupa no máximo o comprimento e o próprio comprimento
+    size_t capacidade = (size_t)n * (sizeof(uint32_t) + (size_t)comprimentoMax);
+    unsigned char *coluna = (unsigned char *)alocarBuffer(capacidade > 0 ? capacidade : 1);
+    if (!coluna) {
+        fprintf(stderr, "Falha na alocação de memória\n");
+        return 1;
+    }
+
+    size_t bytes = 0;
+    for (long i = 0; i < n; i++) {
+        uint32_t comprimento = (uint32_t)(rand() % (comprimentoMax + 1));
+        memcpy(coluna + bytes, &comprimento, sizeof(comprimento));
+        bytes += sizeof(comprimento);
+
+        uint32_t b = 0;
+        if (rand() % 2 == 0) {
+            const char *prefixo = prefixos[rand() % PREFIXOS_COMUNS];
+            for (; b < comprimento && b < TAMANHO_PREFIXO; b++) {
+                coluna[bytes + b] = (unsigned char)prefixo[b];
+            }
+        }
+        for (; b < comprimento; b++) {
+            coluna[bytes + b] = (unsigned char)('a' + rand() % 26);
+        }
+        bytes += comprimento;
+    }
+
+    ConfiguracaoES config;
+    configuracaoESPadrao(&config);
+    int erro = gravarCadeiasArquivo(nomeArquivo, coluna, bytes, (int)n, &config);
+    if (erro == 0) {
+        printf("%ld cadeias (%zu bytes, até %d por cadeia) salvas em %s\n", n, bytes, comprimentoMax, nomeArquivo);
+    }
+
+    liberarBuffer(coluna);
+    return erro == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "Common/EntradaSaida.h"
+#include "Common/Memoria.h"
+
+// Descrição: Este programa gera um arquivo de registros (ver Common/EntradaSaida.h) para a
+// ordenação de registros. Ele recebe o nome do arquivo de saída, o número de registros, a
+// largura da chave (4 ou 8 bytes) e a largura da carga em bytes. As chaves são sorteadas
+// entre -n/2 e n/2, para que haja chaves repetidas; os primeiros bytes da carga (até 8)
+// guardam a posição original do registro, o que permite ao ValidarResultado verificar se a
+// ordenação foi estável, e os demais bytes são derivados da posição.
+
+int main(int argc, char *argv[]) {
+    // Verificar se o número de argumentos está correto
+    if (argc != 5) {
+        fprintf(stderr, "Uso: %s <arquivo_saida> <num_registros> <largura_chave 4|8> <largura_carga>\n", argv[0]);
+        return 1;
+    }
+
+    const char *nomeArquivo = argv[1];
+    long n = atol(argv[2]);
+    int larguraChave = atoi(argv[3]);
+    int larguraCarga = atoi(argv[4]);
+    if (n <= 0 || n > 0x7fffffff || (larguraChave != 4 && larguraChave != 8) ||
+        larguraCarga < 0 || larguraCarga > ES_CARGA_MAXIMA) {
+        fprintf(stderr, "Argumentos inválidos: n entre 1 e 2^31 - 1, chave de 4 ou 8 bytes e carga de 0 a %d bytes.\n",
+                ES_CARGA_MAXIMA);
+        return 1;
+    }
+
+    srand(time(NULL));
+
+    size_t largura = (size_t)(larguraChave + larguraCarga);
+    unsigned char *registros = (unsigned char *)alocarBuffer((size_t)n * largura);
+    if (!registros) {
+        fprintf(stderr, "Falha na alocação de memória\n");
+        return 1;
+    }
+
+    for (long i = 0; i < n; i++) {
+        unsigned char *registro = registros + (size_t)i * largura;
+        long sorteio = ((long)rand() * RAND_MAX + rand()) % (n + 1) - n / 2;
+        if (larguraChave == 4) {
+            int32_t chave = (int32_t)sorteio;
+            memcpy(registro, &chave, sizeof(chave));
+        } else {
+            // Chaves de 64 bits usam também a parte alta
+            int64_t chave = (int64_t)sorteio * 4294967296LL + (int64_t)(sorteio & 0xFF);
+            memcpy(registro, &chave, sizeof(chave));
+        }
+
+        // Carga: posição original (até 8 bytes) seguida de bytes derivados da posição
+        uint64_t posicao = (uint64_t)i;
+        unsigned char *carga = registro + larguraChave;
+        memcpy(carga, &posicao, larguraCarga < 8 ? (size_t)larguraCarga : sizeof(posicao));
+        for (int b = 8; b < larguraCarga; b++) {
+            carga[b] = (unsigned char)(i * 31 + b);
+        }
+    }
+
+    ConfiguracaoES config;
+    configuracaoESPadrao(&config);
+    int erro = gravarRegistrosArquivo(nomeArquivo, registros, (int)n, larguraChave, larguraCarga, &config);
+    if (erro == 0) {
+        printf("%ld registros (chave de %d bytes, carga de %d bytes) salvos em %s\n", n, larguraChave,
+               larguraCarga, nomeArquivo);
+    }
+
+    liberarBuffer(registros);
+    return erro == 0 ? 0 : 1;
+}
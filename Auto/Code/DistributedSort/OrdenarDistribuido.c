@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Common/Opcoes.h"
+#include "Common/OrdenacaoDistribuida.h"
+#include "Common/Registro.h"
+
+/*
+ * Descrição:
+ * Este programa ordena um vetor binário com vários processos trabalhadores na mesma
+ * máquina, cada um com a sua própria memória e o seu pool de threads, como os nós de um
+ * cluster (ver Common/OrdenacaoDistribuida.h): cada processo lê só a sua fatia da entrada,
+ * os processos combinam os separadores a partir de uma amostra global, trocam as chaves por
+ * sockets Unix, ordenam localmente com o Quicksort concorrente de dois pivôs e gravam
+ * fragmentos ordenados <prefixo_saida>.0, <prefixo_saida>.1, ...
+ *
+ * Os fragmentos são vetores binários comuns (verificáveis pelo ValidarResultado), e a sua
+ * concatenação, na ordem, é o vetor ordenado. São exibidos o tempo e o volume trocado em
+ * cada fase e o tamanho de cada fragmento. O tempo total é registrado em
+ * Data/distribuida.txt, com o número total de threads (processos x threads).
+ */
+
+// Opções comuns implementadas por este programa: só a E/S dos fragmentos (a ordenação local
+// é sempre a mesma e as threads de cada processo não são fixadas)
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO)
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
+    if (argc != 5) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <prefixo_saida> <num_processos> <threads_por_processo> [opções]\n",
+                argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    int numProcessos = atoi(argv[3]);
+    int numThreads = atoi(argv[4]);
+    if (numProcessos <= 0 || numProcessos > DISTRIBUIDA_MAX_PROCESSOS || numThreads <= 0) {
+        fprintf(stderr, "O número de processos deve estar entre 1 e %d e o de threads deve ser positivo.\n",
+                DISTRIBUIDA_MAX_PROCESSOS);
+        return 1;
+    }
+    // Dois pivôs sempre: os separadores repetidos concentram chaves iguais em um fragmento,
+    // e a partição de Lomuto fica quadrática com elas
+    AlgoritmoOrdenacao algoritmo = ORDENACAO_DUPLO_PIVO_CONC;
+
+    // Garantir que o diretório e o arquivo de log existam
+    garantirDiretorioEArquivo("Data/distribuida.txt");
+
+    printf("Processos: %d, threads por processo: %d, ordenação local: %s\n", numProcessos, numThreads,
+           nomeAlgoritmoOrdenacao(algoritmo));
+
+    EstatisticasDistribuida estatisticas;
+    if (ordenarDistribuido(argv[1], argv[2], numProcessos, numThreads, algoritmo, &opcoes.es, &estatisticas) != 0) {
+        return 1;
+    }
+
+    printf("Tamanho do array: %ld\n", estatisticas.n);
+    imprimirEstatisticasDistribuida(stdout, &estatisticas);
+    printf("Tempo de ordenação: %f segundos\n", estatisticas.tempoTotal);
+
+    // Registrar o tempo e o número total de threads no arquivo
+    registrarTempoNoArquivo("Data/distribuida.txt", "OrdenacaoDistribuida", estatisticas.tempoTotal,
+                            (int)estatisticas.n, numProcessos * numThreads);
+
+    printf("Fragmentos ordenados salvos em %s.0 a %s.%d\n", argv[2], argv[2], numProcessos - 1);
+    return 0;
+}
@@ -3,7 +3,10 @@
 #include <unistd.h>
 #include <pthread.h>
 #include <sys/time.h>
-#include <sys/stat.h>
+#include "Common/Lote.h"
+#include "Common/Opcoes.h"
+#include "Common/Ordenacao.h"
+#include "Common/Registro.h"
 
 /*
  * Descrição do programa:
@@ -12,63 +15,44 @@
  * Após a ordenação de cada segmento, os segmentos ordenados são mesclados em um único array ordenado.
  * O programa lê um array de inteiros de um arquivo binário de entrada, ordena o array e salva o resultado em um arquivo binário de saída.
  * O número de threads é fornecido como parâmetro de entrada.
+ * O algoritmo fica em Common/Ordenacao.h (biblioteca libconcsort); os segmentos são
+ * ordenados por um pool com uma thread por segmento.
+ *
+ * Com um backend assíncrono de E/S (--es uring ou pread) ou com a gravação direta
+ * (--es-direto), a mesclagem é feita diretamente sobre o buffer que será gravado e cada
+ * bloco já mesclado é enviado ao disco enquanto o restante da mesclagem continua, sem a
+ * cópia de volta para o array.
+ *
+ * Com --afinidade (ver Common/Topologia.h), a thread de cada segmento é fixada em uma CPU e
+ * as páginas do segmento são tocadas pela primeira vez no nó dessa thread. Com mais de um
+ * nó, a mesclagem é feita em duas etapas: os segmentos de cada nó são mesclados por uma
+ * thread local e só as sequências resultantes (uma por nó) são mescladas entre nós.
+ *
+ * No modo em lote (--entradas ou --manifesto, ver Common/Lote.h), apenas o número de
+ * threads é posicional e todos os arquivos são ordenados com o mesmo pool.
+ *
+ * Com --preordenacao, uma passada linear mede quanto do vetor já está ordenado (ver
+ * Common/Preordenacao.h): vetores já ordenados não são tocados, vetores invertidos são
+ * apenas invertidos e vetores com corridas longas têm as corridas mescladas. As métricas
+ * são registradas em Data/preordenacao.csv.
+ *
+ * Com --compactar, chaves que cabem em 8 ou 16 bits depois de subtrair o mínimo são
+ * compactadas e ordenadas por radix sort (ver Common/Compactacao.h), com o tempo de cada
+ * fase registrado em Data/compactacao.csv.
+ *
+ * Com --argsort <arquivo>, a permutação que ordena a entrada (índices de 32 ou 64 bits,
+ * --indices) também é gravada, em um arquivo de permutação (ver Common/EntradaSaida.h).
+ *
+ * Com --mesclagem, os segmentos do MinMaxSort (quadrático) e a mesclagem final em uma única
+ * thread dão lugar ao mergesort paralelo (ver Common/Mesclagem.h), e o tempo é registrado
+ * como ConcMesclagem.
  */
 
-// Função para garantir que o diretório "Data" e o arquivo "conc_minmax.txt" existam
-void garantirDiretorioEArquivo() {
-    struct stat st = {0};
-    
-    // Criar o diretório Data, se não existir
-    if (stat("Data", &st) == -1) {
-        mkdir("Data", 0700);  // Cria o diretório com permissão 0700
-    }
-
-    // Abrir o arquivo Data/conc_minmax.txt para verificar a primeira linha
-    FILE *arquivoLog = fopen("Data/conc_minmax.txt", "r+");
-    if (!arquivoLog) {
-        // Se o arquivo não existir, criá-lo e adicionar o cabeçalho
-        arquivoLog = fopen("Data/conc_minmax.txt", "w");
-        if (!arquivoLog) {
-            perror("Erro ao abrir o arquivo de log");
-            exit(1);
-        }
-        // Adicionar a linha de cabeçalho
-        fprintf(arquivoLog, "Programa,Tempo,Comprimento,Threads\n");
-        fclose(arquivoLog); // Fechar após escrever o cabeçalho
-    } else {
-        // Arquivo existe, verificar a primeira linha
-        char linha[256];
-        if (fgets(linha, sizeof(linha), arquivoLog)) {
-            // Verificar se a primeira linha é o cabeçalho esperado
-            if (linha[0] != 'T' || linha[1] != 'e' || linha[2] != 'm' || linha[3] != 'p' || linha[4] != 'o') {
-                // Se não for, adicionar o cabeçalho
-                fseek(arquivoLog, 0, SEEK_SET);  // Voltar para o início do arquivo
-                fprintf(arquivoLog, "Programa,Tempo,Comprimento,Threads\n");
-            }
-        }
-        fclose(arquivoLog); // Fechar o arquivo após verificação
-    }
-}
-
-// Função para registrar o tempo e o número de threads no arquivo
-void registrarTempoNoArquivo(double tempoGasto, int comprimentoA, int numThreads) {
-    FILE *arquivoLog = fopen("Data/conc_minmax.txt", "a");
-    if (!arquivoLog) {
-        perror("Erro ao abrir o arquivo de log");
-        exit(1);
-    }
-
-    // Adicionar a linha de log no arquivo Data/conc_minmax.txt
-    fprintf(arquivoLog, "ConcMinMaxSort,%f,%d,%d\n", tempoGasto, comprimentoA, numThreads);
-    fclose(arquivoLog);
-}
-
-// Estrutura para armazenar dados de cada thread (segmento de array)
-typedef struct {
-    int *arr;   // Ponteiro para o array
-    int inicio; // Índice de início do segmento
-    int fim;    // Índice final do segmento
-} DadosDaThread;
+// Opções comuns implementadas por este programa (o MinMaxSort e o mergesort não usam o perfil
+// de ajuste nem a partição de dois pivôs)
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO | \
+                        OPCOES_GRUPO_LOTE | OPCOES_GRUPO_AFINIDADE | OPCOES_GRUPO_PREORDENACAO | \
+                        OPCOES_GRUPO_COMPACTAR | OPCOES_GRUPO_ARGSORT | OPCOES_GRUPO_MESCLAGEM)
 
 // Macro para obter o tempo em segundos
 #define OBTER_TEMPO(agora) { \
@@ -77,161 +61,26 @@ typedef struct {
     agora = t.tv_sec + t.tv_usec / 1e6; \
 }
 
-// Função para trocar valores entre duas variáveis
-void trocar(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
-
-// Função que realiza o algoritmo Min-Max Sort em um segmento do array
-// Cada thread vai ordenar seu próprio segmento utilizando a técnica de Min-Max Sort
-void* minMaxSort(void *arg) {
-    DadosDaThread *dados = (DadosDaThread*)arg;
-    int *arr = dados->arr;
-    int inicio = dados->inicio;
-    int fim = dados->fim;
-
-    while (inicio < fim) {
-        int posMin = inicio, posMax = fim;
-
-        // Procurar os menores e maiores elementos no segmento
-        for (int i = inicio; i <= fim; i++) {
-            if (arr[i] < arr[posMin]) {
-                posMin = i;
-            }
-            if (arr[i] > arr[posMax]) {
-                posMax = i;
-            }
-        }
-
-        // Trocar o menor elemento com o primeiro do segmento
-        if (posMin != inicio) {
-            trocar(&arr[inicio], &arr[posMin]);
-            if (posMax == inicio) {
-                posMax = posMin;
-            }
-        }
-
-        // Trocar o maior elemento com o último do segmento
-        if (posMax != fim) {
-            trocar(&arr[fim], &arr[posMax]);
-        }
-
-        // Ajustar os limites do segmento
-        inicio++;
-        fim--;
-    }
-    return NULL;
-}
-
-// Função que mescla os segmentos ordenados pelas threads em um único array ordenado
-void mesclarSegmentosOrdenados(int *arr, int n, int numThreads, int tamanhoSegmento) {
-    int *temp = (int*)malloc(n * sizeof(int));
-    if (!temp) {
-        printf("Erro: Falha na alocação de memória para mesclagem.\n");
-        return;
-    }
-
-    int *indices = (int*)malloc(numThreads * sizeof(int));
-    if (!indices) {
-        printf("Erro: Falha na alocação de memória para os índices.\n");
-        free(temp);
-        return;
-    }
-
-    // Inicializar os índices para cada segmento
-    for (int i = 0; i < numThreads; i++) {
-        indices[i] = i * tamanhoSegmento;
-    }
-
-    for (int k = 0; k < n; k++) {
-        int idxMin = -1;
-
-        // Encontrar o menor elemento entre os segmentos
-        for (int i = 0; i < numThreads; i++) {
-            if (indices[i] < (i == numThreads - 1 ? n : (i + 1) * tamanhoSegmento)) {
-                if (idxMin == -1 || arr[indices[i]] < arr[indices[idxMin]]) {
-                    idxMin = i;
-                }
-            }
-        }
-
-        // Colocar o menor elemento encontrado no array temporário
-        temp[k] = arr[indices[idxMin]];
-        indices[idxMin]++;  // Avançar o índice do segmento
-    }
-
-    // Copiar os dados mesclados de volta para o array original
-    for (int i = 0; i < n; i++) {
-        arr[i] = temp[i];
-    }
-
-    free(temp);
-    free(indices);
-}
-
-// Função para ler um array de inteiros de um arquivo binário
-int* lerArquivoBinario(const char *nomeArquivo, int *n) {
-    FILE *arquivo = fopen(nomeArquivo, "rb");
-    if (!arquivo) {
-        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
-        return NULL;
-    }
-
-    // Ler o tamanho do array
-    if (fread(n, sizeof(int), 1, arquivo) != 1) {
-        printf("Erro: Falha ao ler o tamanho do array.\n");
-        fclose(arquivo);
-        return NULL;
-    }
-
-    // Alocar memória para o array
-    int *arr = (int*)malloc(*n * sizeof(int));
-    if (!arr) {
-        printf("Erro: Falha na alocação de memória.\n");
-        fclose(arquivo);
-        return NULL;
-    }
-
-    // Ler os elementos do array
-    if (fread(arr, sizeof(int), *n, arquivo) != *n) {
-        printf("Erro: Falha ao ler os elementos do array.\n");
-        free(arr);
-        fclose(arquivo);
-        return NULL;
-    }
-
-    fclose(arquivo);
-    return arr;
-}
-
-// Função para gravar um array de inteiros em um arquivo binário
-void gravarArquivoBinario(const char *nomeArquivo, int *arr, int n) {
-    FILE *arquivo = fopen(nomeArquivo, "wb");
-    if (!arquivo) {
-        printf("Erro: Não foi possível abrir o arquivo de saída.\n");
-        return;
-    }
-
-    // Gravar o tamanho do array
-    fwrite(&n, sizeof(int), 1, arquivo);
-    // Gravar os elementos do array
-    fwrite(arr, sizeof(int), n, arquivo);
-
-    fclose(arquivo);
-}
-
 int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
+
     // Verificar se o número correto de parâmetros foi passado
-    if (argc != 4) {
-        printf("Uso: %s <arquivo_entrada> <arquivo_saida> <num_threads>\n", argv[0]);
+    int lote = modoLote(&opcoes);
+    if (argc != (lote ? 2 : 4)) {
+        printf("Uso: %s <arquivo_entrada> <arquivo_saida> <num_threads> [opções]\n", argv[0]);
+        printf("     %s <num_threads> --entradas <padrão> | --manifesto <arquivo> [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stdout, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
         return 1;
     }
 
     const char *arquivoEntrada = argv[1];
     const char *arquivoSaida = argv[2];
-    int numThreads = atoi(argv[3]);
+    int numThreads = atoi(argv[lote ? 1 : 3]);
 
     // Verificar se o número de threads é positivo
     if (numThreads <= 0) {
@@ -239,64 +88,161 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    // MinMaxSort por segmentos ou mergesort
+    AlgoritmoOrdenacao algoritmo = opcoes.mesclagem ? ORDENACAO_MESCLAGEM : ORDENACAO_MINMAX_CONC;
+    const char *programa = opcoes.mesclagem ? "ConcMesclagem" : "ConcMinMaxSort";
+
     // Garantir que o diretório Data e o arquivo de log existam
-    garantirDiretorioEArquivo();
+    garantirDiretorioEArquivo("Data/conc_minmax.txt");
+
+    // Preparar a afinidade das threads e o primeiro toque distribuído dos vetores
+    PlanoNUMA plano;
+    if (iniciarPlanoNUMA(&plano, opcoes.afinidade, opcoes.topologia, numThreads) == 0 && planoNUMAAtivo(&plano)) {
+        fixarThreadAtual(&plano, 0);
+        ativarPrimeiroToqueNUMA(&plano);
+        descreverPlanoNUMA(&plano, stdout);
+    }
+
+    // Criar o pool de threads (o trabalhador i ordena o segmento i)
+    PoolThreads *pool = criarPoolThreads(numThreads, &plano);
+    if (!pool) {
+        return 1;
+    }
+
+    // Modo em lote: todos os arquivos com o mesmo pool e o log aberto uma única vez
+    if (lote) {
+        OpcoesOrdenacao ordenacao;
+        opcoesOrdenacaoPadrao(&ordenacao, algoritmo);
+        ordenacao.pool = pool;
+        ordenacao.numThreads = numThreads;
+        int resultado = ordenarLote(&opcoes, &ordenacao, pool, "Data/conc_minmax.txt", programa, numThreads);
+        destruirPoolThreads(pool);
+        return resultado;
+    }
 
     // Ler o array do arquivo binário de entrada
     int n;
-    int *arr = lerArquivoBinario(arquivoEntrada, &n);
+    int *arr = lerVetorArquivo(arquivoEntrada, &n, &opcoes.es);
     if (!arr) {
+        destruirPoolThreads(pool);
         return 1;
     }
 
     printf("Tamanho do array: %d\n", n);
 
-    // Criar as threads e dividir o trabalho
-    pthread_t threads[numThreads];
-    DadosDaThread dadosThread[numThreads];
-
-    int tamanhoSegmento = n / numThreads; // Tamanho de cada segmento
-    int restante = n % numThreads;        // Elementos restantes
-
-    double inicio, fim;
-    OBTER_TEMPO(inicio);
-
-    // Criar as threads para ordenar cada segmento
-    for (int i = 0; i < numThreads; i++) {
-        dadosThread[i].arr = arr;
-        dadosThread[i].inicio = i * tamanhoSegmento;
-        dadosThread[i].fim = (i + 1) * tamanhoSegmento - 1;
-
-        // Atribuir os elementos restantes à última thread
-        if (i == numThreads - 1) {
-            dadosThread[i].fim += restante;
+    // Com --argsort, os índices que ordenam a entrada também são calculados
+    void *permutacao = NULL;
+    if (opcoes.argsort) {
+        permutacao = alocarBuffer((size_t)n * opcoes.larguraIndice + 1);
+        if (!permutacao) {
+            printf("Erro: Falha na alocação de memória para a permutação.\n");
+            liberarBuffer(arr);
+            destruirPoolThreads(pool);
+            return 1;
         }
-
-        pthread_create(&threads[i], NULL, minMaxSort, &dadosThread[i]);
     }
 
-    // Aguardar as threads terminarem
-    for (int i = 0; i < numThreads; i++) {
-        pthread_join(threads[i], NULL);
+    // Com E/S assíncrona ou direta, a mesclagem é feita em um array temporário (alinhado a
+    // huge pages, ver Common/Memoria.h) que é gravado durante a própria mesclagem
+    int *temp = NULL;
+    GravadorVetor *gravador = NULL;
+    if (gravacaoIncremental(&opcoes.es)) {
+        temp = (int*)obterBufferTemporario((size_t)n * sizeof(int));
+        if (!temp) {
+            printf("Erro: Falha na alocação de memória para mesclagem.\n");
+            if (permutacao) {
+                liberarBuffer(permutacao);
+            }
+            liberarBuffer(arr);
+            destruirPoolThreads(pool);
+            return 1;
+        }
+        gravador = abrirGravadorVetor(arquivoSaida, temp, n, &opcoes.es);
+        if (!gravador) {
+            liberarBuffer(temp);
+            if (permutacao) {
+                liberarBuffer(permutacao);
+            }
+            liberarBuffer(arr);
+            destruirPoolThreads(pool);
+            return 1;
+        }
     }
 
-    // Mesclar os segmentos ordenados
-    mesclarSegmentosOrdenados(arr, n, numThreads, tamanhoSegmento);
+    OpcoesOrdenacao ordenacao;
+    opcoesOrdenacaoPadrao(&ordenacao, algoritmo);
+    ordenacao.pool = pool;
+    ordenacao.numThreads = numThreads;
+    ordenacao.saida = temp;
+    ordenacao.gravador = gravador;
+    ordenacao.elementosPorBloco = (long)(opcoes.es.tamanhoBloco / sizeof(int));
+    MetricasPreordenacao metricas;
+    ordenacao.preordenacao = opcoes.preordenacao;
+    ordenacao.metricas = &metricas;
+    MetricasCompactacao compactacao;
+    ordenacao.compactar = opcoes.compactar;
+    ordenacao.compactacao = &compactacao;
+    ordenacao.permutacao = permutacao;
+    ordenacao.larguraIndice = opcoes.larguraIndice;
+
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+
+    // Ordenar os segmentos em paralelo e mesclá-los (ou ordenar pelo mergesort)
+    int erroOrdenacao = ordenarI32(arr, n, &ordenacao);
 
     OBTER_TEMPO(fim);
     double tempoProcessamento = fim - inicio;
+    destruirPoolThreads(pool);
 
     printf("Tempo de processamento: %f segundos\n", tempoProcessamento);
+    imprimirRelatorioMemoria(stdout);
 
     // Registrar o tempo e o número de threads no arquivo
-    registrarTempoNoArquivo(tempoProcessamento, n, numThreads);
-
-    // Salvar o array ordenado no arquivo binário
-    gravarArquivoBinario(arquivoSaida, arr, n);
+    registrarTempoNoArquivo("Data/conc_minmax.txt", programa, tempoProcessamento, n, numThreads);
+    if (opcoes.preordenacao) {
+        imprimirPreordenacao(stdout, &metricas);
+        registrarPreordenacao(programa, tempoProcessamento, n, numThreads, &metricas);
+    }
+    if (opcoes.compactar) {
+        imprimirCompactacao(stdout, &compactacao);
+        registrarCompactacao(programa, tempoProcessamento, n, numThreads, &compactacao);
+    }
+
+    // Salvar o array ordenado no arquivo binário (ou aguardar os blocos já enviados)
+    int erroGravacao = gravador ? fecharGravadorVetor(gravador)
+                                : gravarVetorArquivo(arquivoSaida, arr, n, &opcoes.es);
+    if (erroOrdenacao != 0 || erroGravacao != 0) {
+        if (temp) {
+            liberarBuffer(temp);
+        }
+        if (permutacao) {
+            liberarBuffer(permutacao);
+        }
+        liberarBuffer(arr);
+        return 1;
+    }
 
     printf("Array ordenado salvo em %s\n", arquivoSaida);
 
+    // Gravar a permutação
+    if (permutacao) {
+        int erro = gravarPermutacaoArquivo(opcoes.argsort, permutacao, n, opcoes.larguraIndice, &opcoes.es);
+        liberarBuffer(permutacao);
+        if (erro != 0) {
+            if (temp) {
+                liberarBuffer(temp);
+            }
+            liberarBuffer(arr);
+            return 1;
+        }
+        printf("Permutação salva em %s\n", opcoes.argsort);
+    }
+
     // Liberar a memória alocada
-    free(arr);
+    if (temp) {
+        liberarBuffer(temp);
+    }
+    liberarBuffer(arr);
     return 0;
 }
@@ -3,7 +3,11 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <sys/time.h>
-#include <sys/stat.h>
+#include "Common/Lote.h"
+#include "Common/Opcoes.h"
+#include "Common/Ordenacao.h"
+#include "Common/Registro.h"
+#include "Common/Selecao.h"
 
 /*
  * Este programa realiza a ordenação de um vetor de inteiros usando o algoritmo Quicksort
@@ -14,16 +18,22 @@
  * e escreve o vetor ordenado em um arquivo binário de saída.
  *
  * O código usa o modelo de threads POSIX (pthreads) para paralelizar a execução 
- * do Quicksort. Ele divide o vetor em duas partes e cria threads para ordenar 
- * essas partes paralelamente, mas respeita o número máximo de threads especificado 
- * pelo usuário.
+ * do Quicksort. Ele divide o vetor em duas partes e entrega uma delas a um pool
+ * com o número de threads especificado pelo usuário (ver Common/Ordenacao.h, onde
+ * fica o algoritmo, compartilhado com a biblioteca libconcsort).
  *
  * O tempo total de execução da ordenação é medido e impresso ao final.
+ *
+ * As opções comuns estão descritas em Common/Opcoes.h (leitura e gravação, afinidade,
+ * modo em lote, pré-ordenação, compactação, dois pivôs e argsort), e as de seleção
+ * (--topk, --nth e --percentile, que substituem a ordenação completa) em Common/Selecao.h.
  */
 
-int maxThreads;              // Número máximo de threads global
-int currentThreads = 0;      // Contagem global de threads ativas
-pthread_mutex_t threadMutex; // Mutex para gerenciar a contagem de threads
+// Opções comuns implementadas por este programa
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO | \
+                        OPCOES_GRUPO_LOTE | OPCOES_GRUPO_AFINIDADE | OPCOES_GRUPO_PREORDENACAO | \
+                        OPCOES_GRUPO_COMPACTAR | OPCOES_GRUPO_DUPLO_PIVO | OPCOES_GRUPO_AJUSTE | \
+                        OPCOES_GRUPO_ARGSORT)
 
 // Macro para obter o tempo em segundos
 #define OBTER_TEMPO(agora) { \
@@ -32,230 +42,174 @@ pthread_mutex_t threadMutex; // Mutex para gerenciar a contagem de threads
     agora = t.tv_sec + t.tv_usec / 1e6; \
 }
 
-// Definir uma estrutura para armazenar os parâmetros de cada thread
-typedef struct {
-    int *A;  // Ponteiro para o vetor
-    int lo;  // Índice inferior
-    int hi;  // Índice superior
-} QuicksortArgs;
-
-// Função para trocar dois elementos
-void trocar(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
-
-// Função de partição
-int particao(int A[], int lo, int hi) {
-    int meio = lo + (hi - lo) / 2;
-    int pivô = A[meio];
-    trocar(&A[meio], &A[hi]); // Mover o pivô para o final
-
-    int i = lo - 1;
-    for (int j = lo; j < hi; j++) {
-        if (A[j] < pivô) {
-            i++;
-            trocar(&A[i], &A[j]);
-        }
-    }
-    trocar(&A[i + 1], &A[hi]); // Colocar o pivô na posição correta
-    return i + 1;
-}
-
-// Função de Quicksort com threads
-void *quicksort_threaded(void *arg) {
-    QuicksortArgs *args = (QuicksortArgs *)arg;
-    int *A = args->A;
-    int lo = args->lo;
-    int hi = args->hi;
-
-    if (lo < hi) {
-        int p = particao(A, lo, hi);
-
-        QuicksortArgs argsEsquerda = { A, lo, p - 1 };
-        QuicksortArgs argsDireita = { A, p + 1, hi };
-
-        pthread_t threadEsquerda, threadDireita;
-        int threadEsquerdaCriada = 0, threadDireitaCriada = 0;
-
-        // Bloquear mutex e verificar se uma nova thread pode ser criada
-        pthread_mutex_lock(&threadMutex);
-        if (currentThreads < maxThreads) {
-            currentThreads++;
-            pthread_mutex_unlock(&threadMutex);
-
-            pthread_create(&threadEsquerda, NULL, quicksort_threaded, &argsEsquerda);
-            threadEsquerdaCriada = 1;
-        } else {
-            pthread_mutex_unlock(&threadMutex);
-            quicksort_threaded(&argsEsquerda); // Ordenar sem criar nova thread
-        }
-
-        pthread_mutex_lock(&threadMutex);
-        if (currentThreads < maxThreads) {
-            currentThreads++;
-            pthread_mutex_unlock(&threadMutex);
-
-            pthread_create(&threadDireita, NULL, quicksort_threaded, &argsDireita);
-            threadDireitaCriada = 1;
-        } else {
-            pthread_mutex_unlock(&threadMutex);
-            quicksort_threaded(&argsDireita); // Ordenar sem criar nova thread
-        }
-
-        // Aguardar as threads terminarem, caso tenham sido criadas
-        if (threadEsquerdaCriada) {
-            pthread_join(threadEsquerda, NULL);
-            pthread_mutex_lock(&threadMutex);
-            currentThreads--;
-            pthread_mutex_unlock(&threadMutex);
-        }
-        if (threadDireitaCriada) {
-            pthread_join(threadDireita, NULL);
-            pthread_mutex_lock(&threadMutex);
-            currentThreads--;
-            pthread_mutex_unlock(&threadMutex);
-        }
-    }
-
-    return NULL;
-}
-
-// Função para medir o tempo de ordenação
-double medirTempoOrdenacao(int a[], int comprimentoA) {
+// Função para medir o tempo de ordenação com o Quicksort pedido
+// (com metricas, a pré-ordenação é medida e aproveitada antes do Quicksort; com compactacao,
+// as chaves que cabem em 8/16 bits são compactadas; com permutacao, os índices que ordenam o
+// vetor também são escritos)
+double medirTempoOrdenacao(int a[], int comprimentoA, AlgoritmoOrdenacao algoritmo, PoolThreads *pool,
+                           MetricasPreordenacao *metricas, MetricasCompactacao *compactacao, void *permutacao,
+                           int larguraIndice) {
     double inicio, fim;
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, algoritmo);
+    opcoes.pool = pool;
+    opcoes.preordenacao = metricas != NULL;
+    opcoes.metricas = metricas;
+    opcoes.compactar = compactacao != NULL;
+    opcoes.compactacao = compactacao;
+    opcoes.permutacao = permutacao;
+    opcoes.larguraIndice = larguraIndice;
 
     OBTER_TEMPO(inicio);
 
-    QuicksortArgs args = { a, 0, comprimentoA - 1 };
-    quicksort_threaded(&args);
+    ordenarI32(a, comprimentoA, &opcoes);
 
     OBTER_TEMPO(fim);
 
     return fim - inicio;
 }
 
-// Função para garantir que o diretório "Data" e o arquivo "conc_quicksort.txt" existam
-void garantirDiretorioEArquivo() {
-    struct stat st = {0};
-    
-    // Criar o diretório Data, se não existir
-    if (stat("Data", &st) == -1) {
-        mkdir("Data", 0700);  // Cria o diretório com permissão 0700
+// Função principal
+int main(int argc, char *argv[]) {
+    // Extrair as opções de seleção e as comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesSelecao selecao;
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoesSelecao(argc, argv, &selecao);
+    if (argc >= 0) {
+        argc = extrairOpcoes(argc, argv, &opcoes);
     }
-
-    // Abrir o arquivo Data/conc_quicksort.txt para verificar a primeira linha
-    FILE *arquivoLog = fopen("Data/conc_quicksort.txt", "r+");
-    if (!arquivoLog) {
-        // Se o arquivo não existir, criá-lo e adicionar o cabeçalho
-        arquivoLog = fopen("Data/conc_quicksort.txt", "w");
-        if (!arquivoLog) {
-            perror("Erro ao abrir o arquivo de log");
-            exit(1);
-        }
-        // Adicionar a linha de cabeçalho
-        fprintf(arquivoLog, "Programa,Tempo,Comprimento,Threads\n");
-        fclose(arquivoLog); // Fechar após escrever o cabeçalho
-    } else {
-        // Arquivo existe, verificar a primeira linha
-        char linha[256];
-        if (fgets(linha, sizeof(linha), arquivoLog)) {
-            // Verificar se a primeira linha é o cabeçalho esperado
-            if (linha[0] != 'T' || linha[1] != 'e' || linha[2] != 'm' || linha[3] != 'p' || linha[4] != 'o') {
-                // Se não for, adicionar o cabeçalho
-                fseek(arquivoLog, 0, SEEK_SET);  // Voltar para o início do arquivo
-                fprintf(arquivoLog, "Programa,Tempo,Comprimento,Threads\n");
-            }
-        }
-        fclose(arquivoLog); // Fechar o arquivo após verificação
+    int lote = argc >= 0 && modoLote(&opcoes);
+    if (argc != (lote ? 2 : 4)) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> <num_threads> [opções]\n", argv[0]);
+        fprintf(stderr, "     %s <num_threads> --entradas <padrão> | --manifesto <arquivo> [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        imprimirOpcoesSelecao(stderr);
+        return 1;
     }
-}
-
-// Função para registrar o tempo e o número de threads no arquivo
-void registrarTempoNoArquivo(double tempoGasto, int comprimentoA, int numThreads) {
-    FILE *arquivoLog = fopen("Data/conc_quicksort.txt", "a");
-    if (!arquivoLog) {
-        perror("Erro ao abrir o arquivo de log");
-        exit(1);
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
     }
-
-    // Adicionar a linha de log no arquivo Data/conc_quicksort.txt
-    fprintf(arquivoLog, "ConcQuicksort,%f,%d,%d\n", tempoGasto, comprimentoA, numThreads);
-    fclose(arquivoLog);
-}
-
-// Função principal
-int main(int argc, char *argv[]) {
-    if (argc != 4) {
-        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> <num_threads>\n", argv[0]);
+    if (selecao.modo != SELECAO_NENHUMA && (lote || opcoes.argsort || opcoes.preordenacao || opcoes.compactar)) {
+        fprintf(stderr, "As opções de seleção não podem ser usadas com o modo em lote, --argsort, --preordenacao ou --compactar.\n");
         return 1;
     }
 
-    // Definir o número máximo de threads a partir do argumento do usuário
-    maxThreads = atoi(argv[3]);
+    // Definir o número de threads a partir do argumento do usuário
+    int maxThreads = atoi(argv[lote ? 1 : 3]);
     if (maxThreads <= 0) {
         fprintf(stderr, "O número de threads deve ser positivo.\n");
         return 1;
     }
 
-    // Inicializar o mutex para controle das threads
-    pthread_mutex_init(&threadMutex, NULL);
+    // Partição de Lomuto ou de dois pivôs
+    AlgoritmoOrdenacao algoritmo = opcoes.duploPivo ? ORDENACAO_DUPLO_PIVO_CONC : ORDENACAO_QUICKSORT_CONC;
+    const char *programa = opcoes.duploPivo ? "ConcQuicksortDuploPivo" : "ConcQuicksort";
 
     // Garantir que o diretório e o arquivo de log existam
-    garantirDiretorioEArquivo();
+    garantirDiretorioEArquivo("Data/conc_quicksort.txt");
+
+    // Preparar a afinidade: thread principal na CPU do índice 0 e primeiro toque distribuído
+    PlanoNUMA plano;
+    if (iniciarPlanoNUMA(&plano, opcoes.afinidade, opcoes.topologia, maxThreads) == 0 && planoNUMAAtivo(&plano)) {
+        fixarThreadAtual(&plano, 0);
+        ativarPrimeiroToqueNUMA(&plano);
+        descreverPlanoNUMA(&plano, stdout);
+    }
 
-    // Abrir o arquivo binário de entrada
-    FILE *arquivoEntrada = fopen(argv[1], "rb");
-    if (!arquivoEntrada) {
-        perror("Erro ao abrir o arquivo de entrada");
+    // Criar o pool de threads usado pela ordenação
+    PoolThreads *pool = criarPoolThreads(maxThreads, &plano);
+    if (!pool) {
         return 1;
     }
 
-    // Ler o tamanho do vetor
-    int comprimentoA;
-    fread(&comprimentoA, sizeof(int), 1, arquivoEntrada);
+    // Modo em lote: todos os arquivos com o mesmo pool e o log aberto uma única vez
+    if (lote) {
+        OpcoesOrdenacao ordenacao;
+        opcoesOrdenacaoPadrao(&ordenacao, algoritmo);
+        ordenacao.pool = pool;
+        int resultado = ordenarLote(&opcoes, &ordenacao, pool, "Data/conc_quicksort.txt", programa, maxThreads);
+        destruirPoolThreads(pool);
+        return resultado;
+    }
+
+    // Seleção no lugar da ordenação completa
+    if (selecao.modo != SELECAO_NENHUMA) {
+        static const char *programasSelecao[] = { "", "ConcSelecaoTopk", "ConcSelecaoNth", "ConcSelecaoPercentil" };
+        int erro = executarSelecao(argv[1], argv[2], &selecao, &opcoes.es, pool, maxThreads,
+                                   "Data/conc_quicksort.txt", programasSelecao[selecao.modo]);
+        destruirPoolThreads(pool);
+        return erro != 0;
+    }
 
-    // Alocar memória para o vetor
-    int *a = malloc(comprimentoA * sizeof(int));
+    // Ler o vetor do arquivo binário de entrada
+    int comprimentoA;
+    int *a = lerVetorArquivo(argv[1], &comprimentoA, &opcoes.es);
     if (!a) {
-        perror("Falha na alocação de memória");
-        fclose(arquivoEntrada);
+        destruirPoolThreads(pool);
         return 1;
     }
 
     printf("Tamanho do array: %d\n", comprimentoA);
 
-    // Ler o vetor do arquivo
-    fread(a, sizeof(int), comprimentoA, arquivoEntrada);
-    fclose(arquivoEntrada);
+    // Com --argsort, os índices que ordenam a entrada também são calculados
+    void *permutacao = NULL;
+    if (opcoes.argsort) {
+        permutacao = alocarBuffer((size_t)comprimentoA * opcoes.larguraIndice + 1);
+        if (!permutacao) {
+            printf("Erro: Falha na alocação de memória para a permutação.\n");
+            liberarBuffer(a);
+            destruirPoolThreads(pool);
+            return 1;
+        }
+    }
 
     // Medir o tempo de ordenação
-    double tempoDecorrido = medirTempoOrdenacao(a, comprimentoA);
+    MetricasPreordenacao metricas;
+    MetricasCompactacao compactacao;
+    double tempoDecorrido = medirTempoOrdenacao(a, comprimentoA, algoritmo, pool,
+                                                opcoes.preordenacao ? &metricas : NULL,
+                                                opcoes.compactar ? &compactacao : NULL, permutacao,
+                                                opcoes.larguraIndice);
+    destruirPoolThreads(pool);
     printf("Tempo de ordenação: %f segundos\n", tempoDecorrido);
+    imprimirRelatorioMemoria(stdout);
 
     // Registrar o tempo e o número de threads no arquivo
-    registrarTempoNoArquivo(tempoDecorrido, comprimentoA, maxThreads);
+    registrarTempoNoArquivo("Data/conc_quicksort.txt", programa, tempoDecorrido, comprimentoA, maxThreads);
+    if (opcoes.preordenacao) {
+        imprimirPreordenacao(stdout, &metricas);
+        registrarPreordenacao(programa, tempoDecorrido, comprimentoA, maxThreads, &metricas);
+    }
+    if (opcoes.compactar) {
+        imprimirCompactacao(stdout, &compactacao);
+        registrarCompactacao(programa, tempoDecorrido, comprimentoA, maxThreads, &compactacao);
+    }
 
-    // Abrir o arquivo binário de saída
+    // Escrever o vetor ordenado no arquivo binário de saída
     const char *arquivoSaidaNome = argv[2];
-    FILE *arquivoSaida = fopen(argv[2], "wb");
-    if (!arquivoSaida) {
-        perror("Erro ao abrir o arquivo de saída");
-        free(a);
+    if (gravarVetorArquivo(arquivoSaidaNome, a, comprimentoA, &opcoes.es) != 0) {
+        if (permutacao) {
+            liberarBuffer(permutacao);
+        }
+        liberarBuffer(a);
         return 1;
     }
 
-    // Escrever o vetor ordenado no arquivo de saída
-    fwrite(&comprimentoA, sizeof(int), 1, arquivoSaida);
-    fwrite(a, sizeof(int), comprimentoA, arquivoSaida);
-    fclose(arquivoSaida);
-
     printf("Array ordenado salvo em %s\n", arquivoSaidaNome);
 
-    // Liberar memória alocada e destruir o mutex
-    free(a);
-    pthread_mutex_destroy(&threadMutex);
+    // Gravar a permutação
+    if (permutacao) {
+        int erro = gravarPermutacaoArquivo(opcoes.argsort, permutacao, comprimentoA, opcoes.larguraIndice, &opcoes.es);
+        liberarBuffer(permutacao);
+        if (erro != 0) {
+            liberarBuffer(a);
+            return 1;
+        }
+        printf("Permutação salva em %s\n", opcoes.argsort);
+    }
+
+    // Liberar memória alocada
+    liberarBuffer(a);
 
     return 0;
 }
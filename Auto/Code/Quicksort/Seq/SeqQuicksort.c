@@ -3,7 +3,10 @@
 #include <unistd.h>
 #include <stdbool.h>
 #include <sys/time.h>
-#include <sys/stat.h>
+#include "Common/Lote.h"
+#include "Common/Opcoes.h"
+#include "Common/Ordenacao.h"
+#include "Common/Registro.h"
 
 /*
  * Descrição:
@@ -13,12 +16,39 @@
  * O tempo de execução da ordenação também é medido e exibido. 
  *
  * O programa usa recursão para implementar o Quicksort e particionamento para reorganizar
- * os elementos em torno de um pivô.
+ * os elementos em torno de um pivô (ver Common/Ordenacao.h, biblioteca libconcsort).
  * 
  * A validação da ordenação pode ser ativada com a macro `VALIDAR_ORDENACAO` para garantir que
  * o vetor está corretamente ordenado.
+ *
+ * A leitura e a gravação dos arquivos podem usar io_uring ou pread/pwrite com
+ * várias requisições em voo (opção --es, ver Common/Opcoes.h).
+ *
+ * No modo em lote (--entradas ou --manifesto, ver Common/Lote.h), não há argumentos
+ * posicionais; com --lote-concorrente, os arquivos pequenos são ordenados ao mesmo tempo
+ * por um pool com uma thread por CPU.
+ *
+ * Com --preordenacao, uma passada linear mede quanto do vetor já está ordenado (ver
+ * Common/Preordenacao.h): vetores já ordenados não são tocados, vetores invertidos são
+ * apenas invertidos e vetores com corridas longas têm as corridas mescladas. As métricas
+ * são registradas em Data/preordenacao.csv.
+ *
+ * Com --compactar, chaves que cabem em 8 ou 16 bits depois de subtrair o mínimo são
+ * compactadas e ordenadas por radix sort (ver Common/Compactacao.h), com o tempo de cada
+ * fase registrado em Data/compactacao.csv.
+ *
+ * Com --duplo-pivo, a partição de Hoare dá lugar à de dois pivôs de Yaroslavskiy (ver
+ * Common/Ordenacao.h), e o tempo é registrado como SeqQuicksortDuploPivo.
+ *
+ * Com --argsort <arquivo>, a permutação que ordena a entrada (índices de 32 ou 64 bits,
+ * --indices) também é gravada, em um arquivo de permutação (ver Common/EntradaSaida.h).
  */
 
+// Opções comuns implementadas por este programa (a afinidade não se aplica a uma única thread)
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO | \
+                        OPCOES_GRUPO_LOTE | OPCOES_GRUPO_PREORDENACAO | OPCOES_GRUPO_COMPACTAR | \
+                        OPCOES_GRUPO_DUPLO_PIVO | OPCOES_GRUPO_AJUSTE | OPCOES_GRUPO_ARGSORT)
+
 // Macro para obter o tempo atual em segundos
 #define OBTER_TEMPO(agora) { \
     struct timeval t; \
@@ -26,156 +56,100 @@
     agora = t.tv_sec + t.tv_usec / 1e6; \
 }
 
-// Função para trocar dois elementos
-void trocar(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
-
-// Função para particionar o vetor, selecionando um pivô e reorganizando os elementos
-// O pivô é movido para a última posição, e os elementos menores que ele vão para a esquerda
-// e os maiores vão para a direita.
-int particionar(int A[], int lo, int hi) {
-    int meio = lo + (hi - lo) / 2; // Seleciona o pivô como o elemento do meio
-    int pivo = A[meio];
-
-    // Mover o pivô para o final para simplificar a partição
-    trocar(&A[meio], &A[hi]);
-
-    int i = lo - 1;
-    int j = hi;
-
-    while (1) {
-        // Move o índice 'i' até encontrar um elemento maior ou igual ao pivô
-        do {
-            i++;
-        } while (A[i] < pivo);
-
-        // Move o índice 'j' até encontrar um elemento menor ou igual ao pivô
-        do {
-            j--;
-        } while (A[j] > pivo && j > lo);
-
-        // Se os índices se cruzaram, o pivô pode ser colocado na posição correta
-        if (i >= j) {
-            trocar(&A[i], &A[hi]);
-            return j;
-        }
-
-        // Se não, troca os elementos para garantir que a partição seja feita corretamente
-        trocar(&A[i], &A[j]);
-    }
-}
-
-// Algoritmo Quicksort: ordena o vetor recursivamente utilizando o particionamento
-void quicksort(int A[], int lo, int hi) {
-    if (lo < hi) {
-        int p = particionar(A, lo, hi); // Encontra a posição do pivô
-        quicksort(A, lo, p);             // Ordena a parte esquerda
-        quicksort(A, p + 1, hi);         // Ordena a parte direita
-    }
-}
-
-// Função para medir o tempo de ordenação
-double medirTempoDeOrdenacao(int a[], int comprimentoA) {
+// Função para medir o tempo de ordenação com o Quicksort pedido
+// (com metricas, a pré-ordenação é medida e aproveitada antes do Quicksort; com compactacao,
+// as chaves que cabem em 8/16 bits são compactadas; com permutacao, os índices que ordenam o
+// vetor também são escritos, com uma única thread)
+double medirTempoDeOrdenacao(int a[], int comprimentoA, AlgoritmoOrdenacao algoritmo, MetricasPreordenacao *metricas,
+                             MetricasCompactacao *compactacao, void *permutacao, int larguraIndice) {
     double inicio, fim;
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, algoritmo);
+    opcoes.preordenacao = metricas != NULL;
+    opcoes.metricas = metricas;
+    opcoes.compactar = compactacao != NULL;
+    opcoes.compactacao = compactacao;
+    opcoes.permutacao = permutacao;
+    opcoes.larguraIndice = larguraIndice;
+    opcoes.numThreads = 1;
 
     OBTER_TEMPO(inicio);  // Marca o tempo inicial
-    quicksort(a, 0, comprimentoA - 1);  // Ordena o vetor
+    ordenarI32(a, comprimentoA, &opcoes);  // Ordena o vetor
     OBTER_TEMPO(fim);     // Marca o tempo final
 
     return fim - inicio;  // Retorna o tempo de execução em segundos
 }
 
-// Função para garantir que o diretório "Data" e o arquivo "seq_quicksort.txt" existam
-void garantirDiretorioEArquivo() {
-    struct stat st = {0};
-    
-    // Criar o diretório Data, se não existir
-    if (stat("Data", &st) == -1) {
-        mkdir("Data", 0700);  // Cria o diretório com permissão 0700
-    }
-
-    // Abrir o arquivo Data/seq_quicksort.txt para verificar a primeira linha
-    FILE *arquivoLog = fopen("Data/seq_quicksort.txt", "r+");
-    if (!arquivoLog) {
-        // Se o arquivo não existir, criá-lo e adicionar o cabeçalho
-        arquivoLog = fopen("Data/seq_quicksort.txt", "w");
-        if (!arquivoLog) {
-            perror("Erro ao abrir o arquivo de log");
-            exit(1);
-        }
-        // Adicionar a linha de cabeçalho
-        fprintf(arquivoLog,  "Programa,Tempo,Comprimento,Threads\n");
-        fclose(arquivoLog); // Fechar após escrever o cabeçalho
-    } else {
-        // Arquivo existe, verificar a primeira linha
-        char linha[256];
-        if (fgets(linha, sizeof(linha), arquivoLog)) {
-            // Verificar se a primeira linha é o cabeçalho esperado
-            if (linha[0] != 'T' || linha[1] != 'e' || linha[2] != 'm' || linha[3] != 'p' || linha[4] != 'o') {
-                // Se não for, adicionar o cabeçalho
-                fseek(arquivoLog, 0, SEEK_SET);  // Voltar para o início do arquivo
-                fprintf(arquivoLog,  "Programa,Tempo,Comprimento,Threads\n");
-            }
-        }
-        fclose(arquivoLog); // Fechar o arquivo após verificação
-    }
-}
-
-// Função para registrar o tempo no arquivo
-void registrarTempoNoArquivo(double tempoGasto, int comprimentoA) {
-    FILE *arquivoLog = fopen("Data/seq_quicksort.txt", "a");
-    if (!arquivoLog) {
-        perror("Erro ao abrir o arquivo de log");
-        exit(1);
-    }
-
-    // Adicionar a linha de log no arquivo Data/seq_quicksort.txt
-    fprintf(arquivoLog, "SeqQuicksort,%f,%d,\n", tempoGasto, comprimentoA);
-    fclose(arquivoLog);
-}
-
 // Função principal
 int main(int argc, char *argv[]) {
-    if (argc != 3) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
+    int lote = modoLote(&opcoes);
+    if (argc != (lote ? 1 : 3)) {
         // Verifica se o número correto de argumentos foi fornecido (entrada e saída de arquivos)
-        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida>\n", argv[0]);
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> [opções]\n", argv[0]);
+        fprintf(stderr, "     %s --entradas <padrão> | --manifesto <arquivo> [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
         return 1;
     }
-
-    // Garantir que o diretório e o arquivo de log existam
-    garantirDiretorioEArquivo();
-
-    // Abrir o arquivo binário de entrada
-    FILE *arquivoEntrada = fopen(argv[1], "rb");
-    if (!arquivoEntrada) {
-        perror("Erro ao abrir o arquivo de entrada");
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
         return 1;
     }
 
-    // Ler o tamanho do vetor armazenado no arquivo
-    int comprimentoA;
-    fread(&comprimentoA, sizeof(int), 1, arquivoEntrada);
+    // Partição de Hoare ou de dois pivôs
+    AlgoritmoOrdenacao algoritmo = opcoes.duploPivo ? ORDENACAO_DUPLO_PIVO_SEQ : ORDENACAO_QUICKSORT_SEQ;
+    const char *programa = opcoes.duploPivo ? "SeqQuicksortDuploPivo" : "SeqQuicksort";
+
+    // Modo em lote: todos os arquivos no mesmo processo, com o log aberto uma única vez
+    if (lote) {
+        PoolThreads *pool = NULL;
+        if (opcoes.loteConcorrente) {
+            pool = criarPoolThreads(cpusDisponiveis(), NULL);
+            if (!pool) {
+                return 1;
+            }
+        }
+        OpcoesOrdenacao ordenacao;
+        opcoesOrdenacaoPadrao(&ordenacao, algoritmo);
+        int resultado = ordenarLote(&opcoes, &ordenacao, pool, "Data/seq_quicksort.txt", programa, 0);
+        if (pool) {
+            destruirPoolThreads(pool);
+        }
+        return resultado;
+    }
 
-    // Alocar memória para armazenar o vetor
-    int *a = malloc(comprimentoA * sizeof(int));
+    // Garantir que o diretório e o arquivo de log existam
+    garantirDiretorioEArquivo("Data/seq_quicksort.txt");
+
+    // Ler o vetor de inteiros do arquivo binário de entrada
+    int comprimentoA;
+    int *a = lerVetorArquivo(argv[1], &comprimentoA, &opcoes.es);
     if (!a) {
-        perror("Falha na alocação de memória");
-        fclose(arquivoEntrada);
         return 1;
     }
 
     printf("Tamanho do array: %d\n", comprimentoA);
 
-    // Ler o vetor de inteiros do arquivo
-    fread(a, sizeof(int), comprimentoA, arquivoEntrada);
-    fclose(arquivoEntrada);
+    // Com --argsort, os índices que ordenam a entrada também são calculados
+    void *permutacao = NULL;
+    if (opcoes.argsort) {
+        permutacao = alocarBuffer((size_t)comprimentoA * opcoes.larguraIndice + 1);
+        if (!permutacao) {
+            printf("Erro: Falha na alocação de memória para a permutação.\n");
+            liberarBuffer(a);
+            return 1;
+        }
+    }
 
     // Medir o tempo de ordenação
-    double tempoGasto = medirTempoDeOrdenacao(a, comprimentoA);
+    MetricasPreordenacao metricas;
+    MetricasCompactacao compactacao;
+    double tempoGasto = medirTempoDeOrdenacao(a, comprimentoA, algoritmo, opcoes.preordenacao ? &metricas : NULL,
+                                              opcoes.compactar ? &compactacao : NULL, permutacao,
+                                              opcoes.larguraIndice);
     printf("Tempo gasto para ordenar: %f segundos\n", tempoGasto);
+    imprimirRelatorioMemoria(stdout);
 
     // // Etapa de validação (opcional)
     // #ifdef VALIDAR_ORDENACAO
@@ -187,25 +161,41 @@ int main(int argc, char *argv[]) {
     // #endif
 
     // Registrar o tempo no arquivo
-    registrarTempoNoArquivo(tempoGasto, comprimentoA);
+    registrarTempoNoArquivo("Data/seq_quicksort.txt", programa, tempoGasto, comprimentoA, 0);
+    if (opcoes.preordenacao) {
+        imprimirPreordenacao(stdout, &metricas);
+        registrarPreordenacao(programa, tempoGasto, comprimentoA, 0, &metricas);
+    }
+    if (opcoes.compactar) {
+        imprimirCompactacao(stdout, &compactacao);
+        registrarCompactacao(programa, tempoGasto, comprimentoA, 0, &compactacao);
+    }
 
-    // Abrir o arquivo binário de saída para escrever o vetor ordenado
+    // Escrever o tamanho do vetor e o vetor ordenado no arquivo de saída
     const char *arquivoSaidaNome = argv[2];
-    FILE *arquivoSaida = fopen(argv[2], "wb");
-    if (!arquivoSaida) {
-        perror("Erro ao abrir o arquivo de saída");
-        free(a);  // Libera a memória alocada antes de sair
+    if (gravarVetorArquivo(arquivoSaidaNome, a, comprimentoA, &opcoes.es) != 0) {
+        if (permutacao) {
+            liberarBuffer(permutacao);
+        }
+        liberarBuffer(a);  // Libera a memória alocada antes de sair
         return 1;
     }
-    // Escrever o tamanho do vetor e o vetor ordenado no arquivo de saída
-    fwrite(&comprimentoA, sizeof(int), 1, arquivoSaida);  // Escrever o tamanho do vetor
-    fwrite(a, sizeof(int), comprimentoA, arquivoSaida);  // Escrever o vetor ordenado
-    fclose(arquivoSaida);
 
     printf("Array ordenado salvo em %s\n", arquivoSaidaNome);
 
+    // Gravar a permutação
+    if (permutacao) {
+        int erro = gravarPermutacaoArquivo(opcoes.argsort, permutacao, comprimentoA, opcoes.larguraIndice, &opcoes.es);
+        liberarBuffer(permutacao);
+        if (erro != 0) {
+            liberarBuffer(a);
+            return 1;
+        }
+        printf("Permutação salva em %s\n", opcoes.argsort);
+    }
+
     // Liberar a memória alocada para o vetor
-    free(a);
+    liberarBuffer(a);
 
     return 0;
 }
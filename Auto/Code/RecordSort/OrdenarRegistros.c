@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "Common/Opcoes.h"
+#include "Common/OrdenacaoRegistros.h"
+#include "Common/Registro.h"
+
+/*
+ * Descrição:
+ * Este programa ordena um arquivo de registros (chave de 32 ou 64 bits seguida de uma carga
+ * de largura fixa, ver Common/EntradaSaida.h) pela chave, de forma estável, com a ordenação
+ * de registros da biblioteca libconcsort (Common/OrdenacaoRegistros.h): as chaves são
+ * ordenadas em pares de 16 bytes por um radix sort dividido entre as threads, e a carga
+ * viaja no próprio par (cargas pequenas) ou é levada ao destino em uma única passada de
+ * permutação (cargas grandes), sem que os registros inteiros sejam trocados de lugar.
+ *
+ * A estratégia escolhida pelo tamanho da carga é exibida. O tempo de ordenação é medido,
+ * impresso e registrado em Data/registros.txt.
+ */
+
+// Opções comuns implementadas por este programa: além de --memoria, só a E/S (sem --es-direto
+// e --indice-esparso, que o formato de registros não usa) e a afinidade
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_AFINIDADE)
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
+    if (argc != 4) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> <num_threads> [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    int numThreads = atoi(argv[3]);
+    if (numThreads <= 0) {
+        fprintf(stderr, "O número de threads deve ser positivo.\n");
+        return 1;
+    }
+
+    // Garantir que o diretório e o arquivo de log existam
+    garantirDiretorioEArquivo("Data/registros.txt");
+
+    // Preparar a afinidade das threads do pool
+    PlanoNUMA plano;
+    if (iniciarPlanoNUMA(&plano, opcoes.afinidade, opcoes.topologia, numThreads) == 0 && planoNUMAAtivo(&plano)) {
+        fixarThreadAtual(&plano, 0);
+        ativarPrimeiroToqueNUMA(&plano);
+        descreverPlanoNUMA(&plano, stdout);
+    }
+
+    PoolThreads *pool = criarPoolThreads(numThreads, &plano);
+    if (!pool) {
+        return 1;
+    }
+
+    // Ler os registros do arquivo de entrada
+    void *registros;
+    int n, larguraChave, larguraCarga;
+    if (lerRegistrosArquivo(argv[1], &registros, &n, &larguraChave, &larguraCarga, &opcoes.es) != 0) {
+        destruirPoolThreads(pool);
+        return 1;
+    }
+
+    printf("Registros: %d, chave de %d bytes, carga de %d bytes\n", n, larguraChave, larguraCarga);
+    printf("Estratégia: %s\n", nomeEstrategiaRegistros(estrategiaRegistros(larguraCarga)));
+
+    // O resultado vai para um segundo vetor, de onde é gravado
+    size_t bytes = (size_t)n * (size_t)(larguraChave + larguraCarga);
+    void *ordenados = alocarBuffer(bytes > 0 ? bytes : 1);
+    if (!ordenados) {
+        printf("Erro: Falha na alocação de memória.\n");
+        liberarBuffer(registros);
+        destruirPoolThreads(pool);
+        return 1;
+    }
+
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+    int erro = ordenarRegistros(registros, ordenados, n, larguraChave, larguraCarga, pool, numThreads);
+    OBTER_TEMPO(fim);
+    destruirPoolThreads(pool);
+    liberarBuffer(registros);
+
+    printf("Tempo de ordenação: %f segundos\n", fim - inicio);
+    imprimirRelatorioMemoria(stdout);
+
+    // Registrar o tempo e o número de threads no arquivo
+    registrarTempoNoArquivo("Data/registros.txt", "OrdenacaoRegistros", fim - inicio, n, numThreads);
+
+    // Gravar os registros ordenados no arquivo de saída
+    if (erro != 0 || gravarRegistrosArquivo(argv[2], ordenados, n, larguraChave, larguraCarga, &opcoes.es) != 0) {
+        liberarBuffer(ordenados);
+        return 1;
+    }
+
+    printf("Registros ordenados salvos em %s\n", argv[2]);
+
+    liberarBuffer(ordenados);
+    return 0;
+}
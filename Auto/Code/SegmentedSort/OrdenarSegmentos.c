@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "Common/Opcoes.h"
+#include "Common/OrdenacaoSegmentada.h"
+#include "Common/Registro.h"
+
+/*
+ * Descrição:
+ * Este programa ordena um arquivo segmentado (muitos vetores pequenos em um único arquivo,
+ * ver Common/EntradaSaida.h), ordenando cada segmento de forma independente com a
+ * ordenação segmentada da biblioteca libconcsort (Common/OrdenacaoSegmentada.h): os
+ * segmentos são agrupados em tarefas de tamanho parecido para um pool com o número de
+ * threads informado, e cada segmento é ordenado por uma rede de ordenação, por inserção ou
+ * por Quicksort, conforme o tamanho.
+ *
+ * O tempo de ordenação é medido, impresso e registrado em Data/segmentos.txt, junto com a
+ * quantidade de segmentos ordenados por cada núcleo.
+ */
+
+// Opções comuns implementadas por este programa: além de --memoria, só a E/S (sem --es-direto
+// e --indice-esparso, que o formato segmentado não usa) e a afinidade
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_AFINIDADE)
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+// Função para contar os segmentos ordenados por cada núcleo
+void imprimirNucleos(const long *deslocamentos, int numSegmentos) {
+    long rede = 0, insercao = 0, quicksort = 0, paralelo = 0;
+    for (int s = 0; s < numSegmentos; s++) {
+        long n = deslocamentos[s + 1] - deslocamentos[s];
+        if (n > SEGMENTOS_LIMITE_PARALELO) {
+            paralelo++;
+        } else if (n > SEGMENTOS_LIMITE_INSERCAO) {
+            quicksort++;
+        } else if (n > SEGMENTOS_LIMITE_REDE) {
+            insercao++;
+        } else {
+            rede++;
+        }
+    }
+    printf("Segmentos por núcleo: rede %ld, inserção %ld, quicksort %ld, quicksort concorrente %ld\n",
+           rede, insercao, quicksort, paralelo);
+}
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
+    if (argc != 4) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> <num_threads> [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    int numThreads = atoi(argv[3]);
+    if (numThreads <= 0) {
+        fprintf(stderr, "O número de threads deve ser positivo.\n");
+        return 1;
+    }
+
+    // Garantir que o diretório e o arquivo de log existam
+    garantirDiretorioEArquivo("Data/segmentos.txt");
+
+    // Preparar a afinidade das threads do pool
+    PlanoNUMA plano;
+    if (iniciarPlanoNUMA(&plano, opcoes.afinidade, opcoes.topologia, numThreads) == 0 && planoNUMAAtivo(&plano)) {
+        fixarThreadAtual(&plano, 0);
+        ativarPrimeiroToqueNUMA(&plano);
+        descreverPlanoNUMA(&plano, stdout);
+    }
+
+    PoolThreads *pool = criarPoolThreads(numThreads, &plano);
+    if (!pool) {
+        return 1;
+    }
+
+    // Ler os segmentos do arquivo de entrada
+    int *valores, n, numSegmentos;
+    long *deslocamentos;
+    if (lerSegmentosArquivo(argv[1], &valores, &n, &deslocamentos, &numSegmentos, &opcoes.es) != 0) {
+        destruirPoolThreads(pool);
+        return 1;
+    }
+
+    printf("Segmentos: %d, elementos: %d\n", numSegmentos, n);
+    imprimirNucleos(deslocamentos, numSegmentos);
+
+    OpcoesOrdenacao ordenacao;
+    opcoesOrdenacaoPadrao(&ordenacao, ORDENACAO_QUICKSORT_CONC);
+    ordenacao.pool = pool;
+
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+    int erro = ordenarSegmentosI32(valores, deslocamentos, numSegmentos, &ordenacao);
+    OBTER_TEMPO(fim);
+    destruirPoolThreads(pool);
+
+    printf("Tempo de ordenação: %f segundos\n", fim - inicio);
+    imprimirRelatorioMemoria(stdout);
+
+    // Registrar o tempo e o número de threads no arquivo
+    registrarTempoNoArquivo("Data/segmentos.txt", "OrdenacaoSegmentada", fim - inicio, n, numThreads);
+
+    // Gravar os segmentos ordenados no arquivo de saída
+    if (erro != 0 || gravarSegmentosArquivo(argv[2], valores, deslocamentos, numSegmentos, &opcoes.es) != 0) {
+        liberarBuffer(valores);
+        free(deslocamentos);
+        return 1;
+    }
+
+    printf("Segmentos ordenados salvos em %s\n", argv[2]);
+
+    liberarBuffer(valores);
+    free(deslocamentos);
+    return 0;
+}
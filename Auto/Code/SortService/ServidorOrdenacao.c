@@ -0,0 +1,337 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include "Common/Opcoes.h"
+#include "Common/Ordenacao.h"
+#include "Common/Registro.h"
+#include "Common/Servico.h"
+
+/*
+ * Descrição:
+ * Servidor de ordenação de longa duração. Em vez de um processo por ordenação, o servidor
+ * cria uma única vez o pool de threads e as arenas temporárias (já tocadas, para não
+ * pagar as falhas de página em cada pedido) e atende os clientes em um socket Unix.
+ *
+ * Cada cliente envia o vetor em um memfd (ver Common/Servico.h); o servidor mapeia o
+ * mesmo memfd e ordena os dados no lugar, sem cópias. O controle de admissão limita as
+ * ordenações simultâneas (--max-tarefas) e os pedidos em espera (--fila); pedidos além
+ * disso (e os que chegam durante o encerramento) são recusados com SERVICO_OCUPADO.
+ *
+ * Cada ordenação é registrada em Data/servico_ordenacao.txt, mantido aberto.
+ * O servidor termina com SIGINT ou SIGTERM, após concluir os pedidos em andamento.
+ */
+
+// Opções comuns implementadas por este programa: só a afinidade (os vetores chegam em memória
+// compartilhada, sem E/S de arquivos)
+#define OPCOES_ACEITAS OPCOES_GRUPO_AFINIDADE
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+// Estado compartilhado pelas conexões
+typedef struct {
+    PoolThreads *pool;
+    FILE *registro;
+    int maxTarefas;
+    int fila;
+    int emExecucao;            // Ordenações em andamento
+    int naFila;                // Pedidos aguardando admissão
+    int encerrando;            // 1 após SIGINT/SIGTERM: novos pedidos são recusados
+    pthread_mutex_t mutex;
+    pthread_cond_t condicao;
+} EstadoServidor;
+
+// Dados de cada conexão
+typedef struct {
+    EstadoServidor *estado;
+    int sock;
+} Conexao;
+
+static volatile sig_atomic_t encerrar = 0;
+
+// Função chamada por SIGINT/SIGTERM
+void tratarSinal(int sinal) {
+    (void)sinal;
+    encerrar = 1;
+}
+
+// Função para aguardar a admissão de um pedido; retorna -1 se a fila estiver cheia
+int admitirPedido(EstadoServidor *estado) {
+    pthread_mutex_lock(&estado->mutex);
+    if (estado->encerrando ||
+        (estado->emExecucao >= estado->maxTarefas && estado->naFila >= estado->fila)) {
+        pthread_mutex_unlock(&estado->mutex);
+        return -1;
+    }
+
+    estado->naFila++;
+    while (estado->emExecucao >= estado->maxTarefas && !estado->encerrando) {
+        pthread_cond_wait(&estado->condicao, &estado->mutex);
+    }
+    estado->naFila--;
+    if (estado->encerrando) {
+        pthread_cond_broadcast(&estado->condicao);
+        pthread_mutex_unlock(&estado->mutex);
+        return -1;
+    }
+    estado->emExecucao++;
+    pthread_mutex_unlock(&estado->mutex);
+    return 0;
+}
+
+// Função para liberar a vaga de um pedido concluído
+void concluirPedido(EstadoServidor *estado) {
+    pthread_mutex_lock(&estado->mutex);
+    estado->emExecucao--;
+    pthread_cond_broadcast(&estado->condicao);
+    pthread_mutex_unlock(&estado->mutex);
+}
+
+// Função para retornar o nome registrado no log para cada algoritmo
+const char *nomeNoRegistro(AlgoritmoOrdenacao algoritmo) {
+    switch (algoritmo) {
+        case ORDENACAO_QUICKSORT_SEQ:  return "ServicoSeqQuicksort";
+        case ORDENACAO_QUICKSORT_CONC: return "ServicoConcQuicksort";
+        case ORDENACAO_MINMAX_SEQ:     return "ServicoSeqMinMaxSort";
+        case ORDENACAO_CORRIDAS:       return "ServicoCorridas";
+        case ORDENACAO_CONTAGEM:       return "ServicoContagem";
+        case ORDENACAO_APRENDIDA:      return "ServicoAprendida";
+        case ORDENACAO_DUPLO_PIVO_SEQ:  return "ServicoDuploPivoSeq";
+        case ORDENACAO_DUPLO_PIVO_CONC: return "ServicoDuploPivoConc";
+        case ORDENACAO_MESCLAGEM:      return "ServicoMesclagem";
+        case ORDENACAO_MESCLAGEM_LOCAL: return "ServicoMesclagemLocal";
+        default:                       return "ServicoConcMinMaxSort";
+    }
+}
+
+// Função que atende um pedido e preenche a resposta
+void atenderPedido(EstadoServidor *estado, const PedidoOrdenacao *pedido, int fdDados,
+                   RespostaOrdenacao *resposta) {
+    memset(resposta, 0, sizeof(*resposta));
+
+    // Validar o pedido antes de ocupar uma vaga
+    if (pedido->magia != SERVICO_MAGIA || pedido->versao != SERVICO_VERSAO || fdDados < 0 ||
+        pedido->algoritmo < ORDENACAO_QUICKSORT_SEQ || pedido->algoritmo >= ORDENACAO_NUM_ALGORITMOS ||
+        pedido->n < 0 || pedido->n > 0x7fffffff || pedido->numThreads < 0) {
+        resposta->status = SERVICO_PEDIDO_INVALIDO;
+        return;
+    }
+
+    int *vetor = mapearVetorCompartilhado(fdDados, (long)pedido->n);
+    if (!vetor) {
+        resposta->status = SERVICO_PEDIDO_INVALIDO;
+        return;
+    }
+
+    double chegada, inicio, fim;
+    OBTER_TEMPO(chegada);
+    if (admitirPedido(estado) < 0) {
+        resposta->status = SERVICO_OCUPADO;
+        liberarVetorCompartilhado(vetor, (long)pedido->n);
+        return;
+    }
+
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, (AlgoritmoOrdenacao)pedido->algoritmo);
+    opcoes.pool = estado->pool;
+    // Mais segmentos que trabalhadores não aceleram a ordenação e só custam memória
+    int maxThreads = numTrabalhadoresPool(estado->pool);
+    opcoes.numThreads = pedido->numThreads < maxThreads ? pedido->numThreads : maxThreads;
+    long memoriaExtra = -1;
+    opcoes.memoriaExtra = &memoriaExtra;
+
+    OBTER_TEMPO(inicio);
+    int erro = ordenarI32(vetor, (long)pedido->n, &opcoes);
+    OBTER_TEMPO(fim);
+
+    resposta->status = erro == 0 ? SERVICO_OK : SERVICO_ERRO;
+    resposta->tempoOrdenacao = fim - inicio;
+    resposta->tempoEspera = inicio - chegada;
+    resposta->memoriaExtra = memoriaExtra;
+
+    // Registrar antes de liberar a vaga (o encerramento aguarda as vagas para fechar o log)
+    if (erro == 0 && estado->registro) {
+        int limitaThreads = pedido->algoritmo == ORDENACAO_MINMAX_CONC || pedido->algoritmo == ORDENACAO_CONTAGEM ||
+                            pedido->algoritmo == ORDENACAO_APRENDIDA || pedido->algoritmo == ORDENACAO_MESCLAGEM ||
+                            pedido->algoritmo == ORDENACAO_MESCLAGEM_LOCAL;
+        int threads = limitaThreads && opcoes.numThreads > 0 ? opcoes.numThreads : maxThreads;
+        int sequencial = pedido->algoritmo == ORDENACAO_QUICKSORT_SEQ || pedido->algoritmo == ORDENACAO_MINMAX_SEQ ||
+                         pedido->algoritmo == ORDENACAO_CORRIDAS || pedido->algoritmo == ORDENACAO_DUPLO_PIVO_SEQ;
+        registrarTempo(estado->registro, nomeNoRegistro((AlgoritmoOrdenacao)pedido->algoritmo),
+                       resposta->tempoOrdenacao, (int)pedido->n, sequencial ? 0 : threads);
+    }
+
+    concluirPedido(estado);
+    liberarVetorCompartilhado(vetor, (long)pedido->n);
+}
+
+// Função executada pela thread de cada conexão: atende os pedidos até o cliente desconectar
+void *atenderConexao(void *arg) {
+    Conexao *conexao = (Conexao *)arg;
+    EstadoServidor *estado = conexao->estado;
+
+    while (1) {
+        PedidoOrdenacao pedido;
+        RespostaOrdenacao resposta;
+        int fdDados;
+        if (receberPedido(conexao->sock, &pedido, &fdDados) != 0) {
+            break;
+        }
+
+        atenderPedido(estado, &pedido, fdDados, &resposta);
+        if (fdDados >= 0) {
+            close(fdDados);
+        }
+        if (enviarResposta(conexao->sock, &resposta) != 0) {
+            break;
+        }
+    }
+
+    close(conexao->sock);
+    free(conexao);
+    return NULL;
+}
+
+// Função para criar e tocar as arenas temporárias, deixando-as livres para reaproveitamento
+void prepararArenas(int quantidade, long arenaMB) {
+    size_t bytes = (size_t)arenaMB * 1024 * 1024;
+    void *arenas[quantidade];
+
+    // Obter todas antes de devolver, para que sejam arenas distintas
+    for (int i = 0; i < quantidade; i++) {
+        arenas[i] = bytes > 0 ? obterBufferTemporario(bytes) : NULL;
+        if (arenas[i]) {
+            memset(arenas[i], 0, bytes);
+        }
+    }
+    for (int i = 0; i < quantidade; i++) {
+        if (arenas[i]) {
+            devolverBufferTemporario(arenas[i]);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções do serviço e as comuns (--memoria, --afinidade, ...)
+    OpcoesServico servico;
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoesServico(argc, argv, SERVICO_SERVIDOR, &servico);
+    if (argc >= 0) {
+        argc = extrairOpcoes(argc, argv, &opcoes);
+    }
+    if (argc != 2) {
+        fprintf(stderr, "Uso: %s <num_threads> [opções]\n", argv[0]);
+        imprimirOpcoesServico(stderr, SERVICO_SERVIDOR);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    int numThreads = atoi(argv[1]);
+    if (numThreads <= 0) {
+        fprintf(stderr, "O número de threads deve ser positivo.\n");
+        return 1;
+    }
+
+    // Preparar a afinidade e o pool de threads, que ficam ativos enquanto o servidor existir
+    PlanoNUMA plano;
+    if (iniciarPlanoNUMA(&plano, opcoes.afinidade, opcoes.topologia, numThreads) == 0 && planoNUMAAtivo(&plano)) {
+        ativarPrimeiroToqueNUMA(&plano);
+        descreverPlanoNUMA(&plano, stdout);
+    }
+
+    EstadoServidor estado;
+    memset(&estado, 0, sizeof(estado));
+    estado.maxTarefas = servico.maxTarefas;
+    estado.fila = servico.fila;
+    pthread_mutex_init(&estado.mutex, NULL);
+    pthread_cond_init(&estado.condicao, NULL);
+
+    estado.pool = criarPoolThreads(numThreads, &plano);
+    if (!estado.pool) {
+        return 1;
+    }
+
+    // Uma arena por ordenação simultânea, usada pelas mesclagens do MinMaxSort
+    prepararArenas(servico.maxTarefas, servico.arenaMB);
+
+    estado.registro = abrirArquivoRegistro("Data/servico_ordenacao.txt");
+
+    int sockServidor = escutarServico(servico.socket);
+    if (sockServidor < 0) {
+        destruirPoolThreads(estado.pool);
+        return 1;
+    }
+
+    // SIGINT/SIGTERM interrompem o accept (sem SA_RESTART)
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = tratarSinal;
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+
+    printf("Servidor de ordenação em %s: %d threads, até %d ordenações simultâneas e %d na fila\n",
+           servico.socket, numThreads, servico.maxTarefas, servico.fila);
+    fflush(stdout);
+
+    while (!encerrar) {
+        int sock = accept(sockServidor, NULL, NULL);
+        if (sock < 0) {
+            if (errno != EINTR) {
+                perror("Erro ao aceitar conexão");
+            }
+            continue;
+        }
+
+        Conexao *conexao = malloc(sizeof(Conexao));
+        pthread_t thread;
+        if (!conexao) {
+            close(sock);
+            continue;
+        }
+        conexao->estado = &estado;
+        conexao->sock = sock;
+
+        if (pthread_create(&thread, NULL, atenderConexao, conexao) != 0) {
+            perror("Erro ao criar a thread da conexão");
+            close(sock);
+            free(conexao);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+    // Parar de aceitar conexões e pedidos e aguardar as ordenações em andamento; as
+    // conexões ociosas são fechadas com o fim do processo
+    printf("Encerrando o servidor...\n");
+    close(sockServidor);
+    unlink(servico.socket);
+
+    pthread_mutex_lock(&estado.mutex);
+    estado.encerrando = 1;
+    pthread_cond_broadcast(&estado.condicao);
+    while (estado.emExecucao > 0 || estado.naFila > 0) {
+        pthread_cond_wait(&estado.condicao, &estado.mutex);
+    }
+    pthread_mutex_unlock(&estado.mutex);
+
+    destruirPoolThreads(estado.pool);
+    imprimirRelatorioMemoria(stdout);
+    liberarBuffersTemporarios();
+    if (estado.registro) {
+        fclose(estado.registro);
+    }
+    return 0;
+}
@@ -0,0 +1,513 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Descrição:
+ * Este programa faz operações de conjunto sobre arquivos binários já ordenados (no formato
+ * simples dos programas de ordenação: o comprimento seguido dos inteiros), sem carregar
+ * nem reordenar as entradas. As N entradas são lidas em fluxo, com buffers sequenciais
+ * grandes, e combinadas por uma árvore de perdedores (loser tree), que entrega o menor
+ * valor entre as N entradas com log2 N comparações.
+ *
+ * Operações (com repetições, como std::set_union e afins do C++):
+ * - mesclar (merge): todos os valores de todas as entradas, em ordem;
+ * - distintos (distinct): cada valor presente em alguma entrada, uma única vez;
+ * - uniao (union): cada valor tantas vezes quanto na entrada em que mais aparece;
+ * - intersecao (intersection): cada valor tantas vezes quanto na entrada em que menos
+ *   aparece (zero se faltar em alguma);
+ * - diferenca (difference): os valores da primeira entrada, descontadas as ocorrências nas
+ *   demais.
+ * Com entradas sem repetições, uniao, intersecao e diferenca são as operações de conjunto
+ * usuais.
+ *
+ * A interseção de duas entradas dispensa a árvore: cada lado avança até o valor atual do
+ * outro com comparações vetoriais (AVX2, com 8 valores por instrução, ou SSE2, com 4), o
+ * que salta rapidamente os trechos sem valores em comum.
+ *
+ * A ordem de cada entrada é verificada durante a leitura. A saída é gravada no mesmo
+ * formato binário, e o número de valores e o tempo são exibidos.
+ */
+
+#define TAMANHO_BUFFER_SAIDA (1L << 20)  // Valores do buffer de saída (4 MB)
+#define MEMORIA_ENTRADAS     (64L << 20) // Bytes divididos entre os buffers das entradas
+#define BUFFER_ENTRADA_MIN   (1L << 14)  // Valores mínimos do buffer de cada entrada
+#define BUFFER_ENTRADA_MAX   (1L << 20)  // Valores máximos do buffer de cada entrada
+#define FIM_ENTRADA          LLONG_MAX   // Chave de uma entrada esgotada na árvore
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+// Operações disponíveis
+typedef enum {
+    OP_MESCLAR = 0,
+    OP_DISTINTOS,
+    OP_UNIAO,
+    OP_INTERSECAO,
+    OP_DIFERENCA
+} Operacao;
+
+// Leitura em fluxo de uma entrada ordenada
+typedef struct {
+    const char *nome;
+    int fd;
+    long restantes;  // Valores ainda não lidos do arquivo
+    int *buffer;
+    long capacidade;
+    long tamanho;    // Valores válidos no buffer
+    long posicao;    // Próximo valor do buffer
+    long long atual; // Valor atual ou FIM_ENTRADA
+    int anterior;    // Último valor do bloco anterior (verificação da ordem)
+    int lidos;       // 1 depois do primeiro bloco
+} LeitorOrdenado;
+
+// Gravação em fluxo da saída
+typedef struct {
+    int fd;
+    int *buffer;
+    long usados;
+    long total;
+} EscritorOrdenado;
+
+static int erroLeitura = 0;
+
+// Função para ler o próximo bloco da entrada; retorna o número de valores lidos (0 no fim)
+static long recarregar(LeitorOrdenado *leitor) {
+    leitor->tamanho = 0;
+    leitor->posicao = 0;
+    if (leitor->restantes == 0 || erroLeitura) {
+        return 0;
+    }
+
+    long quantidade = leitor->restantes < leitor->capacidade ? leitor->restantes : leitor->capacidade;
+    size_t bytes = (size_t)quantidade * sizeof(int), lidos = 0;
+    while (lidos < bytes) {
+        ssize_t ret = read(leitor->fd, (char *)leitor->buffer + lidos, bytes - lidos);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            fprintf(stderr, "Erro: Falha ao ler %s (%s).\n", leitor->nome, ret < 0 ? strerror(errno) : "fim do arquivo");
+            erroLeitura = 1;
+            return 0;
+        }
+        lidos += (size_t)ret;
+    }
+
+    // O bloco precisa continuar a ordem do bloco anterior
+    const int *v = leitor->buffer;
+    int ordenado = !leitor->lidos || v[0] >= leitor->anterior;
+    for (long i = 1; ordenado && i < quantidade; i++) {
+        ordenado = v[i] >= v[i - 1];
+    }
+    if (!ordenado) {
+        fprintf(stderr, "Erro: O arquivo %s não está ordenado.\n", leitor->nome);
+        erroLeitura = 1;
+        return 0;
+    }
+
+    leitor->anterior = v[quantidade - 1];
+    leitor->lidos = 1;
+    leitor->restantes -= quantidade;
+    leitor->tamanho = quantidade;
+    return quantidade;
+}
+
+// Função para garantir um valor disponível no buffer; retorna 0 se a entrada acabou
+static int disponivel(LeitorOrdenado *leitor) {
+    return leitor->posicao < leitor->tamanho || recarregar(leitor) > 0;
+}
+
+// Função para avançar a entrada e atualizar o valor atual
+static void avancar(LeitorOrdenado *leitor) {
+    leitor->posicao++;
+    leitor->atual = disponivel(leitor) ? leitor->buffer[leitor->posicao] : FIM_ENTRADA;
+}
+
+// Função para abrir uma entrada e ler o seu primeiro bloco
+static int abrirLeitor(LeitorOrdenado *leitor, const char *nome, long capacidade) {
+    memset(leitor, 0, sizeof(*leitor));
+    leitor->nome = nome;
+    leitor->fd = open(nome, O_RDONLY);
+    if (leitor->fd < 0) {
+        fprintf(stderr, "Erro: Não foi possível abrir %s.\n", nome);
+        return -1;
+    }
+    posix_fadvise(leitor->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    int n;
+    if (read(leitor->fd, &n, sizeof(n)) != (ssize_t)sizeof(n) || n < 0) {
+        fprintf(stderr, "Erro: %s não é um vetor binário simples.\n", nome);
+        close(leitor->fd);
+        return -1;
+    }
+    leitor->restantes = n;
+    leitor->capacidade = capacidade;
+    leitor->buffer = malloc((size_t)capacidade * sizeof(int));
+    if (!leitor->buffer) {
+        perror("Falha na alocação de memória");
+        close(leitor->fd);
+        return -1;
+    }
+    leitor->atual = recarregar(leitor) > 0 ? leitor->buffer[0] : FIM_ENTRADA;
+    return 0;
+}
+
+// Função para fechar uma entrada
+static void fecharLeitor(LeitorOrdenado *leitor) {
+    free(leitor->buffer);
+    close(leitor->fd);
+}
+
+// Função para gravar o buffer de saída
+static int descarregar(EscritorOrdenado *escritor) {
+    size_t bytes = (size_t)escritor->usados * sizeof(int), gravados = 0;
+    while (gravados < bytes) {
+        ssize_t ret = write(escritor->fd, (const char *)escritor->buffer + gravados, bytes - gravados);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            perror("Erro ao gravar a saída");
+            return -1;
+        }
+        gravados += (size_t)ret;
+    }
+    escritor->usados = 0;
+    return 0;
+}
+
+// Função para acrescentar repeticoes cópias do valor à saída
+static int emitir(EscritorOrdenado *escritor, int valor, long repeticoes) {
+    for (long r = 0; r < repeticoes; r++) {
+        if (escritor->usados == TAMANHO_BUFFER_SAIDA && descarregar(escritor) != 0) {
+            return -1;
+        }
+        escritor->buffer[escritor->usados++] = valor;
+    }
+    escritor->total += repeticoes;
+    return 0;
+}
+
+// Função para verificar se a entrada a vence a entrada b (menor valor; empate pelo índice)
+static int vence(const LeitorOrdenado *leitores, int a, int b) {
+    return leitores[a].atual < leitores[b].atual || (leitores[a].atual == leitores[b].atual && a < b);
+}
+
+// Função para montar a subárvore do nó, guardando os perdedores; retorna o vencedor
+static int construirArvore(int *perdedores, const LeitorOrdenado *leitores, int k, int no) {
+    if (no >= k) {
+        return no - k;
+    }
+    int esquerda = construirArvore(perdedores, leitores, k, 2 * no);
+    int direita = construirArvore(perdedores, leitores, k, 2 * no + 1);
+    if (vence(leitores, esquerda, direita)) {
+        perdedores[no] = direita;
+        return esquerda;
+    }
+    perdedores[no] = esquerda;
+    return direita;
+}
+
+// Função para refazer as partidas do caminho da folha do vencedor até a raiz
+static int repetirPartidas(int *perdedores, const LeitorOrdenado *leitores, int k, int vencedor) {
+    for (int no = (vencedor + k) / 2; no >= 1; no /= 2) {
+        if (vence(leitores, perdedores[no], vencedor)) {
+            int troca = perdedores[no];
+            perdedores[no] = vencedor;
+            vencedor = troca;
+        }
+    }
+    return vencedor;
+}
+
+// Função para combinar as k entradas pela árvore de perdedores
+static int combinarEntradas(LeitorOrdenado *leitores, int k, Operacao operacao, EscritorOrdenado *escritor) {
+    int *perdedores = malloc((size_t)k * sizeof(int));
+    long *contagens = calloc((size_t)k, sizeof(long));
+    if (!perdedores || !contagens) {
+        perror("Falha na alocação de memória");
+        free(perdedores);
+        free(contagens);
+        return -1;
+    }
+
+    int erro = 0;
+    int vencedor = construirArvore(perdedores, leitores, k, 1);
+    while (erro == 0 && leitores[vencedor].atual != FIM_ENTRADA) {
+        int valor = (int)leitores[vencedor].atual;
+
+        // Na mesclagem, cada valor vai direto para a saída
+        if (operacao == OP_MESCLAR) {
+            erro = emitir(escritor, valor, 1);
+            avancar(&leitores[vencedor]);
+            vencedor = repetirPartidas(perdedores, leitores, k, vencedor);
+            continue;
+        }
+
+        // Nas demais, as ocorrências do valor são contadas por entrada
+        while (leitores[vencedor].atual == valor) {
+            contagens[vencedor]++;
+            avancar(&leitores[vencedor]);
+            vencedor = repetirPartidas(perdedores, leitores, k, vencedor);
+        }
+
+        long repeticoes = 0;
+        if (operacao == OP_DISTINTOS) {
+            repeticoes = 1;
+        } else if (operacao == OP_UNIAO) {
+            for (int i = 0; i < k; i++) {
+                repeticoes = contagens[i] > repeticoes ? contagens[i] : repeticoes;
+            }
+        } else if (operacao == OP_INTERSECAO) {
+            repeticoes = contagens[0];
+            for (int i = 1; i < k; i++) {
+                repeticoes = contagens[i] < repeticoes ? contagens[i] : repeticoes;
+            }
+        } else {
+            repeticoes = contagens[0];
+            for (int i = 1; i < k; i++) {
+                repeticoes -= contagens[i];
+            }
+        }
+        if (repeticoes > 0) {
+            erro = emitir(escritor, valor, repeticoes);
+        }
+        memset(contagens, 0, (size_t)k * sizeof(long));
+    }
+
+    free(perdedores);
+    free(contagens);
+    return erro;
+}
+
+// Função para encontrar, a partir de inicio, o primeiro valor maior ou igual à chave
+static long primeiroNaoMenorEscalar(const int *v, long inicio, long fim, int chave) {
+    while (inicio < fim && v[inicio] < chave) {
+        inicio++;
+    }
+    return inicio;
+}
+
+#if defined(__x86_64__)
+// Função para encontrar o primeiro valor maior ou igual à chave com comparações de 4 valores (SSE2)
+static long primeiroNaoMenorSSE2(const int *v, long inicio, long fim, int chave) {
+    __m128i c = _mm_set1_epi32(chave);
+    while (inicio + 16 <= fim && v[inicio + 15] < chave) {
+        inicio += 16;
+    }
+    while (inicio + 4 <= fim) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(v + inicio));
+        int menores = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(c, x)));
+        if (menores != 0xF) {
+            return inicio + __builtin_ctz(~menores);
+        }
+        inicio += 4;
+    }
+    return primeiroNaoMenorEscalar(v, inicio, fim, chave);
+}
+
+// Função para encontrar o primeiro valor maior ou igual à chave com comparações de 8 valores (AVX2)
+__attribute__((target("avx2")))
+static long primeiroNaoMenorAVX2(const int *v, long inicio, long fim, int chave) {
+    __m256i c = _mm256_set1_epi32(chave);
+    while (inicio + 32 <= fim && v[inicio + 31] < chave) {
+        inicio += 32;
+    }
+    while (inicio + 8 <= fim) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(v + inicio));
+        int menores = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(c, x)));
+        if (menores != 0xFF) {
+            return inicio + __builtin_ctz(~menores);
+        }
+        inicio += 8;
+    }
+    return primeiroNaoMenorEscalar(v, inicio, fim, chave);
+}
+#endif
+
+// Função para avançar a entrada até o primeiro valor maior ou igual à chave; retorna 0 se ela acabou
+static int avancarAte(LeitorOrdenado *leitor, int chave,
+                      long (*primeiroNaoMenor)(const int *, long, long, int)) {
+    for (;;) {
+        leitor->posicao = primeiroNaoMenor(leitor->buffer, leitor->posicao, leitor->tamanho, chave);
+        if (leitor->posicao < leitor->tamanho) {
+            return 1;
+        }
+        if (recarregar(leitor) == 0) {
+            return 0;
+        }
+    }
+}
+
+// Função para intersectar duas entradas, saltando os trechos sem valores em comum
+static int intersectarDuas(LeitorOrdenado *a, LeitorOrdenado *b, EscritorOrdenado *escritor, const char **instrucoes) {
+    long (*primeiroNaoMenor)(const int *, long, long, int) = primeiroNaoMenorEscalar;
+    *instrucoes = "escalar";
+#if defined(__x86_64__)
+    primeiroNaoMenor = primeiroNaoMenorSSE2;
+    *instrucoes = "SSE2";
+    if (__builtin_cpu_supports("avx2")) {
+        primeiroNaoMenor = primeiroNaoMenorAVX2;
+        *instrucoes = "AVX2";
+    }
+#endif
+
+    int erro = 0;
+    while (erro == 0 && disponivel(a) && disponivel(b)) {
+        int x = a->buffer[a->posicao], y = b->buffer[b->posicao];
+        if (x < y) {
+            avancarAte(a, y, primeiroNaoMenor);
+        } else if (y < x) {
+            avancarAte(b, x, primeiroNaoMenor);
+        } else {
+            erro = emitir(escritor, x, 1);
+            a->posicao++;
+            b->posicao++;
+        }
+    }
+    return erro;
+}
+
+// Função para converter o nome da operação; retorna -1 se for inválido
+static int operacaoDoNome(const char *nome, Operacao *operacao) {
+    static const char *nomes[][2] = {
+        {"mesclar", "merge"}, {"distintos", "distinct"}, {"uniao", "union"},
+        {"intersecao", "intersection"}, {"diferenca", "difference"}
+    };
+    for (int i = 0; i < (int)(sizeof(nomes) / sizeof(nomes[0])); i++) {
+        if (strcmp(nome, nomes[i][0]) == 0 || strcmp(nome, nomes[i][1]) == 0) {
+            *operacao = (Operacao)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Função para verificar se a saída é uma das entradas (que seria truncada antes da leitura)
+static int saidaEhEntrada(const char *saida, char *entradas[], int k) {
+    struct stat s, e;
+    if (stat(saida, &s) < 0) {
+        return 0;
+    }
+    for (int i = 0; i < k; i++) {
+        if (stat(entradas[i], &e) == 0 && e.st_dev == s.st_dev && e.st_ino == s.st_ino) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    Operacao operacao;
+    if (argc < 4 || operacaoDoNome(argv[1], &operacao) != 0) {
+        fprintf(stderr, "Uso: %s <operação> <arquivo_saida> <entrada1> [entrada2 ...]\n", argv[0]);
+        fprintf(stderr, "Operações: mesclar (merge), distintos (distinct), uniao (union), intersecao (intersection),\n");
+        fprintf(stderr, "           diferenca (difference: a primeira entrada menos as demais)\n");
+        return 1;
+    }
+
+    int k = argc - 3;
+    char **nomes = argv + 3;
+    if (saidaEhEntrada(argv[2], nomes, k)) {
+        fprintf(stderr, "Erro: O arquivo de saída não pode ser uma das entradas.\n");
+        return 1;
+    }
+
+    // A memória dos buffers de entrada é dividida entre as entradas
+    long capacidade = MEMORIA_ENTRADAS / (long)sizeof(int) / k;
+    capacidade = capacidade < BUFFER_ENTRADA_MIN ? BUFFER_ENTRADA_MIN : capacidade;
+    capacidade = capacidade > BUFFER_ENTRADA_MAX ? BUFFER_ENTRADA_MAX : capacidade;
+
+    LeitorOrdenado *leitores = calloc((size_t)k, sizeof(LeitorOrdenado));
+    EscritorOrdenado escritor = {0};
+    escritor.fd = -1;
+    escritor.buffer = malloc(TAMANHO_BUFFER_SAIDA * sizeof(int));
+    if (!leitores || !escritor.buffer) {
+        perror("Falha na alocação de memória");
+        free(leitores);
+        free(escritor.buffer);
+        return 1;
+    }
+
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+    int abertos = 0, erro = 0;
+    while (abertos < k && abrirLeitor(&leitores[abertos], nomes[abertos], capacidade) == 0) {
+        abertos++;
+    }
+    if (abertos < k) {
+        erro = -1;
+    }
+
+    // O cabeçalho é gravado ao final, quando o número de valores for conhecido
+    if (erro == 0) {
+        escritor.fd = open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (escritor.fd < 0 || lseek(escritor.fd, sizeof(int), SEEK_SET) < 0) {
+            perror("Erro ao criar o arquivo de saída");
+            erro = -1;
+        }
+    }
+
+    const char *metodo = "árvore de perdedores";
+    const char *instrucoes = NULL;
+    if (erro == 0 && operacao == OP_INTERSECAO && k == 2) {
+        erro = intersectarDuas(&leitores[0], &leitores[1], &escritor, &instrucoes);
+        metodo = "interseção vetorial";
+    } else if (erro == 0) {
+        erro = combinarEntradas(leitores, k, operacao, &escritor);
+    }
+
+    if (erro == 0 && !erroLeitura && escritor.total > INT_MAX) {
+        fprintf(stderr, "Erro: A saída passa do tamanho máximo do formato (%d valores).\n", INT_MAX);
+        erro = -1;
+    }
+    if (erro == 0 && !erroLeitura) {
+        int total = (int)escritor.total;
+        erro = descarregar(&escritor);
+        if (erro == 0 && pwrite(escritor.fd, &total, sizeof(total), 0) != (ssize_t)sizeof(total)) {
+            perror("Erro ao gravar o cabeçalho da saída");
+            erro = -1;
+        }
+    }
+    OBTER_TEMPO(fim);
+
+    if (escritor.fd >= 0) {
+        close(escritor.fd);
+        if (erro != 0 || erroLeitura) {
+            unlink(argv[2]);
+        }
+    }
+    for (int i = 0; i < abertos; i++) {
+        fecharLeitor(&leitores[i]);
+    }
+    free(leitores);
+    free(escritor.buffer);
+    if (erro != 0 || erroLeitura) {
+        return 1;
+    }
+
+    if (instrucoes) {
+        printf("Método: %s (%s)\n", metodo, instrucoes);
+    } else {
+        printf("Método: %s com %d entrada(s)\n", metodo, k);
+    }
+    printf("Valores na saída: %ld\n", escritor.total);
+    printf("Tempo: %f segundos\n", fim - inicio);
+    printf("Resultado salvo em %s\n", argv[2]);
+    return 0;
+}
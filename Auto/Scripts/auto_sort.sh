@@ -0,0 +1,54 @@
+#!/bin/bash
+
+# Definir cores para melhor visibilidade
+RED="\033[1;31m"
+BLUE="\033[1;34m"
+WHITE="\033[1;37m"
+GREEN="\033[1;32m"
+RESET="\033[0m"
+
+# Banner
+echo -e "${RED}**************************************************"
+echo -e "${RED}-                                                -"
+echo -e "${RED}-             ${BLUE}Ordenação Automática${RED}               -"
+echo -e "${RED}-                                                -"
+echo -e "${RED}**************************************************${RESET}"
+
+# Descrição:
+# Este script compila o programa Ordenar, que escolhe sozinho o algoritmo e o número de threads
+# de cada entrada (ver Code/Common/Despacho.h), e o executa para cada arquivo de entrada binário,
+# gravando as saídas em Files/Output/AutoSort. O plano de cada arquivo, com o tempo previsto e o
+# real, é registrado em Data/despacho.csv.
+# Opções extras do programa (ex.: --es uring) podem ser passadas pela variável de ambiente OPCOES_ORDENACAO.
+
+# Diretório contendo o programa e diretório dos arquivos de entrada e saída
+diretorio_programa="Code/AutoSort"
+diretorio_arquivos="Files"
+diretorio_saida="$diretorio_arquivos/Output/AutoSort"
+
+# Compilar o programa
+echo -e "${BLUE}Compilando o programa Ordenar...${RESET}"
+gcc -ICode -o "$diretorio_programa/Ordenar" "$diretorio_programa/Ordenar.c" Code/Common/*.c -lpthread
+if [[ $? -ne 0 ]]; then
+    echo -e "${RED}Erro ao compilar Ordenar${RESET}"
+    echo "--------------------------------------------------"
+    exit 1
+fi
+echo "--------------------------------------------------"
+
+# Perguntar o número máximo de threads (vazio = uma por CPU)
+echo -e "${BLUE}Número máximo de threads (Enter = uma por CPU):  ${GREEN}"
+read max_threads
+echo -e "${RESET}--------------------------------------------------"
+
+mkdir -p "$diretorio_saida"
+
+# Ordenar cada arquivo de entrada com o plano escolhido pelo programa
+arquivos_entrada=($(ls -t "$diretorio_arquivos/Input"/*.bin))
+for ((i=0; i<${#arquivos_entrada[@]}; i++)); do
+    echo -e "${BLUE}Ordenando ${arquivos_entrada[$i]}...${RESET}"
+    "$diretorio_programa/Ordenar" "${arquivos_entrada[$i]}" "$diretorio_saida/Output$i.bin" $max_threads $OPCOES_ORDENACAO
+    echo "--------------------------------------------------"
+done
+
+echo -e "${RED}**************************************************${RESET}"
@@ -0,0 +1,41 @@
+#!/bin/bash
+
+# Definir cores para melhor visibilidade
+RED="\033[1;31m"
+BLUE="\033[1;34m"
+WHITE="\033[1;37m"
+GREEN="\033[1;32m"
+RESET="\033[0m"
+
+# Banner
+echo -e "${RED}**************************************************"
+echo -e "${RED}-                                                -"
+echo -e "${RED}-            ${BLUE}Autoajuste da Máquina${RED}               -"
+echo -e "${RED}-                                                -"
+echo -e "${RED}**************************************************${RESET}"
+
+# Descrição:
+# Este script compila o programa Autoajuste e o executa uma vez, calibrando os algoritmos de
+# ordenação na máquina atual (limites de inserção e de tarefa, threads por tamanho e
+# coeficientes do modelo de custo, ver Code/Common/Ajuste.h). O perfil é gravado em
+# Data/ajuste.conf e carregado automaticamente por todos os programas de ordenação.
+# O tamanho máximo da calibração pode ser passado como argumento (padrão: 1000000).
+
+# Diretório contendo o programa e arquivo do perfil
+diretorio_programa="Code/Autotune"
+arquivo_perfil="Data/ajuste.conf"
+
+# Compilar o programa
+echo -e "${BLUE}Compilando o programa Autoajuste...${RESET}"
+gcc -ICode -o "$diretorio_programa/Autoajuste" "$diretorio_programa/Autoajuste.c" Code/Common/*.c -lpthread
+if [[ $? -ne 0 ]]; then
+    echo -e "${RED}Erro ao compilar Autoajuste${RESET}"
+    echo "--------------------------------------------------"
+    exit 1
+fi
+echo "--------------------------------------------------"
+
+# Executar a calibração
+echo -e "${BLUE}Calibrando (alguns segundos)...${RESET}"
+"$diretorio_programa/Autoajuste" "$arquivo_perfil" $1
+echo -e "${RED}**************************************************${RESET}"
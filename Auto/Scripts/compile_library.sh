@@ -0,0 +1,54 @@
+#!/bin/bash
+
+# Definir cores para melhor visibilidade
+RED="\033[1;31m"
+BLUE="\033[1;34m"
+WHITE="\033[1;37m"
+GREEN="\033[1;32m"
+RESET="\033[0m"
+
+# Banner
+echo -e "${RED}**************************************************"
+echo -e "${RED}-                                                -"
+echo -e "${RED}-            ${BLUE}Compilar a libconcsort${RED}              -"
+echo -e "${RED}-                                                -"
+echo -e "${RED}**************************************************${RESET}"
+
+# Descrição:
+# Este script compila os módulos de Code/Common na biblioteca libconcsort, nas versões
+# estática (Lib/libconcsort.a) e compartilhada (Lib/libconcsort.so). A API fica em
+# Code/Common/Ordenacao.h. Um programa pode usá-la, por exemplo, com:
+#   gcc -ICode/Common -o app app.c Lib/libconcsort.a -lpthread
+#   gcc -ICode/Common -o app app.c -LLib -lconcsort -lpthread
+
+# Diretórios do código-fonte e da biblioteca
+diretorio_fonte="Code/Common"
+diretorio_lib="Lib"
+diretorio_objetos="$diretorio_lib/obj"
+
+mkdir -p "$diretorio_objetos"
+
+# Compilar cada módulo como código independente de posição (usado pelas duas versões)
+for fonte in "$diretorio_fonte"/*.c; do
+    objeto="$diretorio_objetos/$(basename "$fonte" .c).o"
+    echo -e "${BLUE}Compilando $fonte...${RESET}"
+    gcc -O2 -fPIC -c -o "$objeto" "$fonte"
+    if [[ $? -ne 0 ]]; then
+        echo -e "${RED}Erro ao compilar $fonte${RESET}"
+        echo "--------------------------------------------------"
+        exit 1
+    fi
+done
+
+# Gerar a biblioteca estática e a compartilhada
+rm -f "$diretorio_lib/libconcsort.a"
+ar rcs "$diretorio_lib/libconcsort.a" "$diretorio_objetos"/*.o && \
+gcc -shared -o "$diretorio_lib/libconcsort.so" "$diretorio_objetos"/*.o -lpthread
+if [[ $? -ne 0 ]]; then
+    echo -e "${RED}Erro ao gerar a biblioteca${RESET}"
+    echo "--------------------------------------------------"
+    exit 1
+fi
+
+echo -e "${GREEN}Biblioteca gerada em $diretorio_lib/libconcsort.a e $diretorio_lib/libconcsort.so${RESET}"
+echo -e "${RED}**************************************************${RESET}"
@@ -19,10 +19,11 @@ echo -e "${RED}**************************************************${RESET}"
 # O script segue as etapas abaixo:
 # 1. Verifica se cada programa C já foi compilado. Se não, compila o programa.
 # 2. Pergunta ao usuário quantas threads o programa deve usar.
-# 3. Para cada arquivo de entrada binário no diretório de entrada, o programa é executado com o número de threads especificado.
+# 3. Todos os arquivos de entrada binários do diretório de entrada são ordenados por uma única execução do programa (modo em lote, com um manifesto), com o número de threads especificado.
 # 4. Os resultados são armazenados em arquivos de saída com base no índice de execução.
 # 5. Cada conjunto de arquivos de saída é organizado em um diretório com o nome do número de threads.
-# O script processa todos os arquivos de entrada binários, executando o programa para cada um e gerando os arquivos de saída correspondentes.
+# O script processa todos os arquivos de entrada binários em uma única execução do programa, gerando os arquivos de saída correspondentes.
+# Opções extras dos programas (ex.: --es uring) podem ser passadas pela variável de ambiente OPCOES_ORDENACAO.
 
 # Diretório contendo o programa em C (Fonte)
 diretorio_programas="Code/MinMaxSort/Conc"
@@ -61,7 +62,7 @@ for programa in "$diretorio_programas"/*.c; do
             # Compilar novamente o programa
             echo -e "${BLUE}Compilando $nome_programa novamente...${RESET}"
             echo "--------------------------------------------------"
-            gcc -o "$diretorio_programas/$nome_programa" "$programa"
+            gcc -ICode -o "$diretorio_programas/$nome_programa" "$programa" Code/Common/*.c -lpthread
             
             # Verificar se a compilação foi bem-sucedida
             if [[ $? -ne 0 ]]; then
@@ -75,7 +76,7 @@ for programa in "$diretorio_programas"/*.c; do
         # Compilar o programa se não estiver compilado
         echo -e "${BLUE}Compilando $nome_programa...${RESET}"
         echo "--------------------------------------------------"
-        gcc -o "$diretorio_programas/$nome_programa" "$programa"
+        gcc -ICode -o "$diretorio_programas/$nome_programa" "$programa" Code/Common/*.c -lpthread
         
         # Verificar se a compilação foi bem-sucedida
         if [[ $? -ne 0 ]]; then
@@ -94,37 +95,37 @@ for programa in "$diretorio_programas"/*.c; do
     # Obter a lista de arquivos de entrada, ordenados pela data de modificação (mais recentes primeiro)
     arquivos_entrada=($(ls -t "$diretorio_arquivos/Input"/*.bin))
 
-    # Loop através de cada arquivo de entrada pelo índice
+    # Criar um diretório com o nome do número de threads 
+    diretorio_threads="$diretorio_arquivos/Output/MinMaxSort/Conc/$num_threads threads"
+    mkdir -p "$diretorio_threads"  # Cria o diretório se ele não existir
+
+    # Montar o manifesto do modo em lote (uma linha "entrada<TAB>saida" por execução), para que
+    # todos os arquivos sejam ordenados por um único processo, com o mesmo pool de threads
+    manifesto=$(mktemp)
     for ((i=0; i<${#arquivos_entrada[@]}; i++)); do
         # Obter o caminho do arquivo de entrada
         arquivo_entrada="${arquivos_entrada[$i]}"
 
-        # Gerar o nome do arquivo de saída com base no índice (Output0.bin, Output1.bin, etc.)
-        arquivo_saida="Output$i.bin"
-
-        # Criar um diretório com o nome do número de threads 
-        diretorio_threads="$diretorio_arquivos/Output/MinMaxSort/Conc/$num_threads threads"
-        mkdir -p "$diretorio_threads"  # Cria o diretório se ele não existir
-
-        # Exibir mensagem de status para o usuário sobre o que está sendo executado
-        echo -e "${BLUE}Executando $nome_programa com $arquivo_entrada como entrada, $arquivo_saida como saída, usando $num_threads threads.${RESET}"
-
         # Verificar se o usuário deseja rodar 5 vezes para cada arquivo
         if [[ "$rodar_5_vezes" == "s" ]]; then
             for ((j=1; j<=5; j++)); do
-                echo -e "${BLUE}Execução $j de 5...${RESET}"
-                # Executar o programa com os arquivos de entrada, saída e o número de threads como argumentos
-                "$diretorio_programas/$nome_programa" "$arquivo_entrada" "$diretorio_threads/$arquivo_saida" "$num_threads"
                 # Adicionar um sufixo para a saída (Output0_1.bin, Output0_2.bin, etc.)
-                arquivo_saida="Output${i}_${j}.bin"
+                printf '%s\t%s\n' "$arquivo_entrada" "$diretorio_threads/Output${i}_${j}.bin" >> "$manifesto"
             done
         else
-            # Caso contrário, rodar uma vez
-            "$diretorio_programas/$nome_programa" "$arquivo_entrada" "$diretorio_threads/$arquivo_saida" "$num_threads"
+            # Caso contrário, rodar uma vez (Output0.bin, Output1.bin, etc.)
+            printf '%s\t%s\n' "$arquivo_entrada" "$diretorio_threads/Output$i.bin" >> "$manifesto"
         fi
-
-        # Separador visual para clareza no terminal entre execuções de programas
-        echo "--------------------------------------------------"
     done
+
+    # Exibir mensagem de status para o usuário sobre o que está sendo executado
+    echo -e "${BLUE}Executando $nome_programa com ${#arquivos_entrada[@]} arquivos de entrada, usando $num_threads threads.${RESET}"
+
+    # Executar o programa uma única vez para todo o lote
+    "$diretorio_programas/$nome_programa" "$num_threads" --manifesto "$manifesto" $OPCOES_ORDENACAO
+    rm -f "$manifesto"
+
+    # Separador visual para clareza no terminal entre execuções de programas
+    echo "--------------------------------------------------"
 done
 echo -e "${RED}**************************************************${RESET}"
\ No newline at end of file
@@ -19,9 +19,10 @@ echo -e "${RED}**************************************************${RESET}"
 # Para cada programa C encontrado no diretório especificado, o script:
 # 1. Compila o programa (se necessário).
 # 2. Pergunta ao usuário quantas threads o programa deve usar.
-# 3. Para cada arquivo de entrada binário encontrado no diretório de entrada, o programa é executado com o número de threads especificado.
+# 3. Todos os arquivos de entrada binários do diretório de entrada são ordenados por uma única execução do programa (modo em lote, com um manifesto), com o número de threads especificado.
 # 4. O script cria diretórios de saída organizados por número de threads e executa o programa em cada arquivo de entrada gerando arquivos de saída correspondentes.
 # 5. O nome do arquivo de saída é gerado automaticamente com base no índice da execução.
+# Opções extras dos programas (ex.: --es uring) podem ser passadas pela variável de ambiente OPCOES_ORDENACAO.
 
 # Diretório contendo os programas em C (Fonte)
 diretorio_programas="Code/Quicksort/Conc"
@@ -54,7 +55,7 @@ for programa in "$diretorio_programas"/*.c; do
         # Compilar o programa C caso o executável não exista
         echo -e "${BLUE}Compilando o programa $nome_programa...${RESET}"
         echo "--------------------------------------------------"
-        gcc -o "$programa_compilado" "$programa"
+        gcc -ICode -o "$programa_compilado" "$programa" Code/Common/*.c -lpthread
 
         # Verificar se a compilação foi bem-sucedida
         if [[ $? -ne 0 ]]; then
@@ -70,7 +71,7 @@ for programa in "$diretorio_programas"/*.c; do
         if [[ "$resposta" == "s" || "$resposta" == "S" ]]; then
             echo -e "${BLUE}Recompilando o programa $nome_programa...${RESET}"
             echo "--------------------------------------------------"
-            gcc -o "$programa_compilado" "$programa"
+            gcc -ICode -o "$programa_compilado" "$programa" Code/Common/*.c -lpthread
             
             # Verificar se a recompilação foi bem-sucedida
             if [[ $? -ne 0 ]]; then
@@ -94,37 +95,38 @@ for programa in "$diretorio_programas"/*.c; do
     # Obter a lista de arquivos de entrada, ordenados pela data de modificação (mais recentes primeiro)
     arquivos_entrada=($(ls -t "$diretorio_arquivos/Input"/*.bin))
 
-    # Loop através de cada arquivo de entrada binário pelo índice
+    # Criar um diretório com o nome do número de threads
+    diretorio_threads="$diretorio_arquivos/Output/Quicksort/Conc/$num_threads threads"
+    mkdir -p "$diretorio_threads"  # Cria o diretório se ele não existir
+
+    # Montar o manifesto do modo em lote (uma linha "entrada<TAB>saida" por execução), para que
+    # todos os arquivos sejam ordenados por um único processo, com o mesmo pool de threads
+    manifesto=$(mktemp)
     for ((i=0; i<${#arquivos_entrada[@]}; i++)); do
         # Obter o caminho do arquivo de entrada
         arquivo_entrada="${arquivos_entrada[$i]}"
 
-        # Criar um diretório com o nome do número de threads
-        diretorio_threads="$diretorio_arquivos/Output/Quicksort/Conc/$num_threads threads"
-        mkdir -p "$diretorio_threads"  # Cria o diretório se ele não existir
-
-        # Exibir mensagem de status para o usuário sobre o que está sendo executado
-        echo -e "${BLUE}Executando $nome_programa com $arquivo_entrada como entrada, usando $num_threads threads.${RESET}"
-
         # Verificar se o usuário deseja rodar 5 vezes para cada arquivo
         if [[ "$rodar_5_vezes" == "s" ]]; then
             for ((j=1; j<=5; j++)); do
                 # Gerar o nome do arquivo de saída com base no índice e execução (ex: Output0_1.bin, Output0_2.bin, etc.)
-                arquivo_saida="Output${i}_${j}.bin"
-                echo -e "${BLUE}Execução $j de 5...${RESET}"
-                
-                # Executar o programa com os arquivos de entrada, saída e o número de threads como argumentos
-                "$programa_compilado" "$arquivo_entrada" "$diretorio_threads/$arquivo_saida" "$num_threads"
+                printf '%s\t%s\n' "$arquivo_entrada" "$diretorio_threads/Output${i}_${j}.bin" >> "$manifesto"
             done
         else
             # Caso contrário, rodar uma vez
-            arquivo_saida="Output$i.bin"
-            "$programa_compilado" "$arquivo_entrada" "$diretorio_threads/$arquivo_saida" "$num_threads"
+            printf '%s\t%s\n' "$arquivo_entrada" "$diretorio_threads/Output$i.bin" >> "$manifesto"
         fi
-
-        # Separador visual para clareza no terminal entre execuções de programas
-        echo "--------------------------------------------------"
     done
+
+    # Exibir mensagem de status para o usuário sobre o que está sendo executado
+    echo -e "${BLUE}Executando $nome_programa com ${#arquivos_entrada[@]} arquivos de entrada, usando $num_threads threads.${RESET}"
+
+    # Executar o programa uma única vez para todo o lote
+    "$programa_compilado" "$num_threads" --manifesto "$manifesto" $OPCOES_ORDENACAO
+    rm -f "$manifesto"
+
+    # Separador visual para clareza no terminal entre execuções de programas
+    echo "--------------------------------------------------"
 done
 
 echo -e "${RED}**************************************************${RESET}"
\ No newline at end of file
@@ -0,0 +1,75 @@
+#!/bin/bash
+
+# Definir cores para melhor visibilidade
+RED="\033[1;31m"
+BLUE="\033[1;34m"
+WHITE="\033[1;37m"
+GREEN="\033[1;32m"
+RESET="\033[0m"
+
+# Banner
+echo -e "${RED}**************************************************"
+echo -e "${RED}-                                                -"
+echo -e "${RED}-        ${BLUE}Quicksort: Um Pivô x Dois Pivôs${RED}         -"
+echo -e "${RED}-                                                -"
+echo -e "${RED}**************************************************${RESET}"
+
+# Descrição:
+# Este script compila o SeqQuicksort e o ConcQuickSort e ordena cada arquivo de entrada binário
+# com as quatro partições: Hoare (SeqQuicksort), dois pivôs sequencial (SeqQuicksort --duplo-pivo),
+# Lomuto (ConcQuickSort) e dois pivôs concorrente (ConcQuickSort --duplo-pivo). Ao final, exibe
+# uma tabela com o tempo de cada partição por arquivo. Os tempos também ficam nos logs de cada
+# programa (Data/seq_quicksort.txt e Data/conc_quicksort.txt, com o sufixo DuploPivo no nome).
+# O número de threads dos concorrentes pode ser passado como argumento (padrão: uma por CPU).
+# Opções extras dos programas (ex.: --es uring) podem ser passadas pela variável de ambiente OPCOES_ORDENACAO.
+
+# Diretórios dos programas e dos arquivos de entrada e saída
+diretorio_seq="Code/Quicksort/Seq"
+diretorio_conc="Code/Quicksort/Conc"
+diretorio_arquivos="Files"
+diretorio_saida="$diretorio_arquivos/Output/Quicksort/Pivos"
+num_threads=${1:-$(nproc)}
+
+# Compilar os programas
+for programa in "$diretorio_seq/SeqQuicksort" "$diretorio_conc/ConcQuickSort"; do
+    echo -e "${BLUE}Compilando o programa $(basename "$programa")...${RESET}"
+    gcc -ICode -o "$programa" "$programa.c" Code/Common/*.c -lpthread
+    if [[ $? -ne 0 ]]; then
+        echo -e "${RED}Erro ao compilar $(basename "$programa")${RESET}"
+        echo "--------------------------------------------------"
+        exit 1
+    fi
+done
+echo "--------------------------------------------------"
+
+mkdir -p "$diretorio_saida"
+
+# Função para extrair o tempo de ordenação da saída de um programa
+tempo_ordenacao() {
+    "$@" $OPCOES_ORDENACAO | grep -E "^Tempo (gasto para ordenar|de ordenação):" | grep -oE "[0-9]+\.[0-9]+"
+}
+
+# Ordenar cada arquivo com as quatro partições
+tabela=$(mktemp)
+arquivos_entrada=($(ls -t "$diretorio_arquivos/Input"/*.bin))
+for ((i=0; i<${#arquivos_entrada[@]}; i++)); do
+    entrada="${arquivos_entrada[$i]}"
+    saida="$diretorio_saida/Output$i.bin"
+    echo -e "${BLUE}Ordenando $entrada...${RESET}"
+    hoare=$(tempo_ordenacao "$diretorio_seq/SeqQuicksort" "$entrada" "$saida")
+    duplo_seq=$(tempo_ordenacao "$diretorio_seq/SeqQuicksort" "$entrada" "$saida" --duplo-pivo)
+    lomuto=$(tempo_ordenacao "$diretorio_conc/ConcQuickSort" "$entrada" "$saida" "$num_threads")
+    duplo_conc=$(tempo_ordenacao "$diretorio_conc/ConcQuickSort" "$entrada" "$saida" "$num_threads" --duplo-pivo)
+    printf '%s\t%s\t%s\t%s\t%s\n' "$(basename "$entrada")" "$hoare" "$duplo_seq" "$lomuto" "$duplo_conc" >> "$tabela"
+done
+echo "--------------------------------------------------"
+
+# Exibir a comparação (tempos em segundos)
+echo -e "${WHITE}Tempos em segundos ($num_threads thread(s) nos concorrentes):${RESET}"
+printf "%-14s %12s %12s %12s %12s\n" "Entrada" "Hoare" "DuploSeq" "Lomuto" "DuploConc"
+while IFS=$'\t' read -r nome hoare duplo_seq lomuto duplo_conc; do
+    printf "%-14s %12s %12s %12s %12s\n" "$nome" "$hoare" "$duplo_seq" "$lomuto" "$duplo_conc"
+done < "$tabela"
+rm -f "$tabela"
+
+echo -e "${RED}**************************************************${RESET}"
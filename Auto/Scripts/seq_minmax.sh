@@ -21,7 +21,8 @@ echo -e "${RED}**************************************************${RESET}"
 # Após a compilação (ou verificação da existência do programa compilado), o script executa cada programa em uma série de arquivos de entrada binários.
 # O programa gerará arquivos de saída correspondentes, com base na execução de algoritmos de ordenação (como MinMaxSort).
 # O script processa todos os arquivos de entrada binários localizados no diretório "Input" e gera arquivos de saída no diretório "Output".
-# Cada programa é executado uma vez para cada arquivo de entrada binário.
+# Cada programa é executado uma única vez para todos os arquivos de entrada (modo em lote, com um manifesto).
+# Opções extras dos programas (ex.: --es uring) podem ser passadas pela variável de ambiente OPCOES_ORDENACAO.
 
 # Diretório contendo os programas em C (Fonte)
 diretorio_programas="Code/MinMaxSort/Seq"
@@ -42,7 +43,7 @@ for programa in "$diretorio_programas"/*.c; do
         # Se o programa não foi compilado, compilar o programa C
         echo -e "${BLUE}Compilando o programa $nome_programa...${RESET}"
         echo "--------------------------------------------------"
-        gcc -o "$programa_compilado" "$programa"
+        gcc -ICode -o "$programa_compilado" "$programa" Code/Common/*.c -lpthread
 
         # Verificar se a compilação foi bem-sucedida
         if [[ $? -ne 0 ]]; then
@@ -61,7 +62,7 @@ for programa in "$diretorio_programas"/*.c; do
                 # Compilar novamente
                 echo -e "${BLUE}Compilando novamente $nome_programa...${RESET}"
                 echo "--------------------------------------------------"
-                gcc -o "$programa_compilado" "$programa"
+                gcc -ICode -o "$programa_compilado" "$programa" Code/Common/*.c -lpthread
 
                 # Verificar se a compilação foi bem-sucedida
                 if [[ $? -ne 0 ]]; then
@@ -87,24 +88,24 @@ for programa in "$diretorio_programas"/*.c; do
     # Obter a lista de arquivos de entrada, ordenados pela data de modificação (mais recentes primeiro)
     arquivos_entrada=($(ls -t "$diretorio_arquivos/Input"/*.bin))
 
-    # Loop através de cada arquivo de entrada binário pelo índice
+    # Montar o manifesto do modo em lote (uma linha "entrada<TAB>saida" por arquivo), para que
+    # todos os arquivos sejam ordenados por um único processo
+    manifesto=$(mktemp)
     for ((i=0; i<${#arquivos_entrada[@]}; i++)); do
-        # Obter o caminho do arquivo de entrada
-        arquivo_entrada="${arquivos_entrada[$i]}"
-
         # Gerar o nome do arquivo de saída com base no nome do programa e no índice
         # O nome do arquivo de saída será algo como "Output0.bin", "Output1.bin", etc.
-        arquivo_saida="$diretorio_arquivos/Output/MinMaxSort/Seq/Output$i.bin"
+        printf '%s\t%s\n' "${arquivos_entrada[$i]}" "$diretorio_arquivos/Output/MinMaxSort/Seq/Output$i.bin" >> "$manifesto"
+    done
 
-        # Exibir mensagem de status para o usuário sobre o que está sendo executado
-        echo -e "${BLUE}Executando $nome_programa com $arquivo_entrada como entrada e $arquivo_saida como saída.${RESET}"
+    # Exibir mensagem de status para o usuário sobre o que está sendo executado
+    echo -e "${BLUE}Executando $nome_programa com ${#arquivos_entrada[@]} arquivos de entrada.${RESET}"
 
-        # Executar o programa compilado com os arquivos de entrada e saída como argumentos
-        "$programa_compilado" "$arquivo_entrada" "$arquivo_saida"
+    # Executar o programa compilado uma única vez para todo o lote
+    "$programa_compilado" --manifesto "$manifesto" $OPCOES_ORDENACAO
+    rm -f "$manifesto"
 
-        # Separador visual para clareza no terminal entre execuções de programas
-        echo "--------------------------------------------------"
-    done
+    # Separador visual para clareza no terminal entre execuções de programas
+    echo "--------------------------------------------------"
 done
 
 echo -e "${RED}**************************************************${RESET}"
\ No newline at end of file
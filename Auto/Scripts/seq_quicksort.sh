@@ -18,9 +18,10 @@ echo -e "${RED}**************************************************${RESET}"
 # Este script executa uma série de programas em C localizados em um diretório específico.
 # Para cada programa, ele verifica se o arquivo compilado já existe.
 # Se o programa já foi compilado, ele o executa diretamente. Caso contrário, o script compila o código fonte,
-# verifica se a compilação foi bem-sucedida e, em seguida, executa o programa para processar arquivos de entrada binários,
+# verifica se a compilação foi bem-sucedida e, em seguida, executa o programa uma única vez (modo em lote) para processar os arquivos de entrada binários,
 # gerando arquivos de saída. O diretório de entrada contém arquivos binários e o diretório de saída será utilizado
 # para armazenar os arquivos gerados pelos programas.
+# Opções extras dos programas (ex.: --es uring) podem ser passadas pela variável de ambiente OPCOES_ORDENACAO.
 
 # Diretório contendo os programas em C (Fonte)
 diretorio_programas="Code/Quicksort/Seq"
@@ -46,7 +47,7 @@ for programa in "$diretorio_programas"/*.c; do
                 # Se o usuário deseja recompilar, compilar o programa novamente
                 echo -e "${BLUE}Compilando o programa $nome_programa...${RESET}"
                 echo "--------------------------------------------------"
-                gcc -o "$caminho_programa_compilado" "$programa"
+                gcc -ICode -o "$caminho_programa_compilado" "$programa" Code/Common/*.c -lpthread
 
                 # Verificar se a compilação foi bem-sucedida (retorno 0 significa sucesso)
                 if [[ $? -ne 0 ]]; then
@@ -72,7 +73,7 @@ for programa in "$diretorio_programas"/*.c; do
         # Se o programa não foi compilado, compilar o programa C usando o compilador GCC
         echo -e "${BLUE}Compilando o programa $nome_programa...${RESET}"
         echo "--------------------------------------------------"
-        gcc -o "$caminho_programa_compilado" "$programa"
+        gcc -ICode -o "$caminho_programa_compilado" "$programa" Code/Common/*.c -lpthread
 
         # Verificar se a compilação foi bem-sucedida (retorno 0 significa sucesso)
         if [[ $? -ne 0 ]]; then
@@ -86,24 +87,24 @@ for programa in "$diretorio_programas"/*.c; do
     # Obter a lista de arquivos de entrada binários do diretório, ordenados pela data de modificação (mais recentes primeiro)
     arquivos_entrada=($(ls -t "$diretorio_arquivos/Input"/*.bin))
 
-    # Loop através de cada arquivo de entrada
+    # Montar o manifesto do modo em lote (uma linha "entrada<TAB>saida" por arquivo), para que
+    # todos os arquivos sejam ordenados por um único processo
+    manifesto=$(mktemp)
     for ((i=0; i<${#arquivos_entrada[@]}; i++)); do
-        # Obter o caminho do arquivo de entrada
-        arquivo_entrada="${arquivos_entrada[$i]}"
-
         # Gerar o nome do arquivo de saída com base no índice e no nome do programa
         # O nome do arquivo de saída será algo como "Output0.bin", "Output1.bin", etc.
-        arquivo_saida="$diretorio_arquivos/Output/Quicksort/Seq/Output$i.bin"
+        printf '%s\t%s\n' "${arquivos_entrada[$i]}" "$diretorio_arquivos/Output/Quicksort/Seq/Output$i.bin" >> "$manifesto"
+    done
 
-        # Exibir mensagem de status para informar o que está acontecendo (nome do programa, arquivo de entrada e saída)
-        echo -e "${BLUE}Executando $nome_programa com $arquivo_entrada como entrada e $arquivo_saida como saída.${RESET}"
+    # Exibir mensagem de status para o usuário sobre o que está sendo executado
+    echo -e "${BLUE}Executando $nome_programa com ${#arquivos_entrada[@]} arquivos de entrada.${RESET}"
 
-        # Executar o programa compilado com os arquivos de entrada e saída como argumentos
-        "$caminho_programa_compilado" "$arquivo_entrada" "$arquivo_saida"
+    # Executar o programa compilado uma única vez para todo o lote
+    "$caminho_programa_compilado" --manifesto "$manifesto" $OPCOES_ORDENACAO
+    rm -f "$manifesto"
 
-        # Separador visual para clareza no terminal entre execuções de programas
-        echo "--------------------------------------------------"
-    done
+    # Separador visual para clareza no terminal entre execuções de programas
+    echo "--------------------------------------------------"
 done
 
 echo -e "${RED}**************************************************${RESET}"
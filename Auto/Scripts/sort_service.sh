@@ -0,0 +1,47 @@
+#!/bin/bash
+
+# Definir cores para melhor visibilidade
+RED="\033[1;31m"
+BLUE="\033[1;34m"
+WHITE="\033[1;37m"
+GREEN="\033[1;32m"
+RESET="\033[0m"
+
+# Banner
+echo -e "${RED}**************************************************"
+echo -e "${RED}-                                                -"
+echo -e "${RED}-             ${BLUE}Servidor de Ordenação${RED}              -"
+echo -e "${RED}-                                                -"
+echo -e "${RED}**************************************************${RESET}"
+
+# Descrição:
+# Este script compila o servidor (ServidorOrdenacao) e o cliente (ClienteOrdenacao) do serviço de ordenação
+# e inicia o servidor em primeiro plano. O servidor mantém o pool de threads e as arenas de memória entre os
+# pedidos e termina com Ctrl+C. Em outro terminal, os vetores são ordenados com, por exemplo:
+#   Code/SortService/ClienteOrdenacao Files/Input/Input0.bin saida.bin 8 --algoritmo quicksort-conc
+# Opções extras do servidor (ex.: --max-tarefas 4 --arena 128) podem ser passadas pela variável de ambiente OPCOES_ORDENACAO.
+
+# Diretório contendo os programas do serviço
+diretorio_programas="Code/SortService"
+
+# Compilar o servidor e o cliente
+for nome_programa in ServidorOrdenacao ClienteOrdenacao; do
+    echo -e "${BLUE}Compilando o programa $nome_programa...${RESET}"
+    gcc -ICode -o "$diretorio_programas/$nome_programa" "$diretorio_programas/$nome_programa.c" Code/Common/*.c -lpthread
+    if [[ $? -ne 0 ]]; then
+        echo -e "${RED}Erro ao compilar $nome_programa${RESET}"
+        echo "--------------------------------------------------"
+        exit 1
+    fi
+done
+echo "--------------------------------------------------"
+
+# Perguntar ao usuário quantas threads o servidor deve manter no pool
+echo -e "${BLUE}Quantas threads o servidor deve usar?  ${GREEN}"
+read num_threads
+echo -e "${RESET}--------------------------------------------------"
+
+# Iniciar o servidor (até Ctrl+C)
+"$diretorio_programas/ServidorOrdenacao" "$num_threads" $OPCOES_ORDENACAO
+
+echo -e "${RED}**************************************************${RESET}"
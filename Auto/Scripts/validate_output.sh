@@ -30,7 +30,7 @@ diretorio_programa="Code/ValidateOutput"
 diretorio_saida_base="Files/Output"
 
 # Lista de diretórios dentro de Output onde os arquivos de saída podem estar
-diretorios=("MinMaxSort/Conc" "MinMaxSort/Seq" "Quicksort/Conc" "Quicksort/Seq")
+diretorios=("MinMaxSort/Conc" "MinMaxSort/Seq" "Quicksort/Conc" "Quicksort/Seq" "AutoSort")
 
 # Função para verificar se o programa de validação já foi compilado
 verificar_compilacao() {
@@ -116,11 +116,12 @@ echo -e "${RED}(1) ${BLUE}- Output/MinMaxSort/Conc${RESET}"
 echo -e "${RED}(2) ${BLUE}- Output/MinMaxSort/Seq${RESET}"
 echo -e "${RED}(3) ${BLUE}- Output/Quicksort/Conc${RESET}"
 echo -e "${RED}(4) ${BLUE}- Output/Quicksort/Seq${RESET}"
-echo -e "${RED}(5) ${BLUE}- Todos os Diretórios${RESET}"
+echo -e "${RED}(5) ${BLUE}- Output/AutoSort${RESET}"
+echo -e "${RED}(6) ${BLUE}- Todos os Diretórios${RESET}"
 echo -e "${RED}--------------------------------------------------"
 
 # Ler a escolha do usuário
-echo -e "${BLUE}Digite sua escolha [1-5]: ${GREEN}" 
+echo -e "${BLUE}Digite sua escolha [1-6]: ${GREEN}" 
 read escolha
 
 # Tratar a escolha do usuário com um case
@@ -142,6 +143,10 @@ case $escolha in
         rodar_validacao "Quicksort/Seq"
         ;;
     5)
+        # Rodar validação no diretório AutoSort (ordenação automática)
+        rodar_validacao "AutoSort"
+        ;;
+    6)
         # Se o usuário escolher "Todos", rodar a validação em todos os diretórios listados
         for dir in "${diretorios[@]}"; do
             rodar_validacao "$dir"
@@ -149,7 +154,7 @@ case $escolha in
         ;;
     *)
         # Caso o usuário insira uma opção inválida, exibe mensagem e sai
-        echo -e "${RED}Escolha inválida. Por favor, selecione um número entre 1 e 5.${RESET}"
+        echo -e "${RED}Escolha inválida. Por favor, selecione um número entre 1 e 6.${RESET}"
         exit 1
         ;;
 esac
@@ -8,9 +8,10 @@
 # 4. Executar o algoritmo ConcQuicksort (Quicksort concorrente).
 # 5. Executar o algoritmo SeqMinMaxSort (MinMaxSort sequencial).
 # 6. Executar o algoritmo ConcMinMaxSort (MinMaxSort concorrente).
-# 7. Validar os resultados de saída gerados pelos algoritmos executados.
-# 8. Gerar um arquivo CSV dos resultados gerados pelos algoritmos executados.
-# 9. Sair do script.
+# 7. Executar a ordenação automática (o programa escolhe o algoritmo e o número de threads).
+# 8. Validar os resultados de saída gerados pelos algoritmos executados.
+# 9. Gerar um arquivo CSV dos resultados gerados pelos algoritmos executados.
+# 10. Sair do script.
 # Dependendo da escolha, o script chama o script correspondente para executar a tarefa.
 
 # Função para garantir que o script tenha permissão de execução
@@ -44,9 +45,10 @@ exibir_menu() {
     echo -e "${RED}(4)${BLUE} - Executar Quicksort Concorrente"
     echo -e "${RED}(5)${BLUE} - Executar MinMaxSort Sequencial"
     echo -e "${RED}(6)${BLUE} - Executar MinMaxSort Concorrente"
-    echo -e "${RED}(7)${BLUE} - Validar Resultados"
-    echo -e "${RED}(8)${BLUE} - Gerar CSV dos Resultados"
-    echo -e "${RED}(9)${BLUE} - Sair"
+    echo -e "${RED}(7)${BLUE} - Executar Ordenação Automática"
+    echo -e "${RED}(8)${BLUE} - Validar Resultados"
+    echo -e "${RED}(9)${BLUE} - Gerar CSV dos Resultados"
+    echo -e "${RED}(10)${BLUE} - Sair"
     
     # Separador final
     echo -e "${RED}==================================================${RESET}"
@@ -73,7 +75,7 @@ while true; do
     exibir_menu
 
     # Lê a escolha do usuário
-    echo -e "${BLUE}Digite sua escolha [1-9]: ${GREEN}" 
+    echo -e "${BLUE}Digite sua escolha [1-10]: ${GREEN}" 
     read escolha
     # Separador final
     echo -e "${RED}==================================================${RESET}"
@@ -135,6 +137,15 @@ while true; do
             echo -e "\n\n"
             ;;
         7)
+            # Chama o script da ordenação automática (algoritmo e threads escolhidos pelo programa)
+            echo -e "${BLUE}Executando Ordenação Automática...${RESET}"
+            echo -e "${RED}==================================================${RESET}"
+            dar_permissao_execucao $(pwd)/Scripts/auto_sort.sh
+            echo -e "\n\n"
+            ./Scripts/auto_sort.sh
+            echo -e "\n\n"
+            ;;
+        8)
             # Chama o script para validar os resultados gerados pelos algoritmos
             echo -e "${BLUE}Validando os Resultados...${RESET}"
             echo -e "${RED}==================================================${RESET}"
@@ -143,7 +154,7 @@ while true; do
             ./Scripts/validate_output.sh
             echo -e "\n\n"
             ;;
-        8)
+        9)
             # Chama o script para gerar o CSV dos resultados gerados pelos algoritmos
             echo -e "${BLUE}Gerando CSV dos Resultados...${RESET}"
             echo -e "${RED}==================================================${RESET}"
@@ -152,7 +163,7 @@ while true; do
             ./Scripts/generate_csv.sh
             echo -e "\n\n"
             ;;
-        9)
+        10)
             # Sair do script
             echo -e "${BLUE}Saindo do script...${RESET}"
             echo -e "${RED}==================================================${RESET}"
@@ -160,7 +171,7 @@ while true; do
             ;;
         *)
             # Caso o usuário escolha uma opção inválida
-            echo -e "${BLUE}Escolha inválida. Por favor, selecione um número entre 1 e 9.${RESET}"
+            echo -e "${BLUE}Escolha inválida. Por favor, selecione um número entre 1 e 10.${RESET}"
             echo -e "${RED}==================================================${RESET}"
             ;;
     esac
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "Common/Opcoes.h"
+#include "Common/OrdenacaoRegistros.h"
+#include "Common/Registro.h"
+
+/*
+ * Descrição:
+ * Este programa aplica uma permutação (gravada por um programa de ordenação com --argsort,
+ * ver Common/EntradaSaida.h) a outra coluna: a posição i da saída recebe o elemento
+ * indices[i] da coluna de entrada, o que reordena a coluna na mesma ordem do vetor que
+ * gerou a permutação. A coluna é um vetor binário no formato simples dos programas de
+ * ordenação, com o mesmo número de elementos da permutação.
+ *
+ * A cópia (aplicarPermutacao, em Common/OrdenacaoRegistros.h) é dividida em trechos da
+ * saída, um por thread. O tempo da aplicação é medido, impresso e registrado em
+ * Data/permutacao.txt.
+ */
+
+// Opções comuns implementadas por este programa: só a E/S da coluna reordenada
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO)
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
+    if (argc != 5) {
+        fprintf(stderr, "Uso: %s <arquivo_permutacao> <coluna_entrada> <coluna_saida> <num_threads> [opções]\n",
+                argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    int numThreads = atoi(argv[4]);
+    if (numThreads <= 0) {
+        fprintf(stderr, "O número de threads deve ser positivo.\n");
+        return 1;
+    }
+
+    // Garantir que o diretório e o arquivo de log existam
+    garantirDiretorioEArquivo("Data/permutacao.txt");
+
+    // Ler a permutação e a coluna
+    void *indices;
+    int n, larguraIndice;
+    if (lerPermutacaoArquivo(argv[1], &indices, &n, &larguraIndice, &opcoes.es) != 0) {
+        return 1;
+    }
+    int comprimento;
+    int *coluna = lerVetorArquivo(argv[2], &comprimento, &opcoes.es);
+    if (!coluna) {
+        liberarBuffer(indices);
+        return 1;
+    }
+    if (comprimento != n) {
+        printf("Erro: A coluna tem %d elementos e a permutação, %d.\n", comprimento, n);
+        liberarBuffer(coluna);
+        liberarBuffer(indices);
+        return 1;
+    }
+
+    printf("Elementos: %d, índices de %d bits\n", n, larguraIndice * 8);
+
+    int *saida = (int *)alocarBuffer((size_t)n * sizeof(int) + 1);
+    PoolThreads *pool = criarPoolThreads(numThreads, NULL);
+    if (!saida || !pool) {
+        printf("Erro: Falha na alocação de memória.\n");
+        if (saida) {
+            liberarBuffer(saida);
+        }
+        liberarBuffer(coluna);
+        liberarBuffer(indices);
+        return 1;
+    }
+
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+    int erro = aplicarPermutacao(coluna, saida, n, sizeof(int), indices, larguraIndice, pool, numThreads);
+    OBTER_TEMPO(fim);
+    destruirPoolThreads(pool);
+    liberarBuffer(coluna);
+    liberarBuffer(indices);
+
+    printf("Tempo de aplicação: %f segundos\n", fim - inicio);
+
+    // Registrar o tempo e o número de threads no arquivo
+    registrarTempoNoArquivo("Data/permutacao.txt", "AplicarPermutacao", fim - inicio, n, numThreads);
+
+    // Gravar a coluna reordenada
+    if (erro != 0 || gravarVetorArquivo(argv[3], saida, n, &opcoes.es) != 0) {
+        liberarBuffer(saida);
+        return 1;
+    }
+
+    printf("Coluna reordenada salva em %s\n", argv[3]);
+
+    liberarBuffer(saida);
+    return 0;
+}
@@ -0,0 +1,456 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "Common/Ajuste.h"
+#include "Common/Opcoes.h"
+
+/*
+ * Descrição:
+ * Este programa calibra os algoritmos de ordenação na máquina em que é executado e grava o
+ * resultado no perfil de ajuste (ver Common/Ajuste.h), carregado depois por todos os
+ * programas de ordenação. A varredura é curta (alguns segundos com o tamanho máximo
+ * padrão de 10^6 elementos) e mede, com vetores aleatórios gerados em memória:
+ *
+ * - o limite de inserção de cada Quicksort (partes pequenas ordenadas por inserção);
+ * - o limite de tarefa do Quicksort concorrente (partes menores não viram tarefas);
+ * - o número de threads mais rápido do Quicksort concorrente em cada classe de tamanho
+ *   (10^2, 10^3, ... até o tamanho máximo; classes menores usam uma thread e as maiores
+ *   repetem a última medida);
+ * - os coeficientes do modelo de custo do despacho automático (programa Ordenar).
+ *
+ * O número de threads testado vai até o número de CPUs disponíveis ao processo, que
+ * respeita a máscara de afinidade e a cota de CPU do cgroup (contêineres). Cada medida é
+ * o menor tempo de várias repetições.
+ */
+
+// Opções comuns implementadas por este programa: nenhuma além de --memoria (as medidas não
+// leem nem gravam vetores e nunca usam um perfil de ajuste anterior)
+#define OPCOES_ACEITAS 0
+
+#define REPETICOES_MIN   3       // Repetições de cada medida (vetores grandes)
+#define ELEMENTOS_MEDIDA 2000000 // Elementos ordenados em cada medida com vetores pequenos
+#define N_INSERCAO       100000  // Tamanho usado na varredura do limite de inserção
+#define N_MINMAX         3000    // Tamanho usado para o coeficiente do MinMaxSort
+#define CORRIDAS_MEDIDA  64      // Corridas do vetor usado para o coeficiente da mesclagem
+
+static const long candidatosInsercao[] = { 1, 8, 16, 24, 32, 48, 64 };
+static const long candidatosTarefa[] = { 1024, 4096, 16384, 65536, 262144 };
+#define NUM_CANDIDATOS(v) (int)(sizeof(v) / sizeof((v)[0]))
+
+// Função para obter o tempo monotônico em segundos
+static double agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Função para preencher o vetor com valores aleatórios em [0, modulo) (sequência fixa)
+static void gerarAleatorio(int *v, long n, unsigned long long modulo) {
+    unsigned long long estado = 0x9E3779B97F4A7C15ull;
+    for (long i = 0; i < n; i++) {
+        estado = estado * 6364136223846793005ull + 1442695040888963407ull;
+        v[i] = (int)((estado >> 33) % modulo);
+    }
+}
+
+// Função para medir o menor tempo de ordenação de n elementos de base com as opções
+static double medirOrdenacao(const int *base, int *trabalho, long n, const OpcoesOrdenacao *opcoes) {
+    int repeticoes = (int)(ELEMENTOS_MEDIDA / n);
+    if (repeticoes < REPETICOES_MIN) {
+        repeticoes = REPETICOES_MIN;
+    }
+
+    double melhor = -1.0;
+    for (int r = 0; r < repeticoes; r++) {
+        memcpy(trabalho, base, (size_t)n * sizeof(int));
+        double inicio = agora();
+        ordenarI32(trabalho, n, opcoes);
+        double tempo = agora() - inicio;
+        if (melhor < 0 || tempo < melhor) {
+            melhor = tempo;
+        }
+    }
+    return melhor;
+}
+
+// Função para escolher o limite de inserção mais rápido de um Quicksort
+static long ajustarInsercao(const int *base, int *trabalho, long n, AlgoritmoOrdenacao algoritmo, PoolThreads *pool) {
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, algoritmo);
+    opcoes.pool = pool;
+    long melhorLimite = 1;
+    double melhorTempo = -1.0;
+
+    printf("Limite de inserção (%s, n = %ld):", nomeAlgoritmoOrdenacao(algoritmo), n);
+    for (int c = 0; c < NUM_CANDIDATOS(candidatosInsercao); c++) {
+        opcoes.limiteInsercao = candidatosInsercao[c];
+        double tempo = medirOrdenacao(base, trabalho, n, &opcoes);
+        printf(" %ld: %.6f s;", candidatosInsercao[c], tempo);
+        if (melhorTempo < 0 || tempo < melhorTempo) {
+            melhorTempo = tempo;
+            melhorLimite = candidatosInsercao[c];
+        }
+    }
+    printf(" -> %ld\n", melhorLimite);
+    return melhorLimite;
+}
+
+// Função para escolher o limite de tarefa mais rápido do Quicksort concorrente
+static long ajustarTarefa(const int *base, int *trabalho, long n, PoolThreads *pool, long limiteInsercao) {
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_CONC);
+    opcoes.pool = pool;
+    opcoes.limiteInsercao = limiteInsercao;
+    long melhorLimite = ORDENACAO_LIMITE_TAREFA;
+    double melhorTempo = -1.0;
+
+    printf("Limite de tarefa (quicksort-conc, n = %ld, %d threads):", n, numTrabalhadoresPool(pool));
+    for (int c = 0; c < NUM_CANDIDATOS(candidatosTarefa); c++) {
+        if (candidatosTarefa[c] >= n) {
+            break;
+        }
+        opcoes.limiteTarefa = candidatosTarefa[c];
+        double tempo = medirOrdenacao(base, trabalho, n, &opcoes);
+        printf(" %ld: %.6f s;", candidatosTarefa[c], tempo);
+        if (melhorTempo < 0 || tempo < melhorTempo) {
+            melhorTempo = tempo;
+            melhorLimite = candidatosTarefa[c];
+        }
+    }
+    printf(" -> %ld\n", melhorLimite);
+    return melhorLimite;
+}
+
+// Função para escolher o número de threads mais rápido do Quicksort concorrente com n elementos
+static int ajustarThreads(const int *base, int *trabalho, long n, PoolThreads **pools, int numPools,
+                          const AjusteAlgoritmo *parametros) {
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_CONC);
+    opcoes.limiteTarefa = parametros->limiteTarefa;
+    opcoes.limiteInsercao = parametros->limiteInsercao;
+    int melhorThreads = 1;
+    double melhorTempo = -1.0;
+
+    printf("Threads (quicksort-conc, n = %ld):", n);
+    for (int p = 0; p < numPools; p++) {
+        opcoes.pool = pools[p];
+        opcoes.threadsUteis = numTrabalhadoresPool(pools[p]);
+        double tempo = medirOrdenacao(base, trabalho, n, &opcoes);
+        printf(" %d: %.6f s;", opcoes.threadsUteis, tempo);
+        if (melhorTempo < 0 || tempo < melhorTempo) {
+            melhorTempo = tempo;
+            melhorThreads = opcoes.threadsUteis;
+        }
+    }
+    printf(" -> %d\n", melhorThreads);
+    return melhorThreads;
+}
+
+// Função para calcular um coeficiente do modelo a partir do tempo medido com uma thread: o
+// tempo que os demais termos não explicam dividido pelo previsto com o coeficiente igual a 1
+static double ajustarCoeficiente(const ModeloCusto *modelo, size_t deslocamento, double medido,
+                                 const PerfilEntrada *perfil, AlgoritmoOrdenacao algoritmo) {
+    ModeloCusto outros = *modelo;
+    outros.usThread = 0.0; // As medidas usam pools já criados
+    *(double *)((char *)&outros + deslocamento) = 0.0;
+    double resto = preverTempo(&outros, perfil, algoritmo, 1);
+
+    ModeloCusto unitario;
+    memset(&unitario, 0, sizeof(unitario));
+    unitario.numCPUs = 1;
+    *(double *)((char *)&unitario + deslocamento) = 1.0;
+    double previsto = preverTempo(&unitario, perfil, algoritmo, 1);
+
+    if (previsto <= 0.0 || medido <= resto) {
+        return *(const double *)((const char *)modelo + deslocamento);
+    }
+    return (medido - resto) / previsto;
+}
+
+// Função para medir o coeficiente de um algoritmo sobre os dados de base
+static void medirCoeficiente(ModeloCusto *modelo, size_t deslocamento, const int *base, int *trabalho, long n,
+                             const OpcoesOrdenacao *opcoes, const char *nome) {
+    PerfilEntrada perfil;
+    perfilarEntrada(base, n, NULL, &perfil);
+    double medido = medirOrdenacao(base, trabalho, n, opcoes);
+    double *coeficiente = (double *)((char *)modelo + deslocamento);
+    *coeficiente = ajustarCoeficiente(modelo, deslocamento, medido, &perfil, opcoes->algoritmo);
+    printf("Modelo: %s = %g (n = %ld, %.6f s)\n", nome, *coeficiente, n, medido);
+}
+
+// Função para gerar um vetor com o número de corridas crescentes pedido
+static void gerarCorridas(int *v, long n, int corridas) {
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_SEQ);
+    opcoes.limiteInsercao = 1;
+    gerarAleatorio(v, n, 1000000000ull);
+    for (int c = 0; c < corridas; c++) {
+        long inicio = n * c / corridas;
+        long fim = n * (c + 1) / corridas;
+        ordenarI32(v + inicio, fim - inicio, &opcoes);
+    }
+}
+
+// Função para criar o diretório do arquivo do perfil, se ele tiver um
+static void garantirDiretorioPerfil(const char *arquivo) {
+    const char *barra = strrchr(arquivo, '/');
+    if (!barra || barra == arquivo || barra - arquivo >= AJUSTE_MAX_CAMINHO) {
+        return;
+    }
+    char diretorio[AJUSTE_MAX_CAMINHO];
+    memcpy(diretorio, arquivo, (size_t)(barra - arquivo));
+    diretorio[barra - arquivo] = '\0';
+    mkdir(diretorio, 0755);
+}
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--memoria, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoesExecucao;
+    argc = extrairOpcoes(argc, argv, &opcoesExecucao);
+    if (argc < 1 || argc > 3) {
+        fprintf(stderr, "Uso: %s [arquivo_perfil] [tamanho_max] [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoesExecucao, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    const char *arquivo = argc >= 2 ? argv[1] : AJUSTE_ARQUIVO_PADRAO;
+    long tamanhoMax = 1000000;
+    if (argc == 3 && lerValorPositivo("tamanho_max", argv[2], &tamanhoMax) < 0) {
+        return 1;
+    }
+    if (tamanhoMax < 1000) {
+        tamanhoMax = 1000;
+    }
+
+    // As medidas não podem depender de um perfil anterior
+    definirArquivoAjuste("nenhum");
+
+    AjusteMaquina ajuste;
+    ajustePadrao(&ajuste);
+    ajuste.cpus = cpusDisponiveis();
+    double cota;
+    if (lerCotaCgroup(&cota) == 0) {
+        printf("CPUs disponíveis: %d (cota do cgroup: %.2f CPUs)\n", ajuste.cpus, cota);
+    } else {
+        printf("CPUs disponíveis: %d (sem cota do cgroup)\n", ajuste.cpus);
+    }
+    printf("Tamanho máximo da calibração: %ld\n", tamanhoMax);
+
+    int *base = malloc((size_t)tamanhoMax * sizeof(int));
+    int *trabalho = malloc((size_t)tamanhoMax * sizeof(int));
+    if (!base || !trabalho) {
+        perror("Erro ao alocar memória");
+        free(base);
+        free(trabalho);
+        return 1;
+    }
+
+    // Pools de 1, 2, 4, ... threads até as CPUs disponíveis
+    PoolThreads *pools[32];
+    int numPools = 0;
+    for (int t = 1; numPools < 32; t *= 2) {
+        int threads = t < ajuste.cpus ? t : ajuste.cpus;
+        pools[numPools] = criarPoolThreads(threads, NULL);
+        if (!pools[numPools]) {
+            fprintf(stderr, "Erro ao criar o pool de threads.\n");
+            break;
+        }
+        numPools++;
+        if (threads == ajuste.cpus) {
+            break;
+        }
+    }
+    if (numPools == 0) {
+        free(base);
+        free(trabalho);
+        return 1;
+    }
+    PoolThreads *poolTodas = pools[numPools - 1];
+    AjusteAlgoritmo *seq = &ajuste.algoritmos[ORDENACAO_QUICKSORT_SEQ];
+    AjusteAlgoritmo *conc = &ajuste.algoritmos[ORDENACAO_QUICKSORT_CONC];
+    AjusteAlgoritmo *duploSeq = &ajuste.algoritmos[ORDENACAO_DUPLO_PIVO_SEQ];
+    AjusteAlgoritmo *duploConc = &ajuste.algoritmos[ORDENACAO_DUPLO_PIVO_CONC];
+
+    // Limites de inserção e de tarefa
+    long nInsercao = tamanhoMax < N_INSERCAO ? tamanhoMax : N_INSERCAO;
+    gerarAleatorio(base, tamanhoMax, 1000000000ull);
+    seq->limiteInsercao = ajustarInsercao(base, trabalho, nInsercao, ORDENACAO_QUICKSORT_SEQ, NULL);
+    conc->limiteInsercao = ajustarInsercao(base, trabalho, nInsercao, ORDENACAO_QUICKSORT_CONC, poolTodas);
+    duploSeq->limiteInsercao = ajustarInsercao(base, trabalho, nInsercao, ORDENACAO_DUPLO_PIVO_SEQ, NULL);
+    duploConc->limiteInsercao = ajustarInsercao(base, trabalho, nInsercao, ORDENACAO_DUPLO_PIVO_CONC, poolTodas);
+    if (ajuste.cpus > 1) {
+        conc->limiteTarefa = ajustarTarefa(base, trabalho, tamanhoMax, poolTodas, conc->limiteInsercao);
+    } else {
+        printf("Limite de tarefa: uma CPU disponível, mantido em %d\n", ORDENACAO_LIMITE_TAREFA);
+    }
+
+    // Threads por classe de tamanho: as menores usam uma thread e as maiores repetem a última
+    int classeMax = classeTamanho(tamanhoMax);
+    int threads = 1;
+    for (int c = 0; c < AJUSTE_NUM_CLASSES; c++) {
+        if (c >= 2 && c <= classeMax) {
+            long n = 1;
+            for (int k = 0; k < c; k++) {
+                n *= 10;
+            }
+            threads = ajustarThreads(base, trabalho, n, pools, numPools, conc);
+        }
+        conc->threads[c] = threads;
+    }
+
+    // O Quicksort concorrente com dois pivôs divide as tarefas da mesma forma
+    duploConc->limiteTarefa = conc->limiteTarefa;
+    memcpy(duploConc->threads, conc->threads, sizeof(conc->threads));
+
+    // Coeficientes do modelo de custo, medidos com uma thread
+    ModeloCusto *modelo = &ajuste.modelo;
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_SEQ);
+    opcoes.limiteInsercao = seq->limiteInsercao;
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsQuicksortSeq), base, trabalho, tamanhoMax, &opcoes,
+                     "nsQuicksortSeq");
+
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_CONC);
+    opcoes.pool = pools[0];
+    opcoes.threadsUteis = 1;
+    opcoes.limiteTarefa = conc->limiteTarefa;
+    opcoes.limiteInsercao = conc->limiteInsercao;
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsQuicksortConc), base, trabalho, tamanhoMax, &opcoes,
+                     "nsQuicksortConc");
+
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_DUPLO_PIVO_SEQ);
+    opcoes.limiteInsercao = duploSeq->limiteInsercao;
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsDuploPivo), base, trabalho, tamanhoMax, &opcoes,
+                     "nsDuploPivo");
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_CONC);
+    opcoes.pool = pools[0];
+    opcoes.threadsUteis = 1;
+    opcoes.limiteTarefa = conc->limiteTarefa;
+    opcoes.limiteInsercao = conc->limiteInsercao;
+
+    // Ganho das threads extras sobre uma thread
+    if (numPools > 1) {
+        double umaThread = medirOrdenacao(base, trabalho, tamanhoMax, &opcoes);
+        opcoes.pool = poolTodas;
+        opcoes.threadsUteis = ajuste.cpus;
+        double todas = medirOrdenacao(base, trabalho, tamanhoMax, &opcoes);
+        double eficiencia = (umaThread / todas - 1.0) / (ajuste.cpus - 1);
+        modelo->eficienciaParalela = eficiencia < 0.05 ? 0.05 : (eficiencia > 1.0 ? 1.0 : eficiencia);
+        printf("Modelo: eficienciaParalela = %g (%d threads: %.6f s, 1 thread: %.6f s)\n",
+               modelo->eficienciaParalela, ajuste.cpus, todas, umaThread);
+        opcoes.pool = pools[0];
+        opcoes.threadsUteis = 1;
+    }
+
+    // Partição de Lomuto com poucas chaves distintas
+    gerarAleatorio(base, nInsercao, 100);
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsDuplicatasLomuto), base, trabalho, nInsercao, &opcoes,
+                     "nsDuplicatasLomuto");
+
+    gerarAleatorio(base, N_MINMAX, 1000000000ull);
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_MINMAX_SEQ);
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsMinMax), base, trabalho, N_MINMAX, &opcoes, "nsMinMax");
+
+    gerarCorridas(base, tamanhoMax, CORRIDAS_MEDIDA);
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_CORRIDAS);
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsCorridas), base, trabalho, tamanhoMax, &opcoes,
+                     "nsCorridas");
+
+    // Contagem com a faixa de valores igual a n
+    gerarAleatorio(base, tamanhoMax, (unsigned long long)tamanhoMax);
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_CONTAGEM);
+    opcoes.pool = pools[0];
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsContagem), base, trabalho, tamanhoMax, &opcoes,
+                     "nsContagem");
+
+    // Ordenação aprendida com chaves uniformes
+    gerarAleatorio(base, tamanhoMax, 1000000000ull);
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_APRENDIDA);
+    opcoes.pool = pools[0];
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsAprendida), base, trabalho, tamanhoMax, &opcoes,
+                     "nsAprendida");
+
+    // Mergesort com chaves aleatórias (o custo não depende da ordem)
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_MESCLAGEM);
+    opcoes.pool = pools[0];
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsMesclagem), base, trabalho, tamanhoMax, &opcoes,
+                     "nsMesclagem");
+
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_MESCLAGEM_LOCAL);
+    opcoes.pool = pools[0];
+    medirCoeficiente(modelo, offsetof(ModeloCusto, nsMesclagemLocal), base, trabalho, tamanhoMax, &opcoes,
+                     "nsMesclagemLocal");
+
+    // Compactação com chaves de 16 bits (a mais longa das larguras compactadas)
+    gerarAleatorio(base, tamanhoMax, 1ull << 16);
+    opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_SEQ);
+    opcoes.pool = pools[0];
+    opcoes.compactar = 1;
+    PerfilEntrada perfilCompactacao;
+    perfilarEntrada(base, tamanhoMax, NULL, &perfilCompactacao);
+    ModeloCusto unitario;
+    memset(&unitario, 0, sizeof(unitario));
+    unitario.numCPUs = 1;
+    unitario.nsCompactacao = 1.0;
+    double medidoCompactacao = medirOrdenacao(base, trabalho, tamanhoMax, &opcoes);
+    double previstoCompactacao = preverTempoCompactado(&unitario, &perfilCompactacao, 1);
+    if (previstoCompactacao > 0.0) {
+        modelo->nsCompactacao = medidoCompactacao / previstoCompactacao;
+    }
+    printf("Modelo: nsCompactacao = %g (n = %ld, %.6f s)\n", modelo->nsCompactacao, tamanhoMax, medidoCompactacao);
+
+    // Inversão do vetor (o custo não depende dos valores)
+    double melhor = -1.0;
+    for (int r = 0; r < REPETICOES_MIN; r++) {
+        double inicio = agora();
+        inverterVetor(base, tamanhoMax);
+        double tempo = agora() - inicio;
+        if (melhor < 0 || tempo < melhor) {
+            melhor = tempo;
+        }
+    }
+    modelo->nsInverter = melhor * 1e9 / tamanhoMax;
+    printf("Modelo: nsInverter = %g\n", modelo->nsInverter);
+
+    // Criação das threads do pool
+    for (int p = 0; p < numPools; p++) {
+        destruirPoolThreads(pools[p]);
+    }
+    melhor = -1.0;
+    for (int r = 0; r < 10; r++) {
+        double inicio = agora();
+        PoolThreads *pool = criarPoolThreads(ajuste.cpus, NULL);
+        if (!pool) {
+            break;
+        }
+        destruirPoolThreads(pool);
+        double tempo = agora() - inicio;
+        if (melhor < 0 || tempo < melhor) {
+            melhor = tempo;
+        }
+    }
+    if (melhor > 0) {
+        modelo->usThread = melhor * 1e6 / ajuste.cpus;
+    }
+    printf("Modelo: usThread = %g\n", modelo->usThread);
+
+    free(base);
+    free(trabalho);
+
+    // Gravar o perfil
+    garantirDiretorioPerfil(arquivo);
+    if (salvarAjuste(arquivo, &ajuste) != 0) {
+        return 1;
+    }
+    ajuste.carregado = 1;
+    snprintf(ajuste.arquivo, sizeof(ajuste.arquivo), "%s", arquivo);
+    imprimirAjuste(stdout, &ajuste);
+    printf("Perfil salvo em %s\n", arquivo);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Common/Opcoes.h"
+#include "Common/Servico.h"
+
+/*
+ * Descrição:
+ * Cliente do servidor de ordenação (ServidorOrdenacao). Recebe os mesmos argumentos dos
+ * programas de ordenação: lê o vetor do arquivo binário de entrada diretamente para um
+ * memfd, envia o memfd ao servidor, que o ordena no lugar, e grava o resultado no arquivo
+ * binário de saída. O algoritmo é escolhido com --algoritmo (padrão: quicksort-conc) e o
+ * número de threads é repassado ao servidor (segmentos do MinMaxSort concorrente).
+ */
+
+// Opções comuns implementadas por este programa: só a E/S (a ordenação é feita pelo servidor)
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO)
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções do serviço e as comuns (--es, ...)
+    OpcoesServico servico;
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoesServico(argc, argv, SERVICO_CLIENTE, &servico);
+    if (argc >= 0) {
+        argc = extrairOpcoes(argc, argv, &opcoes);
+    }
+    if (argc != 3 && argc != 4) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> [num_threads] [opções]\n", argv[0]);
+        imprimirOpcoesServico(stderr, SERVICO_CLIENTE);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    const char *arquivoEntrada = argv[1];
+    const char *arquivoSaida = argv[2];
+    int numThreads = argc == 4 ? atoi(argv[3]) : 0;
+    if (numThreads < 0) {
+        fprintf(stderr, "O número de threads não pode ser negativo.\n");
+        return 1;
+    }
+
+    // Ler o vetor de entrada diretamente no memfd compartilhado com o servidor
+    int n, fdDados;
+    if (lerTamanhoArquivo(arquivoEntrada, &n) != 0) {
+        return 1;
+    }
+    int *vetor = criarVetorCompartilhado(n, &fdDados);
+    if (!vetor) {
+        return 1;
+    }
+    if (lerValoresArquivo(arquivoEntrada, vetor, n, &opcoes.es) != 0 || selarVetorCompartilhado(fdDados) != 0) {
+        liberarVetorCompartilhado(vetor, n);
+        close(fdDados);
+        return 1;
+    }
+
+    printf("Tamanho do array: %d\n", n);
+
+    // Enviar o pedido e aguardar a resposta
+    int sock = conectarServico(servico.socket);
+    if (sock < 0) {
+        liberarVetorCompartilhado(vetor, n);
+        close(fdDados);
+        return 1;
+    }
+
+    PedidoOrdenacao pedido = { SERVICO_MAGIA, SERVICO_VERSAO, servico.algoritmo, numThreads, n };
+    RespostaOrdenacao resposta;
+    if (enviarPedido(sock, &pedido, fdDados) != 0 || receberResposta(sock, &resposta) != 0) {
+        fprintf(stderr, "Erro: falha na comunicação com o servidor.\n");
+        close(sock);
+        liberarVetorCompartilhado(vetor, n);
+        close(fdDados);
+        return 1;
+    }
+    close(sock);
+    close(fdDados);
+
+    if (resposta.status != SERVICO_OK) {
+        fprintf(stderr, "Erro: %s.\n", descricaoStatusServico(resposta.status));
+        liberarVetorCompartilhado(vetor, n);
+        return 1;
+    }
+
+    printf("Algoritmo: %s\n", nomeAlgoritmoOrdenacao(servico.algoritmo));
+    printf("Tempo de ordenação: %f segundos (espera na fila: %f segundos)\n",
+           resposta.tempoOrdenacao, resposta.tempoEspera);
+    if (resposta.memoriaExtra >= 0) {
+        printf("Memória extra (pico): %lld bytes\n", (long long)resposta.memoriaExtra);
+    }
+
+    // Gravar o vetor ordenado pelo servidor
+    if (gravarVetorArquivo(arquivoSaida, vetor, n, &opcoes.es) != 0) {
+        liberarVetorCompartilhado(vetor, n);
+        return 1;
+    }
+
+    printf("Array ordenado salvo em %s\n", arquivoSaida);
+
+    liberarVetorCompartilhado(vetor, n);
+    return 0;
+}
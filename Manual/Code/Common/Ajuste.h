@@ -0,0 +1,79 @@
+#ifndef AJUSTE_H
+#define AJUSTE_H
+
+#include <stdio.h>
+#include "Despacho.h"
+#include "Ordenacao.h"
+
+/*
+ * Perfil de ajuste da máquina: os limites dos algoritmos (quando deixar de criar tarefas,
+ * a partir de quando ordenar por inserção, quantas threads usar para cada tamanho) e os
+ * coeficientes do modelo de custo do despacho automático, medidos na própria máquina pelo
+ * programa Autoajuste e gravados em um arquivo de texto.
+ *
+ * O perfil é carregado uma única vez por processo, na primeira ordenação, do arquivo
+ * informado com --ajuste, da variável de ambiente AJUSTE_VARIAVEL ou de
+ * AJUSTE_ARQUIVO_PADRAO, nessa ordem ("nenhum" desativa o perfil). Sem arquivo, valem os
+ * valores padrão, que reproduzem o comportamento original dos algoritmos.
+ *
+ * Formato: uma chave por linha, "chave=valor"; linhas vazias e começadas por '#' são
+ * ignoradas. Chaves reconhecidas:
+ *
+ *   cpus=4                              CPUs disponíveis na calibração (informativo)
+ *   <algoritmo>.limite_tarefa=4096      Partes menores não viram tarefas
+ *   <algoritmo>.limite_insercao=16      Partes com até esse tamanho vão para a inserção
+ *   <algoritmo>.threads.1e4=2           Threads úteis com 10^4 a 10^5 - 1 elementos
+ *   modelo.<coeficiente>=6.4            Coeficiente do ModeloCusto (ex.: modelo.nsQuicksortSeq)
+ *
+ * com <algoritmo> sendo o nome de nomeAlgoritmoOrdenacao ("quicksort-conc", ...). As
+ * classes de tamanho são as potências de 10 (1e0 a 1e9); a última inclui os vetores
+ * maiores, e uma classe sem valor usa todas as threads do pool.
+ */
+
+#define AJUSTE_ARQUIVO_PADRAO    "Data/ajuste.conf"
+#define AJUSTE_VARIAVEL          "CONCSORT_AJUSTE"
+#define AJUSTE_NUM_CLASSES       10 // Classes de tamanho 10^0 a 10^9
+#define AJUSTE_MAX_CAMINHO       512
+
+// Parâmetros de um algoritmo
+typedef struct {
+    long limiteTarefa;               // Partes menores não viram tarefas (algoritmos concorrentes)
+    long limiteInsercao;             // Partes com até esse tamanho vão para a inserção (1 = nunca)
+    int threads[AJUSTE_NUM_CLASSES]; // Threads úteis por classe de tamanho (0 = todas)
+} AjusteAlgoritmo;
+
+// Perfil de ajuste da máquina
+typedef struct {
+    int carregado;                   // 1 se o perfil veio de um arquivo
+    char arquivo[AJUSTE_MAX_CAMINHO];
+    int cpus;                        // CPUs disponíveis na calibração (0 = desconhecido)
+    AjusteAlgoritmo algoritmos[ORDENACAO_NUM_ALGORITMOS];
+    int modeloAjustado;              // 1 se o arquivo trouxe coeficientes do modelo
+    ModeloCusto modelo;
+} AjusteMaquina;
+
+// Preenche o perfil com os valores padrão
+void ajustePadrao(AjusteMaquina *ajuste);
+
+// Retorna a classe de tamanho de n (floor(log10 n), limitada a AJUSTE_NUM_CLASSES - 1)
+int classeTamanho(long n);
+
+// Lê o perfil do arquivo sobre os valores padrão; retorna -1 se o arquivo não puder ser aberto
+int carregarAjuste(const char *arquivo, AjusteMaquina *ajuste);
+
+// Grava o perfil no arquivo; retorna 0 em caso de sucesso
+int salvarAjuste(const char *arquivo, const AjusteMaquina *ajuste);
+
+// Define o arquivo do perfil do processo (antes da primeira ordenação; "nenhum" desativa)
+void definirArquivoAjuste(const char *arquivo);
+
+// Retorna o perfil do processo, carregado na primeira chamada
+const AjusteMaquina *ajusteMaquina(void);
+
+// Retorna as threads úteis do algoritmo para n elementos, até disponiveis
+int threadsAjustadas(const AjusteMaquina *ajuste, AlgoritmoOrdenacao algoritmo, long n, int disponiveis);
+
+// Imprime o perfil
+void imprimirAjuste(FILE *saida, const AjusteMaquina *ajuste);
+
+#endif
@@ -0,0 +1,389 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Aprendida.h"
+#include "Ordenacao.h"
+#include "Memoria.h"
+
+// Modelo da CDF: segmentos de mesma largura a partir do mínimo da amostra, cada um levando
+// as suas chaves linearmente aos baldes [base[j], base[j + 1]]
+typedef struct {
+    int minimo;
+    double escala;                       // Segmentos por unidade de chave
+    long numBaldes;
+    long base[APRENDIDA_FOLHAS + 1];     // Primeiro balde de cada segmento
+    double inclinacao[APRENDIDA_FOLHAS]; // Baldes cobertos por cada segmento
+} ModeloCDF;
+
+// Chaves da amostra em um segmento do modelo
+typedef struct {
+    unsigned int quantidade;
+    int minimo;
+    int maximo;
+} FolhaAmostra;
+
+// Trecho [inicio, fim) do vetor: amostra, contagem e distribuição
+typedef struct {
+    const ModeloCDF *modelo;
+    const int *origem;
+    int *auxiliar;
+    long inicio;
+    long fim;
+    int *amostra;           // Parte da amostra sorteada pelo trecho
+    long numAmostras;
+    int minimo;             // Mínimo e máximo da parte da amostra
+    int maximo;
+    FolhaAmostra *folhas;   // Histograma da parte da amostra (APRENDIDA_FOLHAS posições)
+    long *contagem;         // Chaves de cada balde; depois, a próxima posição de cada um
+} TrechoAprendida;
+
+// Baldes [primeiro, ultimo) acabados por uma tarefa
+typedef struct {
+    const int *auxiliar;
+    int *destino;
+    const long *inicioBalde; // Posição de cada balde na saída (numBaldes + 1 posições)
+    long primeiro;
+    long ultimo;
+    long maiorBalde;
+    double capacidade;       // Baldes maiores transbordam
+    int erro;
+} ParteBaldes;
+
+// Função para obter o segmento do modelo de uma chave da amostra
+static long folhaDaChave(const ModeloCDF *modelo, int chave) {
+    long j = (long)(((double)chave - modelo->minimo) * modelo->escala);
+    return j < APRENDIDA_FOLHAS ? j : APRENDIDA_FOLHAS - 1;
+}
+
+// Função para obter o balde de uma chave pelo modelo; as chaves fora da faixa da amostra
+// vão para o primeiro ou o último balde, o que mantém o modelo monótono
+static inline long baldeDaChave(const ModeloCDF *modelo, int chave) {
+    double x = ((double)chave - modelo->minimo) * modelo->escala;
+    if (x <= 0.0) {
+        return 0;
+    }
+    if (x >= APRENDIDA_FOLHAS) {
+        return modelo->numBaldes - 1;
+    }
+    long j = (long)x;
+    long balde = modelo->base[j] + (long)((x - j) * modelo->inclinacao[j]);
+    return balde < modelo->numBaldes ? balde : modelo->numBaldes - 1;
+}
+
+// Função para sortear a parte da amostra de um trecho (uma chave em cada uma das
+// numAmostras faixas do trecho) e obter o seu mínimo e máximo
+static void amostrarTrecho(void *arg) {
+    TrechoAprendida *t = (TrechoAprendida *)arg;
+    long tamanho = t->fim - t->inicio;
+    unsigned long long estado = 0x9E3779B97F4A7C15ull ^ (unsigned long long)t->inicio;
+    for (long i = 0; i < t->numAmostras; i++) {
+        long inicioFaixa = tamanho * i / t->numAmostras;
+        long largura = tamanho * (i + 1) / t->numAmostras - inicioFaixa;
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        long deslocamento = largura > 1 ? (long)(estado % (unsigned long long)largura) : 0;
+        t->amostra[i] = t->origem[t->inicio + inicioFaixa + deslocamento];
+    }
+
+    int minimo = t->amostra[0], maximo = minimo;
+    for (long i = 1; i < t->numAmostras; i++) {
+        minimo = t->amostra[i] < minimo ? t->amostra[i] : minimo;
+        maximo = t->amostra[i] > maximo ? t->amostra[i] : maximo;
+    }
+    t->minimo = minimo;
+    t->maximo = maximo;
+}
+
+// Função para contar a parte da amostra de um trecho em cada segmento do modelo
+static void histogramaTrecho(void *arg) {
+    TrechoAprendida *t = (TrechoAprendida *)arg;
+    memset(t->folhas, 0, APRENDIDA_FOLHAS * sizeof(FolhaAmostra));
+    for (long i = 0; i < t->numAmostras; i++) {
+        int chave = t->amostra[i];
+        FolhaAmostra *folha = &t->folhas[folhaDaChave(t->modelo, chave)];
+        if (folha->quantidade == 0 || chave < folha->minimo) {
+            folha->minimo = chave;
+        }
+        if (folha->quantidade == 0 || chave > folha->maximo) {
+            folha->maximo = chave;
+        }
+        folha->quantidade++;
+    }
+}
+
+// Função para contar as chaves de um trecho em cada balde
+static void contarTrecho(void *arg) {
+    TrechoAprendida *t = (TrechoAprendida *)arg;
+    memset(t->contagem, 0, (size_t)t->modelo->numBaldes * sizeof(long));
+    for (long i = t->inicio; i < t->fim; i++) {
+        t->contagem[baldeDaChave(t->modelo, t->origem[i])]++;
+    }
+}
+
+// Função para espalhar as chaves de um trecho nos seus baldes do vetor auxiliar
+static void espalharTrecho(void *arg) {
+    TrechoAprendida *t = (TrechoAprendida *)arg;
+    for (long i = t->inicio; i < t->fim; i++) {
+        int valor = t->origem[i];
+        t->auxiliar[t->contagem[baldeDaChave(t->modelo, valor)]++] = valor;
+    }
+}
+
+// Função para ordenar a parte [lo, hi] pelo Quicksort (Hoare), com a inserção nas partes
+// pequenas; a recursão fica com a parte menor
+static void quicksortGrupo(int A[], long lo, long hi) {
+    while (hi - lo + 1 > APRENDIDA_GRUPO_INSERCAO) {
+        long p = particionar(A, lo, hi);
+        if (p - lo < hi - p) {
+            quicksortGrupo(A, lo, p);
+            lo = p + 1;
+        } else {
+            quicksortGrupo(A, p + 1, hi);
+            hi = p;
+        }
+    }
+    insercao(A, lo, hi);
+}
+
+// Função para acabar um balde: as chaves de origem vão para as posições previstas por um
+// modelo linear entre o mínimo e o máximo do balde, e cada grupo de chaves com a mesma
+// posição prevista é ordenado no destino
+static void acabarBalde(const int *origem, int *destino, long m, long *posicoes) {
+    int minimo = origem[0], maximo = minimo;
+    for (long i = 1; i < m; i++) {
+        minimo = origem[i] < minimo ? origem[i] : minimo;
+        maximo = origem[i] > maximo ? origem[i] : maximo;
+    }
+    if (minimo == maximo) {
+        memcpy(destino, origem, (size_t)m * sizeof(int));
+        return;
+    }
+
+    double escala = (double)m / ((double)maximo - minimo + 1);
+    memset(posicoes, 0, (size_t)m * sizeof(long));
+    for (long i = 0; i < m; i++) {
+        long p = (long)(((double)origem[i] - minimo) * escala);
+        posicoes[p < m ? p : m - 1]++;
+    }
+    long acumulado = 0;
+    for (long p = 0; p < m; p++) {
+        long quantidade = posicoes[p];
+        posicoes[p] = acumulado;
+        acumulado += quantidade;
+    }
+    for (long i = 0; i < m; i++) {
+        long p = (long)(((double)origem[i] - minimo) * escala);
+        destino[posicoes[p < m ? p : m - 1]++] = origem[i];
+    }
+
+    // Depois da distribuição, posicoes[p] é o fim do grupo da posição p
+    long inicio = 0;
+    for (long p = 0; p < m; p++) {
+        long tamanho = posicoes[p] - inicio;
+        if (tamanho > APRENDIDA_GRUPO_INSERCAO) {
+            quicksortGrupo(destino, inicio, posicoes[p] - 1);
+        } else if (tamanho > 1) {
+            insercao(destino, inicio, posicoes[p] - 1);
+        }
+        inicio = posicoes[p];
+    }
+}
+
+// Função para acabar os baldes de uma parte
+static void acabarParte(void *arg) {
+    ParteBaldes *p = (ParteBaldes *)arg;
+    // Os baldes transbordados não usam as posições previstas
+    long maximo = p->maiorBalde < p->capacidade ? p->maiorBalde : (long)p->capacidade;
+    long *posicoes = (long *)malloc((size_t)(maximo + 1) * sizeof(long));
+    if (!posicoes) {
+        p->erro = 1;
+        return;
+    }
+    for (long b = p->primeiro; b < p->ultimo; b++) {
+        long inicio = p->inicioBalde[b];
+        long m = p->inicioBalde[b + 1] - inicio;
+        if (m == 1) {
+            p->destino[inicio] = p->auxiliar[inicio];
+        } else if (m > p->capacidade) {
+            // Balde transbordado: o modelo errou nesta região, e o Quicksort acaba o balde
+            memcpy(p->destino + inicio, p->auxiliar + inicio, (size_t)m * sizeof(int));
+            quicksortGrupo(p->destino, inicio, inicio + m - 1);
+        } else if (m > 1) {
+            acabarBalde(p->auxiliar + inicio, p->destino + inicio, m, posicoes);
+        }
+    }
+    free(posicoes);
+}
+
+// Função para ajustar o modelo em uma amostra do vetor; retorna 0 se o modelo respeitar o
+// limite de erro, 1 se não respeitar e -1 em caso de erro
+static int ajustarModelo(long n, PoolThreads *pool, TrechoAprendida *trechos,
+                         int numTrechos, ModeloCDF *modelo) {
+    long numAmostras = n < APRENDIDA_AMOSTRA ? n : APRENDIDA_AMOSTRA;
+    int *amostra = (int *)malloc((size_t)numAmostras * sizeof(int));
+    FolhaAmostra *folhas = (FolhaAmostra *)malloc((size_t)numTrechos * APRENDIDA_FOLHAS * sizeof(FolhaAmostra));
+    if (!amostra || !folhas) {
+        printf("Erro: Falha na alocação de memória para a amostra do modelo.\n");
+        free(amostra);
+        free(folhas);
+        return -1;
+    }
+
+    // Amostra sorteada em paralelo, cada trecho com uma parte proporcional ao seu tamanho
+    for (int t = 0; t < numTrechos; t++) {
+        long primeira = numAmostras * t / numTrechos;
+        trechos[t].amostra = amostra + primeira;
+        trechos[t].numAmostras = numAmostras * (t + 1) / numTrechos - primeira;
+        trechos[t].folhas = folhas + (size_t)t * APRENDIDA_FOLHAS;
+    }
+    executarItensPool(pool, amostrarTrecho, trechos, sizeof(TrechoAprendida), numTrechos);
+    int minimo = trechos[0].minimo, maximo = trechos[0].maximo;
+    for (int t = 1; t < numTrechos; t++) {
+        minimo = trechos[t].minimo < minimo ? trechos[t].minimo : minimo;
+        maximo = trechos[t].maximo > maximo ? trechos[t].maximo : maximo;
+    }
+
+    // Histograma da amostra nos segmentos e CDF acumulada nos limites de cada um
+    modelo->minimo = minimo;
+    modelo->escala = APRENDIDA_FOLHAS / ((double)maximo - minimo + 1);
+    executarItensPool(pool, histogramaTrecho, trechos, sizeof(TrechoAprendida), numTrechos);
+
+    // Um segmento em que todas as chaves da amostra são iguais não conta no erro: as chaves
+    // repetidas caem no mesmo balde, que já sai ordenado
+    long acumulado = 0, maiorFolha = 0;
+    for (int j = 0; j < APRENDIDA_FOLHAS; j++) {
+        long soma = 0;
+        int minimoFolha = 0, maximoFolha = 0;
+        for (int t = 0; t < numTrechos; t++) {
+            const FolhaAmostra *folha = &folhas[(size_t)t * APRENDIDA_FOLHAS + j];
+            if (folha->quantidade == 0) {
+                continue;
+            }
+            if (soma == 0 || folha->minimo < minimoFolha) {
+                minimoFolha = folha->minimo;
+            }
+            if (soma == 0 || folha->maximo > maximoFolha) {
+                maximoFolha = folha->maximo;
+            }
+            soma += folha->quantidade;
+        }
+        modelo->base[j] = (long)((double)acumulado / numAmostras * modelo->numBaldes);
+        acumulado += soma;
+        if (minimoFolha != maximoFolha && soma > maiorFolha) {
+            maiorFolha = soma;
+        }
+    }
+    modelo->base[APRENDIDA_FOLHAS] = modelo->numBaldes;
+    for (int j = 0; j < APRENDIDA_FOLHAS; j++) {
+        modelo->inclinacao[j] = (double)(modelo->base[j + 1] - modelo->base[j]);
+    }
+
+    free(amostra);
+    free(folhas);
+    return maiorFolha > APRENDIDA_ERRO_MAXIMO * numAmostras ? 1 : 0;
+}
+
+// Ordena os n elementos de origem em destino pelo modelo da CDF
+int ordenarAprendida(const int *origem, int *destino, long n, PoolThreads *pool, int numThreads) {
+    if (n < APRENDIDA_MIN_ELEMENTOS) {
+        return 1;
+    }
+
+    long numTrechos = numTrechosPool(pool, numThreads, n, APRENDIDA_MIN_ELEMENTOS_TRECHO, APRENDIDA_MAX_TRECHOS);
+    TrechoAprendida trechos[APRENDIDA_MAX_TRECHOS];
+    ModeloCDF modelo;
+    modelo.numBaldes = n / APRENDIDA_ELEMENTOS_BALDE;
+    if (modelo.numBaldes > APRENDIDA_MAX_BALDES) {
+        modelo.numBaldes = APRENDIDA_MAX_BALDES;
+    }
+    if (modelo.numBaldes < 1) {
+        modelo.numBaldes = 1;
+    }
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].modelo = &modelo;
+        trechos[t].origem = origem;
+        trechos[t].inicio = n * t / numTrechos;
+        trechos[t].fim = n * (t + 1) / numTrechos;
+    }
+
+    // 1 e 2. Ajuste do modelo e limite de erro
+    int resultado = ajustarModelo(n, pool, trechos, (int)numTrechos, &modelo);
+    if (resultado != 0) {
+        return resultado;
+    }
+
+    // 3. Contagem por balde em cada trecho
+    long numBaldes = modelo.numBaldes;
+    long *contagens = (long *)malloc((size_t)numTrechos * numBaldes * sizeof(long));
+    long *inicioBalde = (long *)malloc((size_t)(numBaldes + 1) * sizeof(long));
+    if (!contagens || !inicioBalde) {
+        printf("Erro: Falha na alocação de memória para os baldes.\n");
+        free(contagens);
+        free(inicioBalde);
+        return -1;
+    }
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].contagem = contagens + t * numBaldes;
+    }
+    executarItensPool(pool, contarTrecho, trechos, sizeof(TrechoAprendida), (int)numTrechos);
+
+    // Posição de cada balde e, dentro dele, de cada trecho (o que mantém a distribuição
+    // estável)
+    long posicao = 0, maiorBalde = 0;
+    for (long b = 0; b < numBaldes; b++) {
+        inicioBalde[b] = posicao;
+        for (long t = 0; t < numTrechos; t++) {
+            long quantidade = contagens[t * numBaldes + b];
+            contagens[t * numBaldes + b] = posicao;
+            posicao += quantidade;
+        }
+        long tamanho = posicao - inicioBalde[b];
+        maiorBalde = tamanho > maiorBalde ? tamanho : maiorBalde;
+    }
+    inicioBalde[numBaldes] = posicao;
+
+    int *auxiliar = (int *)obterBufferTemporario((size_t)n * sizeof(int));
+    if (!auxiliar) {
+        printf("Erro: Falha na alocação de memória para o vetor auxiliar.\n");
+        free(contagens);
+        free(inicioBalde);
+        return -1;
+    }
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].auxiliar = auxiliar;
+    }
+    executarItensPool(pool, espalharTrecho, trechos, sizeof(TrechoAprendida), (int)numTrechos);
+
+    // 4. Acabamento dos baldes, divididos em partes para equilibrar os trabalhadores
+    ParteBaldes partes[4 * APRENDIDA_MAX_TRECHOS];
+    long numPartes = numTrechos > 1 ? 4 * numTrechos : 1;
+    if (numPartes > numBaldes) {
+        numPartes = numBaldes;
+    }
+    for (long p = 0; p < numPartes; p++) {
+        partes[p].auxiliar = auxiliar;
+        partes[p].destino = destino;
+        partes[p].inicioBalde = inicioBalde;
+        partes[p].primeiro = numBaldes * p / numPartes;
+        partes[p].ultimo = numBaldes * (p + 1) / numPartes;
+        partes[p].maiorBalde = maiorBalde;
+        partes[p].capacidade = (double)APRENDIDA_CAPACIDADE * n / numBaldes;
+        partes[p].erro = 0;
+    }
+    executarItensPool(pool, acabarParte, partes, sizeof(ParteBaldes), (int)numPartes);
+
+    resultado = 0;
+    for (long p = 0; p < numPartes; p++) {
+        if (partes[p].erro) {
+            printf("Erro: Falha na alocação de memória para o acabamento dos baldes.\n");
+            resultado = -1;
+            break;
+        }
+    }
+
+    devolverBufferTemporario(auxiliar);
+    free(contagens);
+    free(inicioBalde);
+    return resultado;
+}
@@ -0,0 +1,243 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "Compactacao.h"
+#include "Contagem.h"
+#include "Memoria.h"
+
+#define COMPACTACAO_DIGITOS 256 // Dígitos de 8 bits do radix sort
+
+// Trecho [inicio, fim) processado por uma tarefa em cada fase
+typedef struct {
+    const int *vetor;        // Chaves originais (compactação)
+    int *saida;              // Vetor de resultado (expansão)
+    void *chaves;            // Chaves compactadas (origem da passada)
+    void *destino;           // Destino da passada do radix sort
+    int largura;             // Bytes por chave compactada (1 ou 2)
+    int minimo;
+    int deslocamento;        // Bits à direita do dígito da passada
+    long inicio;
+    long fim;
+    long contagem[COMPACTACAO_DIGITOS]; // Dígitos do trecho; depois, a próxima posição de cada um
+} TrechoCompactacao;
+
+// Função para obter o tempo monotônico em segundos
+static double agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Retorna a largura efetiva das chaves em [minimo, maximo]
+int larguraChaves(int minimo, int maximo) {
+    long faixa = (long)maximo - minimo;
+    if (faixa <= UINT8_MAX) {
+        return 8;
+    }
+    if (faixa <= UINT16_MAX) {
+        return 16;
+    }
+    return 32;
+}
+
+// Função para compactar as chaves de um trecho (chave - mínimo no tipo estreito)
+static void compactarTrecho(void *arg) {
+    TrechoCompactacao *t = (TrechoCompactacao *)arg;
+    unsigned int minimo = (unsigned int)t->minimo;
+    if (t->largura == 1) {
+        uint8_t *chaves = (uint8_t *)t->chaves;
+        for (long i = t->inicio; i < t->fim; i++) {
+            chaves[i] = (uint8_t)((unsigned int)t->vetor[i] - minimo);
+        }
+    } else {
+        uint16_t *chaves = (uint16_t *)t->chaves;
+        for (long i = t->inicio; i < t->fim; i++) {
+            chaves[i] = (uint16_t)((unsigned int)t->vetor[i] - minimo);
+        }
+    }
+}
+
+// Função para contar os dígitos da passada em um trecho
+static void contarDigitos(void *arg) {
+    TrechoCompactacao *t = (TrechoCompactacao *)arg;
+    memset(t->contagem, 0, sizeof(t->contagem));
+    if (t->largura == 1) {
+        const uint8_t *chaves = (const uint8_t *)t->chaves;
+        for (long i = t->inicio; i < t->fim; i++) {
+            t->contagem[chaves[i]]++;
+        }
+    } else {
+        const uint16_t *chaves = (const uint16_t *)t->chaves;
+        for (long i = t->inicio; i < t->fim; i++) {
+            t->contagem[(chaves[i] >> t->deslocamento) & 0xFF]++;
+        }
+    }
+}
+
+// Função para espalhar as chaves de um trecho nas posições dos seus dígitos (estável)
+static void espalharTrecho(void *arg) {
+    TrechoCompactacao *t = (TrechoCompactacao *)arg;
+    if (t->largura == 1) {
+        const uint8_t *chaves = (const uint8_t *)t->chaves;
+        uint8_t *destino = (uint8_t *)t->destino;
+        for (long i = t->inicio; i < t->fim; i++) {
+            destino[t->contagem[chaves[i]]++] = chaves[i];
+        }
+    } else {
+        const uint16_t *chaves = (const uint16_t *)t->chaves;
+        uint16_t *destino = (uint16_t *)t->destino;
+        for (long i = t->inicio; i < t->fim; i++) {
+            destino[t->contagem[(chaves[i] >> t->deslocamento) & 0xFF]++] = chaves[i];
+        }
+    }
+}
+
+// Função para expandir as chaves de um trecho de volta para int (mínimo + chave)
+static void expandirTrecho(void *arg) {
+    TrechoCompactacao *t = (TrechoCompactacao *)arg;
+    unsigned int minimo = (unsigned int)t->minimo;
+    if (t->largura == 1) {
+        const uint8_t *chaves = (const uint8_t *)t->chaves;
+        for (long i = t->inicio; i < t->fim; i++) {
+            t->saida[i] = (int)(minimo + chaves[i]);
+        }
+    } else {
+        const uint16_t *chaves = (const uint16_t *)t->chaves;
+        for (long i = t->inicio; i < t->fim; i++) {
+            t->saida[i] = (int)(minimo + chaves[i]);
+        }
+    }
+}
+
+// Função para executar uma passada do radix sort (chaves -> destino); retorna 0 se a
+// passada foi dispensada porque todas as chaves têm o mesmo dígito
+static int passadaRadix(PoolThreads *pool, TrechoCompactacao *trechos, int numTrechos, long n,
+                        void *chaves, void *destino, int deslocamento) {
+    for (int t = 0; t < numTrechos; t++) {
+        trechos[t].chaves = chaves;
+        trechos[t].destino = destino;
+        trechos[t].deslocamento = deslocamento;
+    }
+    executarItensPool(pool, contarDigitos, trechos, sizeof(trechos[0]), numTrechos);
+
+    // Posição inicial de cada dígito em cada trecho: dígitos em ordem e, dentro de cada
+    // dígito, os trechos em ordem (o que mantém a passada estável)
+    long posicao = 0;
+    for (int d = 0; d < COMPACTACAO_DIGITOS; d++) {
+        long total = 0;
+        for (int t = 0; t < numTrechos; t++) {
+            long quantidade = trechos[t].contagem[d];
+            trechos[t].contagem[d] = posicao;
+            posicao += quantidade;
+            total += quantidade;
+        }
+        if (total == n) {
+            return 0;
+        }
+    }
+
+    executarItensPool(pool, espalharTrecho, trechos, sizeof(trechos[0]), numTrechos);
+    return 1;
+}
+
+// Ordena os n elementos de origem em destino com as chaves compactadas
+int ordenarCompactado(const int *origem, int *destino, long n, PoolThreads *pool, MetricasCompactacao *metricas) {
+    memset(metricas, 0, sizeof(*metricas));
+    metricas->largura = 32;
+    if (n <= 0) {
+        return 1;
+    }
+
+    // 1. Detecção da largura
+    double inicio = agora();
+    faixaValores(origem, n, pool, 0, &metricas->minimo, &metricas->maximo);
+    metricas->largura = larguraChaves(metricas->minimo, metricas->maximo);
+    metricas->tempoDeteccao = agora() - inicio;
+    if (metricas->largura == 32) {
+        return 1;
+    }
+
+    int bytes = metricas->largura / 8;
+    void *chaves = obterBufferTemporario((size_t)n * bytes);
+    void *auxiliar = obterBufferTemporario((size_t)n * bytes);
+    if (!chaves || !auxiliar) {
+        printf("Erro: Falha na alocação de memória para as chaves compactadas.\n");
+        if (chaves) {
+            devolverBufferTemporario(chaves);
+        }
+        if (auxiliar) {
+            devolverBufferTemporario(auxiliar);
+        }
+        return -1;
+    }
+
+    // Um trecho por trabalhador, sem trechos pequenos demais
+    long numTrechos = numTrechosPool(pool, 0, n, COMPACTACAO_MIN_ELEMENTOS_TRECHO, COMPACTACAO_MAX_TRECHOS);
+    TrechoCompactacao *trechos = (TrechoCompactacao *)malloc((size_t)numTrechos * sizeof(TrechoCompactacao));
+    if (!trechos) {
+        printf("Erro: Falha na alocação de memória para os trechos da compactação.\n");
+        devolverBufferTemporario(chaves);
+        devolverBufferTemporario(auxiliar);
+        return -1;
+    }
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].vetor = origem;
+        trechos[t].saida = destino;
+        trechos[t].chaves = chaves;
+        trechos[t].largura = bytes;
+        trechos[t].minimo = metricas->minimo;
+        trechos[t].inicio = n * t / numTrechos;
+        trechos[t].fim = n * (t + 1) / numTrechos;
+    }
+
+    // 2. Compactação
+    inicio = agora();
+    executarItensPool(pool, compactarTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+    metricas->tempoCompactacao = agora() - inicio;
+
+    // 3. Radix sort com dígitos de 8 bits: uma passada por byte da largura (passadas com um
+    // único dígito são dispensadas)
+    inicio = agora();
+    void *atual = chaves, *proximo = auxiliar;
+    for (int deslocamento = 0; deslocamento < metricas->largura; deslocamento += 8) {
+        if (passadaRadix(pool, trechos, (int)numTrechos, n, atual, proximo, deslocamento)) {
+            void *temp = atual;
+            atual = proximo;
+            proximo = temp;
+            metricas->passadas++;
+        }
+    }
+    metricas->tempoOrdenacao = agora() - inicio;
+
+    // 4. Expansão para o vetor de resultado
+    inicio = agora();
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].chaves = atual;
+    }
+    executarItensPool(pool, expandirTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+    metricas->tempoExpansao = agora() - inicio;
+
+    free(trechos);
+    devolverBufferTemporario(chaves);
+    devolverBufferTemporario(auxiliar);
+    return 0;
+}
+
+// Imprime a largura e os tempos de cada fase
+void imprimirCompactacao(FILE *saida, const MetricasCompactacao *metricas) {
+    if (metricas->largura == 0) {
+        fprintf(saida, "Compactação: não executada (vetor resolvido pela pré-ordenação)\n");
+        return;
+    }
+    if (metricas->largura == 32) {
+        fprintf(saida, "Compactação: chaves de %d a %d precisam de 32 bits (detecção: %f s); "
+                "ordenado sem compactação\n", metricas->minimo, metricas->maximo, metricas->tempoDeteccao);
+        return;
+    }
+    fprintf(saida, "Compactação: chaves de %d a %d em %d bits, %d passada(s) de radix; detecção: %f s, "
+            "compactação: %f s, ordenação: %f s, expansão: %f s\n", metricas->minimo, metricas->maximo,
+            metricas->largura, metricas->passadas, metricas->tempoDeteccao, metricas->tempoCompactacao,
+            metricas->tempoOrdenacao, metricas->tempoExpansao);
+}
@@ -0,0 +1,51 @@
+#ifndef COMPACTACAO_H
+#define COMPACTACAO_H
+
+#include <stdio.h>
+#include "PoolThreads.h"
+
+/*
+ * Compactação das chaves: depois de subtrair o mínimo, muitos vetores cabem em 16 bits (ou
+ * em 8), e ordená-los como int de 32 bits desperdiça metade (ou três quartos) da banda de
+ * memória. A compactação é uma etapa opcional em volta da ordenação:
+ *
+ * 1. Detecção: mínimo e máximo por uma redução paralela; a largura efetiva é a do menor
+ *    tipo sem sinal que guarda máximo - mínimo (8 ou 16 bits; acima disso, 32 bits, e o
+ *    vetor é ordenado sem compactação pelo algoritmo pedido).
+ * 2. Compactação: cada chave vira (chave - mínimo) no tipo estreito.
+ * 3. Ordenação: radix sort LSD com dígitos de 8 bits, especializado na largura (uma
+ *    passada com 8 bits e duas com 16, contra quatro com 32); cada passada conta os dígitos
+ *    por trecho em paralelo e espalha as chaves de forma estável, também em paralelo.
+ * 4. Expansão: as chaves voltam a int (mínimo + chave) no vetor de resultado.
+ *
+ * O tempo de cada fase fica em MetricasCompactacao, para comparar o custo da transformação
+ * (detecção, compactação e expansão) com o ganho na ordenação.
+ */
+
+#define COMPACTACAO_MIN_ELEMENTOS_TRECHO 65536 // Elementos mínimos por trecho das fases paralelas
+#define COMPACTACAO_MAX_TRECHOS          256
+
+// Largura e tempos da compactação
+typedef struct {
+    int largura;            // Bits por chave: 8, 16 ou 32 (sem compactação); 0 = não executada
+    int minimo;
+    int maximo;
+    int passadas;           // Passadas do radix sort
+    double tempoDeteccao;   // Segundos
+    double tempoCompactacao;
+    double tempoOrdenacao;
+    double tempoExpansao;
+} MetricasCompactacao;
+
+// Retorna a largura efetiva (8, 16 ou 32 bits) das chaves em [minimo, maximo]
+int larguraChaves(int minimo, int maximo);
+
+// Ordena os n elementos de origem em destino (pode ser o próprio vetor) com as chaves
+// compactadas; com pool, as fases são divididas entre os trabalhadores. Retorna 0 em caso de
+// sucesso, 1 se as chaves precisarem de 32 bits (nada é alterado) e -1 em caso de erro.
+int ordenarCompactado(const int *origem, int *destino, long n, PoolThreads *pool, MetricasCompactacao *metricas);
+
+// Imprime a largura e os tempos de cada fase
+void imprimirCompactacao(FILE *saida, const MetricasCompactacao *metricas);
+
+#endif
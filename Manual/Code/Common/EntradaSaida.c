@@ -0,0 +1,1440 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include "EntradaSaida.h"
+#include "Memoria.h"
+#include "IndiceEsparso.h"
+#include "OrdenacaoCadeias.h"
+
+/*
+ * Implementação dos backends de E/S.
+ *
+ * Uma transferência descreve a cópia de um vetor inteiro entre a memória e o arquivo
+ * (o vetor começa logo após o cabeçalho de um inteiro). Os trechos do vetor são divididos
+ * em blocos alinhados a tamanhoBloco e enviados ao io_uring (ou ao pool de threads).
+ *
+ * No io_uring o próprio vetor é registrado como buffer fixo (em regiões de até 1 GB),
+ * o que evita cópias intermediárias e a fixação das páginas a cada requisição. Se o
+ * registro falhar (por exemplo, por limite de memória bloqueada), as mesmas requisições
+ * são feitas sem buffers fixos.
+ *
+ * A gravação direta usa um caminho próprio (EscritorDireto): a imagem do arquivo
+ * (cabeçalho + elementos) é montada em buffers alinhados e gravada por uma thread
+ * auxiliar, de forma que a cópia para um buffer se sobrepõe à gravação do outro.
+ */
+
+#define ES_REGIAO_MAX (1ul << 30) // Tamanho máximo de um buffer registrado no io_uring
+
+// Anel do io_uring mapeado na memória do processo
+typedef struct {
+    int fd;
+    unsigned entradas;
+    unsigned *sqCabeca, *sqCauda, *sqMascara, *sqVetor;
+    unsigned *cqCabeca, *cqCauda, *cqMascara;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sqMapa, *cqMapa;
+    size_t sqTamanho, cqTamanho, sqesTamanho;
+    unsigned naoSubmetidas; // Entradas preenchidas ainda não entregues ao kernel
+} AnelUring;
+
+// Requisição em voo (um bloco do vetor)
+typedef struct {
+    size_t inicio;  // Byte inicial dentro do vetor
+    size_t tamanho; // Bytes restantes
+} RequisicaoES;
+
+// Pool de threads do fallback pread/pwrite
+typedef struct {
+    pthread_t threads[ES_THREADS_POOL];
+    int numThreads;
+    pthread_mutex_t mutex;
+    pthread_cond_t temTarefa;
+    RequisicaoES *fila;
+    size_t capacidade, cabeca, cauda;
+    int encerrar;
+} PoolES;
+
+// Gravação direta com dois buffers alinhados
+typedef struct {
+    int fd;
+    int usandoDireto;         // 0 se o sistema de arquivos não aceitou O_DIRECT
+    char *buffers[2];
+    int atual;                // Buffer sendo preenchido
+    size_t preenchido;        // Bytes válidos no buffer atual
+    off_t posicaoAtual;       // Posição do buffer atual no arquivo
+    long proximoElemento;     // Próximo elemento esperado (envio em ordem)
+    off_t tamanhoFinal;       // Tamanho exato do arquivo
+
+    // Thread de gravação
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int pendente;             // Buffer aguardando gravação (-1 se nenhum)
+    size_t tamanhoPendente;
+    off_t posicaoPendente;
+    int encerrar;
+    int erro;
+} EscritorDireto;
+
+// Estado de uma transferência (também usado como gravador incremental)
+struct GravadorVetor {
+    BackendES backend;
+    int fd;
+    int escrita;          // 1 = memória -> arquivo, 0 = arquivo -> memória
+    char *base;           // Início do vetor na memória
+    size_t totalBytes;    // Tamanho do vetor em bytes
+    off_t deslocamento;   // Posição do vetor no arquivo
+    size_t tamanhoBloco;
+    int erro;             // Primeiro errno observado
+
+    // io_uring
+    AnelUring anel;
+    int buffersFixos;     // 1 se o vetor foi registrado
+    size_t tamanhoRegiao; // Bytes por buffer registrado
+    RequisicaoES *slots;  // Requisições em voo, indexadas por user_data
+    int *slotsLivres;
+    int numLivres, profundidade;
+
+    // pread/pwrite
+    PoolES pool;
+
+    // Gravação direta e durabilidade
+    EscritorDireto *direto;
+    int durabilidade;
+
+    // Índice esparso gravado ao fechar (ou NULL)
+    char *arquivoIndice;
+    int n;
+};
+
+typedef struct GravadorVetor TransferenciaES;
+
+// Preenche a configuração com os valores padrão (backend stdio)
+void configuracaoESPadrao(ConfiguracaoES *config) {
+    config->backend = ES_STDIO;
+    config->tamanhoBloco = ES_TAMANHO_BLOCO_PADRAO;
+    config->profundidade = ES_PROFUNDIDADE_PADRAO;
+    config->direto = 0;
+    config->durabilidade = 0;
+    config->indiceEsparso = 0;
+}
+
+// Retorna 1 se a configuração grava a saída em segundo plano
+int gravacaoIncremental(const ConfiguracaoES *config) {
+    return config->backend != ES_STDIO || config->direto;
+}
+
+// Converte o nome do backend; retorna -1 se for inválido
+int backendESDoNome(const char *nome, BackendES *backend) {
+    if (strcmp(nome, "stdio") == 0) {
+        *backend = ES_STDIO;
+    } else if (strcmp(nome, "uring") == 0) {
+        *backend = ES_URING;
+    } else if (strcmp(nome, "pread") == 0) {
+        *backend = ES_PREAD;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+// Retorna o nome do backend
+const char *nomeBackendES(BackendES backend) {
+    switch (backend) {
+        case ES_URING: return "uring";
+        case ES_PREAD: return "pread";
+        default:       return "stdio";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// io_uring (chamadas de sistema diretas, sem depender da liburing)
+// ---------------------------------------------------------------------------
+
+// Função para criar o anel e mapear as filas de submissão e conclusão
+static int iniciarAnel(AnelUring *anel, unsigned entradas) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(anel, 0, sizeof(*anel));
+
+    anel->fd = (int)syscall(__NR_io_uring_setup, entradas, &p);
+    if (anel->fd < 0) {
+        return -1;
+    }
+
+    anel->sqTamanho = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    anel->cqTamanho = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (anel->cqTamanho > anel->sqTamanho) {
+            anel->sqTamanho = anel->cqTamanho;
+        }
+        anel->cqTamanho = anel->sqTamanho;
+    }
+
+    anel->sqMapa = mmap(NULL, anel->sqTamanho, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, anel->fd, IORING_OFF_SQ_RING);
+    if (anel->sqMapa == MAP_FAILED) {
+        close(anel->fd);
+        return -1;
+    }
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        anel->cqMapa = anel->sqMapa;
+    } else {
+        anel->cqMapa = mmap(NULL, anel->cqTamanho, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, anel->fd, IORING_OFF_CQ_RING);
+        if (anel->cqMapa == MAP_FAILED) {
+            munmap(anel->sqMapa, anel->sqTamanho);
+            close(anel->fd);
+            return -1;
+        }
+    }
+
+    anel->sqesTamanho = p.sq_entries * sizeof(struct io_uring_sqe);
+    anel->sqes = mmap(NULL, anel->sqesTamanho, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, anel->fd, IORING_OFF_SQES);
+    if (anel->sqes == MAP_FAILED) {
+        if (anel->cqMapa != anel->sqMapa) {
+            munmap(anel->cqMapa, anel->cqTamanho);
+        }
+        munmap(anel->sqMapa, anel->sqTamanho);
+        close(anel->fd);
+        return -1;
+    }
+
+    char *sq = anel->sqMapa;
+    char *cq = anel->cqMapa;
+    anel->entradas = p.sq_entries;
+    anel->sqCabeca = (unsigned *)(sq + p.sq_off.head);
+    anel->sqCauda = (unsigned *)(sq + p.sq_off.tail);
+    anel->sqMascara = (unsigned *)(sq + p.sq_off.ring_mask);
+    anel->sqVetor = (unsigned *)(sq + p.sq_off.array);
+    anel->cqCabeca = (unsigned *)(cq + p.cq_off.head);
+    anel->cqCauda = (unsigned *)(cq + p.cq_off.tail);
+    anel->cqMascara = (unsigned *)(cq + p.cq_off.ring_mask);
+    anel->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return 0;
+}
+
+// Função para desfazer os mapeamentos e fechar o anel
+static void encerrarAnel(AnelUring *anel) {
+    munmap(anel->sqes, anel->sqesTamanho);
+    if (anel->cqMapa != anel->sqMapa) {
+        munmap(anel->cqMapa, anel->cqTamanho);
+    }
+    munmap(anel->sqMapa, anel->sqTamanho);
+    close(anel->fd);
+}
+
+// Função para obter a próxima entrada livre da fila de submissão
+static struct io_uring_sqe *obterEntradaSubmissao(AnelUring *anel) {
+    unsigned cauda = *anel->sqCauda;
+    unsigned cabeca = __atomic_load_n(anel->sqCabeca, __ATOMIC_ACQUIRE);
+    if (cauda - cabeca >= anel->entradas) {
+        return NULL;
+    }
+
+    unsigned indice = cauda & *anel->sqMascara;
+    struct io_uring_sqe *sqe = &anel->sqes[indice];
+    memset(sqe, 0, sizeof(*sqe));
+    anel->sqVetor[indice] = indice;
+    return sqe;
+}
+
+// Função para publicar a entrada preenchida por obterEntradaSubmissao
+static void publicarEntradaSubmissao(AnelUring *anel) {
+    __atomic_store_n(anel->sqCauda, *anel->sqCauda + 1, __ATOMIC_RELEASE);
+    anel->naoSubmetidas++;
+}
+
+// Função para entregar as entradas pendentes ao kernel e aguardar minConcluidas conclusões
+static int submeterAnel(AnelUring *anel, unsigned minConcluidas) {
+    while (1) {
+        int ret = (int)syscall(__NR_io_uring_enter, anel->fd, anel->naoSubmetidas,
+                               minConcluidas, minConcluidas ? IORING_ENTER_GETEVENTS : 0,
+                               NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -errno;
+        }
+        anel->naoSubmetidas -= (unsigned)ret < anel->naoSubmetidas ? (unsigned)ret : anel->naoSubmetidas;
+        if (anel->naoSubmetidas == 0) {
+            return 0;
+        }
+    }
+}
+
+// Função para retirar uma conclusão da fila; retorna 0 se a fila estiver vazia
+static int colherConclusao(AnelUring *anel, struct io_uring_cqe *cqe) {
+    unsigned cabeca = *anel->cqCabeca;
+    if (cabeca == __atomic_load_n(anel->cqCauda, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    *cqe = anel->cqes[cabeca & *anel->cqMascara];
+    __atomic_store_n(anel->cqCabeca, cabeca + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// Função para registrar o vetor como buffers fixos (regiões múltiplas do tamanho do bloco)
+static void registrarBuffersFixos(TransferenciaES *t) {
+    t->buffersFixos = 0;
+    t->tamanhoRegiao = (ES_REGIAO_MAX / t->tamanhoBloco) * t->tamanhoBloco;
+    if (t->totalBytes == 0) {
+        return;
+    }
+
+    size_t numRegioes = (t->totalBytes + t->tamanhoRegiao - 1) / t->tamanhoRegiao;
+    struct iovec *regioes = malloc(numRegioes * sizeof(struct iovec));
+    if (!regioes) {
+        return;
+    }
+    for (size_t i = 0; i < numRegioes; i++) {
+        size_t inicio = i * t->tamanhoRegiao;
+        size_t restante = t->totalBytes - inicio;
+        regioes[i].iov_base = t->base + inicio;
+        regioes[i].iov_len = restante < t->tamanhoRegiao ? restante : t->tamanhoRegiao;
+    }
+
+    if (syscall(__NR_io_uring_register, t->anel.fd, IORING_REGISTER_BUFFERS,
+                regioes, (unsigned)numRegioes) == 0) {
+        t->buffersFixos = 1;
+    }
+    free(regioes);
+}
+
+// Função para preencher e publicar a requisição do slot indicado
+static void prepararRequisicaoUring(TransferenciaES *t, struct io_uring_sqe *sqe, int slot) {
+    RequisicaoES *req = &t->slots[slot];
+
+    if (t->buffersFixos) {
+        sqe->opcode = t->escrita ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->buf_index = (unsigned short)(req->inicio / t->tamanhoRegiao);
+    } else {
+        sqe->opcode = t->escrita ? IORING_OP_WRITE : IORING_OP_READ;
+    }
+    sqe->fd = t->fd;
+    sqe->addr = (unsigned long)(t->base + req->inicio);
+    sqe->len = (unsigned)req->tamanho;
+    sqe->off = (unsigned long long)(t->deslocamento + (off_t)req->inicio);
+    sqe->user_data = (unsigned long long)slot;
+    publicarEntradaSubmissao(&t->anel);
+}
+
+// Função para tratar as conclusões disponíveis (reenviando transferências parciais)
+static void tratarConclusoesUring(TransferenciaES *t) {
+    struct io_uring_cqe cqe;
+    while (colherConclusao(&t->anel, &cqe)) {
+        int slot = (int)cqe.user_data;
+        RequisicaoES *req = &t->slots[slot];
+
+        if (cqe.res < 0 || (cqe.res == 0 && req->tamanho > 0)) {
+            if (!t->erro) {
+                t->erro = cqe.res < 0 ? -cqe.res : EIO;
+            }
+            t->slotsLivres[t->numLivres++] = slot;
+            continue;
+        }
+
+        req->inicio += (size_t)cqe.res;
+        req->tamanho -= (size_t)cqe.res;
+        if (req->tamanho > 0) {
+            // Transferência parcial: reenviar o restante no mesmo slot
+            struct io_uring_sqe *sqe = obterEntradaSubmissao(&t->anel);
+            if (sqe) {
+                prepararRequisicaoUring(t, sqe, slot);
+                continue;
+            }
+            if (!t->erro) {
+                t->erro = EAGAIN;
+            }
+        }
+        t->slotsLivres[t->numLivres++] = slot;
+    }
+}
+
+// Função para enviar um bloco ao io_uring, aguardando um slot livre se necessário
+static void enviarBlocoUring(TransferenciaES *t, size_t inicio, size_t tamanho) {
+    while (t->numLivres == 0 && !t->erro) {
+        int ret = submeterAnel(&t->anel, 1);
+        if (ret < 0) {
+            t->erro = -ret;
+            return;
+        }
+        tratarConclusoesUring(t);
+    }
+    if (t->erro) {
+        return;
+    }
+
+    struct io_uring_sqe *sqe = obterEntradaSubmissao(&t->anel);
+    if (!sqe) {
+        int ret = submeterAnel(&t->anel, 0);
+        if (ret < 0 || !(sqe = obterEntradaSubmissao(&t->anel))) {
+            t->erro = ret < 0 ? -ret : EAGAIN;
+            return;
+        }
+    }
+
+    int slot = t->slotsLivres[--t->numLivres];
+    t->slots[slot].inicio = inicio;
+    t->slots[slot].tamanho = tamanho;
+    prepararRequisicaoUring(t, sqe, slot);
+
+    // Entregar ao kernel sem esperar, mantendo várias requisições em voo
+    int ret = submeterAnel(&t->anel, 0);
+    if (ret < 0 && !t->erro) {
+        t->erro = -ret;
+    }
+}
+
+// Função para aguardar todas as requisições em voo no io_uring
+static void aguardarUring(TransferenciaES *t) {
+    while (t->numLivres < t->profundidade) {
+        int ret = submeterAnel(&t->anel, 1);
+        if (ret < 0) {
+            if (!t->erro) {
+                t->erro = -ret;
+            }
+            return;
+        }
+        tratarConclusoesUring(t);
+    }
+}
+
+// Função para preparar o io_uring da transferência; retorna -1 se não estiver disponível
+static int iniciarUring(TransferenciaES *t, int profundidade) {
+    if (profundidade < 1) {
+        profundidade = ES_PROFUNDIDADE_PADRAO;
+    }
+    if (iniciarAnel(&t->anel, (unsigned)profundidade) < 0) {
+        return -1;
+    }
+
+    t->profundidade = profundidade;
+    t->slots = malloc(profundidade * sizeof(RequisicaoES));
+    t->slotsLivres = malloc(profundidade * sizeof(int));
+    if (!t->slots || !t->slotsLivres) {
+        free(t->slots);
+        free(t->slotsLivres);
+        encerrarAnel(&t->anel);
+        return -1;
+    }
+    for (int i = 0; i < profundidade; i++) {
+        t->slotsLivres[i] = i;
+    }
+    t->numLivres = profundidade;
+
+    registrarBuffersFixos(t);
+    return 0;
+}
+
+// Função para liberar os recursos do io_uring
+static void encerrarUring(TransferenciaES *t) {
+    if (t->buffersFixos) {
+        syscall(__NR_io_uring_register, t->anel.fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+    }
+    encerrarAnel(&t->anel);
+    free(t->slots);
+    free(t->slotsLivres);
+}
+
+// ---------------------------------------------------------------------------
+// Fallback pread/pwrite com pool de threads
+// ---------------------------------------------------------------------------
+
+// Função executada pelas threads do pool: transfere blocos até a fila se esgotar
+static void *trabalhadorPoolES(void *arg) {
+    TransferenciaES *t = (TransferenciaES *)arg;
+    PoolES *pool = &t->pool;
+
+    while (1) {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->cabeca == pool->cauda && !pool->encerrar) {
+            pthread_cond_wait(&pool->temTarefa, &pool->mutex);
+        }
+        if (pool->cabeca == pool->cauda) {
+            pthread_mutex_unlock(&pool->mutex);
+            return NULL;
+        }
+        RequisicaoES req = pool->fila[pool->cabeca++];
+        pthread_mutex_unlock(&pool->mutex);
+
+        while (req.tamanho > 0) {
+            char *ptr = t->base + req.inicio;
+            off_t pos = t->deslocamento + (off_t)req.inicio;
+            ssize_t ret = t->escrita ? pwrite(t->fd, ptr, req.tamanho, pos)
+                                     : pread(t->fd, ptr, req.tamanho, pos);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret <= 0) {
+                pthread_mutex_lock(&pool->mutex);
+                if (!t->erro) {
+                    t->erro = ret < 0 ? errno : EIO;
+                }
+                pthread_mutex_unlock(&pool->mutex);
+                break;
+            }
+            req.inicio += (size_t)ret;
+            req.tamanho -= (size_t)ret;
+        }
+    }
+}
+
+// Função para criar o pool de threads da transferência
+static int iniciarPoolES(TransferenciaES *t) {
+    PoolES *pool = &t->pool;
+    memset(pool, 0, sizeof(*pool));
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->temTarefa, NULL);
+
+    for (int i = 0; i < ES_THREADS_POOL; i++) {
+        if (pthread_create(&pool->threads[i], NULL, trabalhadorPoolES, t) != 0) {
+            break;
+        }
+        pool->numThreads++;
+    }
+    return pool->numThreads > 0 ? 0 : -1;
+}
+
+// Função para colocar um bloco na fila do pool
+static void enviarBlocoPool(TransferenciaES *t, size_t inicio, size_t tamanho) {
+    PoolES *pool = &t->pool;
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->cauda == pool->capacidade) {
+        size_t novaCapacidade = pool->capacidade ? pool->capacidade * 2 : 64;
+        RequisicaoES *novaFila = realloc(pool->fila, novaCapacidade * sizeof(RequisicaoES));
+        if (!novaFila) {
+            if (!t->erro) {
+                t->erro = ENOMEM;
+            }
+            pthread_mutex_unlock(&pool->mutex);
+            return;
+        }
+        pool->fila = novaFila;
+        pool->capacidade = novaCapacidade;
+    }
+    pool->fila[pool->cauda].inicio = inicio;
+    pool->fila[pool->cauda].tamanho = tamanho;
+    pool->cauda++;
+    pthread_cond_signal(&pool->temTarefa);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// Função para esvaziar a fila, encerrar as threads e liberar o pool
+static void encerrarPoolES(TransferenciaES *t) {
+    PoolES *pool = &t->pool;
+    pthread_mutex_lock(&pool->mutex);
+    pool->encerrar = 1;
+    pthread_cond_broadcast(&pool->temTarefa);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->numThreads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->temTarefa);
+    free(pool->fila);
+}
+
+// ---------------------------------------------------------------------------
+// Transferências
+// ---------------------------------------------------------------------------
+
+// Função para iniciar uma transferência assíncrona (io_uring ou pool)
+static TransferenciaES *iniciarTransferencia(int fd, char *base, size_t totalBytes, off_t deslocamento,
+                                             int escrita, const ConfiguracaoES *config) {
+    TransferenciaES *t = calloc(1, sizeof(TransferenciaES));
+    if (!t) {
+        return NULL;
+    }
+
+    t->fd = fd;
+    t->base = base;
+    t->totalBytes = totalBytes;
+    t->deslocamento = deslocamento;
+    t->escrita = escrita;
+    t->backend = config->backend;
+    t->tamanhoBloco = config->tamanhoBloco;
+    if (t->tamanhoBloco < ES_TAMANHO_BLOCO_MIN || t->tamanhoBloco > ES_TAMANHO_BLOCO_MAX) {
+        t->tamanhoBloco = ES_TAMANHO_BLOCO_PADRAO;
+    }
+
+    if (t->backend == ES_URING && iniciarUring(t, config->profundidade) < 0) {
+        fprintf(stderr, "Aviso: io_uring indisponível (%s); usando pread/pwrite.\n", strerror(errno));
+        t->backend = ES_PREAD;
+    }
+    if (t->backend == ES_PREAD && iniciarPoolES(t) < 0) {
+        // Sem threads auxiliares: as transferências serão feitas na própria thread
+        t->backend = ES_STDIO;
+    }
+    return t;
+}
+
+// Função para transferir os bytes [inicio, inicio + tamanho), divididos em blocos alinhados
+static void transferirIntervalo(TransferenciaES *t, size_t inicio, size_t tamanho) {
+    size_t fim = inicio + tamanho;
+    while (inicio < fim && !t->erro) {
+        size_t limiteBloco = (inicio / t->tamanhoBloco + 1) * t->tamanhoBloco;
+        size_t fimBloco = limiteBloco < fim ? limiteBloco : fim;
+
+        if (t->backend == ES_URING) {
+            enviarBlocoUring(t, inicio, fimBloco - inicio);
+        } else if (t->backend == ES_PREAD) {
+            enviarBlocoPool(t, inicio, fimBloco - inicio);
+        } else {
+            char *ptr = t->base + inicio;
+            off_t pos = t->deslocamento + (off_t)inicio;
+            ssize_t ret = t->escrita ? pwrite(t->fd, ptr, fimBloco - inicio, pos)
+                                     : pread(t->fd, ptr, fimBloco - inicio, pos);
+            if (ret <= 0) {
+                if (ret < 0 && errno == EINTR) {
+                    continue;
+                }
+                t->erro = ret < 0 ? errno : EIO;
+                return;
+            }
+            fimBloco = inicio + (size_t)ret;
+        }
+        inicio = fimBloco;
+    }
+}
+
+// Função para aguardar a conclusão da transferência; retorna o primeiro erro observado
+static int concluirTransferencia(TransferenciaES *t) {
+    if (t->backend == ES_URING) {
+        aguardarUring(t);
+        encerrarUring(t);
+    } else if (t->backend == ES_PREAD) {
+        encerrarPoolES(t);
+    }
+    int erro = t->erro;
+    free(t);
+    return erro;
+}
+
+// Função para transferir uma região inteira do arquivo; retorna 0 ou o código de erro
+static int transferirRegiao(int fd, char *base, size_t bytes, off_t deslocamento, int escrita,
+                            const ConfiguracaoES *config) {
+    TransferenciaES *t = iniciarTransferencia(fd, base, bytes, deslocamento, escrita, config);
+    if (!t) {
+        return ENOMEM;
+    }
+    transferirIntervalo(t, 0, bytes);
+    return concluirTransferencia(t);
+}
+
+// Função para ler os valores com fread (backend original)
+static int lerValoresStdio(const char *nomeArquivo, int *vetor, int n) {
+    FILE *arquivo = fopen(nomeArquivo, "rb");
+    if (!arquivo) {
+        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
+        return -1;
+    }
+
+    // Pular o tamanho e ler os valores do vetor
+    if (fseek(arquivo, sizeof(int), SEEK_SET) != 0 ||
+        fread(vetor, sizeof(int), n, arquivo) != (size_t)n) {
+        printf("Erro: Falha ao ler os valores do vetor.\n");
+        fclose(arquivo);
+        return -1;
+    }
+
+    fclose(arquivo);
+    return 0;
+}
+
+// Lê apenas o tamanho do vetor gravado no arquivo
+int lerTamanhoArquivo(const char *nomeArquivo, int *n) {
+    FILE *arquivo = fopen(nomeArquivo, "rb");
+    if (!arquivo) {
+        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
+        return -1;
+    }
+
+    // Ler o tamanho do vetor
+    if (fread(n, sizeof(int), 1, arquivo) != 1 || *n < 0) {
+        printf("Erro: Falha ao ler o tamanho do vetor.\n");
+        fclose(arquivo);
+        return -1;
+    }
+
+    fclose(arquivo);
+    return 0;
+}
+
+// Lê os valores do arquivo em blocos, entregando cada bloco a consumir
+int lerVetorEmBlocos(const char *nomeArquivo, int *bloco, long capacidade,
+                     void (*consumir)(const int *valores, long quantidade, void *contexto), void *contexto) {
+    int fd = open(nomeArquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
+        return -1;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    int n;
+    if (pread(fd, &n, sizeof(n), 0) != (ssize_t)sizeof(n) || n < 0) {
+        printf("Erro: Falha ao ler o tamanho do vetor.\n");
+        close(fd);
+        return -1;
+    }
+
+    off_t posicao = sizeof(int);
+    long restantes = n;
+    while (restantes > 0) {
+        long quantidade = restantes < capacidade ? restantes : capacidade;
+        size_t bytes = (size_t)quantidade * sizeof(int);
+        size_t lidos = 0;
+        while (lidos < bytes) {
+            ssize_t ret = pread(fd, (char *)bloco + lidos, bytes - lidos, posicao + (off_t)lidos);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret <= 0) {
+                printf("Erro: Falha ao ler os elementos do vetor (%s).\n", ret < 0 ? strerror(errno) : "fim do arquivo");
+                close(fd);
+                return -1;
+            }
+            lidos += (size_t)ret;
+        }
+        consumir(bloco, quantidade, contexto);
+        posicao += (off_t)bytes;
+        restantes -= quantidade;
+    }
+
+    close(fd);
+    return 0;
+}
+
+// Lê os n valores do arquivo para um vetor já alocado
+int lerValoresArquivo(const char *nomeArquivo, int *vetor, int n, const ConfiguracaoES *config) {
+    if (config->backend == ES_STDIO) {
+        return lerValoresStdio(nomeArquivo, vetor, n);
+    }
+
+    int fd = open(nomeArquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
+        return -1;
+    }
+
+    // Ler os valores do vetor com várias requisições em voo
+    int erro = transferirRegiao(fd, (char *)vetor, (size_t)n * sizeof(int), sizeof(int), 0, config);
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao ler os valores do vetor (%s).\n", strerror(erro));
+        return -1;
+    }
+    return 0;
+}
+
+// Lê os elementos [inicio, inicio + quantidade) do vetor gravado no arquivo
+int lerTrechoVetorArquivo(const char *nomeArquivo, int *vetor, long inicio, long quantidade,
+                          const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
+        return -1;
+    }
+
+    off_t deslocamento = (off_t)(inicio + 1) * (off_t)sizeof(int); // Depois do tamanho
+    int erro = transferirRegiao(fd, (char *)vetor, (size_t)quantidade * sizeof(int), deslocamento, 0, config);
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao ler os valores do vetor (%s).\n", strerror(erro));
+        return -1;
+    }
+    return 0;
+}
+
+// Lê o vetor do arquivo binário; retorna NULL em caso de erro
+int *lerVetorArquivo(const char *nomeArquivo, int *n, const ConfiguracaoES *config) {
+    if (lerTamanhoArquivo(nomeArquivo, n) != 0) {
+        return NULL;
+    }
+
+    // Alocar memória para o vetor
+    int *vetor = (int *)alocarBuffer((size_t)*n * sizeof(int));
+    if (!vetor && *n > 0) {
+        printf("Erro: Falha na alocação de memória.\n");
+        return NULL;
+    }
+
+    if (lerValoresArquivo(nomeArquivo, vetor, *n, config) != 0) {
+        liberarBuffer(vetor);
+        return NULL;
+    }
+    return vetor;
+}
+
+// ---------------------------------------------------------------------------
+// Arquivos segmentados
+// ---------------------------------------------------------------------------
+
+// Os deslocamentos são gravados como inteiros de 64 bits, o mesmo tamanho de long no Linux
+_Static_assert(sizeof(long) == 8, "long deve ter 64 bits");
+
+// Função para obter a posição dos valores em um arquivo segmentado
+static off_t posicaoValoresSegmentados(int numSegmentos) {
+    return (off_t)(3 * sizeof(int)) + (off_t)(numSegmentos + 1) * (off_t)sizeof(long);
+}
+
+// Lê um arquivo segmentado
+int lerSegmentosArquivo(const char *nomeArquivo, int **valores, int *n, long **deslocamentos,
+                        int *numSegmentos, const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
+        return -1;
+    }
+
+    // Cabeçalho: marcador, número de segmentos e número de valores
+    int cabecalho[3];
+    if (pread(fd, cabecalho, sizeof(cabecalho), 0) != (ssize_t)sizeof(cabecalho) ||
+        cabecalho[0] != ES_MARCADOR_SEGMENTADO || cabecalho[1] < 0 || cabecalho[2] < 0) {
+        printf("Erro: %s não é um arquivo segmentado válido.\n", nomeArquivo);
+        close(fd);
+        return -1;
+    }
+    *numSegmentos = cabecalho[1];
+    *n = cabecalho[2];
+
+    // Deslocamentos: crescentes, de 0 até n
+    size_t bytesDeslocamentos = (size_t)(*numSegmentos + 1) * sizeof(long);
+    *deslocamentos = malloc(bytesDeslocamentos);
+    if (!*deslocamentos) {
+        printf("Erro: Falha na alocação de memória.\n");
+        close(fd);
+        return -1;
+    }
+    int erro = transferirRegiao(fd, (char *)*deslocamentos, bytesDeslocamentos, 3 * sizeof(int), 0, config);
+    int valido = !erro && (*deslocamentos)[0] == 0 && (*deslocamentos)[*numSegmentos] == *n;
+    for (int s = 0; valido && s < *numSegmentos; s++) {
+        valido = (*deslocamentos)[s] <= (*deslocamentos)[s + 1];
+    }
+    if (!valido) {
+        printf("Erro: Deslocamentos inválidos em %s.\n", nomeArquivo);
+        free(*deslocamentos);
+        close(fd);
+        return -1;
+    }
+
+    // Valores de todos os segmentos, em um único buffer
+    *valores = (int *)alocarBuffer((size_t)*n * sizeof(int));
+    if (!*valores) {
+        printf("Erro: Falha na alocação de memória.\n");
+        free(*deslocamentos);
+        close(fd);
+        return -1;
+    }
+    erro = transferirRegiao(fd, (char *)*valores, (size_t)*n * sizeof(int),
+                            posicaoValoresSegmentados(*numSegmentos), 0, config);
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao ler os valores dos segmentos (%s).\n", strerror(erro));
+        liberarBuffer(*valores);
+        free(*deslocamentos);
+        return -1;
+    }
+    return 0;
+}
+
+// Grava um arquivo segmentado
+int gravarSegmentosArquivo(const char *nomeArquivo, const int *valores, const long *deslocamentos,
+                           int numSegmentos, const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Erro: Não foi possível criar o arquivo de saída.\n");
+        return -1;
+    }
+
+    int n = (int)deslocamentos[numSegmentos];
+    int cabecalho[3] = { ES_MARCADOR_SEGMENTADO, numSegmentos, n };
+    int erro = transferirRegiao(fd, (char *)cabecalho, sizeof(cabecalho), 0, 1, config);
+    if (!erro) {
+        erro = transferirRegiao(fd, (char *)deslocamentos, (size_t)(numSegmentos + 1) * sizeof(long),
+                                3 * sizeof(int), 1, config);
+    }
+    if (!erro) {
+        erro = transferirRegiao(fd, (char *)valores, (size_t)n * sizeof(int),
+                                posicaoValoresSegmentados(numSegmentos), 1, config);
+    }
+
+    // No modo de durabilidade, garantir que os dados cheguem ao dispositivo
+    if (!erro && config->durabilidade && fdatasync(fd) != 0) {
+        erro = errno;
+    }
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao gravar o arquivo segmentado (%s).\n", strerror(erro));
+        return -1;
+    }
+    return 0;
+}
+
+// Lê um arquivo de registros
+int lerRegistrosArquivo(const char *nomeArquivo, void **registros, int *n, int *larguraChave,
+                        int *larguraCarga, const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
+        return -1;
+    }
+
+    // Cabeçalho: marcador, larguras da chave e da carga e número de registros
+    int cabecalho[4];
+    if (pread(fd, cabecalho, sizeof(cabecalho), 0) != (ssize_t)sizeof(cabecalho) ||
+        cabecalho[0] != ES_MARCADOR_REGISTROS || (cabecalho[1] != 4 && cabecalho[1] != 8) ||
+        cabecalho[2] < 0 || cabecalho[2] > ES_CARGA_MAXIMA || cabecalho[3] < 0) {
+        printf("Erro: %s não é um arquivo de registros válido.\n", nomeArquivo);
+        close(fd);
+        return -1;
+    }
+    *larguraChave = cabecalho[1];
+    *larguraCarga = cabecalho[2];
+    *n = cabecalho[3];
+
+    size_t bytes = (size_t)*n * (size_t)(*larguraChave + *larguraCarga);
+    *registros = alocarBuffer(bytes > 0 ? bytes : 1);
+    if (!*registros) {
+        printf("Erro: Falha na alocação de memória.\n");
+        close(fd);
+        return -1;
+    }
+    int erro = transferirRegiao(fd, (char *)*registros, bytes, sizeof(cabecalho), 0, config);
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao ler os registros (%s).\n", strerror(erro));
+        liberarBuffer(*registros);
+        return -1;
+    }
+    return 0;
+}
+
+// Grava um arquivo de registros
+int gravarRegistrosArquivo(const char *nomeArquivo, const void *registros, int n, int larguraChave,
+                           int larguraCarga, const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Erro: Não foi possível criar o arquivo de saída.\n");
+        return -1;
+    }
+
+    int cabecalho[4] = { ES_MARCADOR_REGISTROS, larguraChave, larguraCarga, n };
+    int erro = transferirRegiao(fd, (char *)cabecalho, sizeof(cabecalho), 0, 1, config);
+    if (!erro) {
+        erro = transferirRegiao(fd, (char *)registros, (size_t)n * (size_t)(larguraChave + larguraCarga),
+                                sizeof(cabecalho), 1, config);
+    }
+
+    // No modo de durabilidade, garantir que os dados cheguem ao dispositivo
+    if (!erro && config->durabilidade && fdatasync(fd) != 0) {
+        erro = errno;
+    }
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao gravar o arquivo de registros (%s).\n", strerror(erro));
+        return -1;
+    }
+    return 0;
+}
+
+// Lê um arquivo de permutação
+int lerPermutacaoArquivo(const char *nomeArquivo, void **indices, int *n, int *larguraIndice,
+                         const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir o arquivo de permutação.\n");
+        return -1;
+    }
+
+    // Cabeçalho: marcador, largura dos índices e número de índices
+    int cabecalho[3];
+    if (pread(fd, cabecalho, sizeof(cabecalho), 0) != (ssize_t)sizeof(cabecalho) ||
+        cabecalho[0] != ES_MARCADOR_PERMUTACAO || (cabecalho[1] != 4 && cabecalho[1] != 8) || cabecalho[2] < 0) {
+        printf("Erro: %s não é um arquivo de permutação válido.\n", nomeArquivo);
+        close(fd);
+        return -1;
+    }
+    *larguraIndice = cabecalho[1];
+    *n = cabecalho[2];
+
+    size_t bytes = (size_t)*n * (size_t)*larguraIndice;
+    *indices = alocarBuffer(bytes > 0 ? bytes : 1);
+    if (!*indices) {
+        printf("Erro: Falha na alocação de memória.\n");
+        close(fd);
+        return -1;
+    }
+    int erro = transferirRegiao(fd, (char *)*indices, bytes, sizeof(cabecalho), 0, config);
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao ler a permutação (%s).\n", strerror(erro));
+        liberarBuffer(*indices);
+        return -1;
+    }
+    return 0;
+}
+
+// Grava um arquivo de permutação
+int gravarPermutacaoArquivo(const char *nomeArquivo, const void *indices, int n, int larguraIndice,
+                            const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Erro: Não foi possível criar o arquivo de permutação.\n");
+        return -1;
+    }
+
+    int cabecalho[3] = { ES_MARCADOR_PERMUTACAO, larguraIndice, n };
+    int erro = transferirRegiao(fd, (char *)cabecalho, sizeof(cabecalho), 0, 1, config);
+    if (!erro) {
+        erro = transferirRegiao(fd, (char *)indices, (size_t)n * (size_t)larguraIndice, sizeof(cabecalho), 1,
+                                config);
+    }
+
+    // No modo de durabilidade, garantir que os dados cheguem ao dispositivo
+    if (!erro && config->durabilidade && fdatasync(fd) != 0) {
+        erro = errno;
+    }
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao gravar o arquivo de permutação (%s).\n", strerror(erro));
+        return -1;
+    }
+    return 0;
+}
+
+// Lê um arquivo de cadeias
+int lerCadeiasArquivo(const char *nomeArquivo, unsigned char **coluna, size_t *bytes, int *n,
+                      const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: Não foi possível abrir o arquivo de cadeias.\n");
+        return -1;
+    }
+
+    // Cabeçalho: marcador, número de cadeias e bytes da coluna
+    int cabecalho[2];
+    int64_t tamanho;
+    struct stat st;
+    if (pread(fd, cabecalho, sizeof(cabecalho), 0) != (ssize_t)sizeof(cabecalho) ||
+        pread(fd, &tamanho, sizeof(tamanho), sizeof(cabecalho)) != (ssize_t)sizeof(tamanho) ||
+        cabecalho[0] != ES_MARCADOR_CADEIAS || cabecalho[1] < 0 || tamanho < 0 || fstat(fd, &st) != 0 ||
+        st.st_size < ES_CABECALHO_CADEIAS + (off_t)tamanho) {
+        printf("Erro: %s não é um arquivo de cadeias válido.\n", nomeArquivo);
+        close(fd);
+        return -1;
+    }
+    *n = cabecalho[1];
+    *bytes = (size_t)tamanho;
+
+    *coluna = alocarBuffer(*bytes > 0 ? *bytes : 1);
+    if (!*coluna) {
+        printf("Erro: Falha na alocação de memória.\n");
+        close(fd);
+        return -1;
+    }
+    int erro = transferirRegiao(fd, (char *)*coluna, *bytes, ES_CABECALHO_CADEIAS, 0, config);
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao ler as cadeias (%s).\n", strerror(erro));
+        liberarBuffer(*coluna);
+        return -1;
+    }
+    if (validarColunaCadeias(*coluna, *bytes, *n) != 0) {
+        printf("Erro: Os comprimentos das cadeias de %s não correspondem ao tamanho da coluna.\n", nomeArquivo);
+        liberarBuffer(*coluna);
+        return -1;
+    }
+    return 0;
+}
+
+// Grava um arquivo de cadeias
+int gravarCadeiasArquivo(const char *nomeArquivo, const unsigned char *coluna, size_t bytes, int n,
+                         const ConfiguracaoES *config) {
+    int fd = open(nomeArquivo, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Erro: Não foi possível criar o arquivo de cadeias.\n");
+        return -1;
+    }
+
+    unsigned char cabecalho[ES_CABECALHO_CADEIAS];
+    int campos[2] = { ES_MARCADOR_CADEIAS, n };
+    int64_t tamanho = (int64_t)bytes;
+    memcpy(cabecalho, campos, sizeof(campos));
+    memcpy(cabecalho + sizeof(campos), &tamanho, sizeof(tamanho));
+    int erro = transferirRegiao(fd, (char *)cabecalho, sizeof(cabecalho), 0, 1, config);
+    if (!erro) {
+        erro = transferirRegiao(fd, (char *)coluna, bytes, sizeof(cabecalho), 1, config);
+    }
+
+    // No modo de durabilidade, garantir que os dados cheguem ao dispositivo
+    if (!erro && config->durabilidade && fdatasync(fd) != 0) {
+        erro = errno;
+    }
+    close(fd);
+
+    if (erro) {
+        printf("Erro: Falha ao gravar o arquivo de cadeias (%s).\n", strerror(erro));
+        return -1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Gravação direta (O_DIRECT)
+// ---------------------------------------------------------------------------
+
+// Função executada pela thread de gravação: grava cada buffer entregue pelo produtor
+static void *threadEscritorDireto(void *arg) {
+    EscritorDireto *e = (EscritorDireto *)arg;
+
+    pthread_mutex_lock(&e->mutex);
+    while (1) {
+        while (e->pendente < 0 && !e->encerrar) {
+            pthread_cond_wait(&e->cond, &e->mutex);
+        }
+        if (e->pendente < 0) {
+            break;
+        }
+        char *ptr = e->buffers[e->pendente];
+        size_t restante = e->tamanhoPendente;
+        off_t pos = e->posicaoPendente;
+        pthread_mutex_unlock(&e->mutex);
+
+        int erro = 0;
+        while (restante > 0) {
+            ssize_t ret = pwrite(e->fd, ptr, restante, pos);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret <= 0) {
+                erro = ret < 0 ? errno : EIO;
+                break;
+            }
+            ptr += ret;
+            pos += ret;
+            restante -= (size_t)ret;
+        }
+
+        pthread_mutex_lock(&e->mutex);
+        if (erro && !e->erro) {
+            e->erro = erro;
+        }
+        e->pendente = -1;
+        pthread_cond_broadcast(&e->cond);
+    }
+    pthread_mutex_unlock(&e->mutex);
+    return NULL;
+}
+
+// Função para aguardar a gravação em andamento terminar
+static void aguardarBufferDireto(EscritorDireto *e) {
+    pthread_mutex_lock(&e->mutex);
+    while (e->pendente >= 0) {
+        pthread_cond_wait(&e->cond, &e->mutex);
+    }
+    pthread_mutex_unlock(&e->mutex);
+}
+
+// Função para entregar o buffer atual à thread de gravação e passar a preencher o outro
+static void entregarBufferDireto(EscritorDireto *e, size_t tamanho) {
+    aguardarBufferDireto(e);
+
+    pthread_mutex_lock(&e->mutex);
+    e->pendente = e->atual;
+    e->tamanhoPendente = tamanho;
+    e->posicaoPendente = e->posicaoAtual;
+    pthread_cond_broadcast(&e->cond);
+    pthread_mutex_unlock(&e->mutex);
+
+    e->atual ^= 1;
+    e->posicaoAtual += (off_t)tamanho;
+    e->preenchido = 0;
+}
+
+// Função para alocar os dois buffers alinhados a huge pages (2 MB)
+static int alocarBuffersDireto(EscritorDireto *e) {
+    char *buffer = alocarBufferModo(2 * ES_TAMANHO_BUFFER_DIRETO, MEM_THP);
+    if (!buffer) {
+        return -1;
+    }
+    e->buffers[0] = buffer;
+    e->buffers[1] = buffer + ES_TAMANHO_BUFFER_DIRETO;
+    return 0;
+}
+
+// Função para abrir o arquivo com O_DIRECT e iniciar a thread de gravação
+static EscritorDireto *abrirEscritorDireto(const char *nomeArquivo, int n) {
+    EscritorDireto *e = calloc(1, sizeof(EscritorDireto));
+    if (!e) {
+        return NULL;
+    }
+
+    e->usandoDireto = 1;
+    e->fd = open(nomeArquivo, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (e->fd < 0 && errno == EINVAL) {
+        // Sistemas de arquivos como o tmpfs não aceitam O_DIRECT
+        fprintf(stderr, "Aviso: O_DIRECT não suportado em %s; usando gravação com cache.\n", nomeArquivo);
+        e->usandoDireto = 0;
+        e->fd = open(nomeArquivo, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (e->fd < 0) {
+        free(e);
+        return NULL;
+    }
+
+    if (alocarBuffersDireto(e) < 0) {
+        close(e->fd);
+        free(e);
+        return NULL;
+    }
+
+    // O cabeçalho é o início da imagem do arquivo no primeiro buffer
+    memcpy(e->buffers[0], &n, sizeof(int));
+    e->preenchido = sizeof(int);
+    e->tamanhoFinal = (off_t)sizeof(int) + (off_t)n * (off_t)sizeof(int);
+    e->pendente = -1;
+
+    pthread_mutex_init(&e->mutex, NULL);
+    pthread_cond_init(&e->cond, NULL);
+    if (pthread_create(&e->thread, NULL, threadEscritorDireto, e) != 0) {
+        pthread_mutex_destroy(&e->mutex);
+        pthread_cond_destroy(&e->cond);
+        liberarBuffer(e->buffers[0]);
+        close(e->fd);
+        free(e);
+        return NULL;
+    }
+    return e;
+}
+
+// Função para copiar os bytes seguintes da imagem do arquivo para os buffers
+static void enviarBytesDireto(EscritorDireto *e, const char *dados, size_t tamanho) {
+    while (tamanho > 0) {
+        size_t espaco = ES_TAMANHO_BUFFER_DIRETO - e->preenchido;
+        size_t copiar = tamanho < espaco ? tamanho : espaco;
+        memcpy(e->buffers[e->atual] + e->preenchido, dados, copiar);
+        e->preenchido += copiar;
+        dados += copiar;
+        tamanho -= copiar;
+
+        if (e->preenchido == ES_TAMANHO_BUFFER_DIRETO) {
+            entregarBufferDireto(e, ES_TAMANHO_BUFFER_DIRETO);
+        }
+    }
+}
+
+// Função para gravar o último buffer (completado até o alinhamento), ajustar o tamanho
+// do arquivo e, no modo de durabilidade, fazer o único fdatasync
+static int fecharEscritorDireto(EscritorDireto *e, int durabilidade) {
+    if (e->preenchido > 0) {
+        size_t alinhado = (e->preenchido + ES_ALINHAMENTO_DIRETO - 1) & ~(size_t)(ES_ALINHAMENTO_DIRETO - 1);
+        memset(e->buffers[e->atual] + e->preenchido, 0, alinhado - e->preenchido);
+        entregarBufferDireto(e, alinhado);
+    }
+    aguardarBufferDireto(e);
+
+    pthread_mutex_lock(&e->mutex);
+    e->encerrar = 1;
+    pthread_cond_broadcast(&e->cond);
+    pthread_mutex_unlock(&e->mutex);
+    pthread_join(e->thread, NULL);
+
+    int erro = e->erro;
+    if (!erro && ftruncate(e->fd, e->tamanhoFinal) != 0) {
+        erro = errno;
+    }
+    if (!erro && durabilidade && fdatasync(e->fd) != 0) {
+        erro = errno;
+    }
+    if (close(e->fd) != 0 && !erro) {
+        erro = errno;
+    }
+
+    pthread_mutex_destroy(&e->mutex);
+    pthread_cond_destroy(&e->cond);
+    liberarBuffer(e->buffers[0]);
+    free(e);
+    return erro;
+}
+
+// ---------------------------------------------------------------------------
+// Gravação
+// ---------------------------------------------------------------------------
+
+// Grava o vetor no arquivo binário; retorna 0 em caso de sucesso
+int gravarVetorArquivo(const char *nomeArquivo, const int *vetor, int n, const ConfiguracaoES *config) {
+    if (!gravacaoIncremental(config)) {
+        FILE *arquivo = fopen(nomeArquivo, "wb");
+        if (!arquivo) {
+            printf("Erro: Não foi possível criar o arquivo de saída.\n");
+            return -1;
+        }
+
+        // Escrever o tamanho do vetor e os valores
+        fwrite(&n, sizeof(int), 1, arquivo);
+        fwrite(vetor, sizeof(int), n, arquivo);
+
+        // No modo de durabilidade, garantir que os dados cheguem ao dispositivo
+        if (config->durabilidade && (fflush(arquivo) != 0 || fdatasync(fileno(arquivo)) != 0)) {
+            printf("Erro: Falha ao sincronizar o arquivo de saída (%s).\n", strerror(errno));
+            fclose(arquivo);
+            return -1;
+        }
+        fclose(arquivo);
+        return config->indiceEsparso && gravarIndiceEsparso(nomeArquivo, vetor, n) < 0 ? -1 : 0;
+    }
+
+    GravadorVetor *gravador = abrirGravadorVetor(nomeArquivo, vetor, n, config);
+    if (!gravador) {
+        return -1;
+    }
+    enviarBlocoGravador(gravador, 0, n);
+    return fecharGravadorVetor(gravador);
+}
+
+// Função para guardar no gravador o nome e o tamanho da saída, quando o índice esparso for
+// pedido; retorna o gravador ou NULL (liberando-o) se faltar memória
+static GravadorVetor *prepararIndiceGravador(GravadorVetor *gravador, const char *nomeArquivo, int n,
+                                             const ConfiguracaoES *config) {
+    gravador->n = n;
+    gravador->arquivoIndice = NULL;
+    if (config->indiceEsparso) {
+        gravador->arquivoIndice = strdup(nomeArquivo);
+        if (!gravador->arquivoIndice) {
+            printf("Erro: Falha na alocação do gravador.\n");
+            gravador->erro = ENOMEM;
+            fecharGravadorVetor(gravador);
+            return NULL;
+        }
+    }
+    return gravador;
+}
+
+// Abre um gravador incremental para o vetor de n elementos
+GravadorVetor *abrirGravadorVetor(const char *nomeArquivo, const int *vetor, int n, const ConfiguracaoES *config) {
+    if (config->direto) {
+        GravadorVetor *g = calloc(1, sizeof(GravadorVetor));
+        if (!g) {
+            printf("Erro: Falha na alocação do gravador.\n");
+            return NULL;
+        }
+        g->direto = abrirEscritorDireto(nomeArquivo, n);
+        if (!g->direto) {
+            printf("Erro: Não foi possível criar o arquivo de saída.\n");
+            free(g);
+            return NULL;
+        }
+        g->base = (char *)vetor;
+        g->fd = -1;
+        g->durabilidade = config->durabilidade;
+        return prepararIndiceGravador(g, nomeArquivo, n, config);
+    }
+
+    int fd = open(nomeArquivo, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Erro: Não foi possível criar o arquivo de saída.\n");
+        return NULL;
+    }
+
+    // Gravar o cabeçalho de forma síncrona
+    if (pwrite(fd, &n, sizeof(int), 0) != sizeof(int)) {
+        printf("Erro: Falha ao gravar o tamanho do vetor.\n");
+        close(fd);
+        return NULL;
+    }
+
+    TransferenciaES *t = iniciarTransferencia(fd, (char *)vetor, (size_t)n * sizeof(int),
+                                              sizeof(int), 1, config);
+    if (!t) {
+        printf("Erro: Falha na alocação do gravador.\n");
+        close(fd);
+        return NULL;
+    }
+    t->durabilidade = config->durabilidade;
+    return prepararIndiceGravador(t, nomeArquivo, n, config);
+}
+
+// Envia os elementos [inicio, inicio + quantidade) para gravação assíncrona
+int enviarBlocoGravador(GravadorVetor *gravador, long inicio, long quantidade) {
+    if (quantidade <= 0) {
+        return gravador->erro ? -1 : 0;
+    }
+
+    if (gravador->direto) {
+        EscritorDireto *e = gravador->direto;
+        if (inicio != e->proximoElemento) {
+            // A imagem do arquivo é montada sequencialmente
+            gravador->erro = EINVAL;
+            return -1;
+        }
+        enviarBytesDireto(e, gravador->base + (size_t)inicio * sizeof(int), (size_t)quantidade * sizeof(int));
+        e->proximoElemento += quantidade;
+        return 0;
+    }
+
+    transferirIntervalo(gravador, (size_t)inicio * sizeof(int), (size_t)quantidade * sizeof(int));
+    return gravador->erro ? -1 : 0;
+}
+
+// Aguarda todas as gravações pendentes e fecha o arquivo
+int fecharGravadorVetor(GravadorVetor *gravador) {
+    int erro;
+    char *arquivoIndice = gravador->arquivoIndice;
+    const int *vetor = (const int *)gravador->base;
+    int n = gravador->n;
+
+    if (gravador->direto) {
+        erro = fecharEscritorDireto(gravador->direto, gravador->durabilidade);
+        if (!erro) {
+            erro = gravador->erro;
+        }
+        free(gravador);
+    } else {
+        int fd = gravador->fd;
+        int durabilidade = gravador->durabilidade;
+        erro = concluirTransferencia(gravador);
+        if (!erro && durabilidade && fdatasync(fd) != 0) {
+            erro = errno;
+        }
+        if (close(fd) != 0 && !erro) {
+            erro = errno;
+        }
+    }
+
+    if (erro) {
+        printf("Erro: Falha ao gravar o arquivo de saída (%s).\n", strerror(erro));
+        free(arquivoIndice);
+        return -1;
+    }
+
+    // O índice esparso é montado a partir do vetor, que continua na memória
+    int erroIndice = arquivoIndice && gravarIndiceEsparso(arquivoIndice, vetor, n) < 0;
+    free(arquivoIndice);
+    return erroIndice ? -1 : 0;
+}
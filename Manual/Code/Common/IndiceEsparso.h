@@ -0,0 +1,74 @@
+#ifndef INDICE_ESPARSO_H
+#define INDICE_ESPARSO_H
+
+/*
+ * Índice esparso (fence pointers) de um arquivo binário ordenado, gravado ao lado da saída
+ * em <arquivo>.idx (opção --indice-esparso). Com ele, consultas de faixa ("quantos valores
+ * em [a, b]", "valores >= x") leem só as páginas tocadas do arquivo mapeado, em vez do
+ * arquivo inteiro.
+ *
+ * O vetor é dividido em blocos de INDICE_PASSO valores. O índice guarda o maior valor de
+ * cada bloco (a cerca) em layout de Eytzinger: a árvore binária de busca é armazenada em
+ * largura, com os filhos do nó k nas posições 2k e 2k + 1. Os primeiros níveis ficam juntos
+ * nas mesmas linhas de cache, e a busca, sem desvios, pede antecipadamente a linha dos 16
+ * descendentes quatro níveis abaixo (16k a 16k + 15). A busca encontra o primeiro bloco
+ * cujo maior valor não é menor que a chave; a posição exata vem de uma busca binária nesse
+ * bloco (16 KB, poucas páginas) do arquivo mapeado.
+ *
+ * Formato do arquivo (inteiros de 32 bits; o cabeçalho ocupa INDICE_CABECALHO bytes, para
+ * que a árvore comece alinhada a uma linha de cache):
+ *
+ *     int32 marcador | int32 passo | int32 n | int32 numBlocos | reservado |
+ *     int32 cercas[numBlocos + 1] | int32 blocos[numBlocos + 1] | int32 minimos[numBlocos] | int32 maximos[numBlocos]
+ *
+ * cercas[k] e blocos[k] (k de 1 a numBlocos; a posição 0 não é usada) são o maior valor e
+ * o número do bloco do nó k da árvore; minimos[b] e maximos[b] são o menor e o maior valor
+ * do bloco b, em ordem, usados também para detectar um índice desatualizado.
+ */
+
+#define INDICE_PASSO      4096          // Valores por bloco
+#define INDICE_MARCADOR   (-0x49445831) // -"IDX1"
+#define INDICE_EXTENSAO   ".idx"
+#define INDICE_CABECALHO  64            // Bytes do cabeçalho
+
+// Índice aberto para consultas, com o arquivo de dados mapeado
+typedef struct {
+    int n;                // Valores do arquivo de dados
+    int passo;            // Valores por bloco
+    int numBlocos;
+    const int *cercas;    // Árvore de Eytzinger (1 a numBlocos)
+    const int *blocos;
+    const int *minimos;
+    const int *maximos;
+    const int *valores;   // Valores do arquivo de dados mapeado
+    void *mapaIndice;
+    size_t bytesIndice;
+    void *mapaDados;
+    size_t bytesDados;
+    long blocosLidos;     // Blocos do arquivo de dados tocados pelas consultas
+} IndiceEsparso;
+
+// Grava o índice esparso do vetor ordenado de n valores em <arquivoDados>.idx. Se o vetor
+// não estiver ordenado, o índice não é gravado (e um índice antigo é removido). Retorna 0
+// em caso de sucesso, 1 se o vetor não estiver ordenado e -1 em caso de erro.
+int gravarIndiceEsparso(const char *arquivoDados, const int *vetor, long n);
+
+// Grava o índice esparso de um arquivo binário ordenado já existente, lido pelo mapeamento
+// do arquivo; retorna o mesmo que gravarIndiceEsparso
+int construirIndiceEsparso(const char *arquivoDados);
+
+// Mapeia o arquivo de dados e o seu índice; retorna 0 em caso de sucesso e -1 em caso de erro
+int abrirIndiceEsparso(const char *arquivoDados, IndiceEsparso *indice);
+
+// Desfaz os mapeamentos do índice
+void fecharIndiceEsparso(IndiceEsparso *indice);
+
+// Retorna a posição do primeiro valor maior ou igual à chave (n se não houver), ou -1 se o
+// índice não corresponder aos dados
+long limiteInferiorIndice(IndiceEsparso *indice, int chave);
+
+// Retorna a posição do primeiro valor maior que a chave (n se não houver), ou -1 se o
+// índice não corresponder aos dados
+long limiteSuperiorIndice(IndiceEsparso *indice, int chave);
+
+#endif
@@ -0,0 +1,349 @@
+#include "Lote.h"
+#include "Registro.h"
+
+#include <glob.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+// Protege o log e as mensagens das ordenações concorrentes
+static pthread_mutex_t mutexLote = PTHREAD_MUTEX_INITIALIZER;
+
+// Uma ordenação em andamento (tarefa do pool no modo concorrente)
+typedef struct {
+    const ItemLote *item;
+    OpcoesOrdenacao ordenacao;
+    const OpcoesExecucao *opcoes;
+    FILE *registro;
+    const char *programa;
+    int threadsRegistro;
+    int erro;
+} TarefaLote;
+
+// Função para acrescentar uma ordenação ao lote (as cadeias são copiadas)
+static int adicionarItem(Lote *lote, int *capacidade, const char *entrada, const char *saida) {
+    if (lote->numItens == *capacidade) {
+        int novaCapacidade = *capacidade ? *capacidade * 2 : 16;
+        ItemLote *itens = realloc(lote->itens, (size_t)novaCapacidade * sizeof(ItemLote));
+        if (!itens) {
+            perror("Erro ao alocar a lista do lote");
+            return -1;
+        }
+        lote->itens = itens;
+        *capacidade = novaCapacidade;
+    }
+
+    ItemLote *item = &lote->itens[lote->numItens];
+    item->entrada = strdup(entrada);
+    item->saida = strdup(saida);
+    if (!item->entrada || !item->saida) {
+        free(item->entrada);
+        free(item->saida);
+        perror("Erro ao alocar a lista do lote");
+        return -1;
+    }
+    lote->numItens++;
+    return 0;
+}
+
+// Função para montar a saída padrão de uma entrada: <saidaDir>/<nome da entrada>
+static int adicionarComSaidaDir(Lote *lote, int *capacidade, const char *entrada, const char *saidaDir) {
+    if (!saidaDir) {
+        fprintf(stderr, "A entrada %s não tem saída: informe --saida-dir.\n", entrada);
+        return -1;
+    }
+
+    const char *barra = strrchr(entrada, '/');
+    const char *nome = barra ? barra + 1 : entrada;
+    size_t tamanho = strlen(saidaDir) + strlen(nome) + 2;
+    char *saida = malloc(tamanho);
+    if (!saida) {
+        perror("Erro ao alocar a lista do lote");
+        return -1;
+    }
+    snprintf(saida, tamanho, "%s/%s", saidaDir, nome);
+
+    int resultado = adicionarItem(lote, capacidade, entrada, saida);
+    free(saida);
+    return resultado;
+}
+
+// Função para ler o manifesto (uma linha "entrada[<TAB>saida]" por ordenação)
+static int lerManifesto(Lote *lote, int *capacidade, const char *manifesto, const char *saidaDir) {
+    FILE *arquivo = fopen(manifesto, "r");
+    if (!arquivo) {
+        perror("Erro ao abrir o manifesto");
+        return -1;
+    }
+
+    char *linha = NULL;
+    size_t tamanhoLinha = 0;
+    int numeroLinha = 0;
+    int resultado = 0;
+    while (resultado == 0 && getline(&linha, &tamanhoLinha, arquivo) != -1) {
+        numeroLinha++;
+        linha[strcspn(linha, "\r\n")] = '\0';
+        if (linha[0] == '\0' || linha[0] == '#') {
+            continue;
+        }
+
+        char *tab = strchr(linha, '\t');
+        if (tab) {
+            *tab = '\0';
+        }
+        if (linha[0] == '\0' || (tab && tab[1] == '\0')) {
+            fprintf(stderr, "Linha %d do manifesto %s inválida.\n", numeroLinha, manifesto);
+            resultado = -1;
+        } else if (tab) {
+            resultado = adicionarItem(lote, capacidade, linha, tab + 1);
+        } else {
+            resultado = adicionarComSaidaDir(lote, capacidade, linha, saidaDir);
+        }
+    }
+
+    free(linha);
+    fclose(arquivo);
+    return resultado;
+}
+
+// Monta o lote a partir de --entradas, --manifesto e --saida-dir
+int montarLote(const OpcoesExecucao *opcoes, Lote *lote) {
+    int capacidade = 0;
+    lote->itens = NULL;
+    lote->numItens = 0;
+
+    for (int i = 0; i < opcoes->numEntradas; i++) {
+        glob_t arquivos;
+        int resultado = glob(opcoes->entradas[i], 0, NULL, &arquivos);
+        if (resultado != 0) {
+            fprintf(stderr, "Nenhum arquivo corresponde a %s.\n", opcoes->entradas[i]);
+            if (resultado != GLOB_NOMATCH) {
+                globfree(&arquivos);
+            }
+            liberarLote(lote);
+            return -1;
+        }
+        for (size_t j = 0; j < arquivos.gl_pathc; j++) {
+            if (adicionarComSaidaDir(lote, &capacidade, arquivos.gl_pathv[j], opcoes->saidaDir) != 0) {
+                globfree(&arquivos);
+                liberarLote(lote);
+                return -1;
+            }
+        }
+        globfree(&arquivos);
+    }
+
+    if (opcoes->manifesto && lerManifesto(lote, &capacidade, opcoes->manifesto, opcoes->saidaDir) != 0) {
+        liberarLote(lote);
+        return -1;
+    }
+
+    if (lote->numItens == 0) {
+        fprintf(stderr, "O lote não tem nenhum arquivo.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Libera a lista de ordenações
+void liberarLote(Lote *lote) {
+    for (int i = 0; i < lote->numItens; i++) {
+        free(lote->itens[i].entrada);
+        free(lote->itens[i].saida);
+    }
+    free(lote->itens);
+    lote->itens = NULL;
+    lote->numItens = 0;
+}
+
+// Função para ler, ordenar, registrar e gravar um arquivo do lote
+static int ordenarItem(const ItemLote *item, const OpcoesOrdenacao *modelo, const OpcoesExecucao *opcoes,
+                       FILE *registro, const char *programa, int threadsRegistro) {
+    const ConfiguracaoES *es = &opcoes->es;
+    int n;
+    if (lerTamanhoArquivo(item->entrada, &n) != 0) {
+        return -1;
+    }
+
+    // Os buffers voltam para o alocador ao final e são reaproveitados pelos próximos arquivos
+    int *vetor = (int*)obterBufferTemporario((size_t)n * sizeof(int));
+    if (!vetor) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para %s.\n", item->entrada);
+        return -1;
+    }
+    if (lerValoresArquivo(item->entrada, vetor, n, es) != 0) {
+        devolverBufferTemporario(vetor);
+        return -1;
+    }
+
+    // Como nos programas, o MinMaxSort concorrente com E/S assíncrona ou direta mescla
+    // diretamente no buffer de saída, que é gravado durante a própria mesclagem
+    OpcoesOrdenacao ordenacao = *modelo;
+    MetricasPreordenacao metricas;
+    MetricasCompactacao compactacao;
+    ordenacao.preordenacao = opcoes->preordenacao;
+    ordenacao.metricas = &metricas;
+    ordenacao.compactar = opcoes->compactar;
+    ordenacao.compactacao = &compactacao;
+    int *temp = NULL;
+    GravadorVetor *gravador = NULL;
+    if (ordenacao.algoritmo == ORDENACAO_MINMAX_CONC && gravacaoIncremental(es)) {
+        temp = (int*)obterBufferTemporario((size_t)n * sizeof(int));
+        gravador = temp ? abrirGravadorVetor(item->saida, temp, n, es) : NULL;
+        if (!gravador) {
+            if (temp) {
+                devolverBufferTemporario(temp);
+            }
+            devolverBufferTemporario(vetor);
+            return -1;
+        }
+        ordenacao.saida = temp;
+        ordenacao.gravador = gravador;
+        ordenacao.elementosPorBloco = (long)(es->tamanhoBloco / sizeof(int));
+    }
+
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+    int erroOrdenacao = ordenarI32(vetor, n, &ordenacao);
+    OBTER_TEMPO(fim);
+
+    pthread_mutex_lock(&mutexLote);
+    registrarTempo(registro, programa, fim - inicio, n, threadsRegistro);
+    printf("%s: %d elementos ordenados em %f segundos\n", item->entrada, n, fim - inicio);
+    if (ordenacao.preordenacao) {
+        imprimirPreordenacao(stdout, &metricas);
+        registrarPreordenacao(programa, fim - inicio, n, threadsRegistro, &metricas);
+    }
+    if (ordenacao.compactar) {
+        imprimirCompactacao(stdout, &compactacao);
+        registrarCompactacao(programa, fim - inicio, n, threadsRegistro, &compactacao);
+    }
+    pthread_mutex_unlock(&mutexLote);
+
+    int erroGravacao = gravador ? fecharGravadorVetor(gravador)
+                                : gravarVetorArquivo(item->saida, vetor, n, es);
+    if (temp) {
+        devolverBufferTemporario(temp);
+    }
+    devolverBufferTemporario(vetor);
+    return (erroOrdenacao != 0 || erroGravacao != 0) ? -1 : 0;
+}
+
+// Função executada por um trabalhador do pool para um arquivo pequeno
+static void executarTarefaLote(void *arg) {
+    TarefaLote *tarefa = (TarefaLote*)arg;
+    tarefa->erro = ordenarItem(tarefa->item, &tarefa->ordenacao, tarefa->opcoes,
+                               tarefa->registro, tarefa->programa, tarefa->threadsRegistro);
+}
+
+// Função para obter a versão sequencial de um algoritmo
+static AlgoritmoOrdenacao algoritmoSequencial(AlgoritmoOrdenacao algoritmo) {
+    switch (algoritmo) {
+        case ORDENACAO_QUICKSORT_CONC:
+            return ORDENACAO_QUICKSORT_SEQ;
+        case ORDENACAO_MINMAX_CONC:
+            return ORDENACAO_MINMAX_SEQ;
+        case ORDENACAO_DUPLO_PIVO_CONC:
+            return ORDENACAO_DUPLO_PIVO_SEQ;
+        default:
+            return algoritmo;
+    }
+}
+
+// Ordena todos os arquivos do lote
+int executarLote(const Lote *lote, const OpcoesOrdenacao *modelo, const OpcoesExecucao *opcoes,
+                 PoolThreads *pool, FILE *registro, const char *programa, int threadsRegistro) {
+    int falhas = 0;
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+
+    // Os arquivos pequenos são ordenados primeiro, ao mesmo tempo, um por trabalhador
+    char *feito = calloc((size_t)lote->numItens, 1);
+    TarefaLote *tarefas = NULL;
+    if (!feito) {
+        perror("Erro ao alocar o controle do lote");
+        return lote->numItens;
+    }
+    if (opcoes->loteConcorrente && pool) {
+        tarefas = calloc((size_t)lote->numItens, sizeof(TarefaLote));
+        if (!tarefas) {
+            perror("Erro ao alocar as tarefas do lote");
+            free(feito);
+            return lote->numItens;
+        }
+
+        GrupoTarefas grupo;
+        iniciarGrupoTarefas(&grupo);
+        for (int i = 0; i < lote->numItens; i++) {
+            int n;
+            if (lerTamanhoArquivo(lote->itens[i].entrada, &n) != 0 || n > LOTE_LIMITE_CONCORRENTE) {
+                continue; // Erros são relatados na ordenação sequencial abaixo
+            }
+            TarefaLote *tarefa = &tarefas[i];
+            tarefa->item = &lote->itens[i];
+            tarefa->ordenacao = *modelo;
+            tarefa->ordenacao.algoritmo = algoritmoSequencial(modelo->algoritmo);
+            tarefa->ordenacao.pool = NULL;
+            tarefa->opcoes = opcoes;
+            tarefa->registro = registro;
+            tarefa->programa = programa;
+            tarefa->threadsRegistro = threadsRegistro;
+            submeterTarefa(pool, &grupo, -1, executarTarefaLote, tarefa);
+            feito[i] = 1;
+        }
+        aguardarGrupoTarefas(pool, &grupo);
+
+        for (int i = 0; i < lote->numItens; i++) {
+            if (feito[i] && tarefas[i].erro != 0) {
+                fprintf(stderr, "Falha ao ordenar %s.\n", lote->itens[i].entrada);
+                falhas++;
+            }
+        }
+    }
+
+    // Os demais arquivos são ordenados um de cada vez, com todas as threads
+    for (int i = 0; i < lote->numItens; i++) {
+        if (!feito[i] && ordenarItem(&lote->itens[i], modelo, opcoes, registro, programa, threadsRegistro) != 0) {
+            fprintf(stderr, "Falha ao ordenar %s.\n", lote->itens[i].entrada);
+            falhas++;
+        }
+    }
+
+    OBTER_TEMPO(fim);
+    printf("Lote: %d arquivos (%d com falha) em %f segundos\n", lote->numItens, falhas, fim - inicio);
+
+    free(tarefas);
+    free(feito);
+    return falhas;
+}
+
+// Modo em lote completo de um programa
+int ordenarLote(const OpcoesExecucao *opcoes, const OpcoesOrdenacao *modelo, PoolThreads *pool,
+                const char *arquivoLog, const char *programa, int threadsRegistro) {
+    Lote lote;
+    if (montarLote(opcoes, &lote) != 0) {
+        return 1;
+    }
+
+    FILE *registro = abrirArquivoRegistro(arquivoLog);
+    if (!registro) {
+        liberarLote(&lote);
+        return 1;
+    }
+
+    int falhas = executarLote(&lote, modelo, opcoes, pool, registro, programa, threadsRegistro);
+    imprimirRelatorioMemoria(stdout);
+
+    fclose(registro);
+    liberarLote(&lote);
+    liberarBuffersTemporarios();
+    return falhas == 0 ? 0 : 1;
+}
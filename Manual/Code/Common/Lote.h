@@ -0,0 +1,58 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <stdio.h>
+#include "Opcoes.h"
+#include "Ordenacao.h"
+
+/*
+ * Modo em lote dos programas de ordenação: vários arquivos de entrada são ordenados, um
+ * após o outro, pelo mesmo processo, reaproveitando o pool de threads, os buffers (pelos
+ * buffers temporários de Common/Memoria.h) e o arquivo de log já aberto.
+ *
+ * A lista de arquivos vem das opções --entradas (padrões glob, cada arquivo vai para
+ * --saida-dir com o mesmo nome) e/ou de um manifesto (--manifesto) com uma linha por
+ * ordenação no formato "entrada<TAB>saida"; a saída pode ser omitida quando --saida-dir
+ * for informado. Linhas vazias e linhas começadas por '#' são ignoradas. Uma mesma entrada
+ * pode aparecer várias vezes (por exemplo, para repetir a medição).
+ *
+ * Com --lote-concorrente, os arquivos com até LOTE_LIMITE_CONCORRENTE elementos são
+ * ordenados ao mesmo tempo, um por trabalhador do pool, com a versão sequencial do
+ * algoritmo; os arquivos maiores continuam sendo ordenados um de cada vez, com todas as
+ * threads.
+ */
+
+// Arquivos com até esse número de elementos podem ser ordenados ao mesmo tempo
+#define LOTE_LIMITE_CONCORRENTE (1L << 20)
+
+// Uma ordenação do lote
+typedef struct {
+    char *entrada;
+    char *saida;
+} ItemLote;
+
+// Lista de ordenações do lote
+typedef struct {
+    ItemLote *itens;
+    int numItens;
+} Lote;
+
+// Monta o lote a partir de --entradas, --manifesto e --saida-dir; retorna 0 em caso de sucesso
+int montarLote(const OpcoesExecucao *opcoes, Lote *lote);
+
+// Libera a lista de ordenações
+void liberarLote(Lote *lote);
+
+// Ordena todos os arquivos do lote com as opções de ordenação do modelo (algoritmo, pool,
+// threads) e registra cada ordenação no log já aberto, com o nome do programa e o número
+// de threads informados (threadsRegistro <= 0 deixa a coluna vazia). O pool só é
+// obrigatório com --lote-concorrente. Retorna o número de arquivos que falharam.
+int executarLote(const Lote *lote, const OpcoesOrdenacao *modelo, const OpcoesExecucao *opcoes,
+                 PoolThreads *pool, FILE *registro, const char *programa, int threadsRegistro);
+
+// Modo em lote completo de um programa: monta o lote, abre o log uma única vez, ordena
+// todos os arquivos e imprime o relatório de memória; retorna 0 se todos foram ordenados
+int ordenarLote(const OpcoesExecucao *opcoes, const OpcoesOrdenacao *modelo, PoolThreads *pool,
+                const char *arquivoLog, const char *programa, int threadsRegistro);
+
+#endif
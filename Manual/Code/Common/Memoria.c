@@ -0,0 +1,320 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "Memoria.h"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+// Registro de cada buffer entregue pelo alocador
+typedef struct Alocacao {
+    void *ptr;            // Endereço entregue (alinhado a 2 MB nos modos com huge pages)
+    size_t tamanho;       // Bytes mapeados (ou pedidos, no modo malloc)
+    ModoMemoria modo;     // Modo efetivamente usado
+    int temporario;       // 1 se está livre para ser reaproveitado
+    struct Alocacao *prox;
+} Alocacao;
+
+static ModoMemoria modoAtual = MEM_THP;
+static Alocacao *alocacoes = NULL;
+static pthread_mutex_t mutexMemoria = PTHREAD_MUTEX_INITIALIZER;
+static void (*distribuirBuffer)(void *, size_t, void *) = NULL;
+static void *contextoDistribuicao = NULL;
+
+// Define o modo usado por alocarBuffer
+void definirModoMemoria(ModoMemoria modo) {
+    modoAtual = modo;
+}
+
+// Retorna o modo atual
+ModoMemoria modoMemoriaAtual(void) {
+    return modoAtual;
+}
+
+// Converte o nome do modo; retorna -1 se for inválido
+int modoMemoriaDoNome(const char *nome, ModoMemoria *modo) {
+    if (strcmp(nome, "malloc") == 0) {
+        *modo = MEM_MALLOC;
+    } else if (strcmp(nome, "thp") == 0) {
+        *modo = MEM_THP;
+    } else if (strcmp(nome, "hugetlb") == 0) {
+        *modo = MEM_HUGETLB;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+// Retorna o nome do modo
+const char *nomeModoMemoria(ModoMemoria modo) {
+    switch (modo) {
+        case MEM_THP:     return "thp";
+        case MEM_HUGETLB: return "hugetlb";
+        default:          return "malloc";
+    }
+}
+
+// Função para mapear uma região alinhada a 2 MB e pedir huge pages transparentes
+static void *mapearTHP(size_t tamanho) {
+    size_t total = tamanho + MEM_TAMANHO_HUGE_PAGE;
+    char *regiao = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (regiao == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Descartar as sobras antes e depois do trecho alinhado
+    char *alinhado = (char *)(((unsigned long)regiao + MEM_TAMANHO_HUGE_PAGE - 1) & ~(MEM_TAMANHO_HUGE_PAGE - 1));
+    size_t antes = (size_t)(alinhado - regiao);
+    size_t depois = total - antes - tamanho;
+    if (antes > 0) {
+        munmap(regiao, antes);
+    }
+    if (depois > 0) {
+        munmap(alinhado + tamanho, depois);
+    }
+
+    madvise(alinhado, tamanho, MADV_HUGEPAGE);
+    return alinhado;
+}
+
+// Função para mapear huge pages explícitas de 2 MB (hugetlbfs)
+static void *mapearHugetlb(size_t tamanho) {
+    void *ptr = mmap(NULL, tamanho, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+// Define a função que faz o primeiro toque dos buffers grandes de alocarBuffer
+void definirDistribuicaoMemoria(void (*distribuir)(void *buffer, size_t bytes, void *contexto), void *contexto) {
+    distribuirBuffer = distribuir;
+    contextoDistribuicao = contexto;
+}
+
+// Aloca um buffer no modo atual
+void *alocarBuffer(size_t bytes) {
+    void *ptr = alocarBufferModo(bytes, modoAtual);
+    if (ptr && distribuirBuffer && bytes >= MEM_TAMANHO_HUGE_PAGE) {
+        distribuirBuffer(ptr, bytes, contextoDistribuicao);
+    }
+    return ptr;
+}
+
+// Aloca um buffer no modo indicado
+void *alocarBufferModo(size_t bytes, ModoMemoria modo) {
+    Alocacao *registro = malloc(sizeof(Alocacao));
+    if (!registro) {
+        return NULL;
+    }
+
+    // Buffers pequenos não se beneficiam de huge pages
+    if (bytes < MEM_TAMANHO_HUGE_PAGE) {
+        modo = MEM_MALLOC;
+    }
+
+    void *ptr = NULL;
+    size_t tamanho = bytes;
+    if (modo != MEM_MALLOC) {
+        tamanho = (bytes + MEM_TAMANHO_HUGE_PAGE - 1) & ~(MEM_TAMANHO_HUGE_PAGE - 1);
+        if (modo == MEM_HUGETLB) {
+            ptr = mapearHugetlb(tamanho);
+            if (!ptr) {
+                modo = MEM_THP; // Sem páginas reservadas: usar THP
+            }
+        }
+        if (!ptr) {
+            ptr = mapearTHP(tamanho);
+        }
+    } else {
+        ptr = malloc(bytes ? bytes : 1);
+    }
+
+    if (!ptr) {
+        free(registro);
+        return NULL;
+    }
+
+    registro->ptr = ptr;
+    registro->tamanho = tamanho;
+    registro->modo = modo;
+    registro->temporario = 0;
+
+    pthread_mutex_lock(&mutexMemoria);
+    registro->prox = alocacoes;
+    alocacoes = registro;
+    pthread_mutex_unlock(&mutexMemoria);
+    return ptr;
+}
+
+// Função para liberar a memória de um registro já removido da lista
+static void desalocar(Alocacao *registro) {
+    if (registro->modo == MEM_MALLOC) {
+        free(registro->ptr);
+    } else {
+        munmap(registro->ptr, registro->tamanho);
+    }
+    free(registro);
+}
+
+// Libera um buffer obtido por alocarBuffer ou alocarBufferModo
+void liberarBuffer(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    pthread_mutex_lock(&mutexMemoria);
+    Alocacao **atual = &alocacoes;
+    while (*atual && (*atual)->ptr != ptr) {
+        atual = &(*atual)->prox;
+    }
+    Alocacao *registro = *atual;
+    if (registro) {
+        *atual = registro->prox;
+    }
+    pthread_mutex_unlock(&mutexMemoria);
+
+    if (registro) {
+        desalocar(registro);
+    } else {
+        free(ptr); // Buffer que não veio do alocador
+    }
+}
+
+// Obtém um buffer temporário com pelo menos bytes, reaproveitando um devolvido antes
+void *obterBufferTemporario(size_t bytes) {
+    Alocacao *melhor = NULL;
+
+    // Escolher o menor buffer livre que comporte o pedido
+    pthread_mutex_lock(&mutexMemoria);
+    for (Alocacao *a = alocacoes; a; a = a->prox) {
+        if (a->temporario && a->tamanho >= bytes && (!melhor || a->tamanho < melhor->tamanho)) {
+            melhor = a;
+        }
+    }
+    if (melhor) {
+        melhor->temporario = 0;
+    }
+    pthread_mutex_unlock(&mutexMemoria);
+
+    return melhor ? melhor->ptr : alocarBuffer(bytes);
+}
+
+// Devolve um buffer temporário para ser reaproveitado
+void devolverBufferTemporario(void *ptr) {
+    pthread_mutex_lock(&mutexMemoria);
+    for (Alocacao *a = alocacoes; a; a = a->prox) {
+        if (a->ptr == ptr) {
+            a->temporario = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mutexMemoria);
+}
+
+// Libera todos os buffers temporários devolvidos
+void liberarBuffersTemporarios(void) {
+    Alocacao *livres = NULL;
+
+    pthread_mutex_lock(&mutexMemoria);
+    Alocacao **atual = &alocacoes;
+    while (*atual) {
+        Alocacao *a = *atual;
+        if (a->temporario) {
+            *atual = a->prox;
+            a->prox = livres;
+            livres = a;
+        } else {
+            atual = &a->prox;
+        }
+    }
+    pthread_mutex_unlock(&mutexMemoria);
+
+    while (livres) {
+        Alocacao *prox = livres->prox;
+        desalocar(livres);
+        livres = prox;
+    }
+}
+
+// Função para somar, em /proc/self/smaps, os kB em huge pages das regiões que cobrem o buffer
+static size_t kbHugePagesNoIntervalo(unsigned long inicio, unsigned long fim) {
+    FILE *smaps = fopen("/proc/self/smaps", "r");
+    if (!smaps) {
+        return 0;
+    }
+
+    char linha[512];
+    int dentro = 0;
+    size_t totalKb = 0;
+    while (fgets(linha, sizeof(linha), smaps)) {
+        unsigned long a, b, kb;
+        if (sscanf(linha, "%lx-%lx ", &a, &b) == 2 && strchr(linha, '-') < strchr(linha, ' ')) {
+            dentro = a < fim && b > inicio;
+        } else if (dentro && (sscanf(linha, "AnonHugePages: %lu kB", &kb) == 1 ||
+                              sscanf(linha, "Private_Hugetlb: %lu kB", &kb) == 1 ||
+                              sscanf(linha, "Shared_Hugetlb: %lu kB", &kb) == 1)) {
+            totalKb += kb;
+        }
+    }
+    fclose(smaps);
+    return totalKb;
+}
+
+// Retorna quantas huge pages o kernel efetivamente usou para o buffer
+size_t contarHugePages(const void *ptr) {
+    size_t tamanho = 0;
+    ModoMemoria modo = MEM_MALLOC;
+
+    pthread_mutex_lock(&mutexMemoria);
+    for (Alocacao *a = alocacoes; a; a = a->prox) {
+        if (a->ptr == ptr) {
+            tamanho = a->tamanho;
+            modo = a->modo;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mutexMemoria);
+
+    if (modo == MEM_MALLOC) {
+        return 0;
+    }
+
+    // Regiões vizinhas podem ter sido unidas pelo kernel: limitar ao tamanho do buffer
+    size_t paginas = kbHugePagesNoIntervalo((unsigned long)ptr, (unsigned long)ptr + tamanho) * 1024
+                     / MEM_TAMANHO_HUGE_PAGE;
+    size_t maximo = tamanho / MEM_TAMANHO_HUGE_PAGE;
+    return paginas < maximo ? paginas : maximo;
+}
+
+// Imprime quantas huge pages foram obtidas para os buffers alocados
+void imprimirRelatorioMemoria(FILE *saida) {
+    size_t obtidas = 0, possiveis = 0;
+    int buffers = 0, explicitas = 0;
+    const void *ptrs[64];
+
+    // Copiar os endereços para não manter o mutex durante a leitura de /proc
+    pthread_mutex_lock(&mutexMemoria);
+    for (Alocacao *a = alocacoes; a && buffers < 64; a = a->prox) {
+        if (a->modo != MEM_MALLOC && !a->temporario) {
+            ptrs[buffers++] = a->ptr;
+            possiveis += a->tamanho / MEM_TAMANHO_HUGE_PAGE;
+            explicitas += a->modo == MEM_HUGETLB;
+        }
+    }
+    pthread_mutex_unlock(&mutexMemoria);
+
+    if (buffers == 0) {
+        return;
+    }
+    for (int i = 0; i < buffers; i++) {
+        obtidas += contarHugePages(ptrs[i]);
+    }
+
+    // O modo efetivo pode diferir do pedido quando não há huge pages explícitas reservadas
+    const char *efetivo = explicitas == buffers ? "hugetlb" : (explicitas ? "hugetlb/thp" : "thp");
+    fprintf(saida, "Huge pages (%s): %zu de %zu obtidas em %d buffer(s)\n",
+            efetivo, obtidas, possiveis, buffers);
+}
@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "Mesclagem.h"
+#include "Memoria.h"
+
+// Trecho de blocos [inicio, fim) ordenados pela rede bitônica, de origem para destino
+typedef struct {
+    const int *origem;
+    int *destino;
+    long inicio;
+    long fim;
+} TrechoBlocos;
+
+// Parte [inicio, fim) da saída de um nível da mesclagem
+typedef struct {
+    const int *origem;
+    int *destino;
+    long n;
+    long largura; // Tamanho das sequências ordenadas em origem
+    long inicio;
+    long fim;
+} ParteMesclagem;
+
+// Função para ordenar um bloco de MESCLAGEM_BLOCO elementos pela rede bitônica: cada
+// estágio junta sequências de tamanho k / 2 comparando os elementos espelhados e depois
+// completa com os meio-limpadores de distância k / 4, ..., 1
+static void redeBitonica(int v[MESCLAGEM_BLOCO]) {
+    for (int k = 2; k <= MESCLAGEM_BLOCO; k *= 2) {
+        for (int i = 0; i < MESCLAGEM_BLOCO; i += k) {
+            for (int m = 0; m < k / 2; m++) {
+                int a = v[i + m], b = v[i + k - 1 - m];
+                v[i + m] = a < b ? a : b;
+                v[i + k - 1 - m] = a < b ? b : a;
+            }
+        }
+        for (int j = k / 4; j > 0; j /= 2) {
+            for (int i = 0; i < MESCLAGEM_BLOCO; i += 2 * j) {
+                for (int m = 0; m < j; m++) {
+                    int a = v[i + m], b = v[i + m + j];
+                    v[i + m] = a < b ? a : b;
+                    v[i + m + j] = a < b ? b : a;
+                }
+            }
+        }
+    }
+}
+
+// Função para ordenar os blocos de um trecho (o último bloco do vetor pode ser incompleto)
+static void ordenarBlocos(void *arg) {
+    TrechoBlocos *t = (TrechoBlocos *)arg;
+    int bloco[MESCLAGEM_BLOCO];
+    for (long inicio = t->inicio; inicio < t->fim; inicio += MESCLAGEM_BLOCO) {
+        long tamanho = t->fim - inicio < MESCLAGEM_BLOCO ? t->fim - inicio : MESCLAGEM_BLOCO;
+        memcpy(bloco, t->origem + inicio, (size_t)tamanho * sizeof(int));
+        for (long i = tamanho; i < MESCLAGEM_BLOCO; i++) {
+            bloco[i] = INT_MAX;
+        }
+        redeBitonica(bloco);
+        memcpy(t->destino + inicio, bloco, (size_t)tamanho * sizeof(int));
+    }
+}
+
+// Função para encontrar quantos elementos de a estão entre os primeiros diagonal elementos
+// da mesclagem de a e b (busca binária no caminho de mesclagem; a vence os empates)
+static long dividirCaminho(const int *a, long na, const int *b, long nb, long diagonal) {
+    long lo = diagonal > nb ? diagonal - nb : 0;
+    long hi = diagonal < na ? diagonal : na;
+    while (lo < hi) {
+        long meio = lo + (hi - lo) / 2;
+        if (a[meio] <= b[diagonal - meio - 1]) {
+            lo = meio + 1;
+        } else {
+            hi = meio;
+        }
+    }
+    return lo;
+}
+
+// Função para escrever em saida quantidade elementos da mesclagem de a e b, a partir da
+// posição diagonal da mesclagem
+static void mesclarCaminho(const int *a, long na, const int *b, long nb, int *saida, long diagonal,
+                           long quantidade) {
+    long i = dividirCaminho(a, na, b, nb, diagonal);
+    long j = diagonal - i;
+    int *fim = saida + quantidade;
+
+    // Sem desvios: o índice da sequência que forneceu o menor elemento avança
+    while (saida < fim && i < na && j < nb) {
+        int x = a[i], y = b[j];
+        int tomarB = y < x;
+        *saida++ = tomarB ? y : x;
+        j += tomarB;
+        i += 1 - tomarB;
+    }
+
+    // O restante vem de uma única sequência
+    long resto = fim - saida;
+    if (resto > 0) {
+        memcpy(saida, i < na ? a + i : b + j, (size_t)resto * sizeof(int));
+    }
+}
+
+// Função para escrever uma parte da saída de um nível: a parte pode atravessar vários
+// pares de sequências, e cada pedaço começa na sua diagonal do par
+static void mesclarParte(void *arg) {
+    ParteMesclagem *p = (ParteMesclagem *)arg;
+    long par = 2 * p->largura;
+    for (long inicioPar = p->inicio / par * par; inicioPar < p->fim; inicioPar += par) {
+        long meio = inicioPar + p->largura < p->n ? inicioPar + p->largura : p->n;
+        long fimPar = inicioPar + par < p->n ? inicioPar + par : p->n;
+        long primeiro = p->inicio > inicioPar ? p->inicio : inicioPar;
+        long ultimo = p->fim < fimPar ? p->fim : fimPar;
+        mesclarCaminho(p->origem + inicioPar, meio - inicioPar, p->origem + meio, fimPar - meio,
+                       p->destino + primeiro, primeiro - inicioPar, ultimo - primeiro);
+    }
+}
+
+// Ordena os n elementos de origem em destino pelo mergesort
+int ordenarMesclagem(const int *origem, int *destino, long n, PoolThreads *pool, int numThreads) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    // Níveis de mesclagem: o primeiro é escolhido para que o último termine no destino
+    int niveis = 0;
+    for (long largura = MESCLAGEM_BLOCO; largura < n; largura *= 2) {
+        niveis++;
+    }
+    int *auxiliar = NULL;
+    if (niveis > 0) {
+        auxiliar = (int *)obterBufferTemporario((size_t)n * sizeof(int));
+        if (!auxiliar) {
+            printf("Erro: Falha na alocação de memória para o vetor auxiliar.\n");
+            return -1;
+        }
+    }
+    int *buffers[2] = { destino, auxiliar };
+    int atual = niveis % 2;
+
+    // 1. Blocos, com os trechos alinhados aos blocos
+    long numTrechos = numTrechosPool(pool, numThreads, n, MESCLAGEM_MIN_ELEMENTOS_TRECHO, MESCLAGEM_MAX_TRECHOS);
+    long numBlocos = (n + MESCLAGEM_BLOCO - 1) / MESCLAGEM_BLOCO;
+    TrechoBlocos trechos[MESCLAGEM_MAX_TRECHOS];
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].origem = origem;
+        trechos[t].destino = buffers[atual];
+        trechos[t].inicio = numBlocos * t / numTrechos * MESCLAGEM_BLOCO;
+        trechos[t].fim = numBlocos * (t + 1) / numTrechos * MESCLAGEM_BLOCO;
+        if (trechos[t].fim > n) {
+            trechos[t].fim = n;
+        }
+    }
+    executarItensPool(pool, ordenarBlocos, trechos, sizeof(TrechoBlocos), (int)numTrechos);
+
+    // 2 e 3. Níveis de mesclagem, alternando entre os dois buffers
+    ParteMesclagem partes[MESCLAGEM_MAX_TRECHOS];
+    for (long largura = MESCLAGEM_BLOCO; largura < n; largura *= 2) {
+        for (long p = 0; p < numTrechos; p++) {
+            partes[p].origem = buffers[atual];
+            partes[p].destino = buffers[1 - atual];
+            partes[p].n = n;
+            partes[p].largura = largura;
+            partes[p].inicio = n * p / numTrechos;
+            partes[p].fim = n * (p + 1) / numTrechos;
+        }
+        executarItensPool(pool, mesclarParte, partes, sizeof(ParteMesclagem), (int)numTrechos);
+        atual = 1 - atual;
+    }
+
+    if (auxiliar) {
+        devolverBufferTemporario(auxiliar);
+    }
+    return 0;
+}
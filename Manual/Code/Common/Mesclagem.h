@@ -0,0 +1,40 @@
+#ifndef MESCLAGEM_H
+#define MESCLAGEM_H
+
+#include "PoolThreads.h"
+
+/*
+ * Mergesort paralelo e estável, com tempo O(n log n) independente da ordem da entrada (ao
+ * contrário do MinMaxSort concorrente, quadrático nos segmentos e com a mesclagem final
+ * em uma única thread).
+ *
+ * 1. Blocos: o vetor é dividido em blocos de MESCLAGEM_BLOCO elementos, cada um ordenado
+ *    por uma rede bitônica (comparações e trocas sem desvios, com mínimo e máximo, que o
+ *    compilador vetoriza); o último bloco é completado com INT_MAX. Os trechos de blocos
+ *    são divididos entre os trabalhadores.
+ * 2. Mesclagem: a cada nível, as sequências vizinhas são mescladas duas a duas, com a
+ *    sequência da esquerda vencendo os empates. Os níveis alternam entre o destino e um
+ *    vetor auxiliar (o primeiro nível é escolhido para que o último termine no destino),
+ *    de forma que nada é copiado de volta.
+ * 3. Divisão do trabalho: em cada nível, a saída é dividida em partes iguais, uma por
+ *    trabalhador. O início de cada parte dentro de um par de sequências é encontrado por
+ *    uma busca binária na diagonal do caminho de mesclagem (merge path), de forma que os
+ *    níveis de cima, com poucos pares muito grandes, também usam todos os trabalhadores.
+ *
+ * A rede bitônica não é estável, mas só compara chaves inteiras, indistinguíveis quando
+ * iguais; as mesclagens preservam a ordem entre os blocos.
+ *
+ * No ConcMinMax, --mesclagem (ver Common/Opcoes.h) troca a ordenação quadrática dos
+ * segmentos e a mesclagem final em uma única thread por este mergesort.
+ */
+
+#define MESCLAGEM_BLOCO               32    // Elementos ordenados pela rede bitônica (potência de 2)
+#define MESCLAGEM_MIN_ELEMENTOS_TRECHO 65536 // Elementos mínimos por parte das fases paralelas
+#define MESCLAGEM_MAX_TRECHOS         256
+
+// Ordena os n elementos de origem em destino (pode ser o próprio vetor) pelo mergesort; com
+// pool, até numThreads trabalhadores são usados (0 = todos). Retorna 0 em caso de sucesso e
+// -1 em caso de erro.
+int ordenarMesclagem(const int *origem, int *destino, long n, PoolThreads *pool, int numThreads);
+
+#endif
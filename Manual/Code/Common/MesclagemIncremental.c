@@ -0,0 +1,500 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "MesclagemIncremental.h"
+#include "IndiceEsparso.h"
+
+// Estado da mesclagem pelo caminho de arquivo
+typedef struct {
+    int fdBase;
+    long nBase;
+    int *bloco;           // Janela da base lida com pread
+    long capacidade;      // Elementos da janela e do buffer de saída
+    long inicioBloco;     // Primeiro elemento da base na janela
+    long tamanhoBloco;    // Elementos válidos na janela (0 = vazia)
+    int fdSaida;
+    int *saida;           // Buffer de saída
+    long usados;
+    off_t posicaoSaida;   // Posição no arquivo de saída do primeiro elemento do buffer
+    EstatisticasIncremental *estatisticas;
+} MesclagemArquivo;
+
+// Função para encontrar, a partir de inicio, o primeiro elemento maior que chave (ou maior ou
+// igual, sem incluirIguais), por busca exponencial seguida de busca binária
+static long galopar(const int *v, long inicio, long fim, int chave, int incluirIguais) {
+#define ANTES(x) ((x) < chave || (incluirIguais && (x) == chave))
+    if (inicio >= fim || !ANTES(v[inicio])) {
+        return inicio;
+    }
+
+    // v[baixo] vem antes da chave; v[alto] (se alto < fim) não
+    long baixo = inicio, passo = 1, alto = inicio + 1;
+    while (alto < fim && ANTES(v[alto])) {
+        baixo = alto;
+        passo <<= 1;
+        alto = baixo + passo;
+    }
+    if (alto > fim) {
+        alto = fim;
+    }
+    while (alto - baixo > 1) {
+        long meio = baixo + (alto - baixo) / 2;
+        if (ANTES(v[meio])) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    return alto;
+#undef ANTES
+}
+
+// Função para ler bytes do arquivo a partir de posicao, repetindo leituras parciais
+static int lerTudo(int fd, void *destino, size_t bytes, off_t posicao) {
+    size_t lidos = 0;
+    while (lidos < bytes) {
+        ssize_t ret = pread(fd, (char *)destino + lidos, bytes - lidos, posicao + (off_t)lidos);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            printf("Erro: Falha ao ler a base (%s).\n", ret < 0 ? strerror(errno) : "fim do arquivo");
+            return -1;
+        }
+        lidos += (size_t)ret;
+    }
+    return 0;
+}
+
+// Função para gravar bytes no arquivo a partir de posicao, repetindo gravações parciais
+static int gravarTudo(int fd, const void *origem, size_t bytes, off_t posicao) {
+    size_t gravados = 0;
+    while (gravados < bytes) {
+        ssize_t ret = pwrite(fd, (const char *)origem + gravados, bytes - gravados, posicao + (off_t)gravados);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            printf("Erro: Falha ao gravar a saída (%s).\n", ret < 0 ? strerror(errno) : "nada gravado");
+            return -1;
+        }
+        gravados += (size_t)ret;
+    }
+    return 0;
+}
+
+// Função para gravar o buffer de saída no arquivo
+static int descarregarSaida(MesclagemArquivo *m) {
+    if (m->usados == 0) {
+        return 0;
+    }
+    size_t bytes = (size_t)m->usados * sizeof(int);
+    if (gravarTudo(m->fdSaida, m->saida, bytes, m->posicaoSaida) != 0) {
+        return -1;
+    }
+    m->posicaoSaida += (off_t)bytes;
+    m->usados = 0;
+    return 0;
+}
+
+// Função para acrescentar valores ao buffer de saída
+static int emitir(MesclagemArquivo *m, const int *valores, long quantidade) {
+    while (quantidade > 0) {
+        long cabe = m->capacidade - m->usados;
+        long q = quantidade < cabe ? quantidade : cabe;
+        memcpy(m->saida + m->usados, valores, (size_t)q * sizeof(int));
+        m->usados += q;
+        valores += q;
+        quantidade -= q;
+        if (m->usados == m->capacidade && descarregarSaida(m) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Função para ler a janela da base a partir do elemento posicao
+static int carregarBloco(MesclagemArquivo *m, long posicao) {
+    long tamanho = m->nBase - posicao < m->capacidade ? m->nBase - posicao : m->capacidade;
+    m->tamanhoBloco = 0;
+    if (lerTudo(m->fdBase, m->bloco, (size_t)tamanho * sizeof(int), (off_t)(posicao + 1) * (off_t)sizeof(int)) != 0) {
+        return -1;
+    }
+    m->inicioBloco = posicao;
+    m->tamanhoBloco = tamanho;
+    return 0;
+}
+
+// Função para verificar se o elemento posicao da base está na janela
+static int naJanela(const MesclagemArquivo *m, long posicao) {
+    return posicao >= m->inicioBloco && posicao < m->inicioBloco + m->tamanhoBloco;
+}
+
+// Função para ler um único valor da base (uma sonda do galope no arquivo)
+static int sondarBase(MesclagemArquivo *m, long posicao, int *valor) {
+    if (naJanela(m, posicao)) {
+        *valor = m->bloco[posicao - m->inicioBloco];
+        return 0;
+    }
+    m->estatisticas->sondas++;
+    return lerTudo(m->fdBase, valor, sizeof(int), (off_t)(posicao + 1) * (off_t)sizeof(int));
+}
+
+// Função para encontrar, a partir do elemento inicio (< nBase), o primeiro elemento da base
+// maior que chave; retorna -1 em caso de erro
+static long limiteBase(MesclagemArquivo *m, long inicio, int chave) {
+    if (!naJanela(m, inicio) && carregarBloco(m, inicio) != 0) {
+        return -1;
+    }
+    long fimBloco = m->inicioBloco + m->tamanhoBloco;
+    if (fimBloco == m->nBase || m->bloco[m->tamanhoBloco - 1] > chave) {
+        return m->inicioBloco + galopar(m->bloco, inicio - m->inicioBloco, m->tamanhoBloco, chave, 1);
+    }
+
+    // O trecho passa da janela: galope no arquivo, com passos a partir do tamanho da janela
+    long baixo = fimBloco - 1, passo = m->capacidade, alto = baixo + passo;
+    int valor;
+    while (alto < m->nBase) {
+        if (sondarBase(m, alto, &valor) != 0) {
+            return -1;
+        }
+        if (valor > chave) {
+            break;
+        }
+        baixo = alto;
+        passo <<= 1;
+        alto = baixo + passo;
+    }
+    if (alto > m->nBase) {
+        alto = m->nBase;
+    }
+
+    // Busca binária por sondas até o intervalo caber na janela
+    while (alto - baixo > m->capacidade) {
+        long meio = baixo + (alto - baixo) / 2;
+        if (sondarBase(m, meio, &valor) != 0) {
+            return -1;
+        }
+        if (valor <= chave) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    if (carregarBloco(m, baixo) != 0) {
+        return -1;
+    }
+    return baixo + galopar(m->bloco, 0, alto - baixo, chave, 1);
+}
+
+// Função para copiar quantidade elementos da base, a partir de inicio, direto para o arquivo
+// de saída com copy_file_range (ou read/write, se o sistema de arquivos não aceitar)
+static int copiarNoKernel(MesclagemArquivo *m, long inicio, long quantidade) {
+    if (descarregarSaida(m) != 0) {
+        return -1;
+    }
+
+    loff_t de = (loff_t)(inicio + 1) * (loff_t)sizeof(int);
+    loff_t para = m->posicaoSaida;
+    size_t restantes = (size_t)quantidade * sizeof(int);
+    while (restantes > 0) {
+        ssize_t ret = copy_file_range(m->fdBase, &de, m->fdSaida, &para, restantes, 0);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            if (ret < 0 && errno != ENOSYS && errno != EXDEV && errno != EINVAL && errno != EOPNOTSUPP) {
+                printf("Erro: Falha ao copiar a base (%s).\n", strerror(errno));
+                return -1;
+            }
+            break;
+        }
+        restantes -= (size_t)ret;
+        m->estatisticas->bytesKernel += ret;
+    }
+
+    // O restante (sem copy_file_range) passa pelo buffer de saída
+    m->posicaoSaida = para;
+    while (restantes > 0) {
+        size_t bytes = restantes < (size_t)m->capacidade * sizeof(int) ? restantes : (size_t)m->capacidade * sizeof(int);
+        if (lerTudo(m->fdBase, m->saida, bytes, de) != 0) {
+            return -1;
+        }
+        m->usados = (long)(bytes / sizeof(int));
+        if (descarregarSaida(m) != 0) {
+            return -1;
+        }
+        de += (loff_t)bytes;
+        restantes -= bytes;
+    }
+    return 0;
+}
+
+// Função para copiar os elementos [inicio, fim) da base para a saída
+static int copiarBase(MesclagemArquivo *m, long inicio, long fim) {
+    while (inicio < fim) {
+        if (naJanela(m, inicio)) {
+            long fimBloco = m->inicioBloco + m->tamanhoBloco;
+            long q = (fim < fimBloco ? fim : fimBloco) - inicio;
+            if (emitir(m, m->bloco + (inicio - m->inicioBloco), q) != 0) {
+                return -1;
+            }
+            inicio += q;
+        } else if ((fim - inicio) * (long)sizeof(int) >= INCREMENTAL_MIN_COPIA_KERNEL) {
+            return copiarNoKernel(m, inicio, fim - inicio);
+        } else if (carregarBloco(m, inicio) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Função para mesclar o delta à base lendo a base em blocos e gravando a saída com pwrite
+static int mesclarArquivo(int fdBase, long nBase, const int *delta, long n, int fdSaida,
+                          EstatisticasIncremental *estatisticas) {
+    MesclagemArquivo m;
+    memset(&m, 0, sizeof(m));
+    m.fdBase = fdBase;
+    m.nBase = nBase;
+    m.fdSaida = fdSaida;
+    m.capacidade = ES_TAMANHO_BLOCO_PADRAO / sizeof(int);
+    m.estatisticas = estatisticas;
+    m.bloco = malloc((size_t)m.capacidade * sizeof(int));
+    m.saida = malloc((size_t)m.capacidade * sizeof(int));
+    if (!m.bloco || !m.saida) {
+        printf("Erro: Falha na alocação de memória.\n");
+        free(m.bloco);
+        free(m.saida);
+        return -1;
+    }
+    posix_fadvise(fdBase, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    int total = (int)(nBase + n);
+    int erro = emitir(&m, &total, 1);
+    long i = 0, j = 0;
+    while (erro == 0 && j < n) {
+        // Trecho da base com valores menores ou iguais ao próximo valor do delta
+        long limite = i < nBase ? limiteBase(&m, i, delta[j]) : nBase;
+        if (limite < 0) {
+            erro = -1;
+            break;
+        }
+        if (limite > i) {
+            erro = copiarBase(&m, i, limite);
+            estatisticas->trechos++;
+            i = limite;
+        }
+
+        // Trecho do delta com valores menores que o próximo valor da base
+        long k = n;
+        if (erro == 0 && i < nBase) {
+            if (!naJanela(&m, i) && carregarBloco(&m, i) != 0) {
+                erro = -1;
+                break;
+            }
+            k = galopar(delta, j, n, m.bloco[i - m.inicioBloco], 0);
+        }
+        if (erro == 0) {
+            erro = emitir(&m, delta + j, k - j);
+        }
+        j = k;
+    }
+    if (erro == 0 && i < nBase) {
+        erro = copiarBase(&m, i, nBase);
+        estatisticas->trechos++;
+    }
+    if (erro == 0) {
+        erro = descarregarSaida(&m);
+    }
+
+    free(m.bloco);
+    free(m.saida);
+    return erro;
+}
+
+// Função para mesclar o delta à base pelos mapeamentos da base e da saída
+static int mesclarMapeado(int fdBase, long nBase, const int *delta, long n, int fdSaida,
+                          EstatisticasIncremental *estatisticas) {
+    size_t bytesBase = (size_t)(nBase + 1) * sizeof(int);
+    size_t bytesSaida = (size_t)(nBase + n + 1) * sizeof(int);
+    if (ftruncate(fdSaida, (off_t)bytesSaida) < 0) {
+        printf("Erro: Falha ao dimensionar a saída (%s).\n", strerror(errno));
+        return -1;
+    }
+
+    int *base = mmap(NULL, bytesBase, PROT_READ, MAP_SHARED, fdBase, 0);
+    if (base == MAP_FAILED) {
+        printf("Erro: Falha ao mapear a base (%s).\n", strerror(errno));
+        return -1;
+    }
+    int *saida = mmap(NULL, bytesSaida, PROT_READ | PROT_WRITE, MAP_SHARED, fdSaida, 0);
+    if (saida == MAP_FAILED) {
+        printf("Erro: Falha ao mapear a saída (%s).\n", strerror(errno));
+        munmap(base, bytesBase);
+        return -1;
+    }
+    madvise(base, bytesBase, MADV_SEQUENTIAL);
+    madvise(saida, bytesSaida, MADV_SEQUENTIAL);
+
+    const int *valores = base + 1;
+    int *destino = saida + 1;
+    saida[0] = (int)(nBase + n);
+    long i = 0, j = 0;
+    while (j < n) {
+        long limite = galopar(valores, i, nBase, delta[j], 1);
+        if (limite > i) {
+            memcpy(destino, valores + i, (size_t)(limite - i) * sizeof(int));
+            destino += limite - i;
+            estatisticas->trechos++;
+            i = limite;
+        }
+        long k = i < nBase ? galopar(delta, j, n, valores[i], 0) : n;
+        memcpy(destino, delta + j, (size_t)(k - j) * sizeof(int));
+        destino += k - j;
+        j = k;
+    }
+    if (i < nBase) {
+        memcpy(destino, valores + i, (size_t)(nBase - i) * sizeof(int));
+        estatisticas->trechos++;
+    }
+
+    munmap(base, bytesBase);
+    if (munmap(saida, bytesSaida) < 0) {
+        printf("Erro: Falha ao desfazer o mapeamento da saída (%s).\n", strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+// Mescla o delta ordenado ao arquivo ordenado, gravando o resultado em arquivoSaida
+int mesclarDeltaArquivo(const char *arquivoBase, const int *delta, long n, const char *arquivoSaida,
+                        int mapear, const ConfiguracaoES *config, EstatisticasIncremental *estatisticas) {
+    EstatisticasIncremental local;
+    if (!estatisticas) {
+        estatisticas = &local;
+    }
+    memset(estatisticas, 0, sizeof(*estatisticas));
+    estatisticas->delta = n;
+
+    int fdBase = open(arquivoBase, O_RDONLY);
+    if (fdBase < 0) {
+        printf("Erro: Não foi possível abrir a base %s.\n", arquivoBase);
+        return -1;
+    }
+
+    // A base precisa ser um vetor simples, com todos os elementos do cabeçalho
+    int nBase;
+    struct stat st;
+    if (lerTudo(fdBase, &nBase, sizeof(nBase), 0) != 0 || nBase < 0 || fstat(fdBase, &st) < 0 ||
+        st.st_size < (off_t)(nBase + 1L) * (off_t)sizeof(int)) {
+        printf("Erro: A base %s não é um vetor binário válido.\n", arquivoBase);
+        close(fdBase);
+        return -1;
+    }
+    if ((long)nBase + n > INT_MAX) {
+        printf("Erro: A base com o delta passa do tamanho máximo do formato (%d elementos).\n", INT_MAX);
+        close(fdBase);
+        return -1;
+    }
+    estatisticas->base = nBase;
+
+    // A saída é montada em um arquivo temporário, renomeado ao final
+    size_t tamanhoNome = strlen(arquivoSaida) + 32;
+    char *temporario = malloc(tamanhoNome);
+    if (!temporario) {
+        printf("Erro: Falha na alocação de memória.\n");
+        close(fdBase);
+        return -1;
+    }
+    snprintf(temporario, tamanhoNome, "%s.tmp.%d", arquivoSaida, (int)getpid());
+    int fdSaida = open(temporario, (mapear ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC, 0644);
+    if (fdSaida < 0) {
+        printf("Erro: Não foi possível criar o arquivo de saída %s.\n", temporario);
+        free(temporario);
+        close(fdBase);
+        return -1;
+    }
+
+    int erro = mapear ? mesclarMapeado(fdBase, nBase, delta, n, fdSaida, estatisticas)
+                      : mesclarArquivo(fdBase, nBase, delta, n, fdSaida, estatisticas);
+    if (erro == 0 && config && config->durabilidade && fdatasync(fdSaida) < 0) {
+        printf("Erro: Falha no fdatasync da saída (%s).\n", strerror(errno));
+        erro = -1;
+    }
+    if (close(fdSaida) < 0 && erro == 0) {
+        printf("Erro: Falha ao fechar a saída (%s).\n", strerror(errno));
+        erro = -1;
+    }
+    close(fdBase);
+
+    if (erro == 0 && rename(temporario, arquivoSaida) < 0) {
+        printf("Erro: Não foi possível renomear %s para %s (%s).\n", temporario, arquivoSaida, strerror(errno));
+        erro = -1;
+    }
+    if (erro != 0) {
+        unlink(temporario);
+    }
+    free(temporario);
+
+    // O índice esparso da saída é refeito a partir do arquivo mapeado
+    if (erro == 0 && config && config->indiceEsparso && construirIndiceEsparso(arquivoSaida) < 0) {
+        erro = -1;
+    }
+    return erro;
+}
+
+// Extrai de argv as opções do modo incremental
+int extrairOpcoesIncremental(int argc, char *argv[], OpcoesIncremental *opcoes) {
+    opcoes->base = NULL;
+    opcoes->mapear = 0;
+
+    int novoArgc = 1;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--mapear") == 0) {
+            opcoes->mapear = 1;
+            continue;
+        }
+
+        // Argumentos posicionais e opções comuns são mantidos na ordem original
+        if (strcmp(arg, "--base") != 0) {
+            argv[novoArgc++] = argv[i];
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            fprintf(stderr, "A opção %s exige um valor.\n", arg);
+            return -1;
+        }
+        opcoes->base = argv[++i];
+    }
+
+    if (opcoes->mapear && !opcoes->base) {
+        fprintf(stderr, "A opção --mapear exige --base.\n");
+        return -1;
+    }
+    argv[novoArgc] = NULL;
+    return novoArgc;
+}
+
+// Imprime a lista de opções do modo incremental
+void imprimirOpcoesIncremental(FILE *saida) {
+    fprintf(saida, "Modo incremental (a entrada é o delta a acrescentar a um arquivo já ordenado):\n");
+    fprintf(saida, "  --base <arquivo>           Arquivo ordenado que recebe o delta (a saída pode ser ele mesmo)\n");
+    fprintf(saida, "  --mapear                   Mescla pelos mapeamentos (mmap) da base e da saída\n");
+}
+
+// Imprime o resumo de uma mesclagem incremental
+void imprimirEstatisticasIncremental(FILE *saida, const EstatisticasIncremental *estatisticas) {
+    fprintf(saida, "Mesclagem incremental: base de %ld, delta de %ld, %ld trecho(s) da base copiados em bloco\n",
+            estatisticas->base, estatisticas->delta, estatisticas->trechos);
+    fprintf(saida, "Copiados por copy_file_range: %.1f MB, sondas do galope no arquivo: %ld\n",
+            estatisticas->bytesKernel / (1024.0 * 1024.0), estatisticas->sondas);
+}
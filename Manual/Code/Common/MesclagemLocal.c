@@ -0,0 +1,296 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "MesclagemLocal.h"
+#include "Ordenacao.h"
+
+// Parâmetros de uma execução do Mergesort no próprio vetor
+typedef struct {
+    PoolThreads *pool;
+    int *A;
+    int *buffers;          // numBuffers buffers de elementosBuffer elementos
+    long elementosBuffer;
+    int numBuffers;
+    int *livres;           // Índices dos buffers livres nos níveis de cima
+    int numLivres;
+    pthread_mutex_t mutex; // Protege os buffers livres
+    int maxTarefas;        // Tarefas na fila a partir das quais a mesclagem não se divide mais
+} ContextoMesclagemLocal;
+
+// Trecho [inicio, fim) ordenado por um trabalhador, com o seu buffer
+typedef struct {
+    ContextoMesclagemLocal *contexto;
+    int *buffer;
+    long inicio;
+    long fim;
+} TrechoMesclagemLocal;
+
+// Mesclagem das sequências ordenadas [a, m) e [m, b)
+typedef struct {
+    ContextoMesclagemLocal *contexto;
+    long a;
+    long m;
+    long b;
+} TarefaMesclagemLocal;
+
+// Função para inverter o trecho [inicio, fim)
+static void inverterTrecho(int *A, long inicio, long fim) {
+    for (fim--; inicio < fim; inicio++, fim--) {
+        int temp = A[inicio];
+        A[inicio] = A[fim];
+        A[fim] = temp;
+    }
+}
+
+// Função para trocar de lugar os trechos [a, m) e [m, b) por três inversões
+static void rotacionar(int *A, long a, long m, long b) {
+    inverterTrecho(A, a, m);
+    inverterTrecho(A, m, b);
+    inverterTrecho(A, a, b);
+}
+
+// Função para mesclar [a, m) e [m, b) copiando a menor sequência para o buffer (que deve
+// caber nele): a da esquerda é mesclada do início para o fim, a da direita do fim para o
+// início; nos empates, a ordem original é mantida
+static void mesclarComBuffer(int *A, long a, long m, long b, int *buffer) {
+    if (m - a <= b - m) {
+        long tamanho = m - a, i = 0, j = m, k = a;
+        memcpy(buffer, A + a, (size_t)tamanho * sizeof(int));
+        while (i < tamanho && j < b) {
+            A[k++] = A[j] < buffer[i] ? A[j++] : buffer[i++];
+        }
+        memcpy(A + k, buffer + i, (size_t)(tamanho - i) * sizeof(int));
+    } else {
+        long tamanho = b - m, i = m - 1, j = tamanho - 1, k = b - 1;
+        memcpy(buffer, A + m, (size_t)tamanho * sizeof(int));
+        while (j >= 0 && i >= a) {
+            A[k--] = buffer[j] < A[i] ? A[i--] : buffer[j--];
+        }
+        memcpy(A + a, buffer, (size_t)(j + 1) * sizeof(int));
+    }
+}
+
+// Função para encontrar o corte do SymMerge de [a, m) e [m, b): depois de rotacionar
+// [*inicio, m) com [m, *fim), as mesclagens [a, *inicio, *meio) e [*meio, *fim, b) são
+// independentes
+static void cortarSymMerge(const int *A, long a, long m, long b, long *inicio, long *fim, long *meio) {
+    long centro = a + (b - a) / 2;
+    long soma = centro + m;
+    long lo, hi;
+    if (m > centro) {
+        lo = soma - b;
+        hi = centro;
+    } else {
+        lo = a;
+        hi = m;
+    }
+    long p = soma - 1;
+    while (lo < hi) {
+        long c = lo + (hi - lo) / 2;
+        if (!(A[p - c] < A[c])) {
+            lo = c + 1;
+        } else {
+            hi = c;
+        }
+    }
+    *inicio = lo;
+    *fim = soma - lo;
+    *meio = centro;
+}
+
+// Função para mesclar [a, m) e [m, b) pelo SymMerge, com o buffer (pode ser NULL) quando
+// uma das sequências couber nele
+static void symMerge(int *A, long a, long m, long b, int *buffer, long elementosBuffer) {
+    if (a >= m || m >= b || A[m - 1] <= A[m]) {
+        return;
+    }
+    if (buffer && (m - a <= elementosBuffer || b - m <= elementosBuffer)) {
+        mesclarComBuffer(A, a, m, b, buffer);
+        return;
+    }
+
+    // Um único elemento à esquerda ou à direita: busca binária e deslocamento
+    if (m - a == 1) {
+        long lo = m, hi = b;
+        while (lo < hi) {
+            long h = lo + (hi - lo) / 2;
+            if (A[h] < A[a]) {
+                lo = h + 1;
+            } else {
+                hi = h;
+            }
+        }
+        int valor = A[a];
+        memmove(A + a, A + a + 1, (size_t)(lo - 1 - a) * sizeof(int));
+        A[lo - 1] = valor;
+        return;
+    }
+    if (b - m == 1) {
+        long lo = a, hi = m;
+        while (lo < hi) {
+            long h = lo + (hi - lo) / 2;
+            if (!(A[m] < A[h])) {
+                lo = h + 1;
+            } else {
+                hi = h;
+            }
+        }
+        int valor = A[m];
+        memmove(A + lo + 1, A + lo, (size_t)(m - lo) * sizeof(int));
+        A[lo] = valor;
+        return;
+    }
+
+    long inicio, fim, meio;
+    cortarSymMerge(A, a, m, b, &inicio, &fim, &meio);
+    if (inicio < m && m < fim) {
+        rotacionar(A, inicio, m, fim);
+    }
+    symMerge(A, a, inicio, meio, buffer, elementosBuffer);
+    symMerge(A, meio, fim, b, buffer, elementosBuffer);
+}
+
+// Função para obter um buffer livre para uma mesclagem dos níveis de cima (NULL se todos
+// estiverem em uso)
+static int *obterBufferLivre(ContextoMesclagemLocal *contexto) {
+    int *buffer = NULL;
+    pthread_mutex_lock(&contexto->mutex);
+    if (contexto->numLivres > 0) {
+        buffer = contexto->buffers + contexto->livres[--contexto->numLivres] * contexto->elementosBuffer;
+    }
+    pthread_mutex_unlock(&contexto->mutex);
+    return buffer;
+}
+
+// Função para devolver um buffer obtido por obterBufferLivre
+static void devolverBufferLivre(ContextoMesclagemLocal *contexto, int *buffer) {
+    pthread_mutex_lock(&contexto->mutex);
+    contexto->livres[contexto->numLivres++] = (int)((buffer - contexto->buffers) / contexto->elementosBuffer);
+    pthread_mutex_unlock(&contexto->mutex);
+}
+
+static void mesclarConcorrente(ContextoMesclagemLocal *contexto, long a, long m, long b);
+
+// Função executada pela tarefa que mescla uma das metades do SymMerge (ou um par de trechos)
+static void tarefaMesclagemLocal(void *arg) {
+    TarefaMesclagemLocal *tarefa = (TarefaMesclagemLocal *)arg;
+    mesclarConcorrente(tarefa->contexto, tarefa->a, tarefa->m, tarefa->b);
+}
+
+// Função para mesclar [a, m) e [m, b) nos níveis de cima: enquanto houver trabalhadores
+// livres, o corte do SymMerge divide a mesclagem e a metade esquerda vai para o pool
+static void mesclarConcorrente(ContextoMesclagemLocal *contexto, long a, long m, long b) {
+    int *A = contexto->A;
+    if (a >= m || m >= b || A[m - 1] <= A[m]) {
+        return;
+    }
+    if (b - a <= MESCLAGEM_LOCAL_LIMITE_TAREFA || m - a == 1 || b - m == 1 ||
+        tarefasNaFila(contexto->pool) >= contexto->maxTarefas) {
+        int *buffer = obterBufferLivre(contexto);
+        symMerge(A, a, m, b, buffer, contexto->elementosBuffer);
+        if (buffer) {
+            devolverBufferLivre(contexto, buffer);
+        }
+        return;
+    }
+
+    long inicio, fim, meio;
+    cortarSymMerge(A, a, m, b, &inicio, &fim, &meio);
+    if (inicio < m && m < fim) {
+        rotacionar(A, inicio, m, fim);
+    }
+
+    GrupoTarefas grupo;
+    TarefaMesclagemLocal esquerda = { contexto, a, inicio, meio };
+    iniciarGrupoTarefas(&grupo);
+    submeterTarefa(contexto->pool, &grupo, -1, tarefaMesclagemLocal, &esquerda);
+    mesclarConcorrente(contexto, meio, fim, b);
+    aguardarGrupoTarefas(contexto->pool, &grupo);
+}
+
+// Função para ordenar um trecho: blocos por inserção e mesclagens de baixo para cima
+static void ordenarTrechoLocal(void *arg) {
+    TrechoMesclagemLocal *t = (TrechoMesclagemLocal *)arg;
+    int *A = t->contexto->A;
+    long elementosBuffer = t->contexto->elementosBuffer;
+    for (long inicio = t->inicio; inicio < t->fim; inicio += MESCLAGEM_LOCAL_BLOCO) {
+        long fim = inicio + MESCLAGEM_LOCAL_BLOCO < t->fim ? inicio + MESCLAGEM_LOCAL_BLOCO : t->fim;
+        insercao(A, inicio, fim - 1);
+    }
+    for (long largura = MESCLAGEM_LOCAL_BLOCO; largura < t->fim - t->inicio; largura *= 2) {
+        for (long a = t->inicio; a + largura < t->fim; a += 2 * largura) {
+            long b = a + 2 * largura < t->fim ? a + 2 * largura : t->fim;
+            symMerge(A, a, a + largura, b, t->buffer, elementosBuffer);
+        }
+    }
+}
+
+// Ordena o vetor no próprio vetor pelo Mergesort com SymMerge
+int ordenarMesclagemLocal(int *vetor, long n, PoolThreads *pool, int numThreads, long *picoMemoria) {
+    if (picoMemoria) {
+        *picoMemoria = 0;
+    }
+    if (n <= 1) {
+        return 0;
+    }
+
+    // Buffers de cerca de sqrt(n) elementos, um por trecho
+    long numTrechos = numTrechosPool(pool, numThreads, n, MESCLAGEM_LOCAL_MIN_ELEMENTOS_TRECHO, MESCLAGEM_LOCAL_MAX_TRECHOS);
+    ContextoMesclagemLocal contexto;
+    contexto.pool = pool;
+    contexto.A = vetor;
+    contexto.elementosBuffer = 1;
+    while ((contexto.elementosBuffer + 1) * (contexto.elementosBuffer + 1) <= n) {
+        contexto.elementosBuffer++;
+    }
+    contexto.numBuffers = (int)numTrechos;
+    size_t bytes = (size_t)numTrechos * contexto.elementosBuffer * sizeof(int) + (size_t)numTrechos * sizeof(int);
+    contexto.buffers = (int *)malloc((size_t)numTrechos * contexto.elementosBuffer * sizeof(int));
+    contexto.livres = (int *)malloc((size_t)numTrechos * sizeof(int));
+    if (!contexto.buffers || !contexto.livres) {
+        printf("Erro: Falha na alocação de memória para os buffers da mesclagem.\n");
+        free(contexto.buffers);
+        free(contexto.livres);
+        return -1;
+    }
+    contexto.numLivres = 0;
+    contexto.maxTarefas = numTrechos > 1 ? (int)numTrechos : 0;
+    pthread_mutex_init(&contexto.mutex, NULL);
+    if (picoMemoria) {
+        *picoMemoria = (long)bytes;
+    }
+
+    // 1. Trechos, cada um com o seu buffer
+    TrechoMesclagemLocal trechos[MESCLAGEM_LOCAL_MAX_TRECHOS];
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].contexto = &contexto;
+        trechos[t].buffer = contexto.buffers + t * contexto.elementosBuffer;
+        trechos[t].inicio = n * t / numTrechos;
+        trechos[t].fim = n * (t + 1) / numTrechos;
+    }
+    executarItensPool(pool, ordenarTrechoLocal, trechos, sizeof(TrechoMesclagemLocal), (int)numTrechos);
+
+    // 2. Níveis de cima: pares de trechos, com os buffers compartilhados entre as tarefas
+    for (int b = 0; b < contexto.numBuffers; b++) {
+        contexto.livres[contexto.numLivres++] = b;
+    }
+    TarefaMesclagemLocal pares[MESCLAGEM_LOCAL_MAX_TRECHOS];
+    for (long passo = 1; passo < numTrechos; passo *= 2) {
+        int numPares = 0;
+        for (long t = 0; t + passo < numTrechos; t += 2 * passo) {
+            long fim = t + 2 * passo < numTrechos ? t + 2 * passo : numTrechos;
+            pares[numPares].contexto = &contexto;
+            pares[numPares].a = trechos[t].inicio;
+            pares[numPares].m = trechos[t + passo].inicio;
+            pares[numPares].b = trechos[fim - 1].fim;
+            numPares++;
+        }
+        executarItensPool(pool, tarefaMesclagemLocal, pares, sizeof(TarefaMesclagemLocal), numPares);
+    }
+
+    pthread_mutex_destroy(&contexto.mutex);
+    free(contexto.buffers);
+    free(contexto.livres);
+    return 0;
+}
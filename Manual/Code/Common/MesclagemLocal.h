@@ -0,0 +1,39 @@
+#ifndef MESCLAGEM_LOCAL_H
+#define MESCLAGEM_LOCAL_H
+
+#include "PoolThreads.h"
+
+/*
+ * Mergesort paralelo no próprio vetor, para máquinas em que um buffer auxiliar de n
+ * elementos (como o do Mergesort de Common/Mesclagem.h ou o da mesclagem do MinMaxSort
+ * concorrente) não cabe na memória. A ordenação é estável.
+ *
+ * As mesclagens usam o SymMerge (Kim e Kutzner): uma busca binária simétrica encontra o
+ * ponto de corte das duas sequências, uma rotação (três inversões) troca os pedaços do
+ * meio, e as duas metades resultantes são mescladas de forma independente. Quando uma das
+ * sequências cabe em um buffer pequeno (cerca de sqrt(n) elementos), ela é copiada para o
+ * buffer e mesclada em tempo linear, o que atende a maior parte dos níveis de baixo.
+ *
+ * 1. Trechos: o vetor é dividido em trechos, um por trabalhador. Cada trecho ordena blocos
+ *    de MESCLAGEM_LOCAL_BLOCO elementos por inserção e os mescla de baixo para cima, com o
+ *    seu próprio buffer.
+ * 2. Níveis de cima: os trechos são mesclados dois a dois. As mesclagens maiores que
+ *    MESCLAGEM_LOCAL_LIMITE_TAREFA são divididas pelo SymMerge, e a metade esquerda vira
+ *    uma tarefa do pool; as mesclagens menores usam um buffer livre, se houver (senão, só
+ *    rotações).
+ *
+ * A memória extra é a dos buffers (um por trecho) mais a pilha da recursão (O(log n)
+ * quadros por thread); o pico de bytes alocados é informado ao chamador.
+ */
+
+#define MESCLAGEM_LOCAL_BLOCO               16     // Elementos ordenados por inserção antes das mesclagens
+#define MESCLAGEM_LOCAL_LIMITE_TAREFA       65536  // Mesclagens menores não são divididas entre tarefas
+#define MESCLAGEM_LOCAL_MIN_ELEMENTOS_TRECHO 65536 // Elementos mínimos por trecho
+#define MESCLAGEM_LOCAL_MAX_TRECHOS         256
+
+// Ordena os n elementos do vetor no próprio vetor; com pool, até numThreads trabalhadores são
+// usados (0 = todos). picoMemoria (opcional) recebe o pico de bytes alocados pela ordenação.
+// Retorna 0 em caso de sucesso e -1 em caso de erro.
+int ordenarMesclagemLocal(int *vetor, long n, PoolThreads *pool, int numThreads, long *picoMemoria);
+
+#endif
@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Opcoes.h"
+#include "Ajuste.h"
+
+// Preenche as opções com os valores padrão
+void opcoesPadrao(OpcoesExecucao *opcoes) {
+    configuracaoESPadrao(&opcoes->es);
+    opcoes->modoMemoria = MEM_THP;
+    opcoes->afinidade = AFINIDADE_NENHUMA;
+    opcoes->topologia = NULL;
+    opcoes->numEntradas = 0;
+    opcoes->manifesto = NULL;
+    opcoes->saidaDir = NULL;
+    opcoes->loteConcorrente = 0;
+    opcoes->preordenacao = 0;
+    opcoes->compactar = 0;
+    opcoes->duploPivo = 0;
+    opcoes->mesclagem = 0;
+    opcoes->ajuste = NULL;
+    opcoes->argsort = NULL;
+    opcoes->larguraIndice = 4;
+}
+
+// Retorna 1 se as opções pedem o modo em lote
+int modoLote(const OpcoesExecucao *opcoes) {
+    return opcoes->numEntradas > 0 || opcoes->manifesto != NULL;
+}
+
+// Lê o valor inteiro positivo de uma opção
+int lerValorPositivo(const char *opcao, const char *valor, long *saida) {
+    char *fim;
+    long v = strtol(valor, &fim, 10);
+    if (*valor == '\0' || *fim != '\0' || v <= 0) {
+        fprintf(stderr, "Valor inválido para %s: %s\n", opcao, valor);
+        return -1;
+    }
+    *saida = v;
+    return 0;
+}
+
+// Extrai as opções de argv, compactando os argumentos posicionais no início
+int extrairOpcoes(int argc, char *argv[], OpcoesExecucao *opcoes) {
+    opcoesPadrao(opcoes);
+
+    int novoArgc = 1;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+
+        // Argumentos posicionais são mantidos na ordem original
+        if (strncmp(arg, "--", 2) != 0) {
+            argv[novoArgc++] = argv[i];
+            continue;
+        }
+
+        // Opções sem valor
+        if (strcmp(arg, "--es-direto") == 0) {
+            opcoes->es.direto = 1;
+            continue;
+        }
+        if (strcmp(arg, "--es-durabilidade") == 0) {
+            opcoes->es.durabilidade = 1;
+            continue;
+        }
+        if (strcmp(arg, "--indice-esparso") == 0) {
+            opcoes->es.indiceEsparso = 1;
+            continue;
+        }
+        if (strcmp(arg, "--lote-concorrente") == 0) {
+            opcoes->loteConcorrente = 1;
+            continue;
+        }
+        if (strcmp(arg, "--preordenacao") == 0) {
+            opcoes->preordenacao = 1;
+            continue;
+        }
+        if (strcmp(arg, "--compactar") == 0) {
+            opcoes->compactar = 1;
+            continue;
+        }
+        if (strcmp(arg, "--duplo-pivo") == 0) {
+            opcoes->duploPivo = 1;
+            continue;
+        }
+        if (strcmp(arg, "--mesclagem") == 0) {
+            opcoes->mesclagem = 1;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            fprintf(stderr, "A opção %s exige um valor.\n", arg);
+            return -1;
+        }
+        const char *valor = argv[++i];
+        long numero;
+
+        if (strcmp(arg, "--es") == 0) {
+            if (backendESDoNome(valor, &opcoes->es.backend) < 0) {
+                fprintf(stderr, "Backend de E/S inválido: %s (use stdio, uring ou pread)\n", valor);
+                return -1;
+            }
+        } else if (strcmp(arg, "--es-bloco") == 0) {
+            if (lerValorPositivo(arg, valor, &numero) < 0) {
+                return -1;
+            }
+            if (numero * 1024 * 1024 < ES_TAMANHO_BLOCO_MIN || numero * 1024 * 1024 > ES_TAMANHO_BLOCO_MAX) {
+                fprintf(stderr, "O tamanho do bloco deve estar entre 1 e 4 MB.\n");
+                return -1;
+            }
+            opcoes->es.tamanhoBloco = (size_t)numero * 1024 * 1024;
+        } else if (strcmp(arg, "--es-profundidade") == 0) {
+            if (lerValorPositivo(arg, valor, &numero) < 0) {
+                return -1;
+            }
+            opcoes->es.profundidade = (int)numero;
+        } else if (strcmp(arg, "--memoria") == 0) {
+            if (modoMemoriaDoNome(valor, &opcoes->modoMemoria) < 0) {
+                fprintf(stderr, "Modo de memória inválido: %s (use malloc, thp ou hugetlb)\n", valor);
+                return -1;
+            }
+        } else if (strcmp(arg, "--afinidade") == 0) {
+            if (politicaAfinidadeDoNome(valor, &opcoes->afinidade) < 0) {
+                fprintf(stderr, "Política de afinidade inválida: %s (use nenhuma, compacta ou espalhada)\n", valor);
+                return -1;
+            }
+        } else if (strcmp(arg, "--topologia") == 0) {
+            Topologia teste;
+            if (lerTopologia(&teste, valor) < 0) {
+                fprintf(stderr, "Topologia inválida: %s (use NxC, ex.: 2x4)\n", valor);
+                return -1;
+            }
+            opcoes->topologia = valor;
+        } else if (strcmp(arg, "--entradas") == 0) {
+            if (opcoes->numEntradas == OPCOES_MAX_ENTRADAS) {
+                fprintf(stderr, "No máximo %d opções --entradas.\n", OPCOES_MAX_ENTRADAS);
+                return -1;
+            }
+            opcoes->entradas[opcoes->numEntradas++] = valor;
+        } else if (strcmp(arg, "--manifesto") == 0) {
+            opcoes->manifesto = valor;
+        } else if (strcmp(arg, "--saida-dir") == 0) {
+            opcoes->saidaDir = valor;
+        } else if (strcmp(arg, "--ajuste") == 0) {
+            opcoes->ajuste = valor;
+        } else if (strcmp(arg, "--argsort") == 0) {
+            opcoes->argsort = valor;
+        } else if (strcmp(arg, "--indices") == 0) {
+            if (strcmp(valor, "32") != 0 && strcmp(valor, "64") != 0) {
+                fprintf(stderr, "Largura de índice inválida: %s (use 32 ou 64)\n", valor);
+                return -1;
+            }
+            opcoes->larguraIndice = strcmp(valor, "32") == 0 ? 4 : 8;
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", arg);
+            return -1;
+        }
+    }
+
+    // A permutação vem da ordenação dos pares (chave, índice), que não aproveita a
+    // pré-ordenação nem a compactação, e é gravada ao lado de uma única saída
+    if (opcoes->argsort && (modoLote(opcoes) || opcoes->preordenacao || opcoes->compactar)) {
+        fprintf(stderr, "A opção --argsort não pode ser usada com o modo em lote, --preordenacao ou --compactar.\n");
+        return -1;
+    }
+
+    // O diretório das saídas e a ordenação simultânea só existem no modo em lote
+    if (!modoLote(opcoes) && (opcoes->saidaDir || opcoes->loteConcorrente)) {
+        fprintf(stderr, "As opções --saida-dir e --lote-concorrente só podem ser usadas no modo em lote (--entradas ou --manifesto).\n");
+        return -1;
+    }
+
+    definirModoMemoria(opcoes->modoMemoria);
+    if (opcoes->ajuste) {
+        definirArquivoAjuste(opcoes->ajuste);
+    }
+
+    argv[novoArgc] = NULL;
+    return novoArgc;
+}
+
+// Verifica se as opções pedidas pertencem aos grupos que o programa implementa
+int verificarOpcoesAceitas(const OpcoesExecucao *opcoes, int grupos) {
+    const struct {
+        int grupo;
+        const char *nome;
+        int pedida;
+    } pedidas[] = {
+        { OPCOES_GRUPO_ES,             "--es",               opcoes->es.backend != ES_STDIO },
+        { OPCOES_GRUPO_ES,             "--es-bloco",         opcoes->es.tamanhoBloco != ES_TAMANHO_BLOCO_PADRAO },
+        { OPCOES_GRUPO_ES,             "--es-profundidade",  opcoes->es.profundidade != ES_PROFUNDIDADE_PADRAO },
+        { OPCOES_GRUPO_ES,             "--es-durabilidade",  opcoes->es.durabilidade },
+        { OPCOES_GRUPO_ES_DIRETO,      "--es-direto",        opcoes->es.direto },
+        { OPCOES_GRUPO_LOTE,           "--entradas",         opcoes->numEntradas > 0 },
+        { OPCOES_GRUPO_LOTE,           "--manifesto",        opcoes->manifesto != NULL },
+        { OPCOES_GRUPO_LOTE,           "--saida-dir",        opcoes->saidaDir != NULL },
+        { OPCOES_GRUPO_LOTE,           "--lote-concorrente", opcoes->loteConcorrente },
+        { OPCOES_GRUPO_AFINIDADE,      "--afinidade",        opcoes->afinidade != AFINIDADE_NENHUMA },
+        { OPCOES_GRUPO_AFINIDADE,      "--topologia",        opcoes->topologia != NULL },
+        { OPCOES_GRUPO_PREORDENACAO,   "--preordenacao",     opcoes->preordenacao },
+        { OPCOES_GRUPO_COMPACTAR,      "--compactar",        opcoes->compactar },
+        { OPCOES_GRUPO_DUPLO_PIVO,     "--duplo-pivo",       opcoes->duploPivo },
+        { OPCOES_GRUPO_MESCLAGEM,      "--mesclagem",        opcoes->mesclagem },
+        { OPCOES_GRUPO_AJUSTE,         "--ajuste",           opcoes->ajuste != NULL },
+        { OPCOES_GRUPO_ARGSORT,        "--argsort",          opcoes->argsort != NULL },
+        { OPCOES_GRUPO_ARGSORT,        "--indices",          opcoes->larguraIndice != 4 },
+        { OPCOES_GRUPO_INDICE_ESPARSO, "--indice-esparso",   opcoes->es.indiceEsparso },
+    };
+    for (size_t i = 0; i < sizeof(pedidas) / sizeof(pedidas[0]); i++) {
+        if (pedidas[i].pedida && !(grupos & pedidas[i].grupo)) {
+            fprintf(stderr, "A opção %s não é aceita por este programa.\n", pedidas[i].nome);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Imprime a lista de opções aceitas
+void imprimirOpcoes(FILE *saida) {
+    imprimirOpcoesAceitas(saida, OPCOES_GRUPOS_TODOS);
+}
+
+// Imprime a lista de opções, apenas com as dos grupos dados
+void imprimirOpcoesAceitas(FILE *saida, int grupos) {
+    fprintf(saida, "Opções:\n");
+    if (grupos & OPCOES_GRUPO_ES) {
+        fprintf(saida, "  --es <stdio|uring|pread>   Backend de leitura e gravação (padrão: stdio)\n");
+        fprintf(saida, "  --es-bloco <MB>            Tamanho de cada requisição assíncrona, 1 a 4 (padrão: 2)\n");
+        fprintf(saida, "  --es-profundidade <N>      Requisições em voo no io_uring (padrão: %d)\n", ES_PROFUNDIDADE_PADRAO);
+    }
+    if (grupos & OPCOES_GRUPO_ES_DIRETO) {
+        fprintf(saida, "  --es-direto                Grava a saída com O_DIRECT (sem page cache)\n");
+    }
+    if (grupos & OPCOES_GRUPO_ES) {
+        fprintf(saida, "  --es-durabilidade          Faz um único fdatasync ao final da gravação\n");
+    }
+    if (grupos & OPCOES_GRUPO_INDICE_ESPARSO) {
+        fprintf(saida, "  --indice-esparso           Grava também o índice esparso <saida>.idx para consultas de\n");
+        fprintf(saida, "                             faixa (ConsultarIndice)\n");
+    }
+    fprintf(saida, "  --memoria <malloc|thp|hugetlb>  Alocação dos vetores (padrão: thp)\n");
+    if (grupos & OPCOES_GRUPO_AFINIDADE) {
+        fprintf(saida, "  --afinidade <nenhuma|compacta|espalhada>  Fixação das threads em CPUs/nós NUMA (padrão: nenhuma)\n");
+        fprintf(saida, "  --topologia <NxC>          Simula N nós NUMA com C CPUs cada (testes)\n");
+    }
+    if (grupos & OPCOES_GRUPO_PREORDENACAO) {
+        fprintf(saida, "  --preordenacao             Mede corridas e inversões antes de ordenar: vetores já ordenados\n");
+        fprintf(saida, "                             retornam na hora, invertidos são só invertidos e corridas longas\n");
+        fprintf(saida, "                             são mescladas (métricas em Data/preordenacao.csv)\n");
+    }
+    if (grupos & OPCOES_GRUPO_COMPACTAR) {
+        fprintf(saida, "  --compactar                Chaves que cabem em 8/16 bits (depois de subtrair o mínimo) são\n");
+        fprintf(saida, "                             compactadas e ordenadas por radix sort (fases em Data/compactacao.csv)\n");
+    }
+    if (grupos & OPCOES_GRUPO_DUPLO_PIVO) {
+        fprintf(saida, "  --duplo-pivo               Quicksorts: partição com dois pivôs (Yaroslavskiy) no lugar da\n");
+        fprintf(saida, "                             de Hoare (sequencial) ou de Lomuto (concorrente)\n");
+    }
+    if (grupos & OPCOES_GRUPO_MESCLAGEM) {
+        fprintf(saida, "  --mesclagem                Ordena pelo mergesort paralelo (O(n log n)) no lugar dos\n");
+        fprintf(saida, "                             segmentos do MinMaxSort e da mesclagem final\n");
+    }
+    if (grupos & OPCOES_GRUPO_AJUSTE) {
+        fprintf(saida, "  --ajuste <arquivo|nenhum>  Perfil de ajuste da máquina gerado pelo Autoajuste\n");
+        fprintf(saida, "                             (padrão: $%s ou %s)\n", AJUSTE_VARIAVEL, AJUSTE_ARQUIVO_PADRAO);
+    }
+    if (grupos & OPCOES_GRUPO_ARGSORT) {
+        fprintf(saida, "  --argsort <arquivo>        Grava também a permutação que ordena a entrada (índices estáveis)\n");
+        fprintf(saida, "  --indices <32|64>          Largura dos índices da permutação (padrão: 32)\n");
+    }
+    if (grupos & OPCOES_GRUPO_LOTE) {
+        fprintf(saida, "Modo em lote (sem <arquivo_entrada> <arquivo_saida>):\n");
+        fprintf(saida, "  --entradas <padrão>        Arquivos de entrada, ex.: 'Files/Input/*.bin' (pode ser repetida)\n");
+        fprintf(saida, "  --manifesto <arquivo>      Uma ordenação por linha: entrada[<TAB>saida]\n");
+        fprintf(saida, "  --saida-dir <diretório>    Diretório das saídas sem nome no manifesto\n");
+        fprintf(saida, "  --lote-concorrente         Ordena ao mesmo tempo os arquivos pequenos\n");
+    }
+}
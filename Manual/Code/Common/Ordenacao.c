@@ -0,0 +1,948 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Ordenacao.h"
+#include "Ajuste.h"
+
+// Parâmetros de uma execução do Quicksort concorrente
+typedef struct {
+    PoolThreads *pool;
+    int *A;
+    long limiteTarefa;   // Partes menores não viram tarefas
+    long limiteInsercao; // Partes com até esse tamanho vão para a inserção
+    int maxTarefas;      // Tarefas na fila a partir das quais a thread não divide mais
+} ContextoQuicksort;
+
+// Parte do vetor ordenada por uma tarefa do Quicksort concorrente
+typedef struct {
+    const ContextoQuicksort *contexto;
+    long lo;
+    long hi;
+} TarefaQuicksort;
+
+// Segmento ordenado por uma tarefa do MinMaxSort concorrente
+typedef struct {
+    int *arr;
+    long inicio; // Índice de início do segmento
+    long fim;    // Índice final do segmento
+} TarefaSegmento;
+
+// Intervalo [inicio, fim) de uma sequência ordenada
+typedef struct {
+    long inicio;
+    long fim;
+} Sequencia;
+
+// Mesclagem dos segmentos de um nó NUMA
+typedef struct {
+    const int *origem;
+    int *destino;
+    long base;                  // Posição do resultado em destino
+    const Sequencia *sequencias;
+    int numSequencias;
+    int trabalhador;            // Trabalhador do pool no nó dos segmentos
+} TarefaMesclagemNo;
+
+// Preenche as opções padrão para o algoritmo
+void opcoesOrdenacaoPadrao(OpcoesOrdenacao *opcoes, AlgoritmoOrdenacao algoritmo) {
+    opcoes->algoritmo = algoritmo;
+    opcoes->pool = NULL;
+    opcoes->numThreads = 0;
+    opcoes->saida = NULL;
+    opcoes->gravador = NULL;
+    opcoes->elementosPorBloco = ES_TAMANHO_BLOCO_PADRAO / sizeof(int);
+    opcoes->preordenacao = 0;
+    opcoes->metricas = NULL;
+    opcoes->compactar = 0;
+    opcoes->compactacao = NULL;
+    opcoes->limiteTarefa = 0;
+    opcoes->limiteInsercao = 0;
+    opcoes->threadsUteis = 0;
+    opcoes->memoriaExtra = NULL;
+    opcoes->permutacao = NULL;
+    opcoes->larguraIndice = 4;
+}
+
+// Converte o nome do algoritmo; retorna -1 se for inválido
+int algoritmoOrdenacaoDoNome(const char *nome, AlgoritmoOrdenacao *algoritmo) {
+    for (int a = ORDENACAO_QUICKSORT_SEQ; a < ORDENACAO_NUM_ALGORITMOS; a++) {
+        if (strcmp(nome, nomeAlgoritmoOrdenacao((AlgoritmoOrdenacao)a)) == 0) {
+            *algoritmo = (AlgoritmoOrdenacao)a;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Retorna o nome do algoritmo
+const char *nomeAlgoritmoOrdenacao(AlgoritmoOrdenacao algoritmo) {
+    switch (algoritmo) {
+        case ORDENACAO_QUICKSORT_SEQ:  return "quicksort-seq";
+        case ORDENACAO_QUICKSORT_CONC: return "quicksort-conc";
+        case ORDENACAO_MINMAX_SEQ:     return "minmax-seq";
+        case ORDENACAO_MINMAX_CONC:    return "minmax-conc";
+        case ORDENACAO_CORRIDAS:       return "corridas";
+        case ORDENACAO_CONTAGEM:       return "contagem";
+        case ORDENACAO_APRENDIDA:      return "aprendida";
+        case ORDENACAO_DUPLO_PIVO_SEQ:  return "duplo-pivo-seq";
+        case ORDENACAO_DUPLO_PIVO_CONC: return "duplo-pivo-conc";
+        case ORDENACAO_MESCLAGEM:      return "mesclagem";
+        case ORDENACAO_MESCLAGEM_LOCAL: return "mesclagem-local";
+        default:                       return "?";
+    }
+}
+
+// Função para trocar dois elementos
+void trocar(int *a, int *b) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Função de partição (Lomuto): o pivô do meio vai para a posição correta
+long particao(int A[], long lo, long hi) {
+    long meio = lo + (hi - lo) / 2;
+    int pivo = A[meio];
+    trocar(&A[meio], &A[hi]); // Mover o pivô para o final
+
+    long i = lo - 1;
+    for (long j = lo; j < hi; j++) {
+        if (A[j] < pivo) {
+            i++;
+            trocar(&A[i], &A[j]);
+        }
+    }
+    trocar(&A[i + 1], &A[hi]); // Colocar o pivô na posição correta
+    return i + 1;
+}
+
+// Função para particionar o vetor (Hoare), selecionando um pivô e reorganizando os elementos
+// O pivô é movido para a última posição, e os elementos menores que ele vão para a esquerda
+// e os maiores vão para a direita.
+long particionar(int A[], long lo, long hi) {
+    long meio = lo + (hi - lo) / 2; // Seleciona o pivô como o elemento do meio
+    int pivo = A[meio];
+
+    // Mover o pivô para o final para simplificar a partição
+    trocar(&A[meio], &A[hi]);
+
+    long i = lo - 1;
+    long j = hi;
+
+    while (1) {
+        // Move o índice 'i' até encontrar um elemento maior ou igual ao pivô
+        do {
+            i++;
+        } while (A[i] < pivo);
+
+        // Move o índice 'j' até encontrar um elemento menor ou igual ao pivô
+        do {
+            j--;
+        } while (A[j] > pivo && j > lo);
+
+        // Se os índices se cruzaram, o pivô pode ser colocado na posição correta
+        if (i >= j) {
+            trocar(&A[i], &A[hi]);
+            return j;
+        }
+
+        // Se não, troca os elementos para garantir que a partição seja feita corretamente
+        trocar(&A[i], &A[j]);
+    }
+}
+
+// Função para levar às pontas da parte [lo, hi] os pivôs do Quicksort com dois pivôs:
+// cinco elementos igualmente espaçados são ordenados, e o segundo e o quarto (os tercis da
+// amostra) vão para lo e hi
+static void escolherPivos(int A[], long lo, long hi) {
+    long n = hi - lo + 1;
+    if (n >= 6) {
+        long e[5];
+        for (int k = 0; k < 5; k++) {
+            e[k] = lo + n * (k + 1) / 6;
+        }
+        for (int i = 1; i < 5; i++) {
+            for (int j = i; j > 0 && A[e[j - 1]] > A[e[j]]; j--) {
+                trocar(&A[e[j - 1]], &A[e[j]]);
+            }
+        }
+        trocar(&A[lo], &A[e[1]]);
+        trocar(&A[hi], &A[e[3]]);
+    }
+    if (A[lo] > A[hi]) {
+        trocar(&A[lo], &A[hi]);
+    }
+}
+
+// Função de partição com dois pivôs (Yaroslavskiy): os elementos menores que o pivô p vão
+// para a esquerda, os maiores que o pivô q para a direita e os demais ficam no meio
+void particaoDuploPivo(int A[], long lo, long hi, long *esquerda, long *direita) {
+    escolherPivos(A, lo, hi);
+    int p = A[lo], q = A[hi];
+
+    // As trocas são feitas à mão, com o elemento atual em uma variável, para que o laço
+    // leia cada posição uma única vez
+    long l = lo + 1; // Fim da parte esquerda
+    long g = hi - 1; // Início da parte direita
+    for (long k = l; k <= g; k++) {
+        int atual = A[k];
+        if (atual < p) {
+            A[k] = A[l];
+            A[l] = atual;
+            l++;
+        } else if (atual > q) {
+            while (A[g] > q && k < g) {
+                g--;
+            }
+            int trazido = A[g]; // Elemento da direita que ocupa a posição k
+            if (trazido < p) {
+                A[k] = A[l];
+                A[l] = trazido;
+                l++;
+            } else {
+                A[k] = trazido;
+            }
+            A[g] = atual;
+            g--;
+        }
+    }
+
+    // Colocar os pivôs nas posições corretas
+    l--;
+    g++;
+    trocar(&A[lo], &A[l]);
+    trocar(&A[hi], &A[g]);
+    *esquerda = l;
+    *direita = g;
+}
+
+// Função para levar o resultado ao vetor de saída (se houver) antes de um algoritmo in-place
+static int *prepararSaida(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    if (opcoes->saida && opcoes->saida != vetor) {
+        memcpy(opcoes->saida, vetor, (size_t)n * sizeof(int));
+        return opcoes->saida;
+    }
+    return vetor;
+}
+
+// Função para enviar ao gravador o resultado de um algoritmo que não grava durante a execução
+static void enviarResultado(const OpcoesOrdenacao *opcoes, long n) {
+    if (opcoes->gravador && n > 0) {
+        enviarBlocoGravador(opcoes->gravador, 0, n);
+    }
+}
+
+// Obtém o pool da chamada; cria um temporário se as opções não tiverem um
+PoolThreads *poolDaChamada(const OpcoesOrdenacao *opcoes, int *temporario) {
+    *temporario = 0;
+    if (opcoes->pool) {
+        return opcoes->pool;
+    }
+
+    int numThreads = opcoes->numThreads;
+    if (numThreads <= 0) {
+        numThreads = cpusDisponiveis();
+    }
+    *temporario = 1;
+    return criarPoolThreads(numThreads > 0 ? numThreads : 1, NULL);
+}
+
+// Função para obter o limite de inserção da chamada (das opções ou do perfil de ajuste)
+static long limiteInsercaoDaChamada(const OpcoesOrdenacao *opcoes, AlgoritmoOrdenacao algoritmo) {
+    if (opcoes->limiteInsercao > 0) {
+        return opcoes->limiteInsercao;
+    }
+    return ajusteMaquina()->algoritmos[algoritmo].limiteInsercao;
+}
+
+// Função para ordenar a parte [lo, hi] por inserção
+void insercao(int A[], long lo, long hi) {
+    for (long i = lo + 1; i <= hi; i++) {
+        int valor = A[i];
+        long j = i - 1;
+        while (j >= lo && A[j] > valor) {
+            A[j + 1] = A[j];
+            j--;
+        }
+        A[j + 1] = valor;
+    }
+}
+
+// Algoritmo Quicksort sequencial: ordena o vetor recursivamente utilizando o particionamento;
+// as partes com até limiteInsercao elementos são ordenadas por inserção
+static void quicksort(int A[], long lo, long hi, long limiteInsercao) {
+    if (hi - lo + 1 <= limiteInsercao) {
+        insercao(A, lo, hi);
+    } else if (lo < hi) {
+        long p = particionar(A, lo, hi);             // Encontra a posição do pivô
+        quicksort(A, lo, p, limiteInsercao);         // Ordena a parte esquerda
+        quicksort(A, p + 1, hi, limiteInsercao);     // Ordena a parte direita
+    }
+}
+
+// Quicksort sequencial
+int ordenarQuicksortSeqI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int *A = prepararSaida(vetor, n, opcoes);
+    quicksort(A, 0, n - 1, limiteInsercaoDaChamada(opcoes, ORDENACAO_QUICKSORT_SEQ));
+    enviarResultado(opcoes, n);
+    return 0;
+}
+
+// Quicksort sequencial com dois pivôs: três partes por partição; com pivôs iguais, a parte
+// do meio só tem elementos iguais a eles e já está ordenada
+static void quicksortDuploPivo(int A[], long lo, long hi, long limiteInsercao) {
+    if (hi - lo + 1 <= limiteInsercao) {
+        insercao(A, lo, hi);
+    } else if (lo < hi) {
+        long l, g;
+        particaoDuploPivo(A, lo, hi, &l, &g);
+        quicksortDuploPivo(A, lo, l - 1, limiteInsercao);
+        if (A[l] < A[g]) {
+            quicksortDuploPivo(A, l + 1, g - 1, limiteInsercao);
+        }
+        quicksortDuploPivo(A, g + 1, hi, limiteInsercao);
+    }
+}
+
+// Quicksort sequencial com dois pivôs
+int ordenarDuploPivoSeqI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int *A = prepararSaida(vetor, n, opcoes);
+    quicksortDuploPivo(A, 0, n - 1, limiteInsercaoDaChamada(opcoes, ORDENACAO_DUPLO_PIVO_SEQ));
+    enviarResultado(opcoes, n);
+    return 0;
+}
+
+static void quicksortConcorrente(const ContextoQuicksort *contexto, long lo, long hi);
+
+// Função executada pela tarefa que ordena uma das partes
+static void tarefaQuicksort(void *arg) {
+    TarefaQuicksort *tarefa = (TarefaQuicksort *)arg;
+    quicksortConcorrente(tarefa->contexto, tarefa->lo, tarefa->hi);
+}
+
+// Quicksort concorrente: enquanto houver trabalhadores livres, a parte esquerda é entregue
+// ao pool e a direita continua na thread atual
+static void quicksortConcorrente(const ContextoQuicksort *contexto, long lo, long hi) {
+    int *A = contexto->A;
+    if (hi - lo + 1 <= contexto->limiteInsercao) {
+        insercao(A, lo, hi);
+    } else if (lo < hi) {
+        long p = particao(A, lo, hi);
+
+        if (p - lo > contexto->limiteTarefa && tarefasNaFila(contexto->pool) < contexto->maxTarefas) {
+            GrupoTarefas grupo;
+            TarefaQuicksort esquerda = { contexto, lo, p - 1 };
+            iniciarGrupoTarefas(&grupo);
+            submeterTarefa(contexto->pool, &grupo, -1, tarefaQuicksort, &esquerda);
+
+            quicksortConcorrente(contexto, p + 1, hi);
+
+            // Aguardar a parte esquerda (ajudando o pool enquanto isso)
+            aguardarGrupoTarefas(contexto->pool, &grupo);
+        } else {
+            quicksortConcorrente(contexto, lo, p - 1); // Ordenar sem criar nova tarefa
+            quicksortConcorrente(contexto, p + 1, hi);
+        }
+    }
+}
+
+// Função para preencher o contexto de um Quicksort concorrente com os limites das opções ou
+// do perfil de ajuste do algoritmo; com uma única thread útil, nenhuma tarefa é criada e a
+// ordenação fica na thread atual
+static void prepararContextoQuicksort(ContextoQuicksort *contexto, int *vetor, long n, const OpcoesOrdenacao *opcoes,
+                                      PoolThreads *pool, AlgoritmoOrdenacao algoritmo) {
+    const AjusteMaquina *ajuste = ajusteMaquina();
+    int threads = opcoes->threadsUteis > 0
+        ? opcoes->threadsUteis
+        : threadsAjustadas(ajuste, algoritmo, n, numTrabalhadoresPool(pool));
+    contexto->pool = pool;
+    contexto->A = prepararSaida(vetor, n, opcoes);
+    contexto->limiteTarefa = opcoes->limiteTarefa > 0
+        ? opcoes->limiteTarefa
+        : ajuste->algoritmos[algoritmo].limiteTarefa;
+    contexto->limiteInsercao = limiteInsercaoDaChamada(opcoes, algoritmo);
+    contexto->maxTarefas = threads > 1 ? threads : 0;
+}
+
+// Quicksort concorrente
+int ordenarQuicksortConcI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    ContextoQuicksort contexto;
+    prepararContextoQuicksort(&contexto, vetor, n, opcoes, pool, ORDENACAO_QUICKSORT_CONC);
+    quicksortConcorrente(&contexto, 0, n - 1);
+    enviarResultado(opcoes, n);
+
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return 0;
+}
+
+static void quicksortDuploPivoConcorrente(const ContextoQuicksort *contexto, long lo, long hi);
+
+// Função executada pela tarefa que ordena uma das partes do Quicksort com dois pivôs
+static void tarefaDuploPivo(void *arg) {
+    TarefaQuicksort *tarefa = (TarefaQuicksort *)arg;
+    quicksortDuploPivoConcorrente(tarefa->contexto, tarefa->lo, tarefa->hi);
+}
+
+// Função para saber se uma parte com o tamanho dado deve virar uma tarefa do pool
+static int criarTarefa(const ContextoQuicksort *contexto, long tamanho) {
+    return tamanho > contexto->limiteTarefa && tarefasNaFila(contexto->pool) < contexto->maxTarefas;
+}
+
+// Quicksort concorrente com dois pivôs: enquanto houver trabalhadores livres, as partes
+// esquerda e do meio são entregues ao pool e a direita continua na thread atual
+static void quicksortDuploPivoConcorrente(const ContextoQuicksort *contexto, long lo, long hi) {
+    int *A = contexto->A;
+    if (hi - lo + 1 <= contexto->limiteInsercao) {
+        insercao(A, lo, hi);
+    } else if (lo < hi) {
+        long l, g;
+        particaoDuploPivo(A, lo, hi, &l, &g);
+        int meio = A[l] < A[g]; // Com pivôs iguais, a parte do meio já está ordenada
+
+        GrupoTarefas grupo;
+        TarefaQuicksort esquerda = { contexto, lo, l - 1 };
+        TarefaQuicksort centro = { contexto, l + 1, g - 1 };
+        iniciarGrupoTarefas(&grupo);
+        int esquerdaNoPool = criarTarefa(contexto, l - lo);
+        if (esquerdaNoPool) {
+            submeterTarefa(contexto->pool, &grupo, -1, tarefaDuploPivo, &esquerda);
+        }
+        int centroNoPool = meio && criarTarefa(contexto, g - l - 1);
+        if (centroNoPool) {
+            submeterTarefa(contexto->pool, &grupo, -1, tarefaDuploPivo, &centro);
+        }
+
+        quicksortDuploPivoConcorrente(contexto, g + 1, hi);
+        if (!esquerdaNoPool) {
+            quicksortDuploPivoConcorrente(contexto, lo, l - 1);
+        }
+        if (meio && !centroNoPool) {
+            quicksortDuploPivoConcorrente(contexto, l + 1, g - 1);
+        }
+
+        // Aguardar as partes entregues ao pool (ajudando o pool enquanto isso)
+        if (esquerdaNoPool || centroNoPool) {
+            aguardarGrupoTarefas(contexto->pool, &grupo);
+        }
+    }
+}
+
+// Quicksort concorrente com dois pivôs
+int ordenarDuploPivoConcI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    ContextoQuicksort contexto;
+    prepararContextoQuicksort(&contexto, vetor, n, opcoes, pool, ORDENACAO_DUPLO_PIVO_CONC);
+    quicksortDuploPivoConcorrente(&contexto, 0, n - 1);
+    enviarResultado(opcoes, n);
+
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return 0;
+}
+
+// Função que realiza o algoritmo Min-Max Sort no segmento [inicio, fim] do array:
+// a cada passo, o menor elemento vai para o início e o maior para o fim do segmento
+static void minMaxSort(int *arr, long inicio, long fim) {
+    while (inicio < fim) {
+        long posMin = inicio, posMax = fim;
+
+        // Procurar os menores e maiores elementos no segmento
+        for (long i = inicio; i <= fim; i++) {
+            if (arr[i] < arr[posMin]) {
+                posMin = i;
+            }
+            if (arr[i] > arr[posMax]) {
+                posMax = i;
+            }
+        }
+
+        // Trocar o menor elemento com o primeiro do segmento
+        if (posMin != inicio) {
+            trocar(&arr[inicio], &arr[posMin]);
+            if (posMax == inicio) {
+                posMax = posMin;
+            }
+        }
+
+        // Trocar o maior elemento com o último do segmento
+        if (posMax != fim) {
+            trocar(&arr[fim], &arr[posMax]);
+        }
+
+        // Ajustar os limites do segmento
+        inicio++;
+        fim--;
+    }
+}
+
+// MinMaxSort sequencial
+int ordenarMinMaxSeqI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int *arr = prepararSaida(vetor, n, opcoes);
+    minMaxSort(arr, 0, n - 1);
+    enviarResultado(opcoes, n);
+    return 0;
+}
+
+// Função executada pela tarefa de cada segmento
+static void tarefaSegmento(void *arg) {
+    TarefaSegmento *tarefa = (TarefaSegmento *)arg;
+    minMaxSort(tarefa->arr, tarefa->inicio, tarefa->fim);
+}
+
+// Função que mescla as sequências ordenadas de origem em destino, a partir de destino[base].
+// Se houver um gravador, cada bloco de elementosPorBloco já mesclado é enviado ao disco.
+static void mesclarSequencias(const int *origem, int *destino, long base, const Sequencia *sequencias,
+                              int numSequencias, GravadorVetor *gravador, long elementosPorBloco) {
+    long *indices = (long*)malloc(numSequencias * sizeof(long));
+    if (!indices) {
+        printf("Erro: Falha na alocação de memória para os índices.\n");
+        return;
+    }
+
+    // Inicializar os índices para cada sequência e contar os elementos
+    long total = 0;
+    for (int i = 0; i < numSequencias; i++) {
+        indices[i] = sequencias[i].inicio;
+        total += sequencias[i].fim - sequencias[i].inicio;
+    }
+
+    long inicioBloco = base; // Primeiro elemento ainda não enviado ao gravador
+
+    for (long k = base; k < base + total; k++) {
+        int idxMin = -1;
+
+        // Encontrar o menor elemento entre as sequências
+        for (int i = 0; i < numSequencias; i++) {
+            if (indices[i] < sequencias[i].fim) {
+                if (idxMin == -1 || origem[indices[i]] < origem[indices[idxMin]]) {
+                    idxMin = i;
+                }
+            }
+        }
+
+        // Colocar o menor elemento encontrado no destino
+        destino[k] = origem[indices[idxMin]];
+        indices[idxMin]++;  // Avançar o índice da sequência
+
+        // Enviar o bloco completo para gravação enquanto a mesclagem continua
+        if (gravador && k + 1 - inicioBloco == elementosPorBloco) {
+            enviarBlocoGravador(gravador, inicioBloco, elementosPorBloco);
+            inicioBloco = k + 1;
+        }
+    }
+
+    // Enviar o restante da mesclagem
+    if (gravador && base + total > inicioBloco) {
+        enviarBlocoGravador(gravador, inicioBloco, base + total - inicioBloco);
+    }
+
+    free(indices);
+}
+
+// Função executada pela tarefa de cada nó na primeira etapa da mesclagem por nó
+static void tarefaMesclagemNo(void *arg) {
+    TarefaMesclagemNo *tarefa = (TarefaMesclagemNo *)arg;
+    mesclarSequencias(tarefa->origem, tarefa->destino, tarefa->base, tarefa->sequencias,
+                      tarefa->numSequencias, NULL, 0);
+}
+
+// Função que mescla os segmentos em duas etapas: primeiro os segmentos de cada nó NUMA,
+// em paralelo e por um trabalhador do próprio nó (arr -> aux), depois as sequências de cada
+// nó (aux -> destino). Só a segunda etapa lê memória de outros nós.
+static int mesclarPorNo(PoolThreads *pool, const int *arr, int *aux, int *destino,
+                        const Sequencia *segmentos, int numSegmentos,
+                        GravadorVetor *gravador, long elementosPorBloco) {
+    const PlanoNUMA *plano = planoDoPool(pool);
+    int numTrabalhadores = numTrabalhadoresPool(pool);
+    int numNos = plano->topologia.numNos;
+    Sequencia *porNo = (Sequencia*)malloc(numSegmentos * sizeof(Sequencia));
+    Sequencia *resultados = (Sequencia*)malloc(numNos * sizeof(Sequencia));
+    TarefaMesclagemNo *tarefas = (TarefaMesclagemNo*)malloc(numNos * sizeof(TarefaMesclagemNo));
+    if (!porNo || !resultados || !tarefas) {
+        printf("Erro: Falha na alocação de memória para a mesclagem por nó.\n");
+        free(porNo);
+        free(resultados);
+        free(tarefas);
+        return -1;
+    }
+
+    // Agrupar os segmentos pelo nó do trabalhador que os ordenou
+    int numGrupos = 0, usados = 0;
+    long base = 0;
+    for (int no = 0; no < numNos; no++) {
+        int primeiro = usados;
+        long tamanho = 0;
+        int trabalhador = -1;
+        for (int i = 0; i < numSegmentos; i++) {
+            if (noDaThread(plano, i % numTrabalhadores) == no) {
+                porNo[usados++] = segmentos[i];
+                tamanho += segmentos[i].fim - segmentos[i].inicio;
+                if (trabalhador < 0) {
+                    trabalhador = i % numTrabalhadores;
+                }
+            }
+        }
+        if (usados == primeiro) {
+            continue;
+        }
+
+        tarefas[numGrupos].origem = arr;
+        tarefas[numGrupos].destino = aux;
+        tarefas[numGrupos].base = base;
+        tarefas[numGrupos].sequencias = &porNo[primeiro];
+        tarefas[numGrupos].numSequencias = usados - primeiro;
+        tarefas[numGrupos].trabalhador = trabalhador;
+        resultados[numGrupos].inicio = base;
+        resultados[numGrupos].fim = base + tamanho;
+        base += tamanho;
+        numGrupos++;
+    }
+
+    // Primeira etapa: uma tarefa no trabalhador de cada nó
+    GrupoTarefas grupo;
+    iniciarGrupoTarefas(&grupo);
+    for (int g = 0; g < numGrupos; g++) {
+        submeterTarefa(pool, &grupo, tarefas[g].trabalhador, tarefaMesclagemNo, &tarefas[g]);
+    }
+    aguardarGrupoTarefas(pool, &grupo);
+
+    // Segunda etapa: mesclar as sequências de cada nó no destino
+    mesclarSequencias(aux, destino, 0, resultados, numGrupos, gravador, elementosPorBloco);
+
+    free(porNo);
+    free(resultados);
+    free(tarefas);
+    return 0;
+}
+
+// MinMaxSort concorrente: os segmentos são ordenados em paralelo pelo pool e depois mesclados
+int ordenarMinMaxConcI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    int numSegmentos = opcoes->numThreads > 0 ? opcoes->numThreads : numTrabalhadoresPool(pool);
+    TarefaSegmento *tarefas = (TarefaSegmento*)malloc(numSegmentos * sizeof(TarefaSegmento));
+    Sequencia *segmentos = (Sequencia*)malloc(numSegmentos * sizeof(Sequencia));
+    if (!tarefas || !segmentos) {
+        printf("Erro: Falha na alocação de memória para os segmentos.\n");
+        free(tarefas);
+        free(segmentos);
+        if (temporario) {
+            destruirPoolThreads(pool);
+        }
+        return -1;
+    }
+
+    // Com plano NUMA, o segmento i vai para o trabalhador i (fixado no nó onde as páginas do
+    // segmento foram tocadas); sem plano, qualquer trabalhador livre o ordena
+    const PlanoNUMA *plano = planoDoPool(pool);
+    long tamanhoSegmento = n / numSegmentos; // Tamanho de cada segmento
+    long restante = n % numSegmentos;        // Elementos restantes
+
+    GrupoTarefas grupo;
+    iniciarGrupoTarefas(&grupo);
+    for (int i = 0; i < numSegmentos; i++) {
+        tarefas[i].arr = vetor;
+        tarefas[i].inicio = i * tamanhoSegmento;
+        tarefas[i].fim = (i + 1) * tamanhoSegmento - 1;
+
+        // Atribuir os elementos restantes ao último segmento
+        if (i == numSegmentos - 1) {
+            tarefas[i].fim += restante;
+        }
+
+        segmentos[i].inicio = tarefas[i].inicio;
+        segmentos[i].fim = tarefas[i].fim + 1;
+        submeterTarefa(pool, &grupo, plano ? i : -1, tarefaSegmento, &tarefas[i]);
+    }
+    aguardarGrupoTarefas(pool, &grupo);
+
+    // Mesclar os segmentos ordenados no vetor de resultado; sem vetor de saída separado, a
+    // mesclagem usa um buffer temporário
+    int *destino = opcoes->saida ? opcoes->saida : vetor;
+    int mesclagemPorNo = plano && plano->topologia.numNos > 1 && numSegmentos > plano->topologia.numNos;
+    int erro = 0;
+
+    if (mesclagemPorNo) {
+        int *aux = (int*)obterBufferTemporario((size_t)n * sizeof(int));
+        if (!aux) {
+            erro = -1;
+        } else {
+            erro = mesclarPorNo(pool, vetor, aux, destino, segmentos, numSegmentos,
+                                opcoes->gravador, opcoes->elementosPorBloco);
+            devolverBufferTemporario(aux);
+        }
+    } else if (destino != vetor) {
+        mesclarSequencias(vetor, destino, 0, segmentos, numSegmentos,
+                          opcoes->gravador, opcoes->elementosPorBloco);
+    } else {
+        int *aux = (int*)obterBufferTemporario((size_t)n * sizeof(int));
+        if (!aux) {
+            erro = -1;
+        } else {
+            mesclarSequencias(vetor, aux, 0, segmentos, numSegmentos, NULL, 0);
+
+            // Copiar os dados mesclados de volta para o array original
+            memcpy(vetor, aux, (size_t)n * sizeof(int));
+            devolverBufferTemporario(aux);
+            enviarResultado(opcoes, n);
+        }
+    }
+    if (erro) {
+        printf("Erro: Falha na alocação de memória para mesclagem.\n");
+    }
+
+    free(tarefas);
+    free(segmentos);
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return erro;
+}
+
+// Mesclagem de corridas naturais
+int ordenarCorridasI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int *A = prepararSaida(vetor, n, opcoes);
+    if (ordenarCorridas(A, n) != 0) {
+        return -1;
+    }
+    enviarResultado(opcoes, n);
+    return 0;
+}
+
+// Função para ordenar pelo Quicksort quando um algoritmo de distribuição recusa o vetor:
+// o concorrente de dois pivôs com as mesmas threads do pool (o sequencial, de Hoare, com
+// uma). Os vetores recusados costumam ter poucas chaves distintas em uma faixa larga, em que
+// a partição de Lomuto do Quicksort concorrente fica quadrática.
+static int ordenarAlternativa(int *vetor, long n, const OpcoesOrdenacao *opcoes, PoolThreads *pool) {
+    int threads = numTrabalhadoresPool(pool);
+    if (opcoes->numThreads > 0 && opcoes->numThreads < threads) {
+        threads = opcoes->numThreads;
+    }
+    OpcoesOrdenacao alternativa = *opcoes;
+    alternativa.pool = pool;
+    if (threads > 1) {
+        alternativa.algoritmo = ORDENACAO_DUPLO_PIVO_CONC;
+        if (alternativa.threadsUteis <= 0 && threads < numTrabalhadoresPool(pool)) {
+            alternativa.threadsUteis = threads;
+        }
+        return ordenarDuploPivoConcI32(vetor, n, &alternativa);
+    }
+    alternativa.algoritmo = ORDENACAO_QUICKSORT_SEQ;
+    return ordenarQuicksortSeqI32(vetor, n, &alternativa);
+}
+
+// Ordenação por contagem; com faixa de valores grande, o Quicksort é usado no lugar
+int ordenarContagemI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    int *destino = opcoes->saida ? opcoes->saida : vetor;
+    int resultado = ordenarContagem(vetor, destino, n, pool, opcoes->numThreads);
+    if (resultado == 0) {
+        enviarResultado(opcoes, n);
+    } else if (resultado > 0) {
+        resultado = ordenarAlternativa(vetor, n, opcoes, pool);
+    }
+
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return resultado;
+}
+
+// Ordenação aprendida; se o modelo da CDF for recusado, o Quicksort é usado no lugar
+int ordenarAprendidaI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    int *destino = opcoes->saida ? opcoes->saida : vetor;
+    int resultado = ordenarAprendida(vetor, destino, n, pool, opcoes->numThreads);
+    if (resultado == 0) {
+        enviarResultado(opcoes, n);
+    } else if (resultado > 0) {
+        resultado = ordenarAlternativa(vetor, n, opcoes, pool);
+    }
+
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return resultado;
+}
+
+// Mergesort paralelo
+int ordenarMesclagemI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    int *destino = opcoes->saida ? opcoes->saida : vetor;
+    int resultado = ordenarMesclagem(vetor, destino, n, pool, opcoes->numThreads);
+    if (resultado == 0) {
+        enviarResultado(opcoes, n);
+    }
+    if (opcoes->memoriaExtra) {
+        *opcoes->memoriaExtra = n > MESCLAGEM_BLOCO ? (long)(n * sizeof(int)) : 0;
+    }
+
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return resultado;
+}
+
+// Mergesort no próprio vetor
+int ordenarMesclagemLocalI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    int *A = prepararSaida(vetor, n, opcoes);
+    int resultado = ordenarMesclagemLocal(A, n, pool, opcoes->numThreads, opcoes->memoriaExtra);
+    if (resultado == 0) {
+        enviarResultado(opcoes, n);
+    }
+
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return resultado;
+}
+
+// Função para medir a pré-ordenação e, quando possível, ordenar sem o algoritmo pedido.
+// Retorna 1 se o vetor já foi ordenado, 0 se o algoritmo ainda deve ser executado e -1 em
+// caso de erro.
+static int aproveitarPreordenacao(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    MetricasPreordenacao metricas;
+    medirPreordenacao(vetor, n, opcoes->pool, &metricas);
+    EstrategiaPreordenacao estrategia = escolherEstrategiaPreordenacao(&metricas);
+    if (opcoes->metricas) {
+        *opcoes->metricas = metricas;
+    }
+
+    int *A;
+    switch (estrategia) {
+        case PREORDENACAO_JA_ORDENADO:
+            prepararSaida(vetor, n, opcoes);
+            enviarResultado(opcoes, n);
+            return 1;
+        case PREORDENACAO_INVERTIDO:
+            A = prepararSaida(vetor, n, opcoes);
+            inverterVetor(A, n);
+            enviarResultado(opcoes, n);
+            return 1;
+        case PREORDENACAO_CORRIDAS:
+            return ordenarCorridasI32(vetor, n, opcoes) == 0 ? 1 : -1;
+        default:
+            return 0;
+    }
+}
+
+// Função para ordenar com as chaves compactadas, quando couberem em 8 ou 16 bits. Retorna 1
+// se o vetor já foi ordenado, 0 se o algoritmo ainda deve ser executado e -1 em caso de erro.
+static int aproveitarCompactacao(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    MetricasCompactacao metricas;
+    int *destino = opcoes->saida ? opcoes->saida : vetor;
+    int resultado = ordenarCompactado(vetor, destino, n, opcoes->pool, &metricas);
+    if (opcoes->compactacao) {
+        *opcoes->compactacao = metricas;
+    }
+    if (resultado == 0) {
+        enviarResultado(opcoes, n);
+        return 1;
+    }
+    return resultado < 0 ? -1 : 0;
+}
+
+// Função para ordenar o vetor e escrever a permutação que o ordena (argsort), com os pares
+// (chave, índice) da ordenação de registros
+static int ordenarComPermutacao(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+    int *destino = opcoes->saida ? opcoes->saida : vetor;
+    int resultado = argsortChaves(vetor, n, sizeof(int), opcoes->permutacao, opcoes->larguraIndice, destino,
+                                  pool, opcoes->numThreads);
+    if (resultado == 0) {
+        enviarResultado(opcoes, n);
+    }
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return resultado;
+}
+
+// Ordena os n elementos com o algoritmo das opções
+int ordenarI32(int *vetor, long n, const OpcoesOrdenacao *opcoes) {
+    if (opcoes->memoriaExtra) {
+        *opcoes->memoriaExtra = -1;
+    }
+    if (opcoes->compactacao) {
+        memset(opcoes->compactacao, 0, sizeof(*opcoes->compactacao));
+    }
+    if (opcoes->permutacao) {
+        return ordenarComPermutacao(vetor, n, opcoes);
+    }
+    if (opcoes->preordenacao) {
+        int resultado = aproveitarPreordenacao(vetor, n, opcoes);
+        if (resultado != 0) {
+            return resultado < 0 ? -1 : 0;
+        }
+    }
+    if (opcoes->compactar) {
+        int resultado = aproveitarCompactacao(vetor, n, opcoes);
+        if (resultado != 0) {
+            return resultado < 0 ? -1 : 0;
+        }
+    }
+
+    switch (opcoes->algoritmo) {
+        case ORDENACAO_QUICKSORT_SEQ:  return ordenarQuicksortSeqI32(vetor, n, opcoes);
+        case ORDENACAO_QUICKSORT_CONC: return ordenarQuicksortConcI32(vetor, n, opcoes);
+        case ORDENACAO_MINMAX_SEQ:     return ordenarMinMaxSeqI32(vetor, n, opcoes);
+        case ORDENACAO_MINMAX_CONC:    return ordenarMinMaxConcI32(vetor, n, opcoes);
+        case ORDENACAO_CORRIDAS:       return ordenarCorridasI32(vetor, n, opcoes);
+        case ORDENACAO_CONTAGEM:       return ordenarContagemI32(vetor, n, opcoes);
+        case ORDENACAO_APRENDIDA:      return ordenarAprendidaI32(vetor, n, opcoes);
+        case ORDENACAO_DUPLO_PIVO_SEQ:  return ordenarDuploPivoSeqI32(vetor, n, opcoes);
+        case ORDENACAO_DUPLO_PIVO_CONC: return ordenarDuploPivoConcI32(vetor, n, opcoes);
+        case ORDENACAO_MESCLAGEM:      return ordenarMesclagemI32(vetor, n, opcoes);
+        case ORDENACAO_MESCLAGEM_LOCAL: return ordenarMesclagemLocalI32(vetor, n, opcoes);
+        default:                       break;
+    }
+    fprintf(stderr, "Erro: algoritmo de ordenação inválido.\n");
+    return -1;
+}
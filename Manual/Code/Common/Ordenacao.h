@@ -0,0 +1,159 @@
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+#include "EntradaSaida.h"
+#include "Memoria.h"
+#include "PoolThreads.h"
+#include "Preordenacao.h"
+#include "Contagem.h"
+#include "Compactacao.h"
+#include "Aprendida.h"
+#include "Mesclagem.h"
+#include "MesclagemLocal.h"
+#include "OrdenacaoRegistros.h"
+
+/*
+ * API em C da biblioteca libconcsort: os algoritmos de ordenação dos programas (Quicksort
+ * e MinMaxSort, sequenciais e concorrentes) sobre vetores de inteiros de 32 bits em
+ * memória, sem arquivos nem criação de processos.
+ *
+ * Todos os algoritmos têm a mesma assinatura (vetor, n, opções) e podem ser chamados
+ * diretamente ou por ordenarI32, que escolhe o algoritmo pelas opções. Os algoritmos
+ * concorrentes usam um PoolThreads persistente informado nas opções; sem pool, um pool
+ * temporário é criado e destruído na própria chamada.
+ *
+ * Exemplo:
+ *     PoolThreads *pool = criarPoolThreads(8, NULL);
+ *     OpcoesOrdenacao opcoes;
+ *     opcoesOrdenacaoPadrao(&opcoes, ORDENACAO_QUICKSORT_CONC);
+ *     opcoes.pool = pool;
+ *     ordenarI32(vetor, n, &opcoes);   // quantas vezes forem necessárias
+ *     destruirPoolThreads(pool);
+ *
+ * Os programas de ordenação (SeqQuicksort, ConcQuickSort, SeqMinMax e ConcMinMax) são
+ * apenas a leitura dos argumentos e dos arquivos em volta destas funções.
+ *
+ * Com opcoes.preordenacao, ordenarI32 mede antes a pré-ordenação do vetor (ver
+ * Common/Preordenacao.h): um vetor já ordenado retorna imediatamente, um vetor sem subidas
+ * é apenas invertido e um vetor com corridas longas é ordenado pela mesclagem de corridas
+ * naturais; nos demais casos, o algoritmo pedido é usado normalmente.
+ *
+ * Os limites dos Quicksorts (limiteTarefa, limiteInsercao e threadsUteis) valem 0 por
+ * padrão, o que faz cada chamada usar os valores do perfil de ajuste da máquina (ver
+ * Common/Ajuste.h); sem perfil, o comportamento é o original (sem inserção, limite de
+ * tarefa ORDENACAO_LIMITE_TAREFA e todas as threads do pool).
+ *
+ * Com opcoes.compactar, ordenarI32 (depois da pré-ordenação, se pedida) verifica se as
+ * chaves cabem em 8 ou 16 bits depois de subtrair o mínimo e, nesse caso, ordena as chaves
+ * compactadas por radix sort no lugar do algoritmo pedido (ver Common/Compactacao.h).
+ *
+ * Com opcoes.permutacao (argsort), ordenarI32 escreve, além do vetor ordenado, os índices
+ * que o ordenam, com larguraIndice bytes cada. Os algoritmos por comparação trocam apenas
+ * as chaves e não têm como levar os índices junto, então, qualquer que seja o algoritmo
+ * pedido, o argsort usa a ordenação dos pares (chave, índice) de Common/OrdenacaoRegistros.h;
+ * como ela é estável, a permutação é a mesma para todos os algoritmos (índices de chaves
+ * iguais em ordem crescente). A pré-ordenação e a compactação não se aplicam nesse modo.
+ *
+ * ORDENACAO_CONTAGEM ordena por contagem (ver Common/Contagem.h) quando a faixa de valores
+ * é pequena em relação a n; com faixa maior, usa o Quicksort concorrente de dois pivôs
+ * (ou o sequencial, com uma única thread), que não fica quadrático com chaves repetidas.
+ *
+ * ORDENACAO_DUPLO_PIVO_SEQ e ORDENACAO_DUPLO_PIVO_CONC são Quicksorts com a partição de
+ * dois pivôs de Yaroslavskiy (pivôs nos tercis de uma amostra de cinco elementos), que
+ * divide cada parte em três e percorre menos elementos que a partição de um pivô; no
+ * concorrente, as partes esquerda e do meio vão para o pool enquanto houver trabalhadores
+ * livres.
+ *
+ * ORDENACAO_MESCLAGEM é um mergesort paralelo e estável (ver Common/Mesclagem.h), com
+ * tempo O(n log n) qualquer que seja a ordem ou a repetição das chaves.
+ * ORDENACAO_MESCLAGEM_LOCAL é a versão no próprio vetor (ver Common/MesclagemLocal.h), com
+ * buffers de cerca de sqrt(n) elementos em vez de um vetor auxiliar de n; com
+ * opcoes.memoriaExtra, as duas informam o pico de memória extra da ordenação.
+ *
+ * ORDENACAO_APRENDIDA distribui as chaves em baldes por um modelo da CDF ajustado em uma
+ * amostra (ver Common/Aprendida.h); quando o modelo erra demais (distribuições muito
+ * concentradas, por exemplo), usa o Quicksort da mesma forma.
+ */
+
+// Partes menores que isso não são divididas em novas tarefas no Quicksort concorrente
+#define ORDENACAO_LIMITE_TAREFA 4096
+
+// Algoritmos disponíveis
+typedef enum {
+    ORDENACAO_QUICKSORT_SEQ = 0, // Quicksort sequencial (partição de Hoare)
+    ORDENACAO_QUICKSORT_CONC,    // Quicksort concorrente (partição de Lomuto)
+    ORDENACAO_MINMAX_SEQ,        // MinMaxSort sequencial
+    ORDENACAO_MINMAX_CONC,       // MinMaxSort concorrente (segmentos + mesclagem)
+    ORDENACAO_CORRIDAS,          // Mesclagem de corridas naturais (entradas quase ordenadas)
+    ORDENACAO_CONTAGEM,          // Ordenação por contagem (faixa de valores pequena)
+    ORDENACAO_APRENDIDA,         // Distribuição por um modelo da CDF (distribuições suaves)
+    ORDENACAO_DUPLO_PIVO_SEQ,    // Quicksort sequencial com dois pivôs (Yaroslavskiy)
+    ORDENACAO_DUPLO_PIVO_CONC,   // Quicksort concorrente com dois pivôs (três partes por partição)
+    ORDENACAO_MESCLAGEM,         // Mergesort paralelo e estável (blocos bitônicos + caminho de mesclagem)
+    ORDENACAO_MESCLAGEM_LOCAL,   // Mergesort paralelo e estável no próprio vetor (SymMerge, pouca memória)
+    ORDENACAO_NUM_ALGORITMOS
+} AlgoritmoOrdenacao;
+
+// Opções de cada chamada
+typedef struct {
+    AlgoritmoOrdenacao algoritmo;
+    PoolThreads *pool;       // Pool persistente (NULL = pool temporário criado na chamada)
+    int numThreads;          // Threads do pool temporário e segmentos do MinMaxSort (0 = padrão)
+    int *saida;              // Vetor que recebe o resultado (NULL = ordenar o próprio vetor)
+    GravadorVetor *gravador; // Opcional: recebe os trechos já ordenados do vetor de resultado
+    long elementosPorBloco;  // Tamanho dos trechos enviados ao gravador
+    int preordenacao;        // 1 = medir a pré-ordenação e aproveitá-la (só em ordenarI32)
+    MetricasPreordenacao *metricas; // Opcional: recebe as métricas medidas
+    int compactar;           // 1 = ordenar com as chaves compactadas em 8/16 bits, se couberem (só em ordenarI32)
+    MetricasCompactacao *compactacao; // Opcional: recebe a largura e os tempos da compactação
+    long limiteTarefa;       // Quicksort concorrente: partes menores não viram tarefas (0 = perfil)
+    long limiteInsercao;     // Quicksorts: partes com até esse tamanho vão para a inserção (0 = perfil, 1 = nunca)
+    int threadsUteis;        // Quicksort concorrente: threads usadas do pool (0 = perfil, pelo tamanho)
+    long *memoriaExtra;      // Opcional: recebe o pico de memória extra em bytes (mesclagens; -1 nos demais)
+    void *permutacao;        // Opcional: recebe os n índices que ordenam o vetor (argsort, só em ordenarI32)
+    int larguraIndice;       // Bytes de cada índice da permutação (4 ou 8)
+} OpcoesOrdenacao;
+
+// Preenche as opções padrão para o algoritmo
+void opcoesOrdenacaoPadrao(OpcoesOrdenacao *opcoes, AlgoritmoOrdenacao algoritmo);
+
+// Converte o nome do algoritmo ("quicksort-seq", "quicksort-conc", "minmax-seq",
+// "minmax-conc", "corridas", "contagem", "aprendida", "duplo-pivo-seq", "duplo-pivo-conc",
+// "mesclagem" ou "mesclagem-local"); retorna -1 se for inválido
+int algoritmoOrdenacaoDoNome(const char *nome, AlgoritmoOrdenacao *algoritmo);
+
+// Retorna o nome do algoritmo
+const char *nomeAlgoritmoOrdenacao(AlgoritmoOrdenacao algoritmo);
+
+// Ordena os n elementos com o algoritmo das opções; retorna 0 em caso de sucesso.
+// O resultado fica em opcoes->saida (se houver) ou no próprio vetor; no primeiro caso,
+// o conteúdo de vetor também pode ser alterado.
+int ordenarI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+
+// Algoritmos individuais (mesma semântica de ordenarI32)
+int ordenarQuicksortSeqI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarQuicksortConcI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarMinMaxSeqI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarMinMaxConcI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarCorridasI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarContagemI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarAprendidaI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarDuploPivoSeqI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarDuploPivoConcI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarMesclagemI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+int ordenarMesclagemLocalI32(int *vetor, long n, const OpcoesOrdenacao *opcoes);
+
+// Obtém o pool das opções ou, sem pool, cria um temporário com numThreads (ou uma thread
+// por CPU); nesse caso *temporario recebe 1 e o pool deve ser destruído pelo chamador
+PoolThreads *poolDaChamada(const OpcoesOrdenacao *opcoes, int *temporario);
+
+// Blocos básicos compartilhados pelos algoritmos
+void trocar(int *a, int *b);
+long particao(int A[], long lo, long hi);    // Lomuto, pivô do meio; retorna a posição do pivô
+long particionar(int A[], long lo, long hi); // Hoare, pivô do meio; retorna o fim da parte esquerda
+void insercao(int A[], long lo, long hi);    // Inserção na parte [lo, hi] (partes pequenas)
+// Yaroslavskiy, pivôs nos tercis de uma amostra: [lo, *esquerda) < A[*esquerda] <=
+// (*esquerda, *direita) <= A[*direita] < (*direita, hi]; exige lo < hi
+void particaoDuploPivo(int A[], long lo, long hi, long *esquerda, long *direita);
+
+#endif
@@ -0,0 +1,312 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "OrdenacaoCadeias.h"
+#include "Memoria.h"
+
+#define CADEIAS_MAIS_LONGA 8 // Byte baixo da chave das cadeias com mais bytes que o alfabeto
+
+// Cadeia ordenada no lugar da coluna
+typedef struct {
+    uint64_t chave;   // Bytes prof a prof + 6 da cadeia e quantos bytes restam (até 8)
+    uint64_t posicao; // Posição dos bytes da cadeia na coluna (o comprimento fica nos 4 bytes anteriores)
+} ItemCadeia;
+
+// Parâmetros de uma execução da ordenação de cadeias
+typedef struct {
+    PoolThreads *pool;
+    const unsigned char *coluna;
+    ItemCadeia *itens;
+    int maxTarefas; // Tarefas na fila a partir das quais a thread não divide mais
+} ContextoCadeias;
+
+// Faixa [lo, hi) ordenada por uma tarefa
+typedef struct {
+    const ContextoCadeias *contexto;
+    long lo;
+    long hi;
+    size_t profundidade; // Bytes iniciais iguais em todas as cadeias da faixa
+    int recarregar;      // 1 = as chaves ainda estão na profundidade anterior
+} TarefaCadeias;
+
+// Trecho [inicio, fim) dos itens em uma das fases paralelas
+typedef struct {
+    const unsigned char *coluna;
+    ItemCadeia *itens;
+    unsigned char *destino;
+    long inicio;
+    long fim;
+    size_t bytes;        // Bytes das cadeias do trecho (com os comprimentos)
+    size_t deslocamento; // Posição do trecho na coluna de saída
+} TrechoCadeias;
+
+// Compara duas cadeias na ordem lexicográfica dos bytes
+int compararCadeias(const unsigned char *a, uint32_t comprimentoA, const unsigned char *b, uint32_t comprimentoB) {
+    int c = memcmp(a, b, comprimentoA < comprimentoB ? comprimentoA : comprimentoB);
+    if (c != 0) {
+        return c;
+    }
+    return comprimentoA < comprimentoB ? -1 : comprimentoA > comprimentoB;
+}
+
+// Função para ler o comprimento da cadeia que começa em posicao
+static inline uint32_t comprimentoCadeia(const unsigned char *coluna, uint64_t posicao) {
+    uint32_t comprimento;
+    memcpy(&comprimento, coluna + posicao - sizeof(uint32_t), sizeof(uint32_t));
+    return comprimento;
+}
+
+// Função para montar a chave em cache da cadeia na profundidade dada
+static inline uint64_t chaveCadeia(const unsigned char *coluna, uint64_t posicao, size_t profundidade) {
+    uint32_t comprimento = comprimentoCadeia(coluna, posicao);
+    size_t restante = comprimento > profundidade ? comprimento - profundidade : 0;
+    const unsigned char *s = coluna + posicao + profundidade;
+    if (restante >= CADEIAS_MAIS_LONGA) {
+        uint64_t palavra;
+        memcpy(&palavra, s, sizeof(palavra));
+        return (__builtin_bswap64(palavra) & ~(uint64_t)0xFF) | CADEIAS_MAIS_LONGA;
+    }
+
+    uint64_t chave = 0;
+    for (size_t i = 0; i < CADEIAS_ALFABETO; i++) {
+        chave = (chave << 8) | (i < restante ? s[i] : 0);
+    }
+    return (chave << 8) | restante;
+}
+
+// Verifica a coluna de n cadeias
+int validarColunaCadeias(const unsigned char *coluna, size_t bytes, long n) {
+    size_t posicao = 0;
+    for (long i = 0; i < n; i++) {
+        if (bytes - posicao < sizeof(uint32_t)) {
+            return -1;
+        }
+        uint32_t comprimento;
+        memcpy(&comprimento, coluna + posicao, sizeof(uint32_t));
+        posicao += sizeof(uint32_t);
+        if (comprimento > bytes - posicao) {
+            return -1;
+        }
+        posicao += comprimento;
+    }
+    return posicao == bytes ? 0 : -1;
+}
+
+// Função para comparar dois itens que já têm profundidade bytes iguais
+static inline int compararItens(const unsigned char *coluna, const ItemCadeia *a, const ItemCadeia *b,
+                                size_t profundidade) {
+    if (a->chave != b->chave) {
+        return a->chave < b->chave ? -1 : 1;
+    }
+    if ((a->chave & 0xFF) < CADEIAS_MAIS_LONGA) {
+        return 0; // Os bytes restantes cabem na chave e são iguais
+    }
+    profundidade += CADEIAS_ALFABETO;
+    return compararCadeias(coluna + a->posicao + profundidade, comprimentoCadeia(coluna, a->posicao) - profundidade,
+                           coluna + b->posicao + profundidade, comprimentoCadeia(coluna, b->posicao) - profundidade);
+}
+
+// Função para ordenar a faixa [lo, hi) por inserção
+static void insercaoCadeias(const unsigned char *coluna, ItemCadeia *itens, long lo, long hi, size_t profundidade) {
+    for (long i = lo + 1; i < hi; i++) {
+        ItemCadeia item = itens[i];
+        long j = i - 1;
+        while (j >= lo && compararItens(coluna, &itens[j], &item, profundidade) > 0) {
+            itens[j + 1] = itens[j];
+            j--;
+        }
+        itens[j + 1] = item;
+    }
+}
+
+// Função para escolher o pivô pela mediana das chaves do início, do meio e do fim da faixa
+static uint64_t pivoCadeias(const ItemCadeia *itens, long lo, long hi) {
+    uint64_t a = itens[lo].chave, b = itens[lo + (hi - lo) / 2].chave, c = itens[hi - 1].chave;
+    if (a > b) {
+        uint64_t t = a;
+        a = b;
+        b = t;
+    }
+    return c < a ? a : (c > b ? b : c);
+}
+
+static void ordenarFaixaCadeias(const ContextoCadeias *contexto, long lo, long hi, size_t profundidade, int recarregar);
+
+// Função executada pela tarefa que ordena uma das faixas
+static void tarefaCadeias(void *arg) {
+    TarefaCadeias *tarefa = (TarefaCadeias *)arg;
+    ordenarFaixaCadeias(tarefa->contexto, tarefa->lo, tarefa->hi, tarefa->profundidade, tarefa->recarregar);
+}
+
+// Função para saber se uma faixa com o tamanho dado deve virar uma tarefa do pool
+static int criarTarefaCadeias(const ContextoCadeias *contexto, long tamanho) {
+    return tamanho > CADEIAS_LIMITE_TAREFA && tarefasNaFila(contexto->pool) < contexto->maxTarefas;
+}
+
+// Quicksort de múltiplas chaves da faixa [lo, hi), cujas cadeias têm os primeiros
+// profundidade bytes iguais: enquanto houver trabalhadores livres, as faixas menor e igual
+// são entregues ao pool e a maior continua na thread atual
+static void ordenarFaixaCadeias(const ContextoCadeias *contexto, long lo, long hi, size_t profundidade, int recarregar) {
+    const unsigned char *coluna = contexto->coluna;
+    ItemCadeia *itens = contexto->itens;
+    if (recarregar) {
+        for (long i = lo; i < hi; i++) {
+            itens[i].chave = chaveCadeia(coluna, itens[i].posicao, profundidade);
+        }
+    }
+    if (hi - lo <= CADEIAS_LIMITE_INSERCAO) {
+        insercaoCadeias(coluna, itens, lo, hi, profundidade);
+        return;
+    }
+
+    // Partição em três faixas: [lo, lt) menores, [lt, gt) iguais e [gt, hi) maiores que o pivô
+    uint64_t pivo = pivoCadeias(itens, lo, hi);
+    long lt = lo, i = lo, gt = hi;
+    while (i < gt) {
+        uint64_t chave = itens[i].chave;
+        if (chave < pivo) {
+            ItemCadeia t = itens[lt];
+            itens[lt++] = itens[i];
+            itens[i++] = t;
+        } else if (chave > pivo) {
+            ItemCadeia t = itens[--gt];
+            itens[gt] = itens[i];
+            itens[i] = t;
+        } else {
+            i++;
+        }
+    }
+    // Na faixa igual, só as cadeias com mais bytes que a chave continuam, no próximo alfabeto
+    int igual = gt - lt > 1 && (pivo & 0xFF) == CADEIAS_MAIS_LONGA;
+
+    GrupoTarefas grupo;
+    TarefaCadeias menor = { contexto, lo, lt, profundidade, 0 };
+    TarefaCadeias centro = { contexto, lt, gt, profundidade + CADEIAS_ALFABETO, 1 };
+    iniciarGrupoTarefas(&grupo);
+    int menorNoPool = criarTarefaCadeias(contexto, lt - lo);
+    if (menorNoPool) {
+        submeterTarefa(contexto->pool, &grupo, -1, tarefaCadeias, &menor);
+    }
+    int centroNoPool = igual && criarTarefaCadeias(contexto, gt - lt);
+    if (centroNoPool) {
+        submeterTarefa(contexto->pool, &grupo, -1, tarefaCadeias, &centro);
+    }
+
+    ordenarFaixaCadeias(contexto, gt, hi, profundidade, 0);
+    if (!menorNoPool) {
+        ordenarFaixaCadeias(contexto, lo, lt, profundidade, 0);
+    }
+    if (igual && !centroNoPool) {
+        ordenarFaixaCadeias(contexto, lt, gt, profundidade + CADEIAS_ALFABETO, 1);
+    }
+
+    // Aguardar as faixas entregues ao pool (ajudando o pool enquanto isso)
+    if (menorNoPool || centroNoPool) {
+        aguardarGrupoTarefas(contexto->pool, &grupo);
+    }
+}
+
+// Função para montar as chaves iniciais (profundidade 0) das cadeias de um trecho
+static void montarChavesTrecho(void *arg) {
+    TrechoCadeias *t = (TrechoCadeias *)arg;
+    for (long i = t->inicio; i < t->fim; i++) {
+        t->itens[i].chave = chaveCadeia(t->coluna, t->itens[i].posicao, 0);
+    }
+}
+
+// Função para somar os bytes que as cadeias de um trecho ocupam na coluna de saída
+static void medirTrecho(void *arg) {
+    TrechoCadeias *t = (TrechoCadeias *)arg;
+    size_t bytes = 0;
+    for (long i = t->inicio; i < t->fim; i++) {
+        bytes += sizeof(uint32_t) + comprimentoCadeia(t->coluna, t->itens[i].posicao);
+    }
+    t->bytes = bytes;
+}
+
+// Função para copiar as cadeias de um trecho, na ordem dos itens, para a coluna de saída
+static void copiarTrecho(void *arg) {
+    TrechoCadeias *t = (TrechoCadeias *)arg;
+    unsigned char *saida = t->destino + t->deslocamento;
+    for (long i = t->inicio; i < t->fim; i++) {
+        size_t bytes = sizeof(uint32_t) + comprimentoCadeia(t->coluna, t->itens[i].posicao);
+        memcpy(saida, t->coluna + t->itens[i].posicao - sizeof(uint32_t), bytes);
+        saida += bytes;
+    }
+}
+
+// Ordena as n cadeias da coluna de origem e grava a coluna ordenada em destino
+int ordenarCadeias(const unsigned char *origem, unsigned char *destino, size_t bytes, long n,
+                   PoolThreads *pool, int numThreads) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    long numTrechos = numTrechosPool(pool, numThreads, n, CADEIAS_MIN_ELEMENTOS_TRECHO, CADEIAS_MAX_TRECHOS);
+    TrechoCadeias *trechos = (TrechoCadeias *)malloc((size_t)numTrechos * sizeof(TrechoCadeias));
+    ItemCadeia *itens = (ItemCadeia *)obterBufferTemporario((size_t)n * sizeof(ItemCadeia));
+    if (!itens || !trechos) {
+        printf("Erro: Falha na alocação de memória para os itens das cadeias.\n");
+        free(trechos);
+        if (itens) {
+            devolverBufferTemporario(itens);
+        }
+        return -1;
+    }
+
+    // 1. Posições das cadeias (a coluna só pode ser percorrida em ordem)
+    size_t posicao = 0;
+    for (long i = 0; i < n; i++) {
+        uint32_t comprimento;
+        if (bytes - posicao < sizeof(uint32_t)) {
+            posicao = bytes + 1;
+            break;
+        }
+        memcpy(&comprimento, origem + posicao, sizeof(uint32_t));
+        posicao += sizeof(uint32_t);
+        itens[i].posicao = posicao;
+        if (comprimento > bytes - posicao) {
+            posicao = bytes + 1;
+            break;
+        }
+        posicao += comprimento;
+    }
+    if (posicao != bytes) {
+        printf("Erro: A coluna de cadeias não corresponde ao número de cadeias.\n");
+        free(trechos);
+        devolverBufferTemporario(itens);
+        return -1;
+    }
+
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].coluna = origem;
+        trechos[t].itens = itens;
+        trechos[t].destino = destino;
+        trechos[t].inicio = n * t / numTrechos;
+        trechos[t].fim = n * (t + 1) / numTrechos;
+    }
+
+    // 2. Chaves iniciais
+    executarItensPool(pool, montarChavesTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+    // 3. Quicksort de múltiplas chaves; com uma única thread útil, nenhuma tarefa é criada
+    int threads = pool ? numTrabalhadoresPool(pool) : 1;
+    if (numThreads > 0 && numThreads < threads) {
+        threads = numThreads;
+    }
+    ContextoCadeias contexto = { pool, origem, itens, threads > 1 ? threads : 0 };
+    ordenarFaixaCadeias(&contexto, 0, n, 0, 0);
+
+    // 4. Coluna de saída: tamanho de cada trecho, posições por soma de prefixos e cópia
+    executarItensPool(pool, medirTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+    size_t deslocamento = 0;
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].deslocamento = deslocamento;
+        deslocamento += trechos[t].bytes;
+    }
+    executarItensPool(pool, copiarTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+    free(trechos);
+    devolverBufferTemporario(itens);
+    return 0;
+}
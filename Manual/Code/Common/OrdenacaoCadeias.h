@@ -0,0 +1,54 @@
+#ifndef ORDENACAO_CADEIAS_H
+#define ORDENACAO_CADEIAS_H
+
+#include <stdint.h>
+#include "PoolThreads.h"
+
+/*
+ * Ordenação de cadeias de bytes de comprimento variável da biblioteca libconcsort, na
+ * ordem lexicográfica dos bytes sem sinal (como memcmp; uma cadeia que é prefixo de outra
+ * vem antes dela).
+ *
+ * As cadeias ficam em uma coluna com prefixo de comprimento, como no arquivo de cadeias de
+ * Common/EntradaSaida.h: n vezes (uint32 comprimento | bytes), sem preenchimento. A coluna
+ * não é reorganizada durante a ordenação: cada cadeia vira um item de 16 bytes com a sua
+ * posição na coluna e uma chave de 64 bits em cache, e só os itens são trocados de lugar.
+ *
+ * O algoritmo é o quicksort de múltiplas chaves (multikey quicksort, de Bentley e
+ * Sedgewick) sobre um alfabeto de 7 bytes: na profundidade d, a chave em cache guarda os
+ * bytes d a d + 6 da cadeia (em ordem big-endian, completados com zeros) e, no byte baixo,
+ * quantos bytes restam, até 8. Comparar as chaves como inteiros equivale a comparar esses
+ * 7 bytes das cadeias, com a mais curta antes em caso de empate. A partição em três faixas
+ * (menores, iguais e maiores que o pivô) mantém a profundidade nas faixas menor e maior; só
+ * a faixa igual desce para d + 7, e apenas nela as chaves são relidas das cadeias, o que
+ * limita os acessos aleatórios à coluna. Uma faixa igual com menos de 8 bytes restantes
+ * contém cadeias idênticas e não precisa de mais nada. Faixas pequenas são ordenadas por
+ * inserção, comparando as chaves e, no empate, o restante das cadeias.
+ *
+ * A divisão entre as threads segue o Quicksort concorrente: enquanto houver trabalhadores
+ * livres no pool, as faixas menor e igual maiores que CADEIAS_LIMITE_TAREFA viram tarefas, e
+ * a maior continua na thread atual. As chaves iniciais e a coluna de saída (a cópia das
+ * cadeias na nova ordem) são montadas em trechos divididos entre os trabalhadores.
+ */
+
+#define CADEIAS_ALFABETO               7     // Bytes da cadeia em cada chave em cache
+#define CADEIAS_LIMITE_INSERCAO        16    // Faixas com até esse tamanho são ordenadas por inserção
+#define CADEIAS_LIMITE_TAREFA          8192  // Faixas menores não viram tarefas do pool
+#define CADEIAS_MIN_ELEMENTOS_TRECHO   65536 // Cadeias mínimas por trecho das fases paralelas
+#define CADEIAS_MAX_TRECHOS            256
+
+// Compara duas cadeias na ordem lexicográfica dos bytes; retorna um valor negativo, zero ou
+// positivo
+int compararCadeias(const unsigned char *a, uint32_t comprimentoA, const unsigned char *b, uint32_t comprimentoB);
+
+// Verifica a coluna de n cadeias em bytes bytes (cada comprimento deve caber no que resta
+// da coluna, e as cadeias devem ocupá-la inteira); retorna 0 se ela for válida e -1 se não
+int validarColunaCadeias(const unsigned char *coluna, size_t bytes, long n);
+
+// Ordena as n cadeias da coluna de origem (bytes bytes) e grava a coluna ordenada em
+// destino, com o mesmo tamanho (não pode ser a mesma memória); com pool, até numThreads
+// trabalhadores são usados (0 = todos). Retorna 0 em caso de sucesso e -1 em caso de erro.
+int ordenarCadeias(const unsigned char *origem, unsigned char *destino, size_t bytes, long n,
+                   PoolThreads *pool, int numThreads);
+
+#endif
@@ -0,0 +1,601 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "OrdenacaoDistribuida.h"
+#include "Memoria.h"
+
+// Trabalhador e os seus sockets
+typedef struct {
+    int indice;
+    int numProcessos;
+    int numThreads;
+    const char *arquivoEntrada;
+    const char *prefixoSaida;
+    long n;
+    AlgoritmoOrdenacao algoritmo;
+    const ConfiguracaoES *config;
+    int controle;                          // Socket com o coordenador
+    int malha[DISTRIBUIDA_MAX_PROCESSOS];  // Socket com cada trabalhador (-1 no próprio)
+} Trabalhador;
+
+// Trecho [inicio, fim) da fatia na partição
+typedef struct {
+    const int *fatia;
+    int *envio;                            // Fatia reorganizada por balde
+    unsigned char *baldes;                 // Balde de cada elemento
+    const int *separadores;
+    int numProcessos;
+    long inicio;
+    long fim;
+    long contagem[DISTRIBUIDA_MAX_PROCESSOS]; // Elementos por balde e, depois, posição de escrita
+} TrechoParticao;
+
+// Envio dos baldes pela thread de envio
+typedef struct {
+    const Trabalhador *trabalhador;
+    const int *envio;
+    const long *inicioBalde;
+    const long *contagem;
+    int erro;
+} EnvioTroca;
+
+static const char *nomesFases[DISTRIBUIDA_NUM_FASES] = {
+    "leitura", "amostragem", "particao", "contagens", "troca", "ordenacao", "gravacao"
+};
+
+// Retorna o nome da fase
+const char *nomeFaseDistribuida(FaseDistribuida fase) {
+    return fase >= 0 && fase < DISTRIBUIDA_NUM_FASES ? nomesFases[fase] : "?";
+}
+
+// Função para obter o tempo do relógio monotônico em segundos
+static double agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Função para enviar todos os bytes do buffer
+static int enviarTudo(int sock, const void *dados, size_t tamanho) {
+    const char *p = (const char *)dados;
+    while (tamanho > 0) {
+        ssize_t ret = send(sock, p, tamanho, MSG_NOSIGNAL);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            return -1;
+        }
+        p += ret;
+        tamanho -= (size_t)ret;
+    }
+    return 0;
+}
+
+// Função para receber exatamente tamanho bytes; retorna -1 em caso de erro ou se a conexão
+// foi encerrada antes
+static int receberTudo(int sock, void *dados, size_t tamanho) {
+    char *p = (char *)dados;
+    while (tamanho > 0) {
+        ssize_t ret = recv(sock, p, tamanho, 0);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            return -1;
+        }
+        p += ret;
+        tamanho -= (size_t)ret;
+    }
+    return 0;
+}
+
+// Função para comparar dois inteiros (qsort)
+static int compararInteiros(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Função para sortear os índices das amostras (xorshift, com semente própria de cada trabalhador)
+static uint64_t sortear(uint64_t *estado) {
+    uint64_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *estado = x;
+    return x;
+}
+
+// Função para contar os elementos de um trecho em cada balde. O balde b recebe os valores
+// entre os separadores b - 1 e b (inclusive); um valor igual a separadores repetidos pode ir
+// para qualquer um dos baldes entre eles e é distribuído em rodízio.
+static void classificarTrecho(void *arg) {
+    TrechoParticao *t = (TrechoParticao *)arg;
+    int numSeparadores = t->numProcessos - 1;
+    long rodizio = t->inicio;
+    memset(t->contagem, 0, sizeof(t->contagem));
+    for (long i = t->inicio; i < t->fim; i++) {
+        int valor = t->fatia[i];
+
+        // Primeiro separador maior ou igual ao valor e primeiro separador maior que ele
+        int menor = 0, maior = numSeparadores;
+        while (menor < maior) {
+            int meio = (menor + maior) / 2;
+            if (t->separadores[meio] < valor) {
+                menor = meio + 1;
+            } else {
+                maior = meio;
+            }
+        }
+        int balde = menor;
+        if (menor < numSeparadores && t->separadores[menor] == valor) {
+            int ultimo = menor;
+            while (ultimo < numSeparadores && t->separadores[ultimo] == valor) {
+                ultimo++;
+            }
+            balde = menor + (int)(rodizio++ % (ultimo - menor + 1));
+        }
+        t->baldes[i] = (unsigned char)balde;
+        t->contagem[balde]++;
+    }
+}
+
+// Função para copiar os elementos de um trecho para as suas posições em envio
+static void espalharTrecho(void *arg) {
+    TrechoParticao *t = (TrechoParticao *)arg;
+    for (long i = t->inicio; i < t->fim; i++) {
+        t->envio[t->contagem[t->baldes[i]]++] = t->fatia[i];
+    }
+}
+
+// Função executada pela thread de envio: envia cada balde ao seu destino, começando pelo
+// trabalhador seguinte, para que os destinos não recebam todos da mesma origem ao mesmo tempo
+static void *threadEnvio(void *arg) {
+    EnvioTroca *e = (EnvioTroca *)arg;
+    const Trabalhador *t = e->trabalhador;
+    for (int k = 1; k < t->numProcessos && !e->erro; k++) {
+        int destino = (t->indice + k) % t->numProcessos;
+        size_t bytes = (size_t)e->contagem[destino] * sizeof(int);
+        if (bytes > 0 && enviarTudo(t->malha[destino], e->envio + e->inicioBalde[destino], bytes) != 0) {
+            e->erro = errno ? errno : EPIPE;
+        }
+    }
+    return NULL;
+}
+
+// Função para receber, ao mesmo tempo, os baldes de todas as origens em suas posições de
+// destino; retorna 0 em caso de sucesso
+static int receberBaldes(const Trabalhador *t, int *destino, const long *inicioOrigem, const long *quantidade) {
+    struct pollfd fds[DISTRIBUIDA_MAX_PROCESSOS];
+    size_t recebidos[DISTRIBUIDA_MAX_PROCESSOS] = {0};
+    int pendentes = 0;
+    for (int s = 0; s < t->numProcessos; s++) {
+        int espera = s != t->indice && quantidade[s] > 0;
+        fds[s].fd = espera ? t->malha[s] : -1; // poll ignora descritores negativos
+        fds[s].events = POLLIN;
+        pendentes += espera;
+    }
+
+    while (pendentes > 0) {
+        if (poll(fds, (nfds_t)t->numProcessos, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        for (int s = 0; s < t->numProcessos; s++) {
+            if (fds[s].fd < 0 || fds[s].revents == 0) {
+                continue;
+            }
+            size_t total = (size_t)quantidade[s] * sizeof(int);
+            ssize_t ret = recv(fds[s].fd, (char *)(destino + inicioOrigem[s]) + recebidos[s], total - recebidos[s], 0);
+            if (ret < 0 && (errno == EINTR || errno == EAGAIN)) {
+                continue;
+            }
+            if (ret <= 0) {
+                return -1; // Erro ou origem encerrada antes de enviar o balde inteiro
+            }
+            recebidos[s] += (size_t)ret;
+            if (recebidos[s] == total) {
+                fds[s].fd = -1;
+                pendentes--;
+            }
+        }
+    }
+    return 0;
+}
+
+// Função executada por um trabalhador; retorna o código de saída do processo
+static int executarTrabalhador(const Trabalhador *t) {
+    RelatorioTrabalhador relatorio;
+    memset(&relatorio, 0, sizeof(relatorio));
+    int P = t->numProcessos, r = t->indice;
+    long inicio = t->n * r / P;
+    long quantidade = t->n * (r + 1) / P - inicio;
+    relatorio.entrada = quantidade;
+
+    PoolThreads *pool = criarPoolThreads(t->numThreads, NULL);
+    int *fatia = (int *)alocarBuffer((size_t)(quantidade > 0 ? quantidade : 1) * sizeof(int));
+    if (!pool || !fatia) {
+        printf("Erro: Processo %d: falha ao criar o pool ou alocar a fatia.\n", r);
+        return 1;
+    }
+
+    // 1. Leitura da fatia
+    double marca = agora();
+    if (quantidade > 0 && lerTrechoVetorArquivo(t->arquivoEntrada, fatia, inicio, quantidade, t->config) != 0) {
+        return 1;
+    }
+    relatorio.tempo[DISTRIBUIDA_LEITURA] = agora() - marca;
+
+    // 2. Amostragem: a amostra vai ao coordenador, que devolve os separadores
+    marca = agora();
+    int amostras[DISTRIBUIDA_AMOSTRAS];
+    long numAmostras = quantidade < DISTRIBUIDA_AMOSTRAS ? quantidade : DISTRIBUIDA_AMOSTRAS;
+    uint64_t estado = 0x9E3779B97F4A7C15ull * (uint64_t)(r + 1);
+    for (long i = 0; i < numAmostras; i++) {
+        amostras[i] = fatia[sortear(&estado) % (uint64_t)quantidade];
+    }
+    int separadores[DISTRIBUIDA_MAX_PROCESSOS];
+    if (enviarTudo(t->controle, &numAmostras, sizeof(numAmostras)) != 0 ||
+        enviarTudo(t->controle, amostras, (size_t)numAmostras * sizeof(int)) != 0 ||
+        receberTudo(t->controle, separadores, (size_t)(P - 1) * sizeof(int)) != 0) {
+        printf("Erro: Processo %d: falha na comunicação com o coordenador.\n", r);
+        return 1;
+    }
+    relatorio.bytesEnviados[DISTRIBUIDA_AMOSTRAGEM] = sizeof(numAmostras) + numAmostras * sizeof(int);
+    relatorio.bytesRecebidos[DISTRIBUIDA_AMOSTRAGEM] = (P - 1) * sizeof(int);
+    relatorio.tempo[DISTRIBUIDA_AMOSTRAGEM] = agora() - marca;
+
+    // 3. Partição da fatia em baldes, nos trechos do pool
+    marca = agora();
+    long numTrechos = numTrechosPool(pool, 0, quantidade, DISTRIBUIDA_MIN_ELEMENTOS_TRECHO, DISTRIBUIDA_MAX_TRECHOS);
+    TrechoParticao *trechos = (TrechoParticao *)malloc((size_t)numTrechos * sizeof(TrechoParticao));
+    int *envio = (int *)alocarBuffer((size_t)(quantidade > 0 ? quantidade : 1) * sizeof(int));
+    unsigned char *baldes = (unsigned char *)malloc((size_t)(quantidade > 0 ? quantidade : 1));
+    if (!trechos || !envio || !baldes) {
+        printf("Erro: Processo %d: falha na alocação de memória para a partição.\n", r);
+        return 1;
+    }
+    for (long i = 0; i < numTrechos; i++) {
+        trechos[i].fatia = fatia;
+        trechos[i].envio = envio;
+        trechos[i].baldes = baldes;
+        trechos[i].separadores = separadores;
+        trechos[i].numProcessos = P;
+        trechos[i].inicio = quantidade * i / numTrechos;
+        trechos[i].fim = quantidade * (i + 1) / numTrechos;
+    }
+    executarItensPool(pool, classificarTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+    // Posição de cada balde em envio e, dentro do balde, de cada trecho
+    long contagem[DISTRIBUIDA_MAX_PROCESSOS], inicioBalde[DISTRIBUIDA_MAX_PROCESSOS];
+    long posicao = 0;
+    for (int b = 0; b < P; b++) {
+        inicioBalde[b] = posicao;
+        for (long i = 0; i < numTrechos; i++) {
+            long c = trechos[i].contagem[b];
+            trechos[i].contagem[b] = posicao;
+            posicao += c;
+        }
+        contagem[b] = posicao - inicioBalde[b];
+    }
+    executarItensPool(pool, espalharTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+    free(trechos);
+    free(baldes);
+    liberarBuffer(fatia);
+    relatorio.tempo[DISTRIBUIDA_PARTICAO] = agora() - marca;
+
+    // 4. Contagens: o coordenador devolve quantos elementos virão de cada origem
+    marca = agora();
+    long chegada[DISTRIBUIDA_MAX_PROCESSOS], inicioOrigem[DISTRIBUIDA_MAX_PROCESSOS];
+    if (enviarTudo(t->controle, contagem, (size_t)P * sizeof(long)) != 0 ||
+        receberTudo(t->controle, chegada, (size_t)P * sizeof(long)) != 0) {
+        printf("Erro: Processo %d: falha na comunicação com o coordenador.\n", r);
+        return 1;
+    }
+    long total = 0;
+    for (int s = 0; s < P; s++) {
+        inicioOrigem[s] = total;
+        total += chegada[s];
+    }
+    relatorio.bytesEnviados[DISTRIBUIDA_CONTAGENS] = P * sizeof(long);
+    relatorio.bytesRecebidos[DISTRIBUIDA_CONTAGENS] = P * sizeof(long);
+    relatorio.tempo[DISTRIBUIDA_CONTAGENS] = agora() - marca;
+
+    int *vetor = (int *)alocarBuffer((size_t)(total > 0 ? total : 1) * sizeof(int));
+    if (!vetor) {
+        printf("Erro: Processo %d: falha na alocação de memória para o fragmento.\n", r);
+        return 1;
+    }
+
+    // 5. Troca: o próprio balde é copiado; os demais são enviados por uma thread enquanto
+    // esta recebe os das outras origens
+    marca = agora();
+    memcpy(vetor + inicioOrigem[r], envio + inicioBalde[r], (size_t)contagem[r] * sizeof(int));
+    EnvioTroca troca = { t, envio, inicioBalde, contagem, 0 };
+    pthread_t enviador;
+    if (pthread_create(&enviador, NULL, threadEnvio, &troca) != 0) {
+        printf("Erro: Processo %d: falha ao criar a thread de envio.\n", r);
+        return 1;
+    }
+    int erro = receberBaldes(t, vetor, inicioOrigem, chegada);
+    pthread_join(enviador, NULL);
+    if (erro != 0 || troca.erro != 0) {
+        printf("Erro: Processo %d: falha na troca de chaves (%s).\n", r,
+               strerror(troca.erro ? troca.erro : (errno ? errno : EPIPE)));
+        return 1;
+    }
+    liberarBuffer(envio);
+    relatorio.bytesEnviados[DISTRIBUIDA_TROCA] = (long long)(quantidade - contagem[r]) * sizeof(int);
+    relatorio.bytesRecebidos[DISTRIBUIDA_TROCA] = (long long)(total - chegada[r]) * sizeof(int);
+    relatorio.tempo[DISTRIBUIDA_TROCA] = agora() - marca;
+
+    // 6. Ordenação local
+    marca = agora();
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, t->algoritmo);
+    opcoes.pool = pool;
+    if (ordenarI32(vetor, total, &opcoes) != 0) {
+        return 1;
+    }
+    relatorio.tempo[DISTRIBUIDA_ORDENACAO] = agora() - marca;
+    destruirPoolThreads(pool);
+
+    // 7. Gravação do fragmento
+    marca = agora();
+    char nome[4096];
+    snprintf(nome, sizeof(nome), "%s.%d", t->prefixoSaida, r);
+    if (gravarVetorArquivo(nome, vetor, (int)total, t->config) != 0) {
+        return 1;
+    }
+    relatorio.tempo[DISTRIBUIDA_GRAVACAO] = agora() - marca;
+    relatorio.saida = total;
+    if (total > 0) {
+        relatorio.primeiro = vetor[0];
+        relatorio.ultimo = vetor[total - 1];
+    }
+    liberarBuffer(vetor);
+
+    if (enviarTudo(t->controle, &relatorio, sizeof(relatorio)) != 0) {
+        printf("Erro: Processo %d: falha ao enviar o relatório.\n", r);
+        return 1;
+    }
+    return 0;
+}
+
+// Função para coordenar as fases de amostragem e de contagens e coletar os relatórios;
+// retorna 0 em caso de sucesso
+static int coordenar(const int *controle, int P, EstatisticasDistribuida *estatisticas) {
+    // Amostra global e separadores nos quantis
+    int *amostra = (int *)malloc((size_t)P * DISTRIBUIDA_AMOSTRAS * sizeof(int));
+    if (!amostra) {
+        printf("Erro: Falha na alocação de memória para a amostra.\n");
+        return -1;
+    }
+    long tamanhoAmostra = 0;
+    for (int r = 0; r < P; r++) {
+        long numAmostras;
+        if (receberTudo(controle[r], &numAmostras, sizeof(numAmostras)) != 0 || numAmostras < 0 ||
+            numAmostras > DISTRIBUIDA_AMOSTRAS ||
+            receberTudo(controle[r], amostra + tamanhoAmostra, (size_t)numAmostras * sizeof(int)) != 0) {
+            free(amostra);
+            return -1;
+        }
+        tamanhoAmostra += numAmostras;
+    }
+    qsort(amostra, (size_t)tamanhoAmostra, sizeof(int), compararInteiros);
+    int separadores[DISTRIBUIDA_MAX_PROCESSOS];
+    for (int k = 1; k < P; k++) {
+        separadores[k - 1] = tamanhoAmostra > 0 ? amostra[tamanhoAmostra * k / P] : 0;
+    }
+    free(amostra);
+    for (int r = 0; r < P; r++) {
+        if (enviarTudo(controle[r], separadores, (size_t)(P - 1) * sizeof(int)) != 0) {
+            return -1;
+        }
+    }
+
+    // Contagens: a linha r diz quantos elementos o trabalhador r envia a cada destino
+    long contagens[DISTRIBUIDA_MAX_PROCESSOS][DISTRIBUIDA_MAX_PROCESSOS];
+    for (int r = 0; r < P; r++) {
+        if (receberTudo(controle[r], contagens[r], (size_t)P * sizeof(long)) != 0) {
+            return -1;
+        }
+    }
+    for (int d = 0; d < P; d++) {
+        long chegada[DISTRIBUIDA_MAX_PROCESSOS];
+        for (int s = 0; s < P; s++) {
+            chegada[s] = contagens[s][d];
+        }
+        if (enviarTudo(controle[d], chegada, (size_t)P * sizeof(long)) != 0) {
+            return -1;
+        }
+    }
+
+    for (int r = 0; r < P; r++) {
+        if (receberTudo(controle[r], &estatisticas->trabalhadores[r], sizeof(RelatorioTrabalhador)) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Ordena o arquivo com numProcessos trabalhadores e grava os fragmentos
+int ordenarDistribuido(const char *arquivoEntrada, const char *prefixoSaida, int numProcessos, int numThreads,
+                       AlgoritmoOrdenacao algoritmo, const ConfiguracaoES *config, EstatisticasDistribuida *estatisticas) {
+    if (numProcessos < 1 || numProcessos > DISTRIBUIDA_MAX_PROCESSOS || numThreads < 1) {
+        printf("Erro: O número de processos deve estar entre 1 e %d e o de threads deve ser positivo.\n",
+               DISTRIBUIDA_MAX_PROCESSOS);
+        return -1;
+    }
+    int n;
+    if (lerTamanhoArquivo(arquivoEntrada, &n) != 0) {
+        return -1;
+    }
+
+    EstatisticasDistribuida local;
+    if (!estatisticas) {
+        estatisticas = &local;
+    }
+    memset(estatisticas, 0, sizeof(*estatisticas));
+    estatisticas->numProcessos = numProcessos;
+    estatisticas->n = n;
+
+    // Sockets de controle (coordenador no lado 0) e malha entre os trabalhadores
+    int P = numProcessos;
+    int controle[DISTRIBUIDA_MAX_PROCESSOS][2];
+    int malha[DISTRIBUIDA_MAX_PROCESSOS][DISTRIBUIDA_MAX_PROCESSOS];
+    int abertos = 1;
+    for (int i = 0; i < P; i++) {
+        controle[i][0] = controle[i][1] = -1;
+        for (int j = 0; j < P; j++) {
+            malha[i][j] = -1;
+        }
+    }
+    for (int i = 0; i < P && abertos; i++) {
+        abertos = socketpair(AF_UNIX, SOCK_STREAM, 0, controle[i]) == 0;
+        for (int j = i + 1; j < P && abertos; j++) {
+            int par[2];
+            abertos = socketpair(AF_UNIX, SOCK_STREAM, 0, par) == 0;
+            if (abertos) {
+                int tamanho = DISTRIBUIDA_BUFFER_SOCKET;
+                for (int k = 0; k < 2; k++) {
+                    setsockopt(par[k], SOL_SOCKET, SO_SNDBUF, &tamanho, sizeof(tamanho));
+                    setsockopt(par[k], SOL_SOCKET, SO_RCVBUF, &tamanho, sizeof(tamanho));
+                }
+                malha[i][j] = par[0];
+                malha[j][i] = par[1];
+            }
+        }
+    }
+
+    pid_t processos[DISTRIBUIDA_MAX_PROCESSOS];
+    int criados = 0;
+    double inicio = agora();
+    if (!abertos) {
+        printf("Erro: Falha ao criar os sockets dos trabalhadores (%s).\n", strerror(errno));
+    } else {
+        // A saída pendente não deve ser repetida pelos trabalhadores
+        fflush(stdout);
+        fflush(stderr);
+        for (; criados < P; criados++) {
+            pid_t pid = fork();
+            if (pid < 0) {
+                printf("Erro: Falha ao criar o processo %d (%s).\n", criados, strerror(errno));
+                break;
+            }
+            if (pid == 0) {
+                // Trabalhador: fechar os sockets que pertencem aos outros
+                Trabalhador t = { criados, P, numThreads, arquivoEntrada, prefixoSaida, n, algoritmo, config,
+                                  controle[criados][1], {0} };
+                for (int i = 0; i < P; i++) {
+                    close(controle[i][0]);
+                    if (i != criados) {
+                        close(controle[i][1]);
+                    }
+                    for (int j = 0; j < P; j++) {
+                        if (i != criados && malha[i][j] >= 0) {
+                            close(malha[i][j]);
+                        }
+                    }
+                    t.malha[i] = malha[criados][i];
+                }
+                int codigo = executarTrabalhador(&t);
+                fflush(stdout);
+                _exit(codigo);
+            }
+            processos[criados] = pid;
+        }
+    }
+
+    // Coordenador: os lados dos trabalhadores e a malha só são usados por eles
+    int ladoCoordenador[DISTRIBUIDA_MAX_PROCESSOS];
+    for (int i = 0; i < P; i++) {
+        ladoCoordenador[i] = controle[i][0];
+        if (controle[i][1] >= 0) {
+            close(controle[i][1]);
+        }
+        for (int j = 0; j < P; j++) {
+            if (malha[i][j] >= 0) {
+                close(malha[i][j]);
+            }
+        }
+    }
+
+    int erro = criados < P || coordenar(ladoCoordenador, P, estatisticas) != 0;
+    if (erro) {
+        // Um trabalhador parou no meio: os demais não terminariam a troca
+        for (int i = 0; i < criados; i++) {
+            kill(processos[i], SIGKILL);
+        }
+    }
+    for (int i = 0; i < P; i++) {
+        if (ladoCoordenador[i] >= 0) {
+            close(ladoCoordenador[i]);
+        }
+    }
+    for (int i = 0; i < criados; i++) {
+        int status;
+        while (waitpid(processos[i], &status, 0) < 0 && errno == EINTR) {
+        }
+        if (!erro && !(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+            erro = 1;
+        }
+    }
+    estatisticas->tempoTotal = agora() - inicio;
+
+    if (erro) {
+        printf("Erro: A ordenação distribuída não foi concluída.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Imprime o resumo de uma ordenação distribuída
+void imprimirEstatisticasDistribuida(FILE *saida, const EstatisticasDistribuida *estatisticas) {
+    int P = estatisticas->numProcessos;
+    fprintf(saida, "%-12s %12s %16s %16s\n", "Fase", "Tempo (s)", "Enviado (bytes)", "Recebido (bytes)");
+    for (int f = 0; f < DISTRIBUIDA_NUM_FASES; f++) {
+        double tempo = 0;
+        long long enviados = 0, recebidos = 0;
+        for (int r = 0; r < P; r++) {
+            const RelatorioTrabalhador *t = &estatisticas->trabalhadores[r];
+            tempo = t->tempo[f] > tempo ? t->tempo[f] : tempo;
+            enviados += t->bytesEnviados[f];
+            recebidos += t->bytesRecebidos[f];
+        }
+        fprintf(saida, "%-12s %12.6f %16lld %16lld\n", nomeFaseDistribuida((FaseDistribuida)f), tempo, enviados,
+                recebidos);
+    }
+
+    fprintf(saida, "%-10s %12s %12s %12s %13s\n", "Fragmento", "Lidos", "Gravados", "Primeiro", "Último");
+    long maior = 0;
+    int emOrdem = 1, temAnterior = 0, anterior = 0;
+    for (int r = 0; r < P; r++) {
+        const RelatorioTrabalhador *t = &estatisticas->trabalhadores[r];
+        if (t->saida > 0) {
+            fprintf(saida, "%-10d %12ld %12ld %12d %12d\n", r, t->entrada, t->saida, t->primeiro, t->ultimo);
+            emOrdem = emOrdem && (!temAnterior || anterior <= t->primeiro);
+            anterior = t->ultimo;
+            temAnterior = 1;
+        } else {
+            fprintf(saida, "%-10d %12ld %12ld %12s %12s\n", r, t->entrada, t->saida, "-", "-");
+        }
+        maior = t->saida > maior ? t->saida : maior;
+    }
+    if (estatisticas->n > 0) {
+        fprintf(saida, "Desequilíbrio (maior fragmento / média): %.3f\n", (double)maior * P / estatisticas->n);
+    }
+    fprintf(saida, "Fragmentos em ordem entre si: %s\n", emOrdem ? "sim" : "não");
+}
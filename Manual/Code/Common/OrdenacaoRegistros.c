@@ -0,0 +1,370 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "OrdenacaoRegistros.h"
+#include "Memoria.h"
+
+#define REGISTROS_DIGITOS 256 // Valores de um dígito de 8 bits
+
+// Par ordenado no lugar do registro
+typedef struct {
+    uint64_t chave; // Chave sem sinal, na mesma ordem da chave original
+    uint64_t valor; // Carga (até REGISTROS_CARGA_NO_PAR bytes) ou posição na origem
+} ParRegistro;
+
+// Chaves e cargas dos registros: o registro i tem a chave em chaves + i * passoChave e a
+// carga em cargas + i * passoCarga (AoS: os dois passos são o tamanho do registro)
+typedef struct {
+    unsigned char *chaves;
+    size_t passoChave;
+    const unsigned char *cargas;
+    size_t passoCarga;
+} ColunasRegistros;
+
+// Trecho [inicio, fim) dos registros em uma das fases
+typedef struct {
+    const ColunasRegistros *origem;
+    const ColunasRegistros *destino;
+    int larguraChave;
+    int larguraCarga;
+    int larguraIndice;         // Argsort: largura dos índices escritos no destino (0 = registros)
+    EstrategiaRegistros estrategia;
+    ParRegistro *pares;        // Pares lidos na passada
+    ParRegistro *saida;        // Pares escritos na passada
+    int deslocamento;          // Bits à direita do dígito da passada
+    long inicio;
+    long fim;
+    long contagem[REGISTROS_DIGITOS];
+} TrechoRegistros;
+
+// Retorna a estratégia usada para cargas de larguraCarga bytes
+EstrategiaRegistros estrategiaRegistros(int larguraCarga) {
+    return larguraCarga <= REGISTROS_CARGA_NO_PAR ? REGISTROS_CARGA : REGISTROS_INDICES;
+}
+
+// Retorna o nome da estratégia
+const char *nomeEstrategiaRegistros(EstrategiaRegistros estrategia) {
+    return estrategia == REGISTROS_CARGA ? "carga" : "indices";
+}
+
+// Função para empacotar os registros de um trecho em pares (o bit de sinal invertido deixa
+// as chaves negativas antes das positivas na ordem sem sinal)
+static void empacotarTrecho(void *arg) {
+    TrechoRegistros *t = (TrechoRegistros *)arg;
+    const ColunasRegistros *c = t->origem;
+    for (long i = t->inicio; i < t->fim; i++) {
+        ParRegistro *par = &t->pares[i];
+        if (t->larguraChave == 4) {
+            int32_t chave;
+            memcpy(&chave, c->chaves + i * c->passoChave, sizeof(chave));
+            par->chave = (uint32_t)chave ^ 0x80000000u;
+        } else {
+            int64_t chave;
+            memcpy(&chave, c->chaves + i * c->passoChave, sizeof(chave));
+            par->chave = (uint64_t)chave ^ 0x8000000000000000ull;
+        }
+        if (t->estrategia == REGISTROS_CARGA) {
+            par->valor = 0;
+            memcpy(&par->valor, c->cargas + i * c->passoCarga, (size_t)t->larguraCarga);
+        } else {
+            par->valor = (uint64_t)i;
+        }
+    }
+}
+
+// Função para contar os dígitos da passada em um trecho
+static void contarDigitosRegistros(void *arg) {
+    TrechoRegistros *t = (TrechoRegistros *)arg;
+    memset(t->contagem, 0, sizeof(t->contagem));
+    for (long i = t->inicio; i < t->fim; i++) {
+        t->contagem[(t->pares[i].chave >> t->deslocamento) & 0xFF]++;
+    }
+}
+
+// Função para espalhar os pares de um trecho nas posições dos seus dígitos (estável)
+static void espalharRegistros(void *arg) {
+    TrechoRegistros *t = (TrechoRegistros *)arg;
+    for (long i = t->inicio; i < t->fim; i++) {
+        t->saida[t->contagem[(t->pares[i].chave >> t->deslocamento) & 0xFF]++] = t->pares[i];
+    }
+}
+
+// Função para escrever as chaves e as cargas de um trecho do destino a partir dos pares
+// ordenados (com índices, a carga é copiada da posição original na origem; no argsort, os
+// próprios índices são a carga do destino e as chaves só são escritas se houver destino)
+static void desempacotarTrecho(void *arg) {
+    TrechoRegistros *t = (TrechoRegistros *)arg;
+    const ColunasRegistros *o = t->origem;
+    const ColunasRegistros *d = t->destino;
+    unsigned char *cargas = (unsigned char *)d->cargas;
+    for (long i = t->inicio; i < t->fim; i++) {
+        const ParRegistro *par = &t->pares[i];
+        if (t->larguraIndice == 4) {
+            uint32_t indice = (uint32_t)par->valor;
+            memcpy(cargas + i * d->passoCarga, &indice, sizeof(indice));
+        } else if (t->larguraIndice == 8) {
+            memcpy(cargas + i * d->passoCarga, &par->valor, sizeof(par->valor));
+        }
+        if (!d->chaves) {
+            continue;
+        }
+        if (t->larguraChave == 4) {
+            int32_t chave = (int32_t)(uint32_t)(par->chave ^ 0x80000000u);
+            memcpy(d->chaves + i * d->passoChave, &chave, sizeof(chave));
+        } else {
+            int64_t chave = (int64_t)(par->chave ^ 0x8000000000000000ull);
+            memcpy(d->chaves + i * d->passoChave, &chave, sizeof(chave));
+        }
+        if (t->larguraIndice > 0) {
+            continue;
+        }
+        if (t->estrategia == REGISTROS_CARGA) {
+            memcpy(cargas + i * d->passoCarga, &par->valor, (size_t)t->larguraCarga);
+        } else {
+            memcpy(cargas + i * d->passoCarga, o->cargas + par->valor * o->passoCarga, (size_t)t->larguraCarga);
+        }
+    }
+}
+
+// Função para ordenar os registros das colunas de origem nas de destino (com larguraIndice,
+// o destino recebe os índices dos pares no lugar das cargas)
+static int ordenarColunasRegistros(ColunasRegistros *origem, const ColunasRegistros *destino, long n,
+                                   int larguraChave, int larguraCarga, int larguraIndice, PoolThreads *pool,
+                                   int numThreads) {
+    if (larguraChave != 4 && larguraChave != 8) {
+        printf("Erro: A chave dos registros deve ter 4 ou 8 bytes.\n");
+        return -1;
+    }
+    if (larguraCarga < 0) {
+        printf("Erro: Largura de carga inválida.\n");
+        return -1;
+    }
+    if (n <= 0) {
+        return 0;
+    }
+
+    EstrategiaRegistros estrategia = larguraIndice > 0 ? REGISTROS_INDICES : estrategiaRegistros(larguraCarga);
+    long numTrechos = numTrechosPool(pool, numThreads, n, REGISTROS_MIN_ELEMENTOS_TRECHO, REGISTROS_MAX_TRECHOS);
+    TrechoRegistros *trechos = (TrechoRegistros *)malloc((size_t)numTrechos * sizeof(TrechoRegistros));
+    ParRegistro *pares = (ParRegistro *)obterBufferTemporario((size_t)n * sizeof(ParRegistro));
+    ParRegistro *auxiliar = (ParRegistro *)obterBufferTemporario((size_t)n * sizeof(ParRegistro));
+    if (!pares || !auxiliar || !trechos) {
+        printf("Erro: Falha na alocação de memória para os pares dos registros.\n");
+        free(trechos);
+        if (pares) {
+            devolverBufferTemporario(pares);
+        }
+        if (auxiliar) {
+            devolverBufferTemporario(auxiliar);
+        }
+        return -1;
+    }
+
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].origem = origem;
+        trechos[t].destino = destino;
+        trechos[t].larguraChave = larguraChave;
+        trechos[t].larguraCarga = larguraCarga;
+        trechos[t].larguraIndice = larguraIndice;
+        trechos[t].estrategia = estrategia;
+        trechos[t].pares = pares;
+        trechos[t].inicio = n * t / numTrechos;
+        trechos[t].fim = n * (t + 1) / numTrechos;
+    }
+
+    // 1. Empacotamento
+    executarItensPool(pool, empacotarTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+    // 2. Passadas do radix sort, da menor para a maior ordem do dígito
+    for (int deslocamento = 0; deslocamento < 8 * larguraChave; deslocamento += 8) {
+        for (long t = 0; t < numTrechos; t++) {
+            trechos[t].pares = pares;
+            trechos[t].saida = auxiliar;
+            trechos[t].deslocamento = deslocamento;
+        }
+        executarItensPool(pool, contarDigitosRegistros, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+        // Posição inicial de cada dígito em cada trecho: dígitos em ordem e, dentro de cada
+        // dígito, os trechos em ordem (o que mantém a passada estável)
+        long posicao = 0;
+        int dispensada = 0;
+        for (int d = 0; d < REGISTROS_DIGITOS && !dispensada; d++) {
+            long total = 0;
+            for (long t = 0; t < numTrechos; t++) {
+                long quantidade = trechos[t].contagem[d];
+                trechos[t].contagem[d] = posicao;
+                posicao += quantidade;
+                total += quantidade;
+            }
+            dispensada = total == n;
+        }
+        if (dispensada) {
+            continue;
+        }
+
+        executarItensPool(pool, espalharRegistros, trechos, sizeof(trechos[0]), (int)numTrechos);
+        ParRegistro *temp = pares;
+        pares = auxiliar;
+        auxiliar = temp;
+    }
+
+    // 3. Desempacotamento; com índices e a carga no próprio lugar, a carga de origem é
+    // copiada antes de ser sobrescrita
+    unsigned char *copia = NULL;
+    if (estrategia == REGISTROS_INDICES && larguraIndice == 0 && origem->cargas == destino->cargas) {
+        size_t bytes = (size_t)(n - 1) * origem->passoCarga + (size_t)larguraCarga;
+        copia = (unsigned char *)obterBufferTemporario(bytes);
+        if (!copia) {
+            printf("Erro: Falha na alocação de memória para a carga dos registros.\n");
+            free(trechos);
+            devolverBufferTemporario(pares);
+            devolverBufferTemporario(auxiliar);
+            return -1;
+        }
+        memcpy(copia, origem->cargas, bytes);
+        origem->cargas = copia;
+    }
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].pares = pares;
+    }
+    executarItensPool(pool, desempacotarTrecho, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+    if (copia) {
+        devolverBufferTemporario(copia);
+    }
+    free(trechos);
+    devolverBufferTemporario(pares);
+    devolverBufferTemporario(auxiliar);
+    return 0;
+}
+
+// Ordena os registros AoS de origem em destino pela chave
+int ordenarRegistros(const void *origem, void *destino, long n, int larguraChave, int larguraCarga,
+                     PoolThreads *pool, int numThreads) {
+    size_t largura = (size_t)(larguraChave + larguraCarga);
+    ColunasRegistros colunasOrigem = { (unsigned char *)origem, largura,
+                                       (const unsigned char *)origem + larguraChave, largura };
+    ColunasRegistros colunasDestino = { (unsigned char *)destino, largura,
+                                        (const unsigned char *)destino + larguraChave, largura };
+    return ordenarColunasRegistros(&colunasOrigem, &colunasDestino, n, larguraChave, larguraCarga, 0, pool,
+                                   numThreads);
+}
+
+// Ordena as colunas SoA pela chave, nos próprios vetores
+int ordenarColunas(void *chaves, void *cargas, long n, int larguraChave, int larguraCarga,
+                   PoolThreads *pool, int numThreads) {
+    ColunasRegistros colunas = { (unsigned char *)chaves, (size_t)larguraChave,
+                                 (const unsigned char *)cargas, (size_t)larguraCarga };
+    ColunasRegistros destino = colunas;
+    return ordenarColunasRegistros(&colunas, &destino, n, larguraChave, larguraCarga, 0, pool, numThreads);
+}
+
+// Calcula os índices que ordenam as n chaves (argsort estável)
+int argsortChaves(const void *chaves, long n, int larguraChave, void *indices, int larguraIndice,
+                  void *ordenadas, PoolThreads *pool, int numThreads) {
+    if (larguraIndice != 4 && larguraIndice != 8) {
+        printf("Erro: Os índices devem ter 4 ou 8 bytes.\n");
+        return -1;
+    }
+    if (larguraIndice == 4 && n > 4294967296L) {
+        printf("Erro: %ld elementos não cabem em índices de 32 bits.\n", n);
+        return -1;
+    }
+    ColunasRegistros origem = { (unsigned char *)chaves, (size_t)larguraChave, NULL, 0 };
+    ColunasRegistros destino = { (unsigned char *)ordenadas, (size_t)larguraChave, (const unsigned char *)indices,
+                                 (size_t)larguraIndice };
+    return ordenarColunasRegistros(&origem, &destino, n, larguraChave, 0, larguraIndice, pool, numThreads);
+}
+
+// Trecho [inicio, fim) da aplicação de uma permutação
+typedef struct {
+    const unsigned char *origem;
+    unsigned char *destino;
+    const unsigned char *indices;
+    int largura;
+    int larguraIndice;
+    long n;
+    long inicio;
+    long fim;
+    int invalido;              // 1 se algum índice do trecho estiver fora de [0, n)
+} TrechoPermutacao;
+
+// Função para copiar para cada posição do trecho o elemento da origem indicado pelo índice
+static void aplicarTrechoPermutacao(void *arg) {
+    TrechoPermutacao *t = (TrechoPermutacao *)arg;
+    size_t largura = (size_t)t->largura;
+    for (long i = t->inicio; i < t->fim; i++) {
+        uint64_t indice;
+        if (t->larguraIndice == 4) {
+            uint32_t indice32;
+            memcpy(&indice32, t->indices + i * 4, sizeof(indice32));
+            indice = indice32;
+        } else {
+            memcpy(&indice, t->indices + i * 8, sizeof(indice));
+        }
+        if (indice >= (uint64_t)t->n) {
+            t->invalido = 1;
+            return;
+        }
+        // Larguras comuns com tamanho constante, para que a cópia vire um único acesso
+        if (largura == 4) {
+            memcpy(t->destino + i * 4, t->origem + indice * 4, 4);
+        } else if (largura == 8) {
+            memcpy(t->destino + i * 8, t->origem + indice * 8, 8);
+        } else {
+            memcpy(t->destino + i * largura, t->origem + indice * largura, largura);
+        }
+    }
+}
+
+// Aplica a permutação: destino[i] = origem[indices[i]]
+int aplicarPermutacao(const void *origem, void *destino, long n, int largura, const void *indices,
+                      int larguraIndice, PoolThreads *pool, int numThreads) {
+    if (larguraIndice != 4 && larguraIndice != 8) {
+        printf("Erro: Os índices devem ter 4 ou 8 bytes.\n");
+        return -1;
+    }
+    if (largura <= 0) {
+        printf("Erro: Largura de elemento inválida.\n");
+        return -1;
+    }
+    if (n <= 0) {
+        return 0;
+    }
+
+    long numTrechos = numTrechosPool(pool, numThreads, n, REGISTROS_MIN_ELEMENTOS_TRECHO, REGISTROS_MAX_TRECHOS);
+    TrechoPermutacao trechos[REGISTROS_MAX_TRECHOS];
+    for (long t = 0; t < numTrechos; t++) {
+        trechos[t].origem = (const unsigned char *)origem;
+        trechos[t].destino = (unsigned char *)destino;
+        trechos[t].indices = (const unsigned char *)indices;
+        trechos[t].largura = largura;
+        trechos[t].larguraIndice = larguraIndice;
+        trechos[t].n = n;
+        trechos[t].inicio = n * t / numTrechos;
+        trechos[t].fim = n * (t + 1) / numTrechos;
+        trechos[t].invalido = 0;
+    }
+
+    if (!pool || numTrechos == 1) {
+        for (long t = 0; t < numTrechos; t++) {
+            aplicarTrechoPermutacao(&trechos[t]);
+        }
+    } else {
+        GrupoTarefas grupo;
+        iniciarGrupoTarefas(&grupo);
+        for (long t = 0; t < numTrechos; t++) {
+            submeterTarefa(pool, &grupo, -1, aplicarTrechoPermutacao, &trechos[t]);
+        }
+        aguardarGrupoTarefas(pool, &grupo);
+    }
+
+    for (long t = 0; t < numTrechos; t++) {
+        if (trechos[t].invalido) {
+            printf("Erro: A permutação tem índices fora do vetor.\n");
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "OrdenacaoSegmentada.h"
+
+// Grupo de segmentos consecutivos [primeiro, ultimo) ordenado por uma tarefa
+typedef struct {
+    int *valores;
+    const long *deslocamentos;
+    long primeiro;
+    long ultimo;
+} TarefaSegmentos;
+
+// Compara e troca: A[i] recebe o menor e A[j] o maior (sem desvio, com cmov)
+#define COMPARAR_TROCAR(A, i, j) { \
+    int x = (A)[i], y = (A)[j]; \
+    (A)[i] = x < y ? x : y; \
+    (A)[j] = x < y ? y : x; \
+}
+
+// Redes de ordenação com o menor número de comparadores conhecido para 2 a 8 elementos
+static const unsigned char rede2[][2] = { {0,1} };
+static const unsigned char rede3[][2] = { {0,2}, {0,1}, {1,2} };
+static const unsigned char rede4[][2] = { {0,2}, {1,3}, {0,1}, {2,3}, {1,2} };
+static const unsigned char rede5[][2] = { {0,3}, {1,4}, {0,2}, {1,3}, {0,1}, {2,4}, {1,2}, {3,4}, {2,3} };
+static const unsigned char rede6[][2] = { {0,5}, {1,3}, {2,4}, {1,2}, {3,4}, {0,3}, {2,5}, {0,1}, {2,3},
+                                          {4,5}, {1,2}, {3,4} };
+static const unsigned char rede7[][2] = { {0,6}, {2,3}, {4,5}, {0,2}, {1,4}, {3,6}, {0,1}, {2,5}, {3,4},
+                                          {1,2}, {4,6}, {2,3}, {4,5}, {1,2}, {3,4}, {5,6} };
+static const unsigned char rede8[][2] = { {0,2}, {1,3}, {4,6}, {5,7}, {0,4}, {1,5}, {2,6}, {3,7}, {0,1},
+                                          {2,3}, {4,5}, {6,7}, {2,4}, {3,5}, {1,4}, {3,6}, {1,2}, {3,4},
+                                          {5,6} };
+
+// Rede e número de comparadores para cada tamanho (índice = número de elementos)
+static const unsigned char (*const redes[])[2] = { NULL, NULL, rede2, rede3, rede4, rede5, rede6, rede7, rede8 };
+static const int comparadoresRede[] = {
+    0, 0,
+    sizeof(rede2) / 2, sizeof(rede3) / 2, sizeof(rede4) / 2, sizeof(rede5) / 2,
+    sizeof(rede6) / 2, sizeof(rede7) / 2, sizeof(rede8) / 2
+};
+
+// Função para ordenar até SEGMENTOS_LIMITE_REDE elementos com a rede do tamanho
+static void ordenarRede(int *A, long n) {
+    const unsigned char (*rede)[2] = redes[n];
+    for (int c = 0; c < comparadoresRede[n]; c++) {
+        COMPARAR_TROCAR(A, rede[c][0], rede[c][1]);
+    }
+}
+
+// Função para ordenar um segmento pequeno por inserção
+static void ordenarInsercao(int *A, long n) {
+    for (long i = 1; i < n; i++) {
+        int valor = A[i];
+        long j = i - 1;
+        while (j >= 0 && A[j] > valor) {
+            A[j + 1] = A[j];
+            j--;
+        }
+        A[j + 1] = valor;
+    }
+}
+
+// Ordena um único segmento com o núcleo escolhido pelo tamanho
+void ordenarSegmentoI32(int *segmento, long n) {
+    if (n <= 1) {
+        return;
+    }
+    if (n <= SEGMENTOS_LIMITE_REDE) {
+        ordenarRede(segmento, n);
+    } else if (n <= SEGMENTOS_LIMITE_INSERCAO) {
+        ordenarInsercao(segmento, n);
+    } else {
+        OpcoesOrdenacao sequencial;
+        opcoesOrdenacaoPadrao(&sequencial, ORDENACAO_QUICKSORT_SEQ);
+        ordenarQuicksortSeqI32(segmento, n, &sequencial);
+    }
+}
+
+// Função executada por uma tarefa: ordena os segmentos do grupo, exceto os grandes
+static void tarefaSegmentos(void *arg) {
+    TarefaSegmentos *tarefa = (TarefaSegmentos *)arg;
+    for (long s = tarefa->primeiro; s < tarefa->ultimo; s++) {
+        long n = tarefa->deslocamentos[s + 1] - tarefa->deslocamentos[s];
+        if (n <= SEGMENTOS_LIMITE_PARALELO) {
+            ordenarSegmentoI32(tarefa->valores + tarefa->deslocamentos[s], n);
+        }
+    }
+}
+
+// Ordena cada um dos segmentos
+int ordenarSegmentosI32(int *valores, const long *deslocamentos, long numSegmentos,
+                        const OpcoesOrdenacao *opcoes) {
+    if (numSegmentos <= 0) {
+        return 0;
+    }
+
+    int temporario;
+    PoolThreads *pool = poolDaChamada(opcoes, &temporario);
+    if (!pool) {
+        return -1;
+    }
+
+    // Tamanho de cada grupo: várias tarefas por trabalhador, sem grupos pequenos demais.
+    // Os segmentos grandes não contam, pois são ordenados à parte.
+    long total = 0;
+    for (long s = 0; s < numSegmentos; s++) {
+        long n = deslocamentos[s + 1] - deslocamentos[s];
+        if (n <= SEGMENTOS_LIMITE_PARALELO) {
+            total += n;
+        }
+    }
+    long alvo = total / ((long)numTrabalhadoresPool(pool) * SEGMENTOS_TAREFAS_POR_TRABALHADOR);
+    if (alvo < SEGMENTOS_MIN_ELEMENTOS_TAREFA) {
+        alvo = SEGMENTOS_MIN_ELEMENTOS_TAREFA;
+    }
+
+    // Cada grupo é fechado ao atingir o alvo, então há no máximo total / alvo + 1 grupos
+    long maxTarefas = total / alvo + 1;
+    TarefaSegmentos *tarefas = malloc((size_t)maxTarefas * sizeof(TarefaSegmentos));
+    if (!tarefas) {
+        perror("Erro ao alocar as tarefas da ordenação segmentada");
+        if (temporario) {
+            destruirPoolThreads(pool);
+        }
+        return -1;
+    }
+
+    // Agrupar os segmentos consecutivos e entregar cada grupo ao pool
+    GrupoTarefas grupo;
+    iniciarGrupoTarefas(&grupo);
+    long numTarefas = 0, primeiro = 0, acumulado = 0;
+    for (long s = 0; s < numSegmentos; s++) {
+        long n = deslocamentos[s + 1] - deslocamentos[s];
+        if (n <= SEGMENTOS_LIMITE_PARALELO) {
+            acumulado += n;
+        }
+        if (acumulado >= alvo || s == numSegmentos - 1) {
+            TarefaSegmentos *tarefa = &tarefas[numTarefas++];
+            tarefa->valores = valores;
+            tarefa->deslocamentos = deslocamentos;
+            tarefa->primeiro = primeiro;
+            tarefa->ultimo = s + 1;
+            submeterTarefa(pool, &grupo, -1, tarefaSegmentos, tarefa);
+            primeiro = s + 1;
+            acumulado = 0;
+        }
+    }
+    aguardarGrupoTarefas(pool, &grupo);
+    free(tarefas);
+
+    // Os segmentos grandes usam o pool inteiro, um de cada vez
+    OpcoesOrdenacao concorrente;
+    opcoesOrdenacaoPadrao(&concorrente, ORDENACAO_QUICKSORT_CONC);
+    concorrente.pool = pool;
+    for (long s = 0; s < numSegmentos; s++) {
+        long n = deslocamentos[s + 1] - deslocamentos[s];
+        if (n > SEGMENTOS_LIMITE_PARALELO) {
+            ordenarQuicksortConcI32(valores + deslocamentos[s], n, &concorrente);
+        }
+    }
+
+    if (temporario) {
+        destruirPoolThreads(pool);
+    }
+    return 0;
+}
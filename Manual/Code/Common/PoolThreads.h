@@ -0,0 +1,65 @@
+#ifndef POOL_THREADS_H
+#define POOL_THREADS_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include "Topologia.h"
+
+/*
+ * Pool persistente de threads usado pelos algoritmos concorrentes da biblioteca.
+ *
+ * As threads são criadas uma única vez (fixadas segundo o PlanoNUMA, se houver) e
+ * executam tarefas de uma fila compartilhada. Uma tarefa também pode ser endereçada a um
+ * trabalhador específico, para que execute na CPU/nó escolhido pelo plano.
+ *
+ * As tarefas são agrupadas em GrupoTarefas. Quem aguarda um grupo executa tarefas da fila
+ * compartilhada enquanto espera, o que permite submeter tarefas de dentro de outras
+ * tarefas (divisão recursiva do Quicksort) sem bloquear o pool.
+ */
+
+// Estrutura opaca do pool
+typedef struct PoolThreads PoolThreads;
+
+// Conjunto de tarefas aguardadas em conjunto
+typedef struct {
+    int pendentes; // Tarefas submetidas e ainda não concluídas (protegido pelo pool)
+} GrupoTarefas;
+
+// Cria o pool com numTrabalhadores threads; o trabalhador i é fixado no índice i do plano
+// (plano pode ser NULL e deve continuar válido enquanto o pool existir). Retorna NULL em caso de erro.
+PoolThreads *criarPoolThreads(int numTrabalhadores, const PlanoNUMA *plano);
+
+// Aguarda as tarefas pendentes, encerra as threads e libera o pool
+void destruirPoolThreads(PoolThreads *pool);
+
+// Retorna o número de trabalhadores
+int numTrabalhadoresPool(const PoolThreads *pool);
+
+// Retorna o plano usado para fixar os trabalhadores (NULL se não houver)
+const PlanoNUMA *planoDoPool(const PoolThreads *pool);
+
+// Retorna o número de tarefas na fila compartilhada que ainda não começaram
+int tarefasNaFila(PoolThreads *pool);
+
+// Prepara um grupo vazio
+void iniciarGrupoTarefas(GrupoTarefas *grupo);
+
+// Submete funcao(arg) no grupo. Com trabalhador >= 0, a tarefa só é executada pelo
+// trabalhador (trabalhador % numTrabalhadores). Retorna 0 em caso de sucesso; em caso de
+// erro a tarefa é executada na própria thread.
+int submeterTarefa(PoolThreads *pool, GrupoTarefas *grupo, int trabalhador,
+                   void (*funcao)(void *), void *arg);
+
+// Aguarda todas as tarefas do grupo, executando tarefas da fila compartilhada enquanto isso
+void aguardarGrupoTarefas(PoolThreads *pool, GrupoTarefas *grupo);
+
+// Executa funcao em cada um dos num itens consecutivos de tamanho bytes a partir de itens,
+// pelo pool quando houver mais de um (pool pode ser NULL: executa na própria thread)
+void executarItensPool(PoolThreads *pool, void (*funcao)(void *), void *itens, size_t tamanho, int num);
+
+// Retorna o número de trechos das fases paralelas sobre n elementos: um por trabalhador
+// (até numThreads, se positivo), sem trechos com menos de minPorTrecho elementos, entre 1
+// e maxTrechos
+long numTrechosPool(const PoolThreads *pool, int numThreads, long n, long minPorTrecho, long maxTrechos);
+
+#endif
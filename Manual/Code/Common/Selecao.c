@@ -0,0 +1,536 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include "Selecao.h"
+#include "Ordenacao.h"
+#include "Opcoes.h"
+#include "Registro.h"
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+// Trecho [inicio, fim) da faixa em uma rodada da seleção concorrente
+typedef struct {
+    int *vetor;
+    int *buffer;
+    int pivoMenor;
+    int pivoMaior;
+    long inicio;
+    long fim;
+    long contagem[3]; // Chaves < pivoMenor, entre os pivôs e > pivoMaior; depois, a próxima posição de cada faixa
+} TrechoSelecao;
+
+// Função para comparar inteiros (qsort da amostra)
+static int compararInteiros(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Função para obter a faixa (0, 1 ou 2) de um valor em relação aos pivôs
+static inline int faixaSelecao(int valor, int pivoMenor, int pivoMaior) {
+    return (valor >= pivoMenor) + (valor > pivoMaior);
+}
+
+// Função para contar as chaves de cada faixa em um trecho
+static void contarFaixas(void *arg) {
+    TrechoSelecao *t = (TrechoSelecao *)arg;
+    long contagem[3] = {0, 0, 0};
+    for (long i = t->inicio; i < t->fim; i++) {
+        contagem[faixaSelecao(t->vetor[i], t->pivoMenor, t->pivoMaior)]++;
+    }
+    memcpy(t->contagem, contagem, sizeof(contagem));
+}
+
+// Função para distribuir as chaves de um trecho nas posições das suas faixas no buffer
+static void distribuirFaixas(void *arg) {
+    TrechoSelecao *t = (TrechoSelecao *)arg;
+    for (long i = t->inicio; i < t->fim; i++) {
+        int valor = t->vetor[i];
+        t->buffer[t->contagem[faixaSelecao(valor, t->pivoMenor, t->pivoMaior)]++] = valor;
+    }
+}
+
+// Função para copiar um trecho do buffer de volta para o vetor
+static void copiarTrechoSelecao(void *arg) {
+    TrechoSelecao *t = (TrechoSelecao *)arg;
+    memcpy(t->vetor + t->inicio, t->buffer + t->inicio, (size_t)(t->fim - t->inicio) * sizeof(int));
+}
+
+// Função para ordenar A[a], A[b] e A[c], deixando a mediana em A[b]
+static void medianaDeTres(int A[], long a, long b, long c) {
+    if (A[b] < A[a]) {
+        trocar(&A[a], &A[b]);
+    }
+    if (A[c] < A[b]) {
+        trocar(&A[b], &A[c]);
+        if (A[b] < A[a]) {
+            trocar(&A[a], &A[b]);
+        }
+    }
+}
+
+// Função para selecionar a posição k em A[lo..hi] com a partição de Hoare, seguindo
+// apenas o lado que contém k
+static void selecionarSequencial(int A[], long lo, long hi, long k) {
+    while (hi - lo + 1 > SELECAO_LIMITE_INSERCAO) {
+        medianaDeTres(A, lo, lo + (hi - lo) / 2, hi);
+        long j = particionar(A, lo, hi);
+        if (k <= j) {
+            hi = j;
+        } else {
+            lo = j + 1;
+        }
+    }
+    insercao(A, lo, hi);
+}
+
+// Função para escolher os dois pivôs em volta da posição k da faixa [lo, hi) por uma amostra
+static void escolherPivos(const int *vetor, long lo, long hi, long k, int *pivoMenor, int *pivoMaior) {
+    int amostra[SELECAO_AMOSTRA];
+    long m = hi - lo;
+    unsigned long long estado = 0x2545F4914F6CDD1Dull ^ (unsigned long long)m;
+    for (int s = 0; s < SELECAO_AMOSTRA; s++) {
+        estado = estado * 6364136223846793005ull + 1442695040888963407ull;
+        amostra[s] = vetor[lo + (long)((estado >> 33) % (unsigned long long)m)];
+    }
+    qsort(amostra, SELECAO_AMOSTRA, sizeof(int), compararInteiros);
+
+    long posicao = (long)((double)(k - lo) / m * SELECAO_AMOSTRA);
+    long menor = posicao - SELECAO_FOLGA, maior = posicao + SELECAO_FOLGA;
+    *pivoMenor = amostra[menor < 0 ? 0 : menor];
+    *pivoMaior = amostra[maior >= SELECAO_AMOSTRA ? SELECAO_AMOSTRA - 1 : maior];
+}
+
+// Coloca em vetor[k] o elemento da posição k no vetor ordenado
+int selecionarI32(int *vetor, long n, long k, PoolThreads *pool, int numThreads) {
+    if (k < 0 || k >= n) {
+        printf("Erro: Posição de seleção fora do vetor.\n");
+        return -1;
+    }
+
+    // Trechos possíveis sem limite de tamanho: só há rodadas concorrentes com mais de um
+    long maxTrechos = numTrechosPool(pool, numThreads, n, 1, SELECAO_MAX_TRECHOS);
+
+    // Rodadas concorrentes enquanto a faixa de k for grande
+    long lo = 0, hi = n;
+    int *buffer = NULL;
+    TrechoSelecao trechos[SELECAO_MAX_TRECHOS];
+    while (maxTrechos > 1 && hi - lo > SELECAO_MIN_PARALELO) {
+        long m = hi - lo;
+        if (!buffer) {
+            buffer = (int *)obterBufferTemporario((size_t)n * sizeof(int));
+            if (!buffer) {
+                break; // Sem memória para a distribuição, a seleção segue sequencial
+            }
+        }
+
+        long numTrechos = numTrechosPool(pool, numThreads, m, SELECAO_MIN_ELEMENTOS_TRECHO, SELECAO_MAX_TRECHOS);
+
+        int pivoMenor, pivoMaior;
+        escolherPivos(vetor, lo, hi, k, &pivoMenor, &pivoMaior);
+        for (long t = 0; t < numTrechos; t++) {
+            trechos[t].vetor = vetor;
+            trechos[t].buffer = buffer;
+            trechos[t].pivoMenor = pivoMenor;
+            trechos[t].pivoMaior = pivoMaior;
+            trechos[t].inicio = lo + m * t / numTrechos;
+            trechos[t].fim = lo + m * (t + 1) / numTrechos;
+        }
+        executarItensPool(pool, contarFaixas, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+        // Início de cada faixa em cada trecho: faixas em ordem e, dentro delas, os trechos
+        long total[3] = {0, 0, 0};
+        long posicao = lo;
+        for (int f = 0; f < 3; f++) {
+            for (long t = 0; t < numTrechos; t++) {
+                long quantidade = trechos[t].contagem[f];
+                trechos[t].contagem[f] = posicao;
+                posicao += quantidade;
+                total[f] += quantidade;
+            }
+        }
+        executarItensPool(pool, distribuirFaixas, trechos, sizeof(trechos[0]), (int)numTrechos);
+        executarItensPool(pool, copiarTrechoSelecao, trechos, sizeof(trechos[0]), (int)numTrechos);
+
+        // Seguir na faixa que contém k
+        long fimMenores = lo + total[0], fimMeio = fimMenores + total[1];
+        if (k < fimMenores) {
+            hi = fimMenores;
+        } else if (k < fimMeio) {
+            if (pivoMenor == pivoMaior) {
+                lo = hi; // A faixa do meio só tem chaves iguais: vetor[k] já está na posição
+                break;
+            }
+            if (total[1] == m) {
+                break; // Os pivôs não separaram nada (poucas chaves distintas): seguir na sequencial
+            }
+            lo = fimMenores;
+            hi = fimMeio;
+        } else {
+            lo = fimMeio;
+        }
+    }
+    if (buffer) {
+        devolverBufferTemporario(buffer);
+    }
+
+    if (lo < hi) {
+        selecionarSequencial(vetor, lo, hi - 1, k);
+    }
+    return 0;
+}
+
+// Coloca em vetor[0..k) os k menores (ou maiores) elementos, em ordem
+int topkI32(int *vetor, long n, long k, int maiores, PoolThreads *pool, int numThreads) {
+    if (k <= 0 || k > n) {
+        printf("Erro: k deve estar entre 1 e o tamanho do vetor.\n");
+        return -1;
+    }
+
+    // Os k menores terminam em vetor[0..k); os k maiores, em vetor[n - k..n)
+    long posicao = maiores ? n - k : k - 1;
+    if (selecionarI32(vetor, n, posicao, pool, numThreads) != 0) {
+        return -1;
+    }
+    if (maiores) {
+        memmove(vetor, vetor + (n - k), (size_t)k * sizeof(int));
+    }
+
+    // Ordenar apenas os k selecionados, com dois pivôs: a partição de Lomuto do Quicksort
+    // concorrente fica quadrática quando os selecionados têm poucos valores distintos
+    OpcoesOrdenacao opcoes;
+    opcoesOrdenacaoPadrao(&opcoes, pool && k > ORDENACAO_LIMITE_TAREFA ? ORDENACAO_DUPLO_PIVO_CONC
+                                                                      : ORDENACAO_DUPLO_PIVO_SEQ);
+    opcoes.pool = pool;
+    opcoes.numThreads = numThreads;
+    if (ordenarI32(vetor, k, &opcoes) != 0) {
+        return -1;
+    }
+    if (maiores) {
+        for (long i = 0, j = k - 1; i < j; i++, j--) {
+            trocar(&vetor[i], &vetor[j]);
+        }
+    }
+    return 0;
+}
+
+// Função para comparar dois valores na ordem do heap: 1 se a deve ficar acima de b
+static inline int acimaNoHeap(const HeapLimitado *heap, int a, int b) {
+    return heap->maiores ? a < b : a > b;
+}
+
+// Função para descer o valor da posição i até a posição correta do heap de tamanho valores
+static void descerHeap(const HeapLimitado *heap, long i, long tamanho) {
+    int *v = heap->valores;
+    int valor = v[i];
+    while (1) {
+        long filho = 2 * i + 1;
+        if (filho >= tamanho) {
+            break;
+        }
+        if (filho + 1 < tamanho && acimaNoHeap(heap, v[filho + 1], v[filho])) {
+            filho++;
+        }
+        if (!acimaNoHeap(heap, v[filho], valor)) {
+            break;
+        }
+        v[i] = v[filho];
+        i = filho;
+    }
+    v[i] = valor;
+}
+
+// Prepara um heap vazio
+int iniciarHeapLimitado(HeapLimitado *heap, long capacidade, int maiores) {
+    heap->valores = (int *)malloc((size_t)(capacidade > 0 ? capacidade : 1) * sizeof(int));
+    heap->tamanho = 0;
+    heap->capacidade = capacidade;
+    heap->maiores = maiores;
+    if (!heap->valores) {
+        printf("Erro: Falha na alocação de memória para o heap.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Considera os valores de um bloco
+void inserirHeapLimitado(HeapLimitado *heap, const int *valores, long quantidade) {
+    int *v = heap->valores;
+    long i = 0;
+
+    // Preencher o heap até a capacidade e montá-lo de uma vez
+    if (heap->tamanho < heap->capacidade) {
+        long livres = heap->capacidade - heap->tamanho;
+        long copiar = quantidade < livres ? quantidade : livres;
+        memcpy(v + heap->tamanho, valores, (size_t)copiar * sizeof(int));
+        heap->tamanho += copiar;
+        i = copiar;
+        if (heap->tamanho == heap->capacidade) {
+            for (long p = heap->tamanho / 2 - 1; p >= 0; p--) {
+                descerHeap(heap, p, heap->tamanho);
+            }
+        }
+    }
+
+    // Com o heap cheio, cada valor só entra se for melhor que o topo (o pior guardado)
+    for (; i < quantidade; i++) {
+        if (acimaNoHeap(heap, v[0], valores[i])) {
+            v[0] = valores[i];
+            descerHeap(heap, 0, heap->tamanho);
+        }
+    }
+}
+
+// Ordena o conteúdo do heap (heapsort no próprio vetor)
+void finalizarHeapLimitado(HeapLimitado *heap) {
+    long tamanho = heap->tamanho;
+    if (tamanho < heap->capacidade) {
+        for (long p = tamanho / 2 - 1; p >= 0; p--) {
+            descerHeap(heap, p, tamanho);
+        }
+    }
+    for (long fim = tamanho - 1; fim > 0; fim--) {
+        trocar(&heap->valores[0], &heap->valores[fim]);
+        descerHeap(heap, 0, fim);
+    }
+}
+
+// Libera o heap
+void liberarHeapLimitado(HeapLimitado *heap) {
+    free(heap->valores);
+    heap->valores = NULL;
+}
+
+// Extrai de argv as opções de seleção, deixando as demais para extrairOpcoes
+int extrairOpcoesSelecao(int argc, char *argv[], OpcoesSelecao *opcoes) {
+    opcoes->modo = SELECAO_NENHUMA;
+    opcoes->k = 0;
+    opcoes->percentil = 0;
+    opcoes->maiores = 0;
+    opcoes->fluxo = 0;
+
+    int novoArgc = 1;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--maiores") == 0) {
+            opcoes->maiores = 1;
+            continue;
+        }
+        if (strcmp(arg, "--fluxo") == 0) {
+            opcoes->fluxo = 1;
+            continue;
+        }
+        int propria = strcmp(arg, "--topk") == 0 || strcmp(arg, "--nth") == 0 || strcmp(arg, "--percentile") == 0;
+
+        // Argumentos posicionais e opções comuns são mantidos na ordem original
+        if (!propria) {
+            argv[novoArgc++] = argv[i];
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            fprintf(stderr, "A opção %s exige um valor.\n", arg);
+            return -1;
+        }
+        if (opcoes->modo != SELECAO_NENHUMA) {
+            fprintf(stderr, "Use apenas uma das opções --topk, --nth e --percentile.\n");
+            return -1;
+        }
+        const char *valor = argv[++i];
+
+        if (strcmp(arg, "--percentile") == 0) {
+            char *fim;
+            double p = strtod(valor, &fim);
+            if (*valor == '\0' || *fim != '\0' || p < 0 || p > 100) {
+                fprintf(stderr, "Valor inválido para %s: %s (use de 0 a 100)\n", arg, valor);
+                return -1;
+            }
+            opcoes->modo = SELECAO_PERCENTIL;
+            opcoes->percentil = p;
+        } else {
+            if (lerValorPositivo(arg, valor, &opcoes->k) < 0) {
+                return -1;
+            }
+            opcoes->modo = strcmp(arg, "--topk") == 0 ? SELECAO_TOPK : SELECAO_NTH;
+        }
+    }
+
+    if ((opcoes->maiores || opcoes->fluxo) && opcoes->modo == SELECAO_NENHUMA) {
+        fprintf(stderr, "As opções --maiores e --fluxo exigem --topk, --nth ou --percentile.\n");
+        return -1;
+    }
+    argv[novoArgc] = NULL;
+    return novoArgc;
+}
+
+// Imprime a lista de opções de seleção
+void imprimirOpcoesSelecao(FILE *saida) {
+    fprintf(saida, "Seleção (no lugar da ordenação completa):\n");
+    fprintf(saida, "  --topk <K>                 Grava apenas os K menores elementos, em ordem\n");
+    fprintf(saida, "  --nth <K>                  Grava apenas o K-ésimo menor elemento (K a partir de 1)\n");
+    fprintf(saida, "  --percentile <P>           Grava apenas o percentil P (0 a 100, posto mais próximo)\n");
+    fprintf(saida, "  --maiores                  --topk e --nth contam a partir do maior elemento\n");
+    fprintf(saida, "  --fluxo                    Lê a entrada em blocos, com um heap de K posições (entradas\n");
+    fprintf(saida, "                             maiores que a memória; automático quando não couberem)\n");
+}
+
+// Retorna a posição do elemento pedido por --nth ou --percentile
+long posicaoSelecao(const OpcoesSelecao *opcoes, long n) {
+    long posicao;
+    if (opcoes->modo == SELECAO_PERCENTIL) {
+        // Posto mais próximo: o menor elemento com pelo menos p% dos elementos até ele
+        // (com tolerância para o arredondamento de p * n / 100)
+        double exato = opcoes->percentil * (double)n / 100.0;
+        long posto = (long)exato;
+        if (exato - (double)posto > 1e-9) {
+            posto++;
+        }
+        posicao = posto > 0 ? posto - 1 : 0;
+    } else {
+        posicao = opcoes->maiores ? n - opcoes->k : opcoes->k - 1;
+    }
+    return posicao >= 0 && posicao < n ? posicao : -1;
+}
+
+// Função para obter a memória física disponível em bytes
+static long memoriaDisponivel(void) {
+    long paginas = sysconf(_SC_AVPHYS_PAGES), tamanho = sysconf(_SC_PAGESIZE);
+    return paginas > 0 && tamanho > 0 ? paginas * tamanho : 0;
+}
+
+// Função para entregar um bloco lido do arquivo ao heap limitado
+static void consumirBlocoHeap(const int *valores, long quantidade, void *contexto) {
+    inserirHeapLimitado((HeapLimitado *)contexto, valores, quantidade);
+}
+
+// Função para selecionar pelo heap limitado, lendo a entrada em blocos: os k menores (ou
+// maiores) ou, para uma posição, o lado menor do vetor em volta dela. Preenche resultado
+// e *quantidade com os valores a gravar; retorna 0 em caso de sucesso.
+static int selecionarEmFluxo(const char *arquivoEntrada, long n, const OpcoesSelecao *selecao, int **resultado,
+                             long *quantidade) {
+    long capacidade;
+    int maiores;
+    if (selecao->modo == SELECAO_TOPK) {
+        capacidade = selecao->k;
+        maiores = selecao->maiores;
+    } else {
+        // Posição p: os p + 1 menores (topo = p) ou os n - p maiores (último = p)
+        long posicao = posicaoSelecao(selecao, n);
+        maiores = n - posicao < posicao + 1;
+        capacidade = maiores ? n - posicao : posicao + 1;
+    }
+    if ((double)capacidade * sizeof(int) > memoriaDisponivel() / 2) {
+        printf("Erro: O heap de %ld posições não cabe na memória disponível.\n", capacidade);
+        return -1;
+    }
+
+    HeapLimitado heap;
+    int *bloco = (int *)alocarBuffer(ES_TAMANHO_BLOCO_PADRAO);
+    if (!bloco || iniciarHeapLimitado(&heap, capacidade, maiores) != 0) {
+        if (bloco) {
+            liberarBuffer(bloco);
+        }
+        return -1;
+    }
+    int erro = lerVetorEmBlocos(arquivoEntrada, bloco, ES_TAMANHO_BLOCO_PADRAO / sizeof(int), consumirBlocoHeap,
+                                &heap);
+    liberarBuffer(bloco);
+    if (erro != 0) {
+        liberarHeapLimitado(&heap);
+        return -1;
+    }
+    finalizarHeapLimitado(&heap);
+
+    if (selecao->modo == SELECAO_TOPK) {
+        *resultado = heap.valores; // Liberado pelo chamador com free
+        *quantidade = heap.tamanho;
+        return 0;
+    }
+    *resultado = (int *)malloc(sizeof(int));
+    if (!*resultado) {
+        liberarHeapLimitado(&heap);
+        return -1;
+    }
+    (*resultado)[0] = heap.valores[heap.tamanho - 1];
+    *quantidade = 1;
+    liberarHeapLimitado(&heap);
+    return 0;
+}
+
+// Executa --topk, --nth ou --percentile no lugar da ordenação completa
+int executarSelecao(const char *arquivoEntrada, const char *arquivoSaida, const OpcoesSelecao *selecao,
+                    const ConfiguracaoES *config, PoolThreads *pool, int maxThreads, const char *arquivoLog,
+                    const char *programa) {
+    static const char *modos[] = { "", "topk", "nth", "percentile" };
+    int n;
+    if (lerTamanhoArquivo(arquivoEntrada, &n) != 0) {
+        return -1;
+    }
+    if (selecao->modo == SELECAO_TOPK ? selecao->k > n : posicaoSelecao(selecao, n) < 0) {
+        printf("Erro: A posição pedida está fora do vetor de %d elementos.\n", n);
+        return -1;
+    }
+
+    // Entradas que não cabem na memória são lidas em blocos
+    int fluxo = selecao->fluxo || (double)n * sizeof(int) > memoriaDisponivel() / 2;
+    printf("Tamanho do array: %d\n", n);
+    printf("Seleção: %s%s%s\n", modos[selecao->modo], selecao->maiores ? " (maiores)" : "",
+           fluxo ? " em fluxo, com heap limitado" : "");
+
+    double inicio, fim;
+    int *vetor = NULL, *resultado;
+    long quantidade;
+    OBTER_TEMPO(inicio);
+    if (fluxo) {
+        if (selecionarEmFluxo(arquivoEntrada, n, selecao, &resultado, &quantidade) != 0) {
+            return -1;
+        }
+    } else {
+        vetor = lerVetorArquivo(arquivoEntrada, &n, config);
+        if (!vetor) {
+            return -1;
+        }
+        OBTER_TEMPO(inicio); // A leitura do arquivo não entra no tempo da seleção em memória
+        int erro;
+        if (selecao->modo == SELECAO_TOPK) {
+            erro = topkI32(vetor, n, selecao->k, selecao->maiores, pool, maxThreads);
+            quantidade = selecao->k;
+        } else {
+            long posicao = posicaoSelecao(selecao, n);
+            erro = selecionarI32(vetor, n, posicao, pool, maxThreads);
+            vetor[0] = vetor[posicao];
+            quantidade = 1;
+        }
+        if (erro != 0) {
+            liberarBuffer(vetor);
+            return -1;
+        }
+        resultado = vetor;
+    }
+    OBTER_TEMPO(fim);
+
+    printf("Tempo de seleção: %f segundos\n", fim - inicio);
+    if (selecao->modo != SELECAO_TOPK) {
+        printf("Elemento na posição %ld (de 0 a %d, em ordem crescente): %d\n", posicaoSelecao(selecao, n), n - 1,
+               resultado[0]);
+    }
+    registrarTempoNoArquivo(arquivoLog, programa, fim - inicio, n, maxThreads);
+
+    int erro = gravarVetorArquivo(arquivoSaida, resultado, (int)quantidade, config);
+    if (vetor) {
+        liberarBuffer(vetor);
+    } else {
+        free(resultado);
+    }
+    if (erro != 0) {
+        return -1;
+    }
+    printf("Seleção salva em %s\n", arquivoSaida);
+    return 0;
+}
@@ -0,0 +1,343 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "Servico.h"
+#include "Opcoes.h"
+
+// Função para imprimir os nomes aceitos por --algoritmo, separados por vírgulas
+static void imprimirNomesAlgoritmos(FILE *saida) {
+    for (int a = ORDENACAO_QUICKSORT_SEQ; a < ORDENACAO_NUM_ALGORITMOS; a++) {
+        const char *separador = a == ORDENACAO_QUICKSORT_SEQ ? "" : a == ORDENACAO_NUM_ALGORITMOS - 1 ? " ou " : ", ";
+        fprintf(saida, "%s%s", separador, nomeAlgoritmoOrdenacao((AlgoritmoOrdenacao)a));
+    }
+}
+
+// Extrai de argv as opções do serviço, deixando as demais para extrairOpcoes
+int extrairOpcoesServico(int argc, char *argv[], PapelServico papel, OpcoesServico *opcoes) {
+    opcoes->socket = SERVICO_SOCKET_PADRAO;
+    opcoes->algoritmo = ORDENACAO_QUICKSORT_CONC;
+    opcoes->maxTarefas = SERVICO_MAX_TAREFAS_PADRAO;
+    opcoes->fila = SERVICO_FILA_PADRAO;
+    opcoes->arenaMB = SERVICO_ARENA_PADRAO_MB;
+
+    int novoArgc = 1;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        int doCliente = strcmp(arg, "--algoritmo") == 0;
+        int doServidor = strcmp(arg, "--max-tarefas") == 0 || strcmp(arg, "--fila") == 0 ||
+                         strcmp(arg, "--arena") == 0;
+
+        // Argumentos posicionais e opções comuns são mantidos na ordem original
+        if (!doCliente && !doServidor && strcmp(arg, "--socket") != 0) {
+            argv[novoArgc++] = argv[i];
+            continue;
+        }
+        if ((doCliente && papel != SERVICO_CLIENTE) || (doServidor && papel != SERVICO_SERVIDOR)) {
+            fprintf(stderr, "A opção %s só é aceita pelo %s.\n", arg, doCliente ? "cliente" : "servidor");
+            return -1;
+        }
+
+        if (i + 1 >= argc) {
+            fprintf(stderr, "A opção %s exige um valor.\n", arg);
+            return -1;
+        }
+        const char *valor = argv[++i];
+        long numero;
+
+        if (strcmp(arg, "--socket") == 0) {
+            opcoes->socket = valor;
+        } else if (strcmp(arg, "--algoritmo") == 0) {
+            if (algoritmoOrdenacaoDoNome(valor, &opcoes->algoritmo) < 0) {
+                fprintf(stderr, "Algoritmo inválido: %s (use ", valor);
+                imprimirNomesAlgoritmos(stderr);
+                fprintf(stderr, ")\n");
+                return -1;
+            }
+        } else if (strcmp(arg, "--max-tarefas") == 0) {
+            if (lerValorPositivo(arg, valor, &numero) < 0) {
+                return -1;
+            }
+            opcoes->maxTarefas = (int)numero;
+        } else if (strcmp(arg, "--fila") == 0) {
+            // A fila pode ser 0 (recusar tudo que não puder começar imediatamente)
+            if (strcmp(valor, "0") == 0) {
+                opcoes->fila = 0;
+            } else if (lerValorPositivo(arg, valor, &numero) < 0) {
+                return -1;
+            } else {
+                opcoes->fila = (int)numero;
+            }
+        } else {
+            if (strcmp(valor, "0") == 0) {
+                opcoes->arenaMB = 0;
+            } else if (lerValorPositivo(arg, valor, &numero) < 0) {
+                return -1;
+            } else {
+                opcoes->arenaMB = numero;
+            }
+        }
+    }
+    argv[novoArgc] = NULL;
+    return novoArgc;
+}
+
+// Imprime a lista de opções do serviço aceitas no papel dado
+void imprimirOpcoesServico(FILE *saida, PapelServico papel) {
+    fprintf(saida, "Opções do serviço:\n");
+    fprintf(saida, "  --socket <caminho>         Socket Unix do servidor (padrão: %s)\n", SERVICO_SOCKET_PADRAO);
+    if (papel == SERVICO_CLIENTE) {
+        fprintf(saida, "  --algoritmo <nome>         quicksort-seq, quicksort-conc, minmax-seq, minmax-conc, corridas,\n");
+        fprintf(saida, "                             contagem, aprendida, duplo-pivo-seq, duplo-pivo-conc, mesclagem ou\n");
+        fprintf(saida, "                             mesclagem-local (padrão: quicksort-conc)\n");
+    } else {
+        fprintf(saida, "  --max-tarefas <N>          Ordenações simultâneas (padrão: %d)\n", SERVICO_MAX_TAREFAS_PADRAO);
+        fprintf(saida, "  --fila <N>                 Pedidos aguardando antes de recusar (padrão: %d)\n", SERVICO_FILA_PADRAO);
+        fprintf(saida, "  --arena <MB>               Arena temporária pré-tocada por tarefa (padrão: %d)\n", SERVICO_ARENA_PADRAO_MB);
+    }
+}
+
+// Retorna a descrição da situação
+const char *descricaoStatusServico(int status) {
+    switch (status) {
+        case SERVICO_OK:              return "ok";
+        case SERVICO_OCUPADO:         return "servidor ocupado (fila cheia)";
+        case SERVICO_PEDIDO_INVALIDO: return "pedido inválido";
+        default:                      return "erro na ordenação";
+    }
+}
+
+// Função para preencher o endereço do socket; retorna -1 se o caminho for longo demais
+static int montarEndereco(struct sockaddr_un *endereco, const char *caminho) {
+    memset(endereco, 0, sizeof(*endereco));
+    endereco->sun_family = AF_UNIX;
+    if (strlen(caminho) >= sizeof(endereco->sun_path)) {
+        fprintf(stderr, "Erro: caminho do socket longo demais: %s\n", caminho);
+        return -1;
+    }
+    strcpy(endereco->sun_path, caminho);
+    return 0;
+}
+
+// Cria o socket do servidor
+int escutarServico(const char *caminho) {
+    struct sockaddr_un endereco;
+    if (montarEndereco(&endereco, caminho) < 0) {
+        return -1;
+    }
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        perror("Erro ao criar o socket");
+        return -1;
+    }
+
+    // Remover o socket de uma execução anterior
+    unlink(caminho);
+    if (bind(sock, (struct sockaddr *)&endereco, sizeof(endereco)) < 0 || listen(sock, 64) < 0) {
+        perror("Erro ao escutar no socket");
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+// Conecta ao servidor
+int conectarServico(const char *caminho) {
+    struct sockaddr_un endereco;
+    if (montarEndereco(&endereco, caminho) < 0) {
+        return -1;
+    }
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        perror("Erro ao criar o socket");
+        return -1;
+    }
+    if (connect(sock, (struct sockaddr *)&endereco, sizeof(endereco)) < 0) {
+        fprintf(stderr, "Erro ao conectar ao servidor em %s: %s\n", caminho, strerror(errno));
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+// Função para enviar todos os bytes do buffer
+static int enviarTudo(int sock, const void *dados, size_t tamanho) {
+    const char *p = (const char *)dados;
+    while (tamanho > 0) {
+        ssize_t ret = send(sock, p, tamanho, MSG_NOSIGNAL);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            return -1;
+        }
+        p += ret;
+        tamanho -= (size_t)ret;
+    }
+    return 0;
+}
+
+// Função para receber exatamente tamanho bytes; retorna 1 se a conexão foi encerrada antes
+static int receberTudo(int sock, void *dados, size_t tamanho) {
+    char *p = (char *)dados;
+    while (tamanho > 0) {
+        ssize_t ret = recv(sock, p, tamanho, 0);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0) {
+            return -1;
+        }
+        if (ret == 0) {
+            return 1;
+        }
+        p += ret;
+        tamanho -= (size_t)ret;
+    }
+    return 0;
+}
+
+// Envia o pedido junto com o descritor fdDados
+int enviarPedido(int sock, const PedidoOrdenacao *pedido, int fdDados) {
+    struct iovec iov = { (void *)pedido, sizeof(*pedido) };
+    char controle[CMSG_SPACE(sizeof(int))];
+    memset(controle, 0, sizeof(controle));
+
+    struct msghdr mensagem = {0};
+    mensagem.msg_iov = &iov;
+    mensagem.msg_iovlen = 1;
+    mensagem.msg_control = controle;
+    mensagem.msg_controllen = sizeof(controle);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&mensagem);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fdDados, sizeof(int));
+
+    ssize_t ret;
+    do {
+        ret = sendmsg(sock, &mensagem, MSG_NOSIGNAL);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        return -1;
+    }
+
+    // O descritor segue com o primeiro byte; o restante do pedido vai sem controle
+    return enviarTudo(sock, (const char *)pedido + ret, sizeof(*pedido) - (size_t)ret);
+}
+
+// Recebe um pedido e o descritor enviado com ele
+int receberPedido(int sock, PedidoOrdenacao *pedido, int *fdDados) {
+    struct iovec iov = { pedido, sizeof(*pedido) };
+    char controle[CMSG_SPACE(sizeof(int))];
+    struct msghdr mensagem = {0};
+    mensagem.msg_iov = &iov;
+    mensagem.msg_iovlen = 1;
+    mensagem.msg_control = controle;
+    mensagem.msg_controllen = sizeof(controle);
+
+    *fdDados = -1;
+    ssize_t ret;
+    do {
+        ret = recvmsg(sock, &mensagem, MSG_CMSG_CLOEXEC);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        return -1;
+    }
+    if (ret == 0) {
+        return 1;
+    }
+
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&mensagem); cmsg; cmsg = CMSG_NXTHDR(&mensagem, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            memcpy(fdDados, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+
+    // Completar o restante do pedido
+    int erro = receberTudo(sock, (char *)pedido + ret, sizeof(*pedido) - (size_t)ret);
+    if (erro != 0 && *fdDados >= 0) {
+        close(*fdDados);
+        *fdDados = -1;
+    }
+    return erro != 0 ? -1 : 0;
+}
+
+// Envia a resposta
+int enviarResposta(int sock, const RespostaOrdenacao *resposta) {
+    return enviarTudo(sock, resposta, sizeof(*resposta));
+}
+
+// Recebe a resposta
+int receberResposta(int sock, RespostaOrdenacao *resposta) {
+    return receberTudo(sock, resposta, sizeof(*resposta)) == 0 ? 0 : -1;
+}
+
+// Função para obter o tamanho mapeado de um vetor compartilhado (nunca zero)
+static size_t tamanhoMapeamento(long n) {
+    return n > 0 ? (size_t)n * sizeof(int) : sizeof(int);
+}
+
+// Cria um memfd com espaço para n inteiros e o mapeia
+int *criarVetorCompartilhado(long n, int *fd) {
+    size_t bytes = tamanhoMapeamento(n);
+    *fd = memfd_create("concsort", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (*fd < 0) {
+        perror("Erro ao criar o memfd");
+        return NULL;
+    }
+    if (ftruncate(*fd, (off_t)bytes) < 0) {
+        perror("Erro ao dimensionar o memfd");
+        close(*fd);
+        return NULL;
+    }
+    void *vetor = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, *fd, 0);
+    if (vetor == MAP_FAILED) {
+        perror("Erro ao mapear o memfd");
+        close(*fd);
+        return NULL;
+    }
+    return (int *)vetor;
+}
+
+// Sela o tamanho do memfd antes do envio ao servidor
+int selarVetorCompartilhado(int fd) {
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) < 0) {
+        perror("Erro ao selar o memfd");
+        return -1;
+    }
+    return 0;
+}
+
+// Mapeia os n inteiros de um memfd recebido
+int *mapearVetorCompartilhado(int fd, long n) {
+    // Sem o selo, o cliente poderia reduzir o memfd depois da verificação do tamanho
+    int selos = fcntl(fd, F_GET_SEALS);
+    if (selos < 0 || (selos & (F_SEAL_SHRINK | F_SEAL_GROW)) != (F_SEAL_SHRINK | F_SEAL_GROW)) {
+        return NULL;
+    }
+
+    size_t bytes = tamanhoMapeamento(n);
+    struct stat st;
+    if (n < 0 || fstat(fd, &st) < 0 || (size_t)st.st_size < bytes) {
+        return NULL;
+    }
+
+    void *vetor = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return vetor == MAP_FAILED ? NULL : (int *)vetor;
+}
+
+// Desfaz o mapeamento de um vetor compartilhado
+void liberarVetorCompartilhado(int *vetor, long n) {
+    munmap(vetor, tamanhoMapeamento(n));
+}
@@ -0,0 +1,434 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include "Topologia.h"
+#include "Memoria.h"
+
+// Dados de cada thread do primeiro toque
+typedef struct {
+    const PlanoNUMA *plano;
+    int indice;
+    char *inicio;
+    size_t tamanho;
+} SegmentoPrimeiroToque;
+
+// Converte o nome da política; retorna -1 se for inválido
+int politicaAfinidadeDoNome(const char *nome, PoliticaAfinidade *politica) {
+    if (strcmp(nome, "nenhuma") == 0) {
+        *politica = AFINIDADE_NENHUMA;
+    } else if (strcmp(nome, "compacta") == 0) {
+        *politica = AFINIDADE_COMPACTA;
+    } else if (strcmp(nome, "espalhada") == 0) {
+        *politica = AFINIDADE_ESPALHADA;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+// Retorna o nome da política
+const char *nomePoliticaAfinidade(PoliticaAfinidade politica) {
+    switch (politica) {
+        case AFINIDADE_COMPACTA:  return "compacta";
+        case AFINIDADE_ESPALHADA: return "espalhada";
+        default:                  return "nenhuma";
+    }
+}
+
+// Função para acrescentar as CPUs de uma lista no formato do kernel ("0-3,8-11")
+static void lerListaCpus(Topologia *topologia, const char *lista) {
+    const char *p = lista;
+    while (*p && *p != '\n') {
+        char *fim;
+        long a = strtol(p, &fim, 10);
+        long b = a;
+        if (fim == p) {
+            break;
+        }
+        if (*fim == '-') {
+            p = fim + 1;
+            b = strtol(p, &fim, 10);
+        }
+        for (long c = a; c <= b && topologia->numCpus < TOPO_MAX_CPUS; c++) {
+            topologia->cpus[topologia->numCpus++] = (int)c;
+        }
+        p = (*fim == ',') ? fim + 1 : fim;
+    }
+}
+
+// Função para montar a topologia falsa "NxC"
+static int montarTopologiaFalsa(Topologia *topologia, const char *especificacao) {
+    int nos, cpusPorNo;
+    char resto;
+    if (sscanf(especificacao, "%dx%d%c", &nos, &cpusPorNo, &resto) != 2 ||
+        nos <= 0 || cpusPorNo <= 0 || nos > TOPO_MAX_NOS || nos * cpusPorNo > TOPO_MAX_CPUS) {
+        return -1;
+    }
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online < 1) {
+        online = 1;
+    }
+
+    topologia->falsa = 1;
+    topologia->numNos = nos;
+    for (int no = 0; no < nos; no++) {
+        topologia->inicioNo[no] = topologia->numCpus;
+        for (int c = 0; c < cpusPorNo; c++) {
+            // CPUs virtuais mapeadas nas reais
+            topologia->cpus[topologia->numCpus] = topologia->numCpus % (int)online;
+            topologia->numCpus++;
+        }
+    }
+    topologia->inicioNo[nos] = topologia->numCpus;
+    return 0;
+}
+
+// Lê a topologia real ou monta a falsa descrita por especificacao
+int lerTopologia(Topologia *topologia, const char *especificacao) {
+    memset(topologia, 0, sizeof(*topologia));
+    if (especificacao) {
+        return montarTopologiaFalsa(topologia, especificacao);
+    }
+
+    // Nós numerados de forma contígua em /sys/devices/system/node/nodeN
+    for (int no = 0; no < TOPO_MAX_NOS; no++) {
+        char caminho[128];
+        snprintf(caminho, sizeof(caminho), "/sys/devices/system/node/node%d/cpulist", no);
+        FILE *arquivo = fopen(caminho, "r");
+        if (!arquivo) {
+            break;
+        }
+        char lista[4096];
+        topologia->inicioNo[no] = topologia->numCpus;
+        if (fgets(lista, sizeof(lista), arquivo)) {
+            lerListaCpus(topologia, lista);
+        }
+        fclose(arquivo);
+        topologia->numNos = no + 1;
+    }
+
+    // Sem informação de NUMA: um único nó com todas as CPUs
+    if (topologia->numNos == 0 || topologia->numCpus == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        topologia->numNos = 1;
+        topologia->numCpus = 0;
+        topologia->inicioNo[0] = 0;
+        for (long c = 0; c < online && c < TOPO_MAX_CPUS; c++) {
+            topologia->cpus[topologia->numCpus++] = (int)c;
+        }
+        if (topologia->numCpus == 0) {
+            topologia->cpus[topologia->numCpus++] = 0;
+        }
+    }
+    topologia->inicioNo[topologia->numNos] = topologia->numCpus;
+    return 0;
+}
+
+// Prepara o plano
+int iniciarPlanoNUMA(PlanoNUMA *plano, PoliticaAfinidade politica, const char *topologiaFalsa, int numThreads) {
+    plano->politica = politica;
+    plano->numThreads = numThreads > 0 ? numThreads : 1;
+    return lerTopologia(&plano->topologia, topologiaFalsa);
+}
+
+// Retorna 1 se o plano fixa threads
+int planoNUMAAtivo(const PlanoNUMA *plano) {
+    return plano && plano->politica != AFINIDADE_NENHUMA;
+}
+
+// Função para obter a posição (em topologia->cpus) da thread de índice indice
+static int posicaoDaThread(const PlanoNUMA *plano, int indice) {
+    const Topologia *t = &plano->topologia;
+    if (indice < 0) {
+        indice = 0;
+    }
+
+    if (plano->politica == AFINIDADE_ESPALHADA) {
+        int no = indice % t->numNos;
+        int cpusNoNo = t->inicioNo[no + 1] - t->inicioNo[no];
+        if (cpusNoNo <= 0) {
+            return indice % t->numCpus;
+        }
+        return t->inicioNo[no] + (indice / t->numNos) % cpusNoNo;
+    }
+    return indice % t->numCpus;
+}
+
+// CPU (real) em que a thread de índice indice deve executar
+int cpuDaThread(const PlanoNUMA *plano, int indice) {
+    return plano->topologia.cpus[posicaoDaThread(plano, indice)];
+}
+
+// Nó da thread de índice indice
+int noDaThread(const PlanoNUMA *plano, int indice) {
+    const Topologia *t = &plano->topologia;
+    int posicao = posicaoDaThread(plano, indice);
+    int no = 0;
+    while (no + 1 < t->numNos && t->inicioNo[no + 1] <= posicao) {
+        no++;
+    }
+    return no;
+}
+
+// Cria uma thread fixada na CPU do índice indice
+int criarThreadFixada(pthread_t *thread, const PlanoNUMA *plano, int indice,
+                      void *(*funcao)(void *), void *arg) {
+    if (!planoNUMAAtivo(plano)) {
+        return pthread_create(thread, NULL, funcao, arg);
+    }
+
+    pthread_attr_t atributos;
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpuDaThread(plano, indice), &conjunto);
+
+    pthread_attr_init(&atributos);
+    pthread_attr_setaffinity_np(&atributos, sizeof(conjunto), &conjunto);
+    int ret = pthread_create(thread, &atributos, funcao, arg);
+    pthread_attr_destroy(&atributos);
+
+    // CPU fora do cpuset do processo: criar sem afinidade
+    if (ret != 0) {
+        ret = pthread_create(thread, NULL, funcao, arg);
+    }
+    return ret;
+}
+
+// Fixa a thread atual na CPU do índice indice
+void fixarThreadAtual(const PlanoNUMA *plano, int indice) {
+    if (!planoNUMAAtivo(plano)) {
+        return;
+    }
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpuDaThread(plano, indice), &conjunto);
+    sched_setaffinity(0, sizeof(conjunto), &conjunto);
+}
+
+// Função executada por cada thread do primeiro toque
+static void *tocarSegmento(void *arg) {
+    SegmentoPrimeiroToque *seg = (SegmentoPrimeiroToque *)arg;
+    const PlanoNUMA *plano = seg->plano;
+
+    // Na topologia real, associar as páginas ao nó da thread que vai ordenar o segmento
+    if (!plano->topologia.falsa && plano->topologia.numNos > 1) {
+        unsigned long mascara = 1ul << noDaThread(plano, seg->indice);
+        syscall(__NR_mbind, seg->inicio, seg->tamanho, MPOL_PREFERRED,
+                &mascara, sizeof(mascara) * 8, 0);
+    }
+
+    // Tocar uma vez cada página para que ela seja alocada a partir desta CPU
+    long pagina = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < seg->tamanho; i += (size_t)pagina) {
+        seg->inicio[i] = 0;
+    }
+    return NULL;
+}
+
+// Faz o primeiro toque do buffer em paralelo, segmento i no nó da thread i
+void distribuirPaginas(const PlanoNUMA *plano, void *buffer, size_t bytes) {
+    if (!planoNUMAAtivo(plano) || bytes == 0) {
+        return;
+    }
+
+    int numSegmentos = plano->numThreads;
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    pthread_t *threads = malloc(numSegmentos * sizeof(pthread_t));
+    SegmentoPrimeiroToque *segmentos = malloc(numSegmentos * sizeof(SegmentoPrimeiroToque));
+    if (!threads || !segmentos) {
+        free(threads);
+        free(segmentos);
+        return;
+    }
+
+    // Limites dos segmentos alinhados a páginas (mbind exige endereço alinhado)
+    char *base = (char *)buffer;
+    int criadas = 0;
+    for (int i = 0; i < numSegmentos; i++) {
+        size_t inicio = (bytes / numSegmentos) * i / pagina * pagina;
+        size_t fim = (i == numSegmentos - 1) ? bytes : (bytes / numSegmentos) * (i + 1) / pagina * pagina;
+        segmentos[i].plano = plano;
+        segmentos[i].indice = i;
+        segmentos[i].inicio = base + inicio;
+        segmentos[i].tamanho = fim - inicio;
+        if (criarThreadFixada(&threads[criadas], plano, i, tocarSegmento, &segmentos[i]) == 0) {
+            criadas++;
+        } else {
+            tocarSegmento(&segmentos[i]);
+        }
+    }
+    for (int i = 0; i < criadas; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    free(segmentos);
+}
+
+// Função usada como gancho de distribuição do alocador
+static void distribuirBufferAlocado(void *buffer, size_t bytes, void *contexto) {
+    distribuirPaginas((const PlanoNUMA *)contexto, buffer, bytes);
+}
+
+// Faz com que os buffers de alocarBuffer sejam distribuídos segundo o plano
+void ativarPrimeiroToqueNUMA(const PlanoNUMA *plano) {
+    if (planoNUMAAtivo(plano)) {
+        definirDistribuicaoMemoria(distribuirBufferAlocado, (void *)plano);
+    }
+}
+
+// Imprime uma linha descrevendo o plano
+void descreverPlanoNUMA(const PlanoNUMA *plano, FILE *saida) {
+    if (!planoNUMAAtivo(plano)) {
+        return;
+    }
+    const Topologia *t = &plano->topologia;
+    fprintf(saida, "Afinidade %s: %d nó(s), %d CPU(s)%s; threads -> nó:CPU:",
+            nomePoliticaAfinidade(plano->politica), t->numNos, t->numCpus,
+            t->falsa ? " (topologia falsa)" : "");
+    for (int i = 0; i < plano->numThreads && i < 16; i++) {
+        fprintf(saida, " %d:%d", noDaThread(plano, i), cpuDaThread(plano, i));
+    }
+    fprintf(saida, "%s\n", plano->numThreads > 16 ? " ..." : "");
+}
+
+// Função para ler a cota de um arquivo cpu.max do cgroup v2 ("cota período" ou "max período")
+static int lerCpuMax(const char *caminho, double *cpus) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        return -1;
+    }
+    char cota[32];
+    long periodo;
+    int lidos = fscanf(arquivo, "%31s %ld", cota, &periodo);
+    fclose(arquivo);
+    if (lidos != 2 || strcmp(cota, "max") == 0 || periodo <= 0) {
+        return -1;
+    }
+    *cpus = atol(cota) / (double)periodo;
+    return *cpus > 0 ? 0 : -1;
+}
+
+// Função para ler a cota dos arquivos cpu.cfs_quota_us e cpu.cfs_period_us do cgroup v1
+static int lerCfsQuota(const char *diretorio, double *cpus) {
+    char caminho[512];
+    long cota = -1, periodo = 0;
+    snprintf(caminho, sizeof(caminho), "%s/cpu.cfs_quota_us", diretorio);
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        return -1;
+    }
+    int lido = fscanf(arquivo, "%ld", &cota);
+    fclose(arquivo);
+    snprintf(caminho, sizeof(caminho), "%s/cpu.cfs_period_us", diretorio);
+    arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        return -1;
+    }
+    lido += fscanf(arquivo, "%ld", &periodo);
+    fclose(arquivo);
+    if (lido != 2 || cota <= 0 || periodo <= 0) {
+        return -1;
+    }
+    *cpus = cota / (double)periodo;
+    return 0;
+}
+
+// Função para saber se a lista de controladores do cgroup v1 ("cpu,cpuacct") inclui "cpu"
+static int incluiControladorCpu(const char *controladores) {
+    const char *p = controladores;
+    while (*p) {
+        size_t tamanho = strcspn(p, ",");
+        if (tamanho == 3 && strncmp(p, "cpu", 3) == 0) {
+            return 1;
+        }
+        p += tamanho;
+        if (*p == ',') {
+            p++;
+        }
+    }
+    return 0;
+}
+
+// Lê a cota de CPU do cgroup do processo; retorna -1 se não houver cota
+int lerCotaCgroup(double *cpus) {
+    char caminho[512];
+
+    // Caminhos do processo em /proc/self/cgroup ("0::/caminho" no v2, "N:cpu,cpuacct:/caminho" no v1)
+    FILE *arquivo = fopen("/proc/self/cgroup", "r");
+    if (arquivo) {
+        char linha[512];
+        while (fgets(linha, sizeof(linha), arquivo)) {
+            linha[strcspn(linha, "\n")] = '\0';
+            char *controladores = strchr(linha, ':');
+            char *grupo = controladores ? strchr(controladores + 1, ':') : NULL;
+            if (!grupo) {
+                continue;
+            }
+            *grupo++ = '\0';
+            controladores++;
+            if (strcmp(grupo, "/") == 0) {
+                grupo = "";
+            }
+
+            int encontrado = -1;
+            if (*controladores == '\0') {
+                snprintf(caminho, sizeof(caminho), "/sys/fs/cgroup%s/cpu.max", grupo);
+                encontrado = lerCpuMax(caminho, cpus);
+                if (encontrado != 0) {
+                    snprintf(caminho, sizeof(caminho), "/sys/fs/cgroup/unified%s/cpu.max", grupo);
+                    encontrado = lerCpuMax(caminho, cpus);
+                }
+            } else if (incluiControladorCpu(controladores)) {
+                snprintf(caminho, sizeof(caminho), "/sys/fs/cgroup/cpu%s", grupo);
+                encontrado = lerCfsQuota(caminho, cpus);
+                if (encontrado != 0) {
+                    snprintf(caminho, sizeof(caminho), "/sys/fs/cgroup/cpu,cpuacct%s", grupo);
+                    encontrado = lerCfsQuota(caminho, cpus);
+                }
+            }
+            if (encontrado == 0) {
+                fclose(arquivo);
+                return 0;
+            }
+        }
+        fclose(arquivo);
+    }
+
+    // Contêineres com o próprio cgroup montado na raiz
+    if (lerCpuMax("/sys/fs/cgroup/cpu.max", cpus) == 0 || lerCfsQuota("/sys/fs/cgroup/cpu", cpus) == 0) {
+        return 0;
+    }
+    return -1;
+}
+
+// Retorna o número de CPUs disponíveis ao processo
+int cpusDisponiveis(void) {
+    int cpus = 0;
+    cpu_set_t mascara;
+    if (sched_getaffinity(0, sizeof(mascara), &mascara) == 0) {
+        cpus = CPU_COUNT(&mascara);
+    }
+    if (cpus < 1) {
+        cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+
+    double cota;
+    if (lerCotaCgroup(&cota) == 0) {
+        int limite = (int)cota;
+        if (limite < cota) {
+            limite++;
+        }
+        if (limite < cpus) {
+            cpus = limite;
+        }
+    }
+    return cpus > 0 ? cpus : 1;
+}
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include "Common/IndiceEsparso.h"
+
+/*
+ * Descrição:
+ * Este programa responde consultas de faixa sobre um arquivo binário ordenado usando o seu
+ * índice esparso (<arquivo>.idx, gravado com --indice-esparso ou pelo comando construir;
+ * ver Common/IndiceEsparso.h), sem ler o arquivo inteiro: o arquivo é mapeado, a busca
+ * percorre a árvore de cercas do índice e só as páginas do bloco encontrado são lidas.
+ *
+ * Comandos:
+ * - contar <a> <b>: número de valores em [a, b];
+ * - maiores <x> [quantidade]: posição do primeiro valor >= x e os próximos valores (padrão: 10);
+ * - construir: grava o índice de um arquivo ordenado já existente.
+ *
+ * O tempo de cada consulta (sem a abertura dos arquivos) é exibido em microssegundos.
+ */
+
+#define QUANTIDADE_PADRAO 10
+
+// Macro para obter o tempo em segundos (relógio monotônico, com resolução de nanossegundos)
+#define OBTER_TEMPO(agora) { \
+    struct timespec t; \
+    clock_gettime(CLOCK_MONOTONIC, &t); \
+    agora = t.tv_sec + t.tv_nsec / 1e9; \
+}
+
+// Função para ler uma chave inteira de 32 bits; retorna -1 se o valor for inválido
+static int lerChave(const char *valor, int *chave) {
+    char *fim;
+    errno = 0;
+    long v = strtol(valor, &fim, 10);
+    if (*valor == '\0' || *fim != '\0' || errno != 0 || v < INT_MIN || v > INT_MAX) {
+        fprintf(stderr, "Valor inválido: %s\n", valor);
+        return -1;
+    }
+    *chave = (int)v;
+    return 0;
+}
+
+// Função para imprimir o uso do programa
+static void imprimirUso(const char *programa) {
+    fprintf(stderr, "Uso: %s <arquivo_ordenado> contar <a> <b>\n", programa);
+    fprintf(stderr, "     %s <arquivo_ordenado> maiores <x> [quantidade]\n", programa);
+    fprintf(stderr, "     %s <arquivo_ordenado> construir\n", programa);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        imprimirUso(argv[0]);
+        return 1;
+    }
+    const char *arquivo = argv[1];
+    const char *comando = argv[2];
+
+    if (strcmp(comando, "construir") == 0 && argc == 3) {
+        double inicio, fim;
+        OBTER_TEMPO(inicio);
+        if (construirIndiceEsparso(arquivo) != 0) {
+            return 1;
+        }
+        OBTER_TEMPO(fim);
+        printf("Índice esparso salvo em %s%s (%f segundos)\n", arquivo, INDICE_EXTENSAO, fim - inicio);
+        return 0;
+    }
+
+    int contar = strcmp(comando, "contar") == 0 && argc == 5;
+    int maiores = strcmp(comando, "maiores") == 0 && (argc == 4 || argc == 5);
+    if (!contar && !maiores) {
+        imprimirUso(argv[0]);
+        return 1;
+    }
+
+    int a, b = 0;
+    long quantidade = QUANTIDADE_PADRAO;
+    if (lerChave(argv[3], &a) != 0 || (contar && lerChave(argv[4], &b) != 0)) {
+        return 1;
+    }
+    if (maiores && argc == 5) {
+        quantidade = atol(argv[4]);
+        if (quantidade < 0) {
+            fprintf(stderr, "A quantidade não pode ser negativa.\n");
+            return 1;
+        }
+    }
+
+    IndiceEsparso indice;
+    if (abrirIndiceEsparso(arquivo, &indice) != 0) {
+        return 1;
+    }
+    printf("Arquivo: %d valores em %d blocos de %d\n", indice.n, indice.numBlocos, indice.passo);
+
+    double inicio, fim;
+    int erro = 0;
+    if (contar) {
+        OBTER_TEMPO(inicio);
+        long primeiro = limiteInferiorIndice(&indice, a);
+        long ultimo = a <= b ? limiteSuperiorIndice(&indice, b) : primeiro;
+        OBTER_TEMPO(fim);
+        erro = primeiro < 0 || ultimo < 0;
+        if (!erro) {
+            printf("Valores em [%d, %d]: %ld (posições %ld a %ld)\n", a, b, ultimo > primeiro ? ultimo - primeiro : 0,
+                   primeiro, ultimo);
+        }
+    } else {
+        OBTER_TEMPO(inicio);
+        long primeiro = limiteInferiorIndice(&indice, a);
+        OBTER_TEMPO(fim);
+        erro = primeiro < 0;
+        if (!erro) {
+            printf("Valores >= %d: %ld (a partir da posição %ld)\n", a, indice.n - primeiro, primeiro);
+            for (long i = primeiro; i < indice.n && i < primeiro + quantidade; i++) {
+                printf("%d\n", indice.valores[i]);
+            }
+        }
+    }
+    if (!erro) {
+        printf("Tempo de consulta: %.1f microssegundos (%ld bloco(s) do arquivo lidos)\n", (fim - inicio) * 1e6,
+               indice.blocosLidos);
+    }
+
+    fecharIndiceEsparso(&indice);
+    return erro ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Common/EntradaSaida.h"
+#include "Common/Memoria.h"
+
+// Descrição: Este programa gera um arquivo segmentado (ver Common/EntradaSaida.h) com
+// muitos vetores pequenos de inteiros aleatórios, para a ordenação segmentada. Ele recebe
+// o nome do arquivo de saída, o número de segmentos e o tamanho máximo de cada segmento;
+// o tamanho de cada segmento é sorteado entre 0 e o máximo.
+
+int main(int argc, char *argv[]) {
+    // Verificar se o número de argumentos está correto
+    if (argc != 4) {
+        fprintf(stderr, "Uso: %s <arquivo_saida> <num_segmentos> <tamanho_max>\n", argv[0]);
+        return 1;
+    }
+
+    const char *nomeArquivo = argv[1];
+    int numSegmentos = atoi(argv[2]);
+    int tamanhoMax = atoi(argv[3]);
+    if (numSegmentos <= 0 || tamanhoMax <= 0) {
+        fprintf(stderr, "O número de segmentos e o tamanho máximo devem ser positivos.\n");
+        return 1;
+    }
+
+    srand(time(NULL));
+
+    // Sortear o tamanho de cada segmento
+    long *deslocamentos = malloc((size_t)(numSegmentos + 1) * sizeof(long));
+    if (!deslocamentos) {
+        fprintf(stderr, "Falha na alocação de memória\n");
+        return 1;
+    }
+    deslocamentos[0] = 0;
+    for (int s = 0; s < numSegmentos; s++) {
+        deslocamentos[s + 1] = deslocamentos[s] + rand() % (tamanhoMax + 1);
+    }
+    if (deslocamentos[numSegmentos] > 0x7fffffff) {
+        fprintf(stderr, "O total de elementos não cabe no formato do arquivo.\n");
+        free(deslocamentos);
+        return 1;
+    }
+
+    // Gerar os valores entre -total e total
+    long n = deslocamentos[numSegmentos];
+    int *valores = (int *)alocarBuffer((size_t)n * sizeof(int));
+    if (!valores && n > 0) {
+        fprintf(stderr, "Falha na alocação de memória\n");
+        free(deslocamentos);
+        return 1;
+    }
+    for (long i = 0; i < n; i++) {
+        valores[i] = (int)(rand() % (2 * n + 1) - n);
+    }
+
+    ConfiguracaoES config;
+    configuracaoESPadrao(&config);
+    int erro = gravarSegmentosArquivo(nomeArquivo, valores, deslocamentos, numSegmentos, &config);
+    if (erro == 0) {
+        printf("%d segmentos (%ld elementos) salvos em %s\n", numSegmentos, n, nomeArquivo);
+    }
+
+    liberarBuffer(valores);
+    free(deslocamentos);
+    return erro == 0 ? 0 : 1;
+}
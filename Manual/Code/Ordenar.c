@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "Common/Despacho.h"
+#include "Common/MesclagemIncremental.h"
+#include "Common/Opcoes.h"
+#include "Common/Registro.h"
+
+/*
+ * Descrição:
+ * Este programa é a porta de entrada automática dos algoritmos de ordenação: em vez de o
+ * operador escolher entre SeqQuicksort, ConcQuickSort, SeqMinMax e ConcMinMax, ele lê o
+ * vetor do arquivo binário de entrada, mede o perfil da entrada (tamanho, faixa de
+ * valores, duplicatas e pré-ordenação) e escolhe, por um modelo de custo, o algoritmo e o
+ * número de threads (ver Common/Despacho.h). O número máximo de threads é opcional (padrão:
+ * uma por CPU disponível, respeitando a cota do cgroup). Os coeficientes do modelo vêm do
+ * perfil de ajuste da máquina (Autoajuste), quando houver. A passada de medida do perfil é
+ * dividida entre as threads do mesmo pool que depois executa o plano.
+ *
+ * O perfil, o tempo previsto de cada candidato e o plano escolhido são exibidos. O tempo
+ * de ordenação é registrado em Data/ordenar.txt, e o plano, com o tempo previsto e o real,
+ * em Data/despacho.csv.
+ *
+ * No modo incremental (--base), a entrada é um lote pequeno de valores novos (o delta), a
+ * ser acrescentado a um arquivo já ordenado: só o delta é ordenado, pelo plano escolhido, e
+ * depois mesclado à base em uma única passada sequencial, com galope e cópia em bloco dos
+ * trechos intactos (ver Common/MesclagemIncremental.h). A saída pode ser a própria base. O
+ * tempo total (ordenação do delta e mesclagem) é registrado como OrdenarIncremental.
+ *
+ * Com --afinidade, as threads do plano são fixadas em CPUs e o vetor é tocado pela primeira
+ * vez distribuído entre os nós (ver Common/Topologia.h). Com --preordenacao, as métricas de
+ * pré-ordenação do perfil (sempre medidas) são registradas também em Data/preordenacao.csv.
+ * O algoritmo e a compactação das chaves em 8/16 bits (candidata do plano quando a faixa da
+ * amostra cabe nessas larguras) são escolhidos pelo plano e só um arquivo é ordenado por
+ * vez, de forma que --duplo-pivo, --compactar, --argsort e o modo em lote são recusados.
+ */
+
+// Opções comuns implementadas por este programa
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO | \
+                        OPCOES_GRUPO_AFINIDADE | OPCOES_GRUPO_PREORDENACAO | OPCOES_GRUPO_AJUSTE)
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    OpcoesIncremental incremental;
+    argc = extrairOpcoesIncremental(argc, argv, &incremental);
+    if (argc >= 0) {
+        argc = extrairOpcoes(argc, argv, &opcoes);
+    }
+    if (argc != 3 && argc != 4) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> [max_threads] [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        imprimirOpcoesIncremental(stderr);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    int maxThreads = argc == 4 ? atoi(argv[3]) : cpusDisponiveis();
+    if (maxThreads <= 0) {
+        fprintf(stderr, "O número de threads deve ser positivo.\n");
+        return 1;
+    }
+
+    // Garantir que o diretório e o arquivo de log existam
+    garantirDiretorioEArquivo("Data/ordenar.txt");
+
+    // Preparar a afinidade antes da leitura, para que o primeiro toque distribua o vetor
+    PlanoNUMA numa;
+    int afinidade = iniciarPlanoNUMA(&numa, opcoes.afinidade, opcoes.topologia, maxThreads) == 0 &&
+                    planoNUMAAtivo(&numa);
+    if (afinidade) {
+        fixarThreadAtual(&numa, 0);
+        ativarPrimeiroToqueNUMA(&numa);
+        descreverPlanoNUMA(&numa, stdout);
+    }
+
+    // Ler o vetor de inteiros do arquivo binário de entrada
+    int n;
+    int *vetor = lerVetorArquivo(argv[1], &n, &opcoes.es);
+    if (!vetor) {
+        return 1;
+    }
+
+    printf("Tamanho do array: %d\n", n);
+
+    // Criar o pool com maxThreads, usado pelo perfil e pelo plano (com afinidade, com as
+    // threads fixadas)
+    PoolThreads *pool = criarPoolThreads(maxThreads, afinidade ? &numa : NULL);
+    if (!pool) {
+        liberarBuffer(vetor);
+        return 1;
+    }
+
+    // Medir o perfil da entrada e escolher o plano
+    double inicio, fim;
+    ModeloCusto modelo;
+    PerfilEntrada perfil;
+    PlanoOrdenacao plano;
+    modeloCustoMaquina(&modelo);
+
+    OBTER_TEMPO(inicio);
+    perfilarEntrada(vetor, n, pool, &perfil);
+    planejarOrdenacao(&modelo, &perfil, maxThreads, &plano);
+    OBTER_TEMPO(fim);
+    double tempoPerfil = fim - inicio;
+
+    imprimirPerfil(stdout, &perfil);
+    imprimirCandidatos(stdout, &modelo, &perfil, maxThreads);
+    printf("Plano: %s com %d thread(s), tempo previsto: %f segundos (perfil em %f segundos)\n",
+           nomePlano(&plano), plano.numThreads, plano.tempoPrevisto, tempoPerfil);
+
+    // Executar o plano (com plano.numThreads trabalhadores do pool)
+    OBTER_TEMPO(inicio);
+    int erro = executarPlano(vetor, n, &plano, pool);
+    OBTER_TEMPO(fim);
+    double tempoGasto = fim - inicio;
+    destruirPoolThreads(pool);
+    if (erro != 0) {
+        liberarBuffer(vetor);
+        return 1;
+    }
+
+    printf("Tempo de ordenação: %f segundos (previsto: %f)\n", tempoGasto, plano.tempoPrevisto);
+    imprimirRelatorioMemoria(stdout);
+
+    // Modo incremental: mesclar o delta ordenado à base em vez de gravá-lo sozinho
+    if (incremental.base) {
+        EstatisticasIncremental estatisticas;
+        OBTER_TEMPO(inicio);
+        erro = mesclarDeltaArquivo(incremental.base, vetor, n, argv[2], incremental.mapear, &opcoes.es,
+                                   &estatisticas);
+        OBTER_TEMPO(fim);
+        liberarBuffer(vetor);
+        if (erro != 0) {
+            return 1;
+        }
+
+        imprimirEstatisticasIncremental(stdout, &estatisticas);
+        printf("Tempo de mesclagem: %f segundos (%s)\n", fim - inicio, incremental.mapear ? "mmap" : "arquivo");
+        registrarTempoNoArquivo("Data/ordenar.txt", "OrdenarIncremental", tempoGasto + (fim - inicio), n,
+                                plano.numThreads);
+        registrarDespacho("OrdenarIncremental", tempoGasto, tempoPerfil, &perfil, &plano);
+        if (opcoes.preordenacao) {
+            registrarPreordenacao("OrdenarIncremental", tempoGasto, n, plano.numThreads, &perfil.preordenacao);
+        }
+        printf("Array ordenado salvo em %s\n", argv[2]);
+        return 0;
+    }
+
+    // Registrar o tempo e o plano
+    registrarTempoNoArquivo("Data/ordenar.txt", "Ordenar", tempoGasto, n, plano.numThreads);
+    registrarDespacho("Ordenar", tempoGasto, tempoPerfil, &perfil, &plano);
+    if (opcoes.preordenacao) {
+        registrarPreordenacao("Ordenar", tempoGasto, n, plano.numThreads, &perfil.preordenacao);
+    }
+
+    // Escrever o vetor ordenado no arquivo de saída
+    if (gravarVetorArquivo(argv[2], vetor, n, &opcoes.es) != 0) {
+        liberarBuffer(vetor);
+        return 1;
+    }
+
+    printf("Array ordenado salvo em %s\n", argv[2]);
+
+    liberarBuffer(vetor);
+    return 0;
+}
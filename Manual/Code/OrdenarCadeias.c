@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "Common/Opcoes.h"
+#include "Common/OrdenacaoCadeias.h"
+#include "Common/Registro.h"
+
+/*
+ * Descrição:
+ * Este programa ordena um arquivo de cadeias de bytes de comprimento variável (cada uma
+ * precedida do seu comprimento, ver Common/EntradaSaida.h) na ordem lexicográfica dos
+ * bytes, com a ordenação de cadeias da biblioteca libconcsort (Common/OrdenacaoCadeias.h):
+ * um quicksort de múltiplas chaves sobre itens de 16 bytes com 7 bytes de cada cadeia em
+ * cache, dividido entre as threads pelo pool, seguido da cópia das cadeias na nova ordem.
+ *
+ * O tempo de ordenação (incluindo a montagem da coluna de saída) é medido, impresso e
+ * registrado em Data/cadeias.txt.
+ *
+ * Das opções comuns, aceita apenas as de E/S, --memoria, --afinidade e --topologia; as
+ * opções dos vetores de inteiros (--preordenacao, --compactar, --duplo-pivo, --ajuste,
+ * --argsort, --indice-esparso e o modo em lote) são recusadas com um erro.
+ */
+
+// Opções comuns implementadas por este programa: além da E/S (sem --es-direto, que o formato
+// de cadeias não usa) e de --memoria, só a afinidade (as demais são dos vetores de inteiros)
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_AFINIDADE)
+
+// Macro para obter o tempo em segundos
+#define OBTER_TEMPO(agora) { \
+    struct timeval t; \
+    gettimeofday(&t, NULL); \
+    agora = t.tv_sec + t.tv_usec / 1e6; \
+}
+
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
+    if (argc != 4) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> <num_threads> [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stderr, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
+
+    int numThreads = atoi(argv[3]);
+    if (numThreads <= 0) {
+        fprintf(stderr, "O número de threads deve ser positivo.\n");
+        return 1;
+    }
+
+    // Garantir que o diretório e o arquivo de log existam
+    garantirDiretorioEArquivo("Data/cadeias.txt");
+
+    // Preparar a afinidade das threads do pool
+    PlanoNUMA plano;
+    if (iniciarPlanoNUMA(&plano, opcoes.afinidade, opcoes.topologia, numThreads) == 0 && planoNUMAAtivo(&plano)) {
+        fixarThreadAtual(&plano, 0);
+        ativarPrimeiroToqueNUMA(&plano);
+        descreverPlanoNUMA(&plano, stdout);
+    }
+
+    PoolThreads *pool = criarPoolThreads(numThreads, &plano);
+    if (!pool) {
+        return 1;
+    }
+
+    // Ler as cadeias do arquivo de entrada
+    unsigned char *coluna;
+    size_t bytes;
+    int n;
+    if (lerCadeiasArquivo(argv[1], &coluna, &bytes, &n, &opcoes.es) != 0) {
+        destruirPoolThreads(pool);
+        return 1;
+    }
+
+    printf("Cadeias: %d, %zu bytes (%.1f bytes por cadeia em média)\n", n, bytes,
+           n > 0 ? (double)bytes / n - 4 : 0.0);
+
+    // O resultado vai para uma segunda coluna, de onde é gravado
+    unsigned char *ordenadas = alocarBuffer(bytes > 0 ? bytes : 1);
+    if (!ordenadas) {
+        printf("Erro: Falha na alocação de memória.\n");
+        liberarBuffer(coluna);
+        destruirPoolThreads(pool);
+        return 1;
+    }
+
+    double inicio, fim;
+    OBTER_TEMPO(inicio);
+    int erro = ordenarCadeias(coluna, ordenadas, bytes, n, pool, numThreads);
+    OBTER_TEMPO(fim);
+    destruirPoolThreads(pool);
+    liberarBuffer(coluna);
+
+    printf("Tempo de ordenação: %f segundos\n", fim - inicio);
+    imprimirRelatorioMemoria(stdout);
+
+    // Registrar o tempo e o número de threads no arquivo
+    registrarTempoNoArquivo("Data/cadeias.txt", "OrdenacaoCadeias", fim - inicio, n, numThreads);
+
+    // Gravar as cadeias ordenadas no arquivo de saída
+    if (erro != 0 || gravarCadeiasArquivo(argv[2], ordenadas, bytes, n, &opcoes.es) != 0) {
+        liberarBuffer(ordenadas);
+        return 1;
+    }
+
+    printf("Cadeias ordenadas salvas em %s\n", argv[2]);
+
+    liberarBuffer(ordenadas);
+    return 0;
+}
@@ -2,7 +2,10 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/time.h>
-#include <sys/stat.h>
+#include "Common/Lote.h"
+#include "Common/Opcoes.h"
+#include "Common/Ordenacao.h"
+#include "Common/Registro.h"
 
 /* 
  * Descrição:
@@ -15,12 +18,37 @@
  * Funcionalidades:
  * 1. Leitura do vetor de um arquivo binário.
  * 2. Verificação se o vetor está ordenado.
- * 3. Aplicação do algoritmo Min-Max Sort para ordenar o vetor.
+ * 3. Aplicação do algoritmo Min-Max Sort para ordenar o vetor (Common/Ordenacao.h).
  * 4. Medição do tempo de execução da ordenação.
  * 5. Salvamento do vetor ordenado em um novo arquivo binário.
  * 6. Exibição de algumas partes do vetor antes e após a ordenação.
+ *
+ * A leitura e a gravação dos arquivos podem usar io_uring ou pread/pwrite com
+ * várias requisições em voo (opção --es, ver Common/Opcoes.h).
+ *
+ * No modo em lote (--entradas ou --manifesto, ver Common/Lote.h), não há argumentos
+ * posicionais; com --lote-concorrente, os arquivos pequenos são ordenados ao mesmo tempo
+ * por um pool com uma thread por CPU.
+ *
+ * Com --preordenacao, uma passada linear mede quanto do vetor já está ordenado (ver
+ * Common/Preordenacao.h): vetores já ordenados não são tocados, vetores invertidos são
+ * apenas invertidos e vetores com corridas longas têm as corridas mescladas. As métricas
+ * são registradas em Data/preordenacao.csv.
+ *
+ * Com --compactar, chaves que cabem em 8 ou 16 bits depois de subtrair o mínimo são
+ * compactadas e ordenadas por radix sort (ver Common/Compactacao.h), com o tempo de cada
+ * fase registrado em Data/compactacao.csv.
+ *
+ * Com --argsort <arquivo>, a permutação que ordena a entrada (índices de 32 ou 64 bits,
+ * --indices) também é gravada, em um arquivo de permutação (ver Common/EntradaSaida.h).
  */
 
+// Opções comuns implementadas por este programa (o MinMaxSort não usa o perfil de ajuste,
+// a partição de dois pivôs nem a afinidade das threads)
+#define OPCOES_ACEITAS (OPCOES_GRUPO_ES | OPCOES_GRUPO_ES_DIRETO | OPCOES_GRUPO_INDICE_ESPARSO | \
+                        OPCOES_GRUPO_LOTE | OPCOES_GRUPO_PREORDENACAO | OPCOES_GRUPO_COMPACTAR | \
+                        OPCOES_GRUPO_ARGSORT)
+
 // Macro para obter o tempo atual em segundos
 #define OBTER_TEMPO(agora) { \
     struct timeval t; \
@@ -28,55 +56,6 @@
     agora = t.tv_sec + t.tv_usec / 1e6; \
 }
 
-// Função para garantir que o diretório "Data" e o arquivo "seq_minmax.txt" existam
-void garantirDiretorioEArquivo() {
-    struct stat st = {0};
-    
-    // Criar o diretório Data, se não existir
-    if (stat("Data", &st) == -1) {
-        mkdir("Data", 0700);  // Cria o diretório com permissão 0700
-    }
-
-    // Abrir o arquivo Data/seq_minmax.txt para verificar a primeira linha
-    FILE *arquivoLog = fopen("Data/seq_minmax.txt", "r+");
-    if (!arquivoLog) {
-        // Se o arquivo não existir, criá-lo e adicionar o cabeçalho
-        arquivoLog = fopen("Data/seq_minmax.txt", "w");
-        if (!arquivoLog) {
-            perror("Erro ao abrir o arquivo de log");
-            exit(1);
-        }
-        // Adicionar a linha de cabeçalho
-        fprintf(arquivoLog, "Programa,Tempo,Comprimento,Threads\n");
-        fclose(arquivoLog); // Fechar após escrever o cabeçalho
-    } else {
-        // Arquivo existe, verificar a primeira linha
-        char linha[256];
-        if (fgets(linha, sizeof(linha), arquivoLog)) {
-            // Verificar se a primeira linha é o cabeçalho esperado
-            if (linha[0] != 'T' || linha[1] != 'e' || linha[2] != 'm' || linha[3] != 'p' || linha[4] != 'o') {
-                // Se não for, adicionar o cabeçalho
-                fseek(arquivoLog, 0, SEEK_SET);  // Voltar para o início do arquivo
-                fprintf(arquivoLog, "Programa,Tempo,Comprimento,Threads\n");
-            }
-        }
-        fclose(arquivoLog); // Fechar o arquivo após verificação
-    }
-}
-
-// Função para registrar o tempo no arquivo
-void registrarTempoNoArquivo(double tempoGasto, int comprimentoA) {
-    FILE *arquivoLog = fopen("Data/seq_minmax.txt", "a");
-    if (!arquivoLog) {
-        perror("Erro ao abrir o arquivo de log");
-        exit(1);
-    }
-
-    // Adicionar a linha de log no arquivo Data/seq_minmax.txt
-    fprintf(arquivoLog, "SeqMinMaxSort,%f,%d,\n", tempoGasto, comprimentoA);
-    fclose(arquivoLog);
-}
-
 // // Função para verificar se o vetor já está ordenado
 // int estaOrdenado(int vetor[], int n) {
 //     for (int i = 1; i < n; i++) {
@@ -87,121 +66,66 @@ void registrarTempoNoArquivo(double tempoGasto, int comprimentoA) {
 //     return 1; // Está ordenado
 // }
 
-// Algoritmo Min-Max Sort
-void minMaxSort(int vetor[], int n) {
-    int indiceMin = 0, indiceMax = n - 1;
-
-    while (indiceMin < indiceMax) {
-        int posMin = indiceMin, posMax = indiceMax;
-
-        // Procurar o menor e o maior valor no vetor
-        for (int i = indiceMin; i <= indiceMax; i++) {
-            if (vetor[i] < vetor[posMin]) {
-                posMin = i;
-            }
-            if (vetor[i] > vetor[posMax]) {
-                posMax = i;
-            }
-        }
+int main(int argc, char *argv[]) {
+    // Extrair as opções comuns (--es, ...) e manter apenas os argumentos posicionais
+    OpcoesExecucao opcoes;
+    argc = extrairOpcoes(argc, argv, &opcoes);
 
-        // Trocar o menor valor com o início do vetor
-        if (posMin != indiceMin) {
-            int temp = vetor[indiceMin];
-            vetor[indiceMin] = vetor[posMin];
-            vetor[posMin] = temp;
+    // Verifica se os parâmetros de entrada foram passados corretamente
+    int lote = modoLote(&opcoes);
+    if (argc != (lote ? 1 : 3)) {
+        printf("Uso: %s <arquivo_entrada.bin> <arquivo_saida.bin> [opções]\n", argv[0]);
+        printf("     %s --entradas <padrão> | --manifesto <arquivo> [opções]\n", argv[0]);
+        imprimirOpcoesAceitas(stdout, OPCOES_ACEITAS);
+        return 1;
+    }
+    if (verificarOpcoesAceitas(&opcoes, OPCOES_ACEITAS) != 0) {
+        return 1;
+    }
 
-            // Ajustar a posição do maior valor caso tenha sido trocado com o menor
-            if (posMax == indiceMin) {
-                posMax = posMin;
+    // Modo em lote: todos os arquivos no mesmo processo, com o log aberto uma única vez
+    if (lote) {
+        PoolThreads *pool = NULL;
+        if (opcoes.loteConcorrente) {
+            pool = criarPoolThreads(cpusDisponiveis(), NULL);
+            if (!pool) {
+                return 1;
             }
         }
-
-        // Trocar o maior valor com o final do vetor
-        if (posMax != indiceMax) {
-            int temp = vetor[indiceMax];
-            vetor[indiceMax] = vetor[posMax];
-            vetor[posMax] = temp;
+        OpcoesOrdenacao ordenacao;
+        opcoesOrdenacaoPadrao(&ordenacao, ORDENACAO_MINMAX_SEQ);
+        int resultado = ordenarLote(&opcoes, &ordenacao, pool, "Data/seq_minmax.txt", "SeqMinMaxSort", 0);
+        if (pool) {
+            destruirPoolThreads(pool);
         }
-
-        // Ajustar os índices
-        indiceMin++;
-        indiceMax--;
-    }
-}
-
-// Função para ler o vetor a partir de um arquivo binário
-int* lerVetorBinario(const char *nomeArquivo, int *n) {
-    FILE *arquivo = fopen(nomeArquivo, "rb");
-    if (!arquivo) {
-        printf("Erro: Não foi possível abrir o arquivo de entrada.\n");
-        return NULL;
-    }
-
-    // Ler o tamanho do vetor
-    if (fread(n, sizeof(int), 1, arquivo) != 1) {
-        printf("Erro: Falha ao ler o tamanho do vetor.\n");
-        fclose(arquivo);
-        return NULL;
-    }
-
-    // Alocar memória para o vetor
-    int *vetor = (int *)malloc(*n * sizeof(int));
-    if (!vetor) {
-        printf("Erro: Falha na alocação de memória.\n");
-        fclose(arquivo);
-        return NULL;
-    }
-
-    // Ler os valores do vetor
-    if (fread(vetor, sizeof(int), *n, arquivo) != *n) {
-        printf("Erro: Falha ao ler os valores do vetor.\n");
-        free(vetor);
-        fclose(arquivo);
-        return NULL;
-    }
-
-    fclose(arquivo);
-    return vetor;
-}
-
-// Função para salvar o vetor em um arquivo binário
-void salvarVetorBinario(const char *nomeArquivo, int *vetor, int n) {
-    FILE *arquivo = fopen(nomeArquivo, "wb");
-    if (!arquivo) {
-        printf("Erro: Não foi possível criar o arquivo de saída.\n");
-        return;
-    }
-
-    // Escrever o tamanho do vetor
-    fwrite(&n, sizeof(int), 1, arquivo);
-
-    // Escrever os valores do vetor
-    fwrite(vetor, sizeof(int), n, arquivo);
-
-    fclose(arquivo);
-}
-
-int main(int argc, char *argv[]) {
-    // Verifica se os parâmetros de entrada foram passados corretamente
-    if (argc != 3) {
-        printf("Uso: %s <arquivo_entrada.bin> <arquivo_saida.bin>\n", argv[0]);
-        return 1;
+        return resultado;
     }
 
     // Garantir que o diretório e o arquivo de log existam
-    garantirDiretorioEArquivo();
+    garantirDiretorioEArquivo("Data/seq_minmax.txt");
 
     const char *arquivoEntrada = argv[1];
     const char *arquivoSaida = argv[2];
     int n;
 
     // Ler o vetor do arquivo binário
-    int *vetor = lerVetorBinario(arquivoEntrada, &n);
+    int *vetor = lerVetorArquivo(arquivoEntrada, &n, &opcoes.es);
     if (!vetor) {
         return 1;
     }
 
     printf("Tamanho do array: %d\n", n);
+
+    // Com --argsort, os índices que ordenam a entrada também são calculados
+    void *permutacao = NULL;
+    if (opcoes.argsort) {
+        permutacao = alocarBuffer((size_t)n * opcoes.larguraIndice + 1);
+        if (!permutacao) {
+            printf("Erro: Falha na alocação de memória para a permutação.\n");
+            liberarBuffer(vetor);
+            return 1;
+        }
+    }
     // // Exibir o vetor antes da ordenação (mostra os primeiros e últimos 5 elementos, se houver muitos)
     // printf("\nVetor (antes): [ ");
     // for (int i = 0; i < (n < 10 ? n : 5); i++) {
@@ -214,27 +138,66 @@ int main(int argc, char *argv[]) {
     // printf("]\n");
 
     // Ordenar o vetor e medir o tempo de execução
+    // (com --preordenacao, vetores já ordenados, invertidos ou com corridas longas não
+    // passam pelas O(n²) passadas do MinMaxSort)
+    OpcoesOrdenacao ordenacao;
+    MetricasPreordenacao metricas;
+    opcoesOrdenacaoPadrao(&ordenacao, ORDENACAO_MINMAX_SEQ);
+    ordenacao.preordenacao = opcoes.preordenacao;
+    ordenacao.metricas = &metricas;
+    MetricasCompactacao compactacao;
+    ordenacao.compactar = opcoes.compactar;
+    ordenacao.compactacao = &compactacao;
+    ordenacao.permutacao = permutacao;
+    ordenacao.larguraIndice = opcoes.larguraIndice;
+    ordenacao.numThreads = 1;
     double inicio, fim, tempoExecucao;
 
     OBTER_TEMPO(inicio);
 
-    minMaxSort(vetor, n);
+    ordenarI32(vetor, n, &ordenacao);
 
     OBTER_TEMPO(fim);
 
     tempoExecucao = fim - inicio;
     printf("Tempo de execução: %f segundos\n", tempoExecucao);
+    imprimirRelatorioMemoria(stdout);
 
     // Registrar o tempo no arquivo
-    registrarTempoNoArquivo(tempoExecucao, n);
+    registrarTempoNoArquivo("Data/seq_minmax.txt", "SeqMinMaxSort", tempoExecucao, n, 0);
+    if (opcoes.preordenacao) {
+        imprimirPreordenacao(stdout, &metricas);
+        registrarPreordenacao("SeqMinMaxSort", tempoExecucao, n, 0, &metricas);
+    }
+    if (opcoes.compactar) {
+        imprimirCompactacao(stdout, &compactacao);
+        registrarCompactacao("SeqMinMaxSort", tempoExecucao, n, 0, &compactacao);
+    }
 
     // Salvar o vetor ordenado no arquivo binário
-    salvarVetorBinario(arquivoSaida, vetor, n);
+    if (gravarVetorArquivo(arquivoSaida, vetor, n, &opcoes.es) != 0) {
+        if (permutacao) {
+            liberarBuffer(permutacao);
+        }
+        liberarBuffer(vetor);
+        return 1;
+    }
 
     printf("Vetor ordenado salvo em: %s\n", arquivoSaida);
 
+    // Gravar a permutação
+    if (permutacao) {
+        int erro = gravarPermutacaoArquivo(opcoes.argsort, permutacao, n, opcoes.larguraIndice, &opcoes.es);
+        liberarBuffer(permutacao);
+        if (erro != 0) {
+            liberarBuffer(vetor);
+            return 1;
+        }
+        printf("Permutação salva em %s\n", opcoes.argsort);
+    }
+
     // Liberar a memória alocada para o vetor
-    free(vetor);
+    liberarBuffer(vetor);
 
     return 0;
 }
@@ -1,10 +1,28 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 
 // Descrição: Este programa verifica se um array de inteiros armazenado em um arquivo binário está ordenado em ordem crescente.
 // Ele recebe o nome de um arquivo binário como argumento. O programa lê o comprimento do array e os seus elementos a partir do arquivo,
 // e então verifica se o array está ordenado. O resultado da verificação é impresso na tela como "True" (se ordenado) ou "False" (se não ordenado).
+// Arquivos segmentados (ver Common/EntradaSaida.h) também são aceitos: nesse caso, cada segmento deve estar ordenado.
+// Arquivos de registros também são aceitos: as chaves devem estar em ordem crescente e, quando a carga tiver ao menos 8 bytes
+// (com a posição original do registro nos 8 primeiros, como no CriarRegistros), registros de mesma chave devem manter a ordem original.
+// Arquivos de permutação (--argsort) são verificados como permutação: cada índice de 0 a n - 1 aparece exatamente uma vez.
+// Arquivos de cadeias devem estar na ordem lexicográfica dos bytes, e os comprimentos devem ocupar a coluna inteira.
+
+// Primeiro inteiro dos arquivos segmentados (ES_MARCADOR_SEGMENTADO em Common/EntradaSaida.h)
+#define MARCADOR_SEGMENTADO (-0x53454731)
+
+// Primeiro inteiro dos arquivos de registros (ES_MARCADOR_REGISTROS em Common/EntradaSaida.h)
+#define MARCADOR_REGISTROS (-0x52454731)
+
+// Primeiro inteiro dos arquivos de permutação (ES_MARCADOR_PERMUTACAO em Common/EntradaSaida.h)
+#define MARCADOR_PERMUTACAO (-0x50455231)
+
+// Primeiro inteiro dos arquivos de cadeias (ES_MARCADOR_CADEIAS em Common/EntradaSaida.h)
+#define MARCADOR_CADEIAS (-0x53545231)
 
 // Função que verifica se o array está ordenado em ordem crescente
 bool estaOrdenado(int A[], int comprimento) {
@@ -16,6 +34,186 @@ bool estaOrdenado(int A[], int comprimento) {
     return true; // O array está ordenado
 }
 
+// Função que verifica cada segmento de um arquivo segmentado (o marcador já foi lido)
+void verificarSegmentosDoArquivo(FILE *arquivo) {
+    int cabecalho[2]; // Número de segmentos e número de valores
+    if (fread(cabecalho, sizeof(int), 2, arquivo) != 2 || cabecalho[0] < 0 || cabecalho[1] < 0) {
+        perror("Erro ao ler o cabeçalho dos segmentos");
+        return;
+    }
+    int numSegmentos = cabecalho[0], comprimento = cabecalho[1];
+
+    long *deslocamentos = (long *)malloc((numSegmentos + 1) * sizeof(long));
+    int *A = (int *)malloc(comprimento * sizeof(int) + 1);
+    if (deslocamentos == NULL || A == NULL) {
+        perror("Falha na alocação de memória");
+        free(deslocamentos);
+        free(A);
+        return;
+    }
+
+    if (fread(deslocamentos, sizeof(long), numSegmentos + 1, arquivo) != (size_t)(numSegmentos + 1) ||
+        fread(A, sizeof(int), comprimento, arquivo) != (size_t)comprimento) {
+        perror("Erro ao ler os segmentos");
+        free(deslocamentos);
+        free(A);
+        return;
+    }
+
+    // Todos os segmentos devem estar dentro do vetor e ordenados
+    bool ordenado = deslocamentos[0] == 0 && deslocamentos[numSegmentos] == comprimento;
+    for (int s = 0; ordenado && s < numSegmentos; s++) {
+        ordenado = deslocamentos[s] <= deslocamentos[s + 1] &&
+                   estaOrdenado(A + deslocamentos[s], (int)(deslocamentos[s + 1] - deslocamentos[s]));
+    }
+    printf(ordenado ? "True\n" : "False\n");
+
+    free(deslocamentos);
+    free(A);
+}
+
+// Função que lê a chave de 4 ou 8 bytes de um registro
+long long chaveDoRegistro(const unsigned char *registro, int larguraChave) {
+    if (larguraChave == 4) {
+        int chave;
+        memcpy(&chave, registro, sizeof(chave));
+        return chave;
+    }
+    long long chave;
+    memcpy(&chave, registro, sizeof(chave));
+    return chave;
+}
+
+// Função que verifica a ordem (e a estabilidade) de um arquivo de registros (o marcador já foi lido)
+void verificarRegistrosDoArquivo(FILE *arquivo) {
+    int cabecalho[3]; // Largura da chave, largura da carga e número de registros
+    if (fread(cabecalho, sizeof(int), 3, arquivo) != 3 || (cabecalho[0] != 4 && cabecalho[0] != 8) ||
+        cabecalho[1] < 0 || cabecalho[2] < 0) {
+        perror("Erro ao ler o cabeçalho dos registros");
+        return;
+    }
+    int larguraChave = cabecalho[0], larguraCarga = cabecalho[1], comprimento = cabecalho[2];
+    size_t largura = (size_t)(larguraChave + larguraCarga);
+
+    unsigned char *registros = (unsigned char *)malloc((size_t)comprimento * largura + 1);
+    if (registros == NULL) {
+        perror("Falha na alocação de memória");
+        return;
+    }
+    if (fread(registros, largura, comprimento, arquivo) != (size_t)comprimento) {
+        perror("Erro ao ler os registros");
+        free(registros);
+        return;
+    }
+
+    bool ordenado = true;
+    for (int i = 1; ordenado && i < comprimento; i++) {
+        const unsigned char *anterior = registros + (size_t)(i - 1) * largura;
+        const unsigned char *atual = anterior + largura;
+        long long chaveAnterior = chaveDoRegistro(anterior, larguraChave);
+        long long chaveAtual = chaveDoRegistro(atual, larguraChave);
+        ordenado = chaveAnterior <= chaveAtual;
+
+        // Mesma chave: a posição original guardada na carga deve crescer
+        if (ordenado && chaveAnterior == chaveAtual && larguraCarga >= 8) {
+            unsigned long long posicaoAnterior, posicaoAtual;
+            memcpy(&posicaoAnterior, anterior + larguraChave, sizeof(posicaoAnterior));
+            memcpy(&posicaoAtual, atual + larguraChave, sizeof(posicaoAtual));
+            ordenado = posicaoAnterior < posicaoAtual;
+        }
+    }
+    printf(ordenado ? "True\n" : "False\n");
+
+    free(registros);
+}
+
+// Função que verifica se um arquivo de permutação tem cada índice exatamente uma vez (o marcador já foi lido)
+void verificarPermutacaoDoArquivo(FILE *arquivo) {
+    int cabecalho[2]; // Largura dos índices e número de índices
+    if (fread(cabecalho, sizeof(int), 2, arquivo) != 2 || (cabecalho[0] != 4 && cabecalho[0] != 8) || cabecalho[1] < 0) {
+        perror("Erro ao ler o cabeçalho da permutação");
+        return;
+    }
+    int larguraIndice = cabecalho[0], comprimento = cabecalho[1];
+
+    unsigned char *indices = (unsigned char *)malloc((size_t)comprimento * larguraIndice + 1);
+    bool *visto = (bool *)calloc((size_t)comprimento + 1, sizeof(bool));
+    if (indices == NULL || visto == NULL) {
+        perror("Falha na alocação de memória");
+        free(indices);
+        free(visto);
+        return;
+    }
+    if (fread(indices, larguraIndice, comprimento, arquivo) != (size_t)comprimento) {
+        perror("Erro ao ler os índices");
+        free(indices);
+        free(visto);
+        return;
+    }
+
+    bool valida = true;
+    for (int i = 0; valida && i < comprimento; i++) {
+        unsigned long long indice = 0;
+        memcpy(&indice, indices + (size_t)i * larguraIndice, larguraIndice);
+        valida = indice < (unsigned long long)comprimento && !visto[indice];
+        if (valida) {
+            visto[indice] = true;
+        }
+    }
+    printf(valida ? "True\n" : "False\n");
+
+    free(indices);
+    free(visto);
+}
+
+// Função que verifica se as cadeias de um arquivo de cadeias estão na ordem lexicográfica dos bytes (o marcador já foi lido)
+void verificarCadeiasDoArquivo(FILE *arquivo) {
+    int comprimento;
+    long long bytes;
+    if (fread(&comprimento, sizeof(int), 1, arquivo) != 1 || fread(&bytes, sizeof(bytes), 1, arquivo) != 1 ||
+        comprimento < 0 || bytes < 0) {
+        perror("Erro ao ler o cabeçalho das cadeias");
+        return;
+    }
+
+    unsigned char *coluna = (unsigned char *)malloc((size_t)bytes + 1);
+    if (coluna == NULL) {
+        perror("Falha na alocação de memória");
+        return;
+    }
+    if (fread(coluna, 1, (size_t)bytes, arquivo) != (size_t)bytes) {
+        perror("Erro ao ler as cadeias");
+        free(coluna);
+        return;
+    }
+
+    // Cada cadeia é comparada com a anterior: primeiro os bytes comuns, depois o comprimento
+    bool ordenado = true;
+    size_t posicao = 0, anterior = 0;
+    unsigned int comprimentoAnterior = 0;
+    for (int i = 0; ordenado && i < comprimento; i++) {
+        unsigned int c;
+        ordenado = (size_t)bytes - posicao >= sizeof(c);
+        if (!ordenado) {
+            break;
+        }
+        memcpy(&c, coluna + posicao, sizeof(c));
+        posicao += sizeof(c);
+        ordenado = c <= (size_t)bytes - posicao;
+        if (ordenado && i > 0) {
+            unsigned int comum = c < comprimentoAnterior ? c : comprimentoAnterior;
+            int ordem = memcmp(coluna + anterior, coluna + posicao, comum);
+            ordenado = ordem < 0 || (ordem == 0 && comprimentoAnterior <= c);
+        }
+        anterior = posicao;
+        comprimentoAnterior = c;
+        posicao += c;
+    }
+    printf(ordenado && posicao == (size_t)bytes ? "True\n" : "False\n");
+
+    free(coluna);
+}
+
 // Função que lê o array de um arquivo binário e verifica se está ordenado
 void verificarArrayDoArquivo(const char *nome_arquivo) {
     FILE *arquivo = fopen(nome_arquivo, "rb");
@@ -32,6 +230,34 @@ void verificarArrayDoArquivo(const char *nome_arquivo) {
         return;
     }
 
+    // Arquivo segmentado: verificar cada segmento
+    if (comprimento == MARCADOR_SEGMENTADO) {
+        verificarSegmentosDoArquivo(arquivo);
+        fclose(arquivo);
+        return;
+    }
+
+    // Arquivo de permutação: verificar os índices
+    if (comprimento == MARCADOR_PERMUTACAO) {
+        verificarPermutacaoDoArquivo(arquivo);
+        fclose(arquivo);
+        return;
+    }
+
+    // Arquivo de cadeias: verificar a ordem lexicográfica
+    if (comprimento == MARCADOR_CADEIAS) {
+        verificarCadeiasDoArquivo(arquivo);
+        fclose(arquivo);
+        return;
+    }
+
+    // Arquivo de registros: verificar as chaves e a estabilidade
+    if (comprimento == MARCADOR_REGISTROS) {
+        verificarRegistrosDoArquivo(arquivo);
+        fclose(arquivo);
+        return;
+    }
+
     // Ler os elementos do array da segunda linha do arquivo
     int *A = (int *)malloc(comprimento * sizeof(int));
     if (A == NULL) {